@@ -0,0 +1,155 @@
+#include <cstdio>
+#include <cstdint>
+#include <cstring>
+#include <ctime>
+#include <vector>
+#include "../src/Decoder/InstForm.h"
+#include "../lib/IDASM/Include/INSANE_DisassemblerAMD64.h"
+
+
+
+// Walking code by InstForm lengths vs. decoding it with the disassembler, over libc's code. The RETN
+// scan used to decode ( & disassemble ) 200 byte batches just to learn instruction lengths.
+static constexpr size_t MAX_CODE_SIZE = 1024 * 1024;
+static constexpr size_t BATCH_SIZE    = 200;
+static constexpr int    ROUNDS        = 5;
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+static uint64_t NowNs()
+{
+    timespec time;
+    clock_gettime(CLOCK_MONOTONIC, &time);
+    return static_cast<uint64_t>(time.tv_sec) * 1000000000ull + static_cast<uint64_t>(time.tv_nsec);
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+static bool CopyLibcCode(std::vector<uint8_t>& vecCode)
+{
+    FILE* pFile = fopen("/proc/self/maps", "r");
+    if(pFile == nullptr)
+        return false;
+
+    // First executable mapping of libc.
+    char szLine[512];
+    while(fgets(szLine, sizeof(szLine), pFile) != nullptr)
+    {
+        unsigned long iStart = 0, iEnd = 0; char szPerms[8] = {};
+        if(sscanf(szLine, "%lx-%lx %7s", &iStart, &iEnd, szPerms) != 3 || szPerms[2] != 'x' || strstr(szLine, "libc") == nullptr)
+            continue;
+
+        size_t iSize = iEnd - iStart < MAX_CODE_SIZE ? iEnd - iStart : MAX_CODE_SIZE;
+        vecCode.assign(reinterpret_cast<const uint8_t*>(iStart), reinterpret_cast<const uint8_t*>(iStart) + iSize);
+        break;
+    }
+
+    fclose(pFile);
+    return vecCode.empty() == false;
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+static uint64_t WalkInstForm(const std::vector<uint8_t>& vecCode, size_t& nInstOut)
+{
+    uint64_t iStart = NowNs();
+
+    size_t iOffset = 0; nInstOut = 0;
+    while(iOffset < vecCode.size())
+    {
+        DeadStop::InstForm_t form;
+        if(DeadStop::ParseInstForm(vecCode.data() + iOffset, vecCode.size() - iOffset, form) == false)
+        {
+            iOffset++;
+            continue;
+        }
+
+        iOffset += form.m_iLength;
+        nInstOut++;
+    }
+
+    return NowNs() - iStart;
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+static uint64_t WalkDecoder(const std::vector<uint8_t>& vecCode, bool bDisassemble, ArenaAllocator_t& allocator, size_t& nInstOut)
+{
+    std::vector<InsaneDASM64::Byte>          vecBytes;    vecBytes.reserve(BATCH_SIZE);
+    std::vector<InsaneDASM64::Instruction_t> vecInst;     vecInst.reserve(BATCH_SIZE);
+    std::vector<InsaneDASM64::DASMInst_t>    vecDasmInst; vecDasmInst.reserve(BATCH_SIZE);
+
+    uint64_t iStart = NowNs();
+
+    nInstOut = 0;
+    for(size_t iOffset = 0; iOffset < vecCode.size(); iOffset += BATCH_SIZE)
+    {
+        size_t iSize = vecCode.size() - iOffset < BATCH_SIZE ? vecCode.size() - iOffset : BATCH_SIZE;
+        vecBytes.assign(vecCode.begin() + iOffset, vecCode.begin() + iOffset + iSize);
+        vecInst.clear(); vecDasmInst.clear(); allocator.ResetAllArena();
+
+        InsaneDASM64::Decode(vecBytes, vecInst, allocator);
+        if(bDisassemble == true)
+            InsaneDASM64::Disassemble(vecInst, vecDasmInst);
+
+        nInstOut += vecInst.size();
+    }
+
+    return NowNs() - iStart;
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+int main(void)
+{
+    std::vector<uint8_t> vecCode;
+    if(CopyLibcCode(vecCode) == false)
+    {
+        printf("Couldn't find libc's code in /proc/self/maps\n");
+        return 1;
+    }
+
+    if(InsaneDASM64::Initialize() != InsaneDASM64::IDASMErrorCode_Success)
+    {
+        printf("Failed to initialize the disassembler\n");
+        return 1;
+    }
+
+    ArenaAllocator_t allocator(8 * 1024);
+
+
+    // Best of a few rounds, everything here is warm after the first.
+    uint64_t iInstFormNs = UINT64_MAX, iDecodeNs = UINT64_MAX, iDisassembleNs = UINT64_MAX;
+    size_t   nInstForm   = 0,          nDecode   = 0,          nDisassemble   = 0;
+    for(int iRound = 0; iRound < ROUNDS; iRound++)
+    {
+        uint64_t iNs = WalkInstForm(vecCode, nInstForm);                         if(iNs < iInstFormNs)    iInstFormNs    = iNs;
+        iNs          = WalkDecoder(vecCode, false, allocator, nDecode);          if(iNs < iDecodeNs)      iDecodeNs      = iNs;
+        iNs          = WalkDecoder(vecCode, true,  allocator, nDisassemble);     if(iNs < iDisassembleNs) iDisassembleNs = iNs;
+    }
+
+    InsaneDASM64::UnInitialize();
+
+    if(nInstForm == 0 || nDecode == 0 || nDisassemble == 0)
+    {
+        printf("Nothing decoded, no ratio to give\n");
+        return 1;
+    }
+
+
+    double flInstFormNs = static_cast<double>(iInstFormNs) / static_cast<double>(nInstForm);
+    double flDecodeNs   = static_cast<double>(iDecodeNs)   / static_cast<double>(nDecode);
+    double flDasmNs     = static_cast<double>(iDisassembleNs) / static_cast<double>(nDisassemble);
+
+    printf("%zu bytes of libc code\n", vecCode.size());
+    printf("InstForm              : %8zu inst, %8.2f ms, %7.2f ns / inst\n", nInstForm,    iInstFormNs    / 1e6, flInstFormNs);
+    printf("Decode                : %8zu inst, %8.2f ms, %7.2f ns / inst, %6.1fx InstForm\n", nDecode,      iDecodeNs      / 1e6, flDecodeNs, flDecodeNs / flInstFormNs);
+    printf("Decode + Disassemble  : %8zu inst, %8.2f ms, %7.2f ns / inst, %6.1fx InstForm\n", nDisassemble, iDisassembleNs / 1e6, flDasmNs,   flDasmNs   / flInstFormNs);
+
+    return 0;
+}
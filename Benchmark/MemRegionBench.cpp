@@ -0,0 +1,123 @@
+#include <cstdio>
+#include <cstdint>
+#include <cstdlib>
+#include <ctime>
+#include <vector>
+#include "../src/Defs/MemRegion_t.h"
+#include "../src/SignalHandler/SignalHandler.h"
+
+
+
+// Region lookups through the index vs. a linear scan over the same regions, at the mapping counts big
+// processes have. Also prints the crash memory budget each count needs, see DeadStop_InitializeEx().
+using namespace DeadStop;
+
+static constexpr size_t    LOOKUPS     = 1 << 20;
+static constexpr uintptr_t REGION_BASE = 0x7f0000000000ull;
+static constexpr uintptr_t PAGE_SIZE   = 0x1000;
+static volatile uintptr_t  s_iSink     = 0; // Keeps lookups from being optimized out.
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+static uint64_t NowNs()
+{
+    timespec time;
+    clock_gettime(CLOCK_MONOTONIC, &time);
+    return static_cast<uint64_t>(time.tv_sec) * 1000000000ull + static_cast<uint64_t>(time.tv_nsec);
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+static const MemRegion_t* FindLinear(const std::vector<MemRegion_t>& vecRegions, uintptr_t iAdrs)
+{
+    for(const MemRegion_t& region : vecRegions)
+    {
+        if(iAdrs >= region.m_iStart && iAdrs < region.m_iEnd)
+            return &region;
+    }
+
+    return nullptr;
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+static bool Benchmark(size_t nRegions)
+{
+    std::vector<uint8_t> vecStorage(GetCrashMemoryBudget(nRegions) / 4);
+    MemRegionHandler_t   memRegions;
+    memRegions.SetStorage(vecStorage.data(), vecStorage.size());
+
+    // Page sized mappings with a page gap between them & alternating access, so nothing merges.
+    std::vector<MemRegion_t> vecRegions;
+    for(size_t iRegion = 0; iRegion < nRegions; iRegion++)
+    {
+        uintptr_t iStart = REGION_BASE + iRegion * 2 * PAGE_SIZE;
+        uint32_t  iFlags = (iRegion & 1) != 0 ? MemRegionFlag_Read : MemRegionFlag_Read | MemRegionFlag_Exec;
+        memRegions.RegisterRegion(iStart, iStart + PAGE_SIZE, iFlags);
+        vecRegions.push_back(MemRegion_t(iStart, iStart + PAGE_SIZE, iFlags));
+    }
+
+    uint64_t iBuildNs = NowNs();
+    memRegions.BuildIndex();
+    iBuildNs = NowNs() - iBuildNs;
+
+
+    // Half land in regions, half in the gaps.
+    std::vector<uintptr_t> vecAdrs(LOOKUPS);
+    srand(2);
+    for(uintptr_t& iAdrs : vecAdrs)
+        iAdrs = REGION_BASE + (static_cast<uint64_t>(rand()) * 16) % (nRegions * 2 * PAGE_SIZE);
+
+    // Linear scan is slow, it gets fewer lookups.
+    size_t nLinear = LOOKUPS / (nRegions / 1000 + 1);
+    uintptr_t iSum = 0;
+
+    uint64_t iLinearNs = NowNs();
+    for(size_t iLookup = 0; iLookup < nLinear; iLookup++)
+        iSum += reinterpret_cast<uintptr_t>(FindLinear(vecRegions, vecAdrs[iLookup]));
+    iLinearNs = NowNs() - iLinearNs;
+
+    uint64_t iIndexNs = NowNs();
+    for(size_t iLookup = 0; iLookup < LOOKUPS; iLookup++)
+        iSum += reinterpret_cast<uintptr_t>(memRegions.FindParentRegion(vecAdrs[iLookup], MemRegionFlag_None));
+    iIndexNs = NowNs() - iIndexNs;
+
+    std::vector<MemRegion_t*> vecOut(LOOKUPS);
+    uint64_t iBatchNs = NowNs();
+    memRegions.FindParentRegions(vecAdrs.data(), LOOKUPS, vecOut.data(), MemRegionFlag_None);
+    iBatchNs = NowNs() - iBatchNs;
+    s_iSink  = iSum;
+
+
+    // Both must find the same regions.
+    size_t nMismatches = 0;
+    for(size_t iLookup = 0; iLookup < nLinear; iLookup++)
+    {
+        const MemRegion_t* pLinear = FindLinear(vecRegions, vecAdrs[iLookup]);
+        const MemRegion_t* pIndex  = memRegions.FindParentRegion(vecAdrs[iLookup], MemRegionFlag_None);
+        if((pLinear == nullptr) != (pIndex == nullptr) || (pLinear != nullptr && pLinear->m_iStart != pIndex->m_iStart) || (vecOut[iLookup] == nullptr) != (pLinear == nullptr))
+            nMismatches++;
+    }
+
+    printf("%6zu regions : budget %5.1f MiB | build %7.1f us | linear %8.1f ns | index %5.1f ns | batched %5.1f ns / adrs | %zu mismatches\n",
+            nRegions, GetCrashMemoryBudget(nRegions) / (1024.0 * 1024.0), iBuildNs / 1e3,
+            static_cast<double>(iLinearNs) / nLinear, static_cast<double>(iIndexNs) / LOOKUPS, static_cast<double>(iBatchNs) / LOOKUPS,
+            nMismatches);
+
+    return nMismatches == 0 && memRegions.HasOverflowed() == false;
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+int main(void)
+{
+    bool bAllMatched = true;
+    for(size_t nRegions : { 5000, 10000, 20000, 40000 })
+        bAllMatched &= Benchmark(nRegions);
+
+    return bAllMatched == true ? 0 : 1;
+}
@@ -0,0 +1,175 @@
+#include <algorithm>
+#include <cstdio>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <vector>
+#include <signal.h>
+#include <sys/mman.h>
+#include "../src/Defs/MemRegion_t.h"
+#include "../src/Util/SafeRead/SafeRead.h"
+
+
+
+// Cost of a SafeRead() against the maps check + memcpy it replaced, through the region index & through
+// a linear scan, with extra regions on top of this process's own ( big processes have 10k+ ).
+using namespace DeadStop;
+
+static constexpr size_t    READS         = 200000;
+static constexpr size_t    SOURCE_SIZE   = 1024 * 1024;
+static constexpr uintptr_t FILLER_BASE   = 0x100000000000ull;
+static constexpr uintptr_t PAGE_SIZE     = 0x1000;
+static constexpr size_t    MAX_OWN_MAPS  = 4096; // Lines of our own /proc/self/maps we leave room for.
+static volatile uint64_t   s_iSink       = 0;    // Keeps reads from being optimized out.
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+static uint64_t NowNs()
+{
+    timespec time;
+    clock_gettime(CLOCK_MONOTONIC, &time);
+    return static_cast<uint64_t>(time.tv_sec) * 1000000000ull + static_cast<uint64_t>(time.tv_nsec);
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+static bool HasParentLinear(const std::vector<MemRegion_t>& vecRegions, uintptr_t iStart, uintptr_t iEnd)
+{
+    for(const MemRegion_t& region : vecRegions)
+    {
+        if(iStart >= region.m_iStart && iEnd < region.m_iEnd)
+            return true;
+    }
+
+    return false;
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+static double TimeSafeRead(SafeReadMode_t iMode, uint8_t* pDest, const std::vector<uintptr_t>& vecAdrs, size_t iSize)
+{
+    InitializeSafeRead(iMode);
+
+    uint64_t iSum   = 0;
+    uint64_t iStart = NowNs();
+    for(uintptr_t iAdrs : vecAdrs)
+        iSum += SafeRead(pDest, iAdrs, iSize);
+
+    uint64_t iNs = NowNs() - iStart;
+    s_iSink = iSum;
+    return static_cast<double>(iNs) / static_cast<double>(vecAdrs.size());
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+static void OnFault(int iSignalID, siginfo_t* pSigInfo, void* pContext)
+{
+    // Only reads in recovery point mode fault in here.
+    RecoverFromSafeReadFault(iSignalID);
+    signal(iSignalID, SIG_DFL);
+
+    (void)pSigInfo; (void)pContext;
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+int main(void)
+{
+    struct sigaction action = {};
+    action.sa_sigaction = OnFault;
+    action.sa_flags     = SA_SIGINFO;
+    sigaction(SIGSEGV, &action, nullptr);
+
+
+    // Reads land all over a 1 MiB buffer, so they don't all hit the same cache lines.
+    std::vector<uint8_t>   vecSource(SOURCE_SIZE, 7), vecDest(SOURCE_SIZE);
+    std::vector<uintptr_t> vecAdrs(READS);
+    srand(1);
+    for(uintptr_t& iAdrs : vecAdrs)
+        iAdrs = reinterpret_cast<uintptr_t>(vecSource.data()) + static_cast<size_t>(rand()) % (SOURCE_SIZE - 2 * PAGE_SIZE);
+
+    static char s_szMapsText[1024 * 1024];
+
+    for(size_t nFillers : { 0, 5000, 40000 })
+    {
+        std::vector<uint8_t> vecStorage((nFillers + MAX_OWN_MAPS) * MemRegionHandler_t::STORAGE_PER_REGION + PAGE_SIZE);
+        MemRegionHandler_t   memRegions;
+        memRegions.SetStorage(vecStorage.data(), vecStorage.size());
+        if(memRegions.InitializeFromFile("/proc/self/maps", s_szMapsText, sizeof(s_szMapsText)) == false)
+        {
+            printf("Failed to read /proc/self/maps\n");
+            return 1;
+        }
+
+        // Filler mappings far from anything real, a page each with a page gap between them.
+        std::vector<MemRegion_t> vecRegions(memRegions.GetAllRegions(), memRegions.GetAllRegions() + memRegions.GetRegionCount());
+        for(size_t iFiller = 0; iFiller < nFillers; iFiller++)
+        {
+            uintptr_t iStart = FILLER_BASE + iFiller * 2 * PAGE_SIZE;
+            memRegions.RegisterRegion(iStart, iStart + PAGE_SIZE);
+            vecRegions.push_back(MemRegion_t(iStart, iStart + PAGE_SIZE));
+        }
+        memRegions.BuildIndex();
+
+        // Sorted like the maps are, fillers sit below our buffer.
+        std::sort(vecRegions.begin(), vecRegions.end(), [](const MemRegion_t& a, const MemRegion_t& b) { return a.m_iStart < b.m_iStart; });
+
+
+        for(size_t iSize : { 8, 4096 })
+        {
+            uint64_t iSum = 0;
+
+            uint64_t iIndexNs = NowNs();
+            for(uintptr_t iAdrs : vecAdrs)
+            {
+                if(memRegions.HasParentRegion(iAdrs, iAdrs + iSize - 1) == true)
+                {
+                    memcpy(vecDest.data(), reinterpret_cast<const void*>(iAdrs), iSize);
+                    iSum += iSize;
+                }
+            }
+            iIndexNs = NowNs() - iIndexNs;
+
+            // Linear scan is slow, it gets fewer reads.
+            size_t   nLinear   = READS / (nFillers >= 40000 ? 100 : 10);
+            uint64_t iLinearNs = NowNs();
+            for(size_t iRead = 0; iRead < nLinear; iRead++)
+            {
+                if(HasParentLinear(vecRegions, vecAdrs[iRead], vecAdrs[iRead] + iSize - 1) == true)
+                {
+                    memcpy(vecDest.data(), reinterpret_cast<const void*>(vecAdrs[iRead]), iSize);
+                    iSum += iSize;
+                }
+            }
+            iLinearNs = NowNs() - iLinearNs;
+            s_iSink   = iSum;
+
+            double flVMReadvNs  = TimeSafeRead(SafeReadMode_ProcessVMReadv, vecDest.data(), vecAdrs, iSize);
+            double flRecoveryNs = TimeSafeRead(SafeReadMode_RecoveryPoint,  vecDest.data(), vecAdrs, iSize);
+
+            printf("%6zu regions, %4zu bytes : linear maps + memcpy %8.1f ns | index maps + memcpy %6.1f ns | process_vm_readv %6.1f ns | recovery point %6.1f ns\n",
+                    memRegions.GetRegionCount(), iSize, static_cast<double>(iLinearNs) / nLinear, static_cast<double>(iIndexNs) / READS,
+                    flVMReadvNs, flRecoveryNs);
+        }
+    }
+
+
+    // Reads that fail, off an unreadable page.
+    void* pBadPage = mmap(nullptr, PAGE_SIZE, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if(pBadPage != MAP_FAILED)
+    {
+        std::vector<uintptr_t> vecBadAdrs(READS / 10, reinterpret_cast<uintptr_t>(pBadPage));
+        double flVMReadvNs  = TimeSafeRead(SafeReadMode_ProcessVMReadv, vecDest.data(), vecBadAdrs, 8);
+        double flRecoveryNs = TimeSafeRead(SafeReadMode_RecoveryPoint,  vecDest.data(), vecBadAdrs, 8);
+        printf("Unreadable page, 8 bytes : process_vm_readv %6.1f ns | recovery point %6.1f ns\n", flVMReadvNs, flRecoveryNs);
+        munmap(pBadPage, PAGE_SIZE);
+    }
+
+    return 0;
+}
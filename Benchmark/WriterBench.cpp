@@ -0,0 +1,110 @@
+#include <algorithm>
+#include <cstdio>
+#include <cstdint>
+#include <ctime>
+#include <vector>
+#include <fcntl.h>
+#include <unistd.h>
+#include "../src/Util/Writer/Writer.h"
+
+
+
+// Writer_t over a report the size of a deep crash. 64 frames of 100 disassembled instructions each,
+// registers & frame banners, formatted the way the dump does it & flushed to /dev/null.
+using namespace DeadStop;
+
+static constexpr int    FRAMES       = 64;
+static constexpr int    INSTRUCTIONS = 100;
+static constexpr int    ROUNDS       = 300;
+static constexpr size_t BUFFER_SIZE  = 64 * 1024; // Same as the crash path's output buffer.
+
+static const char* s_szMnemonics[] = { "mov", "push", "lea", "call", "cmp", "jne", "vmovdqu", "add", "xor", "ret" };
+static const char* s_szOperands[]  = { "rax", "qword ptr [rbp-0x18]", "rdi", "0x401136", "dword ptr [rip+0x2ec4]", "eax" };
+static const char* s_szRegisters[] = { "R8", "R9", "R10", "R11", "R12", "R13", "R14", "R15", "RDI", "RSI", "RBP", "RBX", "RDX", "RAX", "RCX", "RSP", "RIP" };
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+static uint64_t NowNs()
+{
+    timespec time;
+    clock_gettime(CLOCK_MONOTONIC, &time);
+    return static_cast<uint64_t>(time.tv_sec) * 1000000000ull + static_cast<uint64_t>(time.tv_nsec);
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+__attribute__((noinline)) static void WriteReport(Writer_t& hFile)
+{
+    for(size_t iReg = 0; iReg < sizeof(s_szRegisters) / sizeof(s_szRegisters[0]); iReg++)
+        hFile.Format(" [ DeadStop ] %-4s : 0x%016lX  %ld\n", s_szRegisters[iReg], 0x7ffd12345678ull * (iReg + 1), static_cast<long>(iReg * 12345));
+
+    for(int iFrame = 0; iFrame < FRAMES; iFrame++)
+    {
+        uintptr_t iAdrs = 0x555555554000ull + static_cast<uintptr_t>(iFrame) * 0x1234;
+        hFile.Format("[ Start ]------------------------------->  Frame %d, %p in %s+0x%lX\n", iFrame, reinterpret_cast<void*>(iAdrs), "/usr/lib/libfoo.so", iAdrs & 0xFFFF);
+
+        for(int iInst = 0; iInst < INSTRUCTIONS; iInst++)
+        {
+            // Instruction bytes go to a scratch writer first, like DumpAssembly() does.
+            char     szBytes[64];
+            Writer_t ssBytes(szBytes, sizeof(szBytes));
+            int      nBytes = 1 + (iInst * 7) % 8;
+            for(int iByte = 0; iByte < nBytes; iByte++)
+                ssBytes.WriteHex((iInst * 31 + iByte * 17) & 0xFF, 2);
+
+            hFile.Write("0x").WriteHex(iAdrs, 0, false).Write("    ");
+            hFile.Write(ssBytes.Data(), ssBytes.Size()).WriteFill(' ', 32 - static_cast<int>(ssBytes.Size()));
+            hFile.WritePadded(s_szMnemonics[iInst % 10], 10);
+
+            int nOperands = iInst % 3;
+            for(int iOperand = 0; iOperand < nOperands; iOperand++)
+                hFile.Write(iOperand == 0 ? " " : ", ").Write(s_szOperands[(iInst + iOperand) % 6]);
+
+            hFile.Write('\n');
+            iAdrs += static_cast<uintptr_t>(nBytes);
+        }
+
+        hFile.Format("[  End  ]------------------------------->  Frame %d\n\n", iFrame);
+    }
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+int main(void)
+{
+    int iFd = open("/dev/null", O_WRONLY | O_CLOEXEC);
+    if(iFd < 0)
+    {
+        printf("Failed to open /dev/null\n");
+        return 1;
+    }
+
+    static char s_buffer[BUFFER_SIZE];
+    std::vector<uint64_t> vecNs;
+    for(int iRound = 0; iRound < ROUNDS; iRound++)
+    {
+        Writer_t hFile(s_buffer, sizeof(s_buffer), iFd);
+
+        uint64_t iStart = NowNs();
+        WriteReport(hFile);
+        hFile.Flush();
+        vecNs.push_back(NowNs() - iStart);
+    }
+    close(iFd);
+
+
+    // Report size, written once into a buffer big enough for all of it.
+    static char s_report[4 * 1024 * 1024];
+    Writer_t ssReport(s_report, sizeof(s_report));
+    WriteReport(ssReport);
+
+    std::sort(vecNs.begin(), vecNs.end());
+    double flMedianUs = static_cast<double>(vecNs[vecNs.size() / 2]) / 1e3;
+    printf("%d frames x %d instructions, %zu bytes : median %.1f us, min %.1f us, %.0f MB/s\n",
+            FRAMES, INSTRUCTIONS, ssReport.Size(), flMedianUs, static_cast<double>(vecNs[0]) / 1e3, static_cast<double>(ssReport.Size()) / flMedianUs);
+
+    return 0;
+}
@@ -0,0 +1,60 @@
+#include <iostream>
+#include <cstring>
+#include <sys/mman.h>
+#include "../Include/DeadStop.h"
+
+
+
+// Mini core. Record keeps the crashing stack, pages the registers & fault address point into & code
+// around each frame, so the request below & the read only page are still there to look at afterwards.
+// deadstop-render testdump.core lists what was kept.
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+struct Request_t
+{
+    char  m_szPath[64];
+    int   m_iStatus;
+    char* m_pReply;
+};
+
+
+__attribute__((noinline)) static void Reply(Request_t* pRequest, int iDepth)
+{
+    if(iDepth > 0)
+    {
+        Reply(pRequest, iDepth - 1);
+        return;
+    }
+
+    // Reply buffer was made read only, this write faults with the page still mapped.
+    strcpy(pRequest->m_pReply, "HTTP/1.1 200 OK");
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+int main(void)
+{
+    if(DeadStop_SetMiniCoreLimits(128 * 1024, 512 * 1024) != ErrCode_Success ||
+       DeadStop_InitializeEx("testdump.core", 50, 50, 16, 10, 0, DeadStopFlag_MiniCore) != ErrCode_Success)
+    {
+        std::cout << "Failed to initialize DeadStop.\n";
+        return 1;
+    }
+    std::cout << "Deadstop initialized successfully\n";
+
+
+    Request_t* pRequest = new Request_t();
+    strcpy(pRequest->m_szPath, "/api/v1/orders?id=1337");
+    pRequest->m_iStatus = 200;
+    pRequest->m_pReply  = static_cast<char*>(mmap(nullptr, 4096, PROT_READ, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0));
+
+    std::cout << "Crashing, run deadstop-render testdump.core for the report.\n";
+    Reply(pRequest, 5);
+
+
+    DeadStop_Uninitialize();
+    std::cout << "Deadstop uninitialized.\n";
+    return 0;
+}
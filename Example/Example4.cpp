@@ -0,0 +1,54 @@
+#include <iostream>
+#include <atomic>
+#include <thread>
+#include <vector>
+#include "../Include/DeadStop.h"
+
+
+
+// Threads crashing at the same time. Only one full report should be written, every other
+// thread shows up as a "Concurrent Crash" record at the end of it.
+static constexpr int       THREAD_COUNT = 8;
+static std::atomic<int>    s_nReady(0);
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+static void BadWorker(int iWorkerIndex)
+{
+    // Wait till every thread is here, so they all fault together.
+    s_nReady.fetch_add(1);
+    while(s_nReady.load() < THREAD_COUNT)
+        ;
+
+    int* pA = reinterpret_cast<int*>(0xCDCDCDCDCDCDCDC0 + iWorkerIndex * 0x10);
+    *pA = 500;
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+int main(void)
+{
+    if(DeadStop_InitializeEx("testdump.txt", 50, 50, 8, 10) != ErrCode_Success)
+    {
+        std::cout << "Failed to initialize DeadStop.\n";
+        return 1;
+    }
+    std::cout << "Deadstop initialized successfully\n";
+
+
+    // This will crash, THREAD_COUNT times.
+    std::vector<std::thread> vecThreads;
+    for(int iThread = 0; iThread < THREAD_COUNT; iThread++)
+        vecThreads.emplace_back(BadWorker, iThread);
+
+    for(std::thread& thread : vecThreads)
+        thread.join();
+
+
+    DeadStop_Uninitialize();
+    std::cout << "Deadstop uninitialized.\n";
+    return 0;
+}
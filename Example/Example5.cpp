@@ -0,0 +1,91 @@
+#include <iostream>
+#include <csignal>
+#include "../Include/DeadStop.h"
+
+
+
+// Stack captures, nothing crashes. Once from normal code, once from inside a signal handler.
+static constexpr int MAX_FRAMES = 32;
+
+// Filled by the signal handler, printed after it returns.
+static DeadStopFrame_t s_signalFrames[MAX_FRAMES];
+static int             s_nSignalFrames = 0;
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+static void PrintFrames(const DeadStopFrame_t* pFrames, int nFrames)
+{
+    static const char* s_szMethods[] = { "start", "frame pointer", "cfi", "heuristic", "stack scan", "jit frame" };
+
+    for(int iFrame = 0; iFrame < nFrames; iFrame++)
+        std::cout << "    " << iFrame << ". " << pFrames[iFrame].m_pAdrs << " ( " << s_szMethods[pFrames[iFrame].m_iMethod] << " )\n";
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+static void OnUserSignal(int iSignalID, siginfo_t* pSigInfo, void* pContext)
+{
+    // Only DeadStop calls in here, std::cout isn't safe inside a signal handler.
+    DeadStop_UnwindContext(pContext, s_signalFrames, MAX_FRAMES, &s_nSignalFrames);
+
+    (void)iSignalID; (void)pSigInfo;
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+__attribute__((noinline)) static void DeepFunction(int iDepth)
+{
+    if(iDepth > 0)
+    {
+        DeepFunction(iDepth - 1);
+        return;
+    }
+
+    DeadStopFrame_t frames[MAX_FRAMES];
+    int             nFrames = 0;
+    if(DeadStop_CaptureStack(frames, MAX_FRAMES, &nFrames) != ErrCode_Success)
+    {
+        std::cout << "Failed to capture stack.\n";
+        return;
+    }
+
+    std::cout << "Captured " << nFrames << " frames :\n";
+    PrintFrames(frames, nFrames);
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+int main(void)
+{
+    if(DeadStop_InitializeEx("testdump.txt", 50, 50, 8, 10) != ErrCode_Success)
+    {
+        std::cout << "Failed to initialize DeadStop.\n";
+        return 1;
+    }
+    std::cout << "Deadstop initialized successfully\n";
+
+
+    // Program keeps running after this.
+    DeepFunction(5);
+
+
+    // Same thing from a signal handler, unwinding through the signal frame into whatever got interrupted.
+    struct sigaction sigAction = {};
+    sigAction.sa_sigaction = OnUserSignal;
+    sigAction.sa_flags     = SA_SIGINFO;
+    sigaction(SIGUSR1, &sigAction, nullptr);
+    raise(SIGUSR1);
+
+    std::cout << "Unwound " << s_nSignalFrames << " frames from a signal context :\n";
+    PrintFrames(s_signalFrames, s_nSignalFrames);
+
+
+    DeadStop_Uninitialize();
+    std::cout << "Deadstop uninitialized.\n";
+    return 0;
+}
@@ -0,0 +1,96 @@
+#include <iostream>
+#include <ucontext.h>
+#include "../Include/DeadStop.h"
+
+
+
+// Fibers. A few of them get suspended somewhere deep, then the last one crashes. Report shows
+// the crash as usual, plus every suspended fiber's stack under "Suspended Fibers".
+static constexpr int    FIBER_COUNT      = 4;
+static constexpr size_t FIBER_STACK_SIZE = 64 * 1024;
+
+static ucontext_t        s_mainContext;
+static ucontext_t        s_fiberContexts[FIBER_COUNT];
+static char              s_fiberStacks[FIBER_COUNT][FIBER_STACK_SIZE] __attribute__((aligned(16)));
+static DeadStopFiberID_t s_fiberIDs[FIBER_COUNT];
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+__attribute__((noinline)) static void Yield(int iFiber)
+{
+    // Fiber's registers land in s_fiberContexts[ iFiber ], which DeadStop reads if we crash.
+    swapcontext(&s_fiberContexts[iFiber], &s_mainContext);
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+__attribute__((noinline)) static void DeepFunction(int iFiber, int iDepth)
+{
+    if(iDepth > 0)
+    {
+        DeepFunction(iFiber, iDepth - 1);
+        return;
+    }
+
+    if(iFiber == FIBER_COUNT - 1)
+    {
+        int* pA = reinterpret_cast<int*>(0xDEADBEEFull);
+        *pA = 500;
+    }
+
+    Yield(iFiber);
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+static void FiberEntry(int iFiber)
+{
+    DeepFunction(iFiber, iFiber + 1);
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+int main(void)
+{
+    if(DeadStop_InitializeEx("testdump.txt", 50, 50, 8, 10) != ErrCode_Success)
+    {
+        std::cout << "Failed to initialize DeadStop.\n";
+        return 1;
+    }
+    std::cout << "Deadstop initialized successfully\n";
+
+
+    for(int iFiber = 0; iFiber < FIBER_COUNT; iFiber++)
+    {
+        getcontext(&s_fiberContexts[iFiber]);
+        s_fiberContexts[iFiber].uc_stack.ss_sp   = s_fiberStacks[iFiber];
+        s_fiberContexts[iFiber].uc_stack.ss_size = FIBER_STACK_SIZE;
+        s_fiberContexts[iFiber].uc_link          = &s_mainContext;
+        makecontext(&s_fiberContexts[iFiber], reinterpret_cast<void(*)()>(FiberEntry), 1, iFiber);
+
+        if(DeadStop_RegisterFiber(s_fiberStacks[iFiber], FIBER_STACK_SIZE, &s_fiberContexts[iFiber],
+                    DeadStopFiberContext_UContext, &s_fiberIDs[iFiber]) != ErrCode_Success)
+        {
+            std::cout << "Failed to register fiber " << iFiber << ".\n";
+            return 1;
+        }
+    }
+
+
+    // Every fiber runs till it yields, the last one crashes instead.
+    for(int iFiber = 0; iFiber < FIBER_COUNT; iFiber++)
+        swapcontext(&s_mainContext, &s_fiberContexts[iFiber]);
+
+
+    for(int iFiber = 0; iFiber < FIBER_COUNT; iFiber++)
+        DeadStop_UnregisterFiber(s_fiberIDs[iFiber]);
+
+    DeadStop_Uninitialize();
+    std::cout << "Deadstop uninitialized.\n";
+    return 0;
+}
@@ -0,0 +1,78 @@
+#include <iostream>
+#include <cstring>
+#include <sys/mman.h>
+#include "../Include/DeadStop.h"
+
+
+
+// JIT code. Two tiny functions are generated at runtime & registered with their frame layouts.
+// The crash happens in a normal function they call, the report names both JIT frames & unwinds
+// through them with their layouts ( "jit frame" ), there's no unwind info for them anywhere.
+typedef void (*Callback_t)();
+typedef void (*JitFn_t)(Callback_t pCallback, void* pNext);
+
+
+// push rbp; mov rbp, rsp; sub rsp, 16; call rdi; leave; ret
+static const unsigned char s_framePointerFn[] = { 0x55, 0x48, 0x89, 0xE5, 0x48, 0x83, 0xEC, 0x10, 0xFF, 0xD7, 0xC9, 0xC3 };
+
+// sub rsp, 24; call rsi; add rsp, 24; ret
+static const unsigned char s_fixedSizeFn[]    = { 0x48, 0x83, 0xEC, 0x18, 0xFF, 0xD6, 0x48, 0x83, 0xC4, 0x18, 0xC3 };
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+__attribute__((noinline)) static void BadCallback()
+{
+    int* pA = reinterpret_cast<int*>(0xDEADBEEFull);
+    *pA = 500;
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+int main(void)
+{
+    if(DeadStop_InitializeEx("testdump.txt", 50, 50, 8, 10) != ErrCode_Success)
+    {
+        std::cout << "Failed to initialize DeadStop.\n";
+        return 1;
+    }
+    std::cout << "Deadstop initialized successfully\n";
+
+
+    unsigned char* pCode = static_cast<unsigned char*>(mmap(nullptr, 4096, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0));
+    if(pCode == MAP_FAILED)
+        return 1;
+
+    memcpy(pCode,       s_framePointerFn, sizeof(s_framePointerFn));
+    memcpy(pCode + 64,  s_fixedSizeFn,    sizeof(s_fixedSizeFn));
+    mprotect(pCode, 4096, PROT_READ | PROT_EXEC);
+
+
+    // Frame is set up after the first 8 bytes, rBP holds it from there on.
+    DeadStopJitFrame_t framePointerLayout = { DeadStopJitFrame_FramePointer, 8, 0, -1 };
+
+    // Return address is 24 bytes above rSP after the first 4 bytes, rBP is never touched.
+    DeadStopJitFrame_t fixedSizeLayout    = { DeadStopJitFrame_FixedSize, 4, 24, -1 };
+
+    DeadStopJitID_t iFramePointerID = 0, iFixedSizeID = 0;
+    DeadStop_RegisterJitCode(pCode,      sizeof(s_framePointerFn), "jit::CallWithFrame", &framePointerLayout, &iFramePointerID);
+    DeadStop_RegisterJitCode(pCode + 64, sizeof(s_fixedSizeFn),    "jit::CallFixed",     &fixedSizeLayout,    &iFixedSizeID);
+
+    // JITs that write a perf map ( /tmp/perf-<pid>.map ) can have it read instead, names only.
+    DeadStop_LoadPerfMap(nullptr, nullptr);
+
+
+    // main -> jit::CallFixed -> jit::CallWithFrame -> BadCallback, crashes.
+    reinterpret_cast<JitFn_t>(pCode + 64)(BadCallback, pCode);
+
+
+    DeadStop_UnregisterJitCode(iFramePointerID);
+    DeadStop_UnregisterJitCode(iFixedSizeID);
+    munmap(pCode, 4096);
+
+    DeadStop_Uninitialize();
+    std::cout << "Deadstop uninitialized.\n";
+    return 0;
+}
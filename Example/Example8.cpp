@@ -0,0 +1,38 @@
+#include <iostream>
+#include "../Include/DeadStop.h"
+
+
+
+// Binary crash records. Crash only copies registers, maps, frames & the memory around them out, into
+// testdump.bin. Turn it into the usual report afterwards with : deadstop-render testdump.bin
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+__attribute__((noinline)) static void Crash(const char* szMsg)
+{
+    std::cout << szMsg << '\n';
+
+    int* pA = reinterpret_cast<int*>(0xDEADBEEFull);
+    *pA = 500;
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+int main(void)
+{
+    if(DeadStop_InitializeEx("testdump.bin", 50, 50, 8, 10, 0, DeadStopFlag_BinaryRecord) != ErrCode_Success)
+    {
+        std::cout << "Failed to initialize DeadStop.\n";
+        return 1;
+    }
+    std::cout << "Deadstop initialized successfully\n";
+
+
+    Crash("Crashing, run deadstop-render testdump.bin for the report.");
+
+
+    DeadStop_Uninitialize();
+    std::cout << "Deadstop uninitialized.\n";
+    return 0;
+}
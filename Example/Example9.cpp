@@ -0,0 +1,54 @@
+#include <iostream>
+#include <unistd.h>
+#include <sys/wait.h>
+#include "../Include/DeadStop.h"
+
+
+
+// Dump slab shared by forked workers, all of them crash at once. Each report lands whole in its own
+// slot of testdump.slab, nothing interleaves. Read them with : deadstop-render testdump.slab
+static const int WORKER_COUNT = 4;
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+__attribute__((noinline)) static void WorkerCrash(int iWorker)
+{
+    int* pA = reinterpret_cast<int*>(0xDEAD0000ull + iWorker);
+    *pA = 500;
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+int main(void)
+{
+    // 8 slots of 256 KiB, the file never grows past 2 MiB. Oldest reports get overwritten first.
+    DeadStop_SetDumpSlabLayout(256 * 1024, 8);
+
+    if(DeadStop_InitializeEx("testdump.slab", 50, 50, 8, 10, 0, DeadStopFlag_DumpSlab) != ErrCode_Success)
+    {
+        std::cout << "Failed to initialize DeadStop.\n";
+        return 1;
+    }
+    std::cout << "Deadstop initialized successfully\n";
+
+
+    // Workers inherit the mapped slab.
+    for(int iWorker = 0; iWorker < WORKER_COUNT; iWorker++)
+    {
+        if(fork() == 0)
+            WorkerCrash(iWorker);
+    }
+
+    for(int iWorker = 0; iWorker < WORKER_COUNT; iWorker++)
+        wait(nullptr);
+
+    std::cout << "Workers crashed, run deadstop-render testdump.slab for their reports.\n";
+
+
+    DeadStop_Uninitialize();
+    std::cout << "Deadstop uninitialized.\n";
+    return 0;
+}
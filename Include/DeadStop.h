@@ -7,6 +7,7 @@
 // purpose : Log crashes with useful information.
 //-------------------------------------------------------------------------
 #pragma once
+#include <stddef.h>
 
 
 typedef enum ErrCodes_t
@@ -15,24 +16,204 @@ typedef enum ErrCodes_t
     ErrCode_Success = 0,
     ErrCode_FailedInit,
     ErrCode_FailedToStartSubModules,
+    ErrCode_FailedToReserveMemory,
+    ErrCode_NotInitialized,
+    ErrCode_InvalidArgs,
+    ErrCode_Busy,
 
     ErrCode_Count
 } ErrCodes_t;
 
 
-/* Initialize DeadStop and allow fine tunning settings. */
+/* Optional behaviour, OR these together for DeadStop_InitializeEx(). */
+typedef enum DeadStopFlags_t
+{
+    DeadStopFlag_None          = 0,
+
+    /* Prefault & mlock() what the crash handler runs on : its code, the disassembler's code & tables
+       and all crash time memory. Keeps crash handling fast on hosts that are swapping. Bytes locked
+       are written at the end of every dump, limited by RLIMIT_MEMLOCK. */
+    DeadStopFlag_LockCrashPath = (1 << 0),
+
+    /* Write a compact binary record instead of the text report : registers, memory maps, unwound frames
+       & the code and stack bytes around them. Crashing costs little more than copying these out, the
+       report is made later by deadstop-render or DeadStop_RenderCrashRecords(). */
+    DeadStopFlag_BinaryRecord  = (1 << 1),
+
+    /* Dump file becomes a slab : preallocated & mapped at initialization, cut into fixed slots ( see
+       DeadStop_SetDumpSlabLayout() ). A crash claims a slot with one atomic add & writes its report
+       straight into it, marking it committed last. Processes sharing the file ( e.g. forked workers )
+       never interleave, a crash loop overwrites the oldest reports instead of filling the disk. Read
+       it with deadstop-render or DeadStop_RenderCrashRecords(). */
+    DeadStopFlag_DumpSlab      = (1 << 2),
+
+    /* Compress the dump as its written, LZ blocks of up to 64 KiB input each, one write() per block. ~100 KiB
+       of the crash memory budget goes to it, dumps are written uncompressed if it doesn't fit. Read them with
+       deadstop-render or DeadStop_RenderCrashRecords(). Has no effect with DeadStopFlag_DumpSlab. */
+    DeadStopFlag_Compress      = (1 << 3),
+
+    /* Keep raw memory in the record, a mini core : the crashing stack from rSP up, pages the general registers
+       & fault address point into and the code pages around each frame. Only what the memory maps say is
+       readable is touched. 1 MiB at most by default, see DeadStop_SetMiniCoreLimits(). Implies
+       DeadStopFlag_BinaryRecord. With DeadStopFlag_DumpSlab, it gets what room the slot has left. */
+    DeadStopFlag_MiniCore      = (1 << 4),
+} DeadStopFlags_t;
+
+
+/* How a captured frame was found, cheapest & most reliable first. */
+typedef enum DeadStopUnwindMethod_t
+{
+    DeadStopUnwind_None = 0,     /* First frame, where the capture started. */
+    DeadStopUnwind_FramePointer,
+    DeadStopUnwind_CFI,
+    DeadStopUnwind_Heuristic,    /* No unwind info, found by following the code to its return. */
+    DeadStopUnwind_StackScan,    /* Low confidence, might be a stale return address left on the stack. */
+    DeadStopUnwind_JitFrame,     /* Frame layout given to DeadStop_RegisterJitCode(). */
+} DeadStopUnwindMethod_t;
+
+
+/* One frame of a captured stack. */
+typedef struct DeadStopFrame_t
+{
+    void*                  m_pAdrs;
+    DeadStopUnwindMethod_t m_iMethod;
+} DeadStopFrame_t;
+
+
+/* Where a registered fiber keeps its registers while switched out, see DeadStop_RegisterFiber(). */
+typedef enum DeadStopFiberContext_t
+{
+    DeadStopFiberContext_UContext = 0, /* ucontext_t, as saved by swapcontext() / getcontext(). */
+    DeadStopFiberContext_Regs,         /* DeadStopFiberRegs_t, saved by your own context switch. */
+} DeadStopFiberContext_t;
+
+
+/* All a hand rolled context switch has to save, for its fibers to be unwound. */
+typedef struct DeadStopFiberRegs_t
+{
+    void* m_pRip; /* Where the fiber resumes. */
+    void* m_pRsp;
+    void* m_pRbp;
+} DeadStopFiberRegs_t;
+
+
+/* Identifies a registered fiber, 0 is never a valid one. */
+typedef unsigned long long DeadStopFiberID_t;
+
+
+/* How frames of registered JIT code look, see DeadStop_RegisterJitCode(). */
+typedef enum DeadStopJitFrameKind_t
+{
+    DeadStopJitFrame_None = 0,     /* Unknown, the code is read to find its return instead. */
+    DeadStopJitFrame_FramePointer, /* push rbp; mov rbp, rsp. rBP holds the frame for the whole body. */
+    DeadStopJitFrame_FixedSize,    /* rSP stays m_iFrameSize bytes below the return address for the whole body. */
+} DeadStopJitFrameKind_t;
+
+
+/* Same layout for all of a registered range. Crashes inside the first m_iPrologueSize bytes, where
+   the frame isn't set up yet, are unwound by reading the code. */
+typedef struct DeadStopJitFrame_t
+{
+    DeadStopJitFrameKind_t m_iKind;
+    unsigned int           m_iPrologueSize;
+    unsigned int           m_iFrameSize;      /* DeadStopJitFrame_FixedSize only. */
+    int                    m_iSavedRbpOffset; /* DeadStopJitFrame_FixedSize only, from rSP. -1 if rBP is left alone. */
+} DeadStopJitFrame_t;
+
+
+/* Identifies registered JIT code, 0 is never a valid one. */
+typedef unsigned long long DeadStopJitID_t;
+
+
+/* Initialize DeadStop and allow fine tunning settings.
+   iCrashMemoryBudget is reserved & prefaulted once, all crash time memory comes from it. 
+   Use 0 for default budget, 4 MiB or ~1 KiB per /proc/self/maps line at initialization ( room for
+   twice the mappings ), whichever is bigger. A given budget needs ~512 bytes per mapping, processes
+   with more mappings than it holds get some left out of their dumps. Peak usage is written at the
+   end of every dump.
+   iFlags is any combination of DeadStopFlags_t. */
 ErrCodes_t DeadStop_InitializeEx(
         const char* szDumpFilePath,
         int iAsmDumpRangeInBytes,
         int iStringDumpSize,
         int iCallStackDepth,
-        int iSignatureSize);
+        int iSignatureSize,
+        size_t iCrashMemoryBudget = 0,
+        unsigned int iFlags = DeadStopFlag_None);
 
 /* Initialize DeadStop with default settings. */
 ErrCodes_t DeadStop_Initialize(const char* szDumpFilePath);
 
+/* Give the calling thread an alternate signal stack, so stack overflows in it get logged too.
+   Threads created with pthread_create() after initialization get one automatically, only 
+   threads that were already running before DeadStop was initialized need to call this. */
+ErrCodes_t DeadStop_InitializeThread();
+
 /* Uninitialize DeadStop. */
 ErrCodes_t DeadStop_Uninitialize();
 
+/* Unwind the calling thread's stack into pFrames, without crashing or writing anything. First frame
+   is the return address into whoever called this. Never allocates & is async-signal-safe, so it can
+   be called from signal handlers & on error paths alike. Needs DeadStop to be initialized. Any number of
+   threads can capture at once, each keeps ~3 KiB of scratch on its own stack. They only wait on each other
+   while the memory maps are read again ( something new got mapped ). ErrCode_Busy if that kept it waiting
+   over 10 ms, or if the read was this thread's own & a signal handler interrupted it.
+   *pFrameCountOut gets the number of frames written, at most iMaxFrames. */
+ErrCodes_t DeadStop_CaptureStack(DeadStopFrame_t* pFrames, int iMaxFrames, int* pFrameCountOut);
+
+/* Same as DeadStop_CaptureStack(), but unwinds from a signal context of the calling thread, i.e. the
+   ucontext_t* an SA_SIGINFO handler gets. First frame is the interrupted instruction. */
+ErrCodes_t DeadStop_UnwindContext(const void* pContext, DeadStopFrame_t* pFrames, int iMaxFrames, int* pFrameCountOut);
+
+/* Register a fiber's stack [ pStackLow, pStackLow + iStackSize ) & where its registers get saved when its
+   switched out, so crash dumps unwind it too. pContext is only read at crash time, keep it valid until the
+   fiber is unregistered. Lock free & O(1), cheap enough for every fiber create. Works before DeadStop is
+   initialized too. ErrCode_FailedToReserveMemory if 16384 fibers are registered already. */
+ErrCodes_t DeadStop_RegisterFiber(const void* pStackLow, size_t iStackSize, const void* pContext,
+        DeadStopFiberContext_t iContextKind, DeadStopFiberID_t* pFiberIDOut);
+
+/* Unregister a fiber, before its stack or context is freed. Lock free & O(1). */
+ErrCodes_t DeadStop_UnregisterFiber(DeadStopFiberID_t iFiberID);
+
+/* Crash dumps unwind at most iMaxFibers registered fibers, iMaxFramesPerFiber frames each. 64 & 16 by
+   default, 0 fibers turns it off. Fiber the crashing thread was on is the crash itself & isn't repeated.
+   Fibers running on other threads at the time show where they were last switched out. */
+ErrCodes_t DeadStop_SetFiberDumpLimits(int iMaxFibers, int iMaxFramesPerFiber);
+
+/* Register JIT generated code [ pStart, pStart + iSize ), so crash dumps name its frames & can unwind
+   through it. szName is copied, cut at 63 characters. pFrame tells how its frames look, nullptr if
+   unknown. Overlapping ranges are fine, the most recent one wins. Lock free & O(1), fine for the hot
+   codegen path. Works before DeadStop is initialized too. ErrCode_FailedToReserveMemory if 65536
+   ranges are registered already. */
+ErrCodes_t DeadStop_RegisterJitCode(const void* pStart, size_t iSize, const char* szName,
+        const DeadStopJitFrame_t* pFrame, DeadStopJitID_t* pJitIDOut);
+
+/* Unregister JIT code, once its freed or rewritten. Lock free & O(1). */
+ErrCodes_t DeadStop_UnregisterJitCode(DeadStopJitID_t iJitID);
+
+/* Register every "START SIZE name" line ( hex ) of a perf map, nullptr for /tmp/perf-<pid>.map. Calling
+   it again on the same file only reads lines added since, & crash dumps pick up lines added since on
+   their own. Entries stay registered, a line with the same START as an earlier one replaces it ( code
+   rewritten in place ). *pLoadedOut gets the number of lines taken, can be nullptr. */
+ErrCodes_t DeadStop_LoadPerfMap(const char* szPath, int* pLoadedOut);
+
+/* Slot size & count of dump slabs made from now on ( see DeadStopFlag_DumpSlab ), call it before
+   initializing. 32 slots of 512 KiB by default. Slots are rounded up to whole pages, 16 KiB at least,
+   reports that don't fit are cut short. A slab that already exists keeps the layout it was made with. */
+ErrCodes_t DeadStop_SetDumpSlabLayout(size_t iSlotSize, int nSlots);
+
+/* Mini core limits ( see DeadStopFlag_MiniCore ), call it before initializing. At most iStackSize bytes
+   of stack, iTotalSize bytes in all, 256 KiB & 1 MiB by default. Both are rounded up to whole pages.
+   iTotalSize must be 64 KiB to 64 MiB & no less than iStackSize. */
+ErrCodes_t DeadStop_SetMiniCoreLimits(size_t iStackSize, size_t iTotalSize);
+
+/* Render every binary record in szRecordPath ( see DeadStopFlag_BinaryRecord ) as the text report it
+   stands for, appended to szOutputPath, or written to stdout if nullptr. Disassembly is done now, by this
+   build. Code no record holds is read from the crashed modules' files, if they are still the same files.
+   Dump slabs are read slot by slot, oldest first. Compressed dumps are inflated first. Text reports are
+   copied out as they are, so this also reads back text dumps written with DeadStopFlag_Compress.
+   ErrCode_Busy while DeadStop is initialized, ErrCode_InvalidArgs if the file holds nothing readable. */
+ErrCodes_t DeadStop_RenderCrashRecords(const char* szRecordPath, const char* szOutputPath);
+
 /* Get string message for given ErrCode_t. */
 const char* DeadStop_GetErrorMessage(ErrCodes_t iErrCode);
@@ -0,0 +1,98 @@
+#include <cstdio>
+#include <cstdint>
+#include <cstring>
+#include "../src/Defs/MemRegion_t.h"
+#include "../src/Jit/JitRegistry.h"
+
+
+
+// Region index with JIT code registered inside a bigger mapping. JIT range is code, the rest of
+// the mapping around it must still be found as the mapping it is.
+using namespace DeadStop;
+
+
+static int s_nFailed = 0;
+#define CHECK(x) do { if((x) == false) { std::printf("FAILED : %s ( line %d )\n", #x, __LINE__); s_nFailed++; } } while(0)
+
+
+alignas(16) static unsigned char s_storage[64 * MemRegionHandler_t::STORAGE_PER_REGION];
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+static void JitInsideMapping()
+{
+    MemRegionHandler_t memRegions;
+    memRegions.SetStorage(s_storage, sizeof(s_storage));
+    memRegions.RegisterRegion(0x10000, 0x20000, MemRegionFlag_Read | MemRegionFlag_Write);
+
+    uint64_t iJitID = 0;
+    CHECK(RegisterJitCode(0x14000, 0x15000, "jit", 3, nullptr, iJitID) == true);
+    AddJitRegions(memRegions);
+
+    // Before, inside & after the JIT range.
+    CHECK(memRegions.FindParentRegion(0x12000, MemRegionFlag_Read | MemRegionFlag_Write) != nullptr);
+    CHECK(memRegions.FindParentRegion(0x14800, MemRegionFlag_Read | MemRegionFlag_Write) != nullptr);
+    CHECK(memRegions.FindParentRegion(0x18000, MemRegionFlag_Read | MemRegionFlag_Write) != nullptr);
+    CHECK(memRegions.HasParentRegion(0x1FFFF) == true);
+    CHECK(memRegions.HasParentRegion(0x20000) == false);
+
+    CHECK(memRegions.HasExecutableRegion(0x14000, 0x14FFF) == true);
+    CHECK(memRegions.HasExecutableRegion(0x15000)          == false);
+    CHECK(memRegions.HasExecutableRegion(0x13FFF)          == false);
+
+    // Whole mapping, across the JIT range. Range ends are the last byte.
+    CHECK(memRegions.FindParentRegion(0x10000, 0x1FFFF, MemRegionFlag_Read | MemRegionFlag_Write) != nullptr);
+    CHECK(memRegions.HasParentRegion(0x10000, 0x1FFFF) == true);
+
+    uintptr_t    pAdrs[4] = { 0x10000, 0x14000, 0x16000, 0x20000 };
+    MemRegion_t* pOut[4]  = {};
+    memRegions.FindParentRegions(pAdrs, 4, pOut);
+    CHECK(pOut[0] != nullptr && pOut[1] != nullptr && pOut[2] != nullptr && pOut[3] == nullptr);
+
+    CHECK(memRegions.HasOverflowed() == false);
+    UnregisterJitCode(iJitID);
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+static void Overlaps()
+{
+    // Registered out of order, one region over two others & the gap between them.
+    MemRegionHandler_t memRegions;
+    memRegions.SetStorage(s_storage, sizeof(s_storage));
+    memRegions.RegisterRegion(0x30000, 0x40000, MemRegionFlag_Read);
+    memRegions.RegisterRegion(0x28000, 0x38000, MemRegionFlag_Read | MemRegionFlag_Exec);
+    memRegions.RegisterRegion(0x10000, 0x20000, MemRegionFlag_Read | MemRegionFlag_Write);
+    memRegions.RegisterRegion(0x18000, 0x31000, MemRegionFlag_Read);
+
+    CHECK(memRegions.FindParentRegion(0x1C000, MemRegionFlag_Read | MemRegionFlag_Write) != nullptr);
+    CHECK(memRegions.FindParentRegion(0x24000, MemRegionFlag_Read | MemRegionFlag_Write) == nullptr);
+    CHECK(memRegions.HasParentRegion(0x24000) == true);
+    CHECK(memRegions.HasExecutableRegion(0x28000, 0x37FFF) == true);
+    CHECK(memRegions.HasExecutableRegion(0x38000) == false);
+    CHECK(memRegions.HasParentRegion(0x3F000) == true);
+    CHECK(memRegions.HasParentRegion(0x10000, 0x3FFFF) == true);
+    CHECK(memRegions.HasParentRegion(0x40000) == false);
+
+    // Same access, overlapping or touching, ends up as one region.
+    memRegions.Clear();
+    memRegions.RegisterRegion(0x10000, 0x18000, MemRegionFlag_Read);
+    memRegions.RegisterRegion(0x14000, 0x20000, MemRegionFlag_Read);
+    memRegions.RegisterRegion(0x20000, 0x28000, MemRegionFlag_Read);
+    MemRegion_t* pRegion = memRegions.FindParentRegion(0x10000);
+    CHECK(pRegion != nullptr && pRegion->m_iStart == 0x10000 && pRegion->m_iEnd == 0x28000);
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+int main(void)
+{
+    JitInsideMapping();
+    Overlaps();
+
+    std::printf("%s\n", s_nFailed == 0 ? "All passed" : "Some checks failed");
+    return s_nFailed == 0 ? 0 : 1;
+}
@@ -0,0 +1,40 @@
+//=========================================================================
+//                      deadstop-render
+//=========================================================================
+// by      : INSANE
+// created : 16/10/2026
+//
+// purpose : Turns binary crash records ( DeadStopFlag_BinaryRecord ) into
+//           the usual text reports. Reads dump slabs ( DeadStopFlag_DumpSlab )
+//           & inflates compressed dumps ( DeadStopFlag_Compress ) too.
+//-------------------------------------------------------------------------
+#include <iostream>
+#include "../Include/DeadStop.h"
+
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+int main(int argc, char** argv)
+{
+    if(argc < 2 || argc > 3)
+    {
+        std::cerr << "Usage : " << argv[0] << " <record file or dump slab> [ output file, stdout if none ]\n";
+        return 2;
+    }
+
+
+    ErrCodes_t iErrCode = DeadStop_RenderCrashRecords(argv[1], argc == 3 ? argv[2] : nullptr);
+    switch(iErrCode)
+    {
+        case ErrCode_Success:                 return 0;
+        case ErrCode_InvalidArgs:             std::cerr << argv[1] << " holds nothing this version can read.\n";         break;
+        case ErrCode_FailedInit:              std::cerr << "Couldn't open " << argv[1] << " or the output file.\n";      break;
+        case ErrCode_FailedToReserveMemory:   std::cerr << "Couldn't reserve memory to render with.\n";                  break;
+        case ErrCode_FailedToStartSubModules: std::cerr << "Couldn't start the disassembler.\n";                         break;
+
+        default: std::cerr << "Rendering failed, error code " << static_cast<int>(iErrCode) << ".\n"; break;
+    }
+
+    return 1;
+}
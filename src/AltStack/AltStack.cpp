@@ -0,0 +1,272 @@
+//=========================================================================
+//                      Alternate Signal Stack
+//=========================================================================
+// by      : INSANE
+// created : 16/10/2026
+//
+// purpose : Per thread alternate signal stacks ( with guard pages ), so we can
+//           still log crashes caused by stack overflows.
+//-------------------------------------------------------------------------
+#include "AltStack.h"
+#include "../Util/Assertion/Assertion.h"
+#include "../Util/MemoryLock/MemoryLock.h"
+#include <atomic>
+#include <new>
+#include <signal.h>
+#include <pthread.h>
+#include <dlfcn.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#include <errno.h>
+
+
+// Mind this...
+using namespace DeadStop;
+
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+namespace DEADSTOP_NAMESPACE
+{
+    // NOTE : Trivial type on purpose. Signal handler reads this, and thread_local objects with
+    //        constructors / destructors go through a TLS wrapper that may allocate on first access.
+    static thread_local ThreadStackInfo_t t_stackInfo;
+
+
+    // Unmaps this thread's alternate stack when the thread exits ( even through pthread_exit ).
+    // Only ever touched from InstallAltStackForThisThread().
+    struct AltStackCleanup_t
+    {
+        bool m_bArmed = false;
+        ~AltStackCleanup_t() { if(m_bArmed == true) UninstallAltStackForThisThread(); }
+    };
+    static thread_local AltStackCleanup_t t_altStackCleanup;
+
+
+    static std::atomic<bool> s_bAltStacksEnabled(false);
+
+
+    // Guard area below the stack we blame on stack overflows. Big locals can jump right over a single
+    // guard page, so we look a little further than the guard itself.
+    static constexpr size_t MIN_STACK_GUARD_WINDOW = 64 * 1024;
+
+    static size_t GetPageSize() { return static_cast<size_t>(sysconf(_SC_PAGESIZE)); }
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+void DeadStop::EnableAltStacks(bool bEnable)
+{
+    s_bAltStacksEnabled.store(bEnable, std::memory_order_release);
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+bool DeadStop::InstallAltStackForThisThread()
+{
+    if(t_stackInfo.m_bInstalled == true)
+        return true;
+
+
+    // Layout : [ guard page ][ ALT_STACK_SIZE usable ][ guard page ]
+    // Mapped with MAP_NORESERVE & never prefaulted. Kernel only backs the pages a signal handler
+    // actually touches, so threads that never crash don't pay memory for this.
+    size_t iPageSize  = GetPageSize();
+    size_t iUsable    = (ALT_STACK_SIZE + iPageSize - 1) & ~(iPageSize - 1);
+    size_t iMinSize   = static_cast<size_t>(sysconf(_SC_MINSIGSTKSZ));
+    if(iUsable < iMinSize)
+        iUsable = (iMinSize + iPageSize - 1) & ~(iPageSize - 1);
+
+    size_t iTotalSize = iUsable + 2 * iPageSize;
+
+    void* pMemory = mmap(nullptr, iTotalSize, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+    if(pMemory == MAP_FAILED)
+        return false;
+
+    uint8_t* pUsable = reinterpret_cast<uint8_t*>(pMemory) + iPageSize;
+    if(mprotect(pUsable, iUsable, PROT_READ | PROT_WRITE) != 0)
+    {
+        munmap(pMemory, iTotalSize);
+        return false;
+    }
+
+
+    stack_t altStack;
+    altStack.ss_sp    = pUsable;
+    altStack.ss_size  = iUsable;
+    altStack.ss_flags = 0;
+    if(sigaltstack(&altStack, nullptr) != 0)
+    {
+        munmap(pMemory, iTotalSize);
+        return false;
+    }
+
+
+    // Remember this thread's normal stack bounds, we can't ask pthread from inside the handler.
+    ThreadStackInfo_t info;
+    pthread_attr_t attr;
+    if(pthread_getattr_np(pthread_self(), &attr) == 0)
+    {
+        void*  pStackAdrs = nullptr;
+        size_t iStackSize = 0;
+        size_t iGuardSize = 0;
+        pthread_attr_getstack(&attr, &pStackAdrs, &iStackSize);
+        pthread_attr_getguardsize(&attr, &iGuardSize);
+        pthread_attr_destroy(&attr);
+
+        info.m_iStackLow  = reinterpret_cast<uintptr_t>(pStackAdrs);
+        info.m_iStackHigh = info.m_iStackLow + iStackSize;
+        info.m_iGuardSize = iGuardSize;
+    }
+
+    info.m_iAltStackLow  = reinterpret_cast<uintptr_t>(pUsable);
+    info.m_iAltStackHigh = reinterpret_cast<uintptr_t>(pUsable) + iUsable;
+    info.m_bInstalled    = true;
+    t_stackInfo          = info;
+
+    t_altStackCleanup.m_bArmed = true;
+    return true;
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+void DeadStop::UninstallAltStackForThisThread()
+{
+    if(t_stackInfo.m_bInstalled == false)
+        return;
+
+
+    // Only unmap if its still our stack that is installed, & we are not running on it.
+    stack_t current;
+    if(sigaltstack(nullptr, &current) != 0 || (current.ss_flags & SS_ONSTACK) != 0)
+        return;
+
+    if(reinterpret_cast<uintptr_t>(current.ss_sp) == t_stackInfo.m_iAltStackLow)
+    {
+        stack_t disable;
+        disable.ss_sp    = nullptr;
+        disable.ss_size  = 0;
+        disable.ss_flags = SS_DISABLE;
+        sigaltstack(&disable, nullptr);
+    }
+
+
+    size_t iPageSize = GetPageSize();
+    munmap(reinterpret_cast<void*>(t_stackInfo.m_iAltStackLow - iPageSize),
+            (t_stackInfo.m_iAltStackHigh - t_stackInfo.m_iAltStackLow) + 2 * iPageSize);
+
+    t_stackInfo                = ThreadStackInfo_t();
+    t_altStackCleanup.m_bArmed = false;
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+DEADSTOP_CRASH_PATH
+const ThreadStackInfo_t* DeadStop::GetThisThreadStackInfo()
+{
+    return &t_stackInfo;
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+DEADSTOP_CRASH_PATH
+bool DeadStop::IsStackGuardHit(const ThreadStackInfo_t& info, uintptr_t iFaultAdrs, uintptr_t iRSP)
+{
+    if(info.m_iStackLow == 0 || info.m_iStackHigh <= info.m_iStackLow)
+        return false;
+
+
+    // Right below the stack?
+    size_t iWindow = info.m_iGuardSize > MIN_STACK_GUARD_WINDOW ? info.m_iGuardSize : MIN_STACK_GUARD_WINDOW;
+    if(iFaultAdrs < info.m_iStackLow && iFaultAdrs >= info.m_iStackLow - iWindow)
+        return true;
+
+
+    // Main thread's stack grows on demand, limit reported by pthread is the rlimit. Faulting inside
+    // of that limit but below rSP means kernel couldn't grow the stack any further.
+    if(iFaultAdrs >= info.m_iStackLow && iFaultAdrs < info.m_iStackHigh && iFaultAdrs < iRSP)
+        return true;
+
+
+    return false;
+}
+
+
+
+#if (DEADSTOP_WRAP_PTHREAD_CREATE == 1)
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+namespace DEADSTOP_NAMESPACE
+{
+    typedef int (*PthreadCreate_t)(pthread_t*, const pthread_attr_t*, void* (*)(void*), void*);
+
+    struct ThreadStartArgs_t
+    {
+        void* (*m_pfnStart)(void*);
+        void*   m_pArg;
+    };
+
+
+    static void* ThreadTrampoline(void* pArgs)
+    {
+        ThreadStartArgs_t args = *reinterpret_cast<ThreadStartArgs_t*>(pArgs);
+        delete reinterpret_cast<ThreadStartArgs_t*>(pArgs);
+
+        // Alternate stack is unmapped by t_altStackCleanup on thread exit.
+        InstallAltStackForThisThread();
+
+        return args.m_pfnStart(args.m_pArg);
+    }
+
+
+    // glibc's own name for it. Only static builds have it, libc.a's pthread_create is a weak alias of it.
+    // Weak reference doesn't pull it out of libc.a, CMakeLists.txt links with -u __pthread_create for that.
+    extern "C" int __pthread_create(pthread_t*, const pthread_attr_t*, void* (*)(void*), void*) __attribute__((weak));
+
+    static PthreadCreate_t FindRealPthreadCreate()
+    {
+        // Static builds have no next object to look in.
+        PthreadCreate_t pfnPthreadCreate = reinterpret_cast<PthreadCreate_t>(dlsym(RTLD_NEXT, "pthread_create"));
+        if(pfnPthreadCreate == nullptr)
+            pfnPthreadCreate = &__pthread_create;
+
+        return pfnPthreadCreate;
+    }
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+// Interposes libc's pthread_create, so threads created after DeadStop_Initialize are covered
+// without the user doing anything.
+extern "C" int pthread_create(pthread_t* pThread, const pthread_attr_t* pAttr, void* (*pfnStart)(void*), void* pArg) __THROWNL
+{
+    static PthreadCreate_t s_pfnRealPthreadCreate = FindRealPthreadCreate();
+
+    // Nothing to hand the thread to, e.g. a static build linked without -u __pthread_create.
+    if(s_pfnRealPthreadCreate == nullptr)
+        return EAGAIN;
+
+    if(s_bAltStacksEnabled.load(std::memory_order_acquire) == false)
+        return s_pfnRealPthreadCreate(pThread, pAttr, pfnStart, pArg);
+
+
+    // Can't throw out of a C function, out of memory is what pthread_create() says then anyway.
+    ThreadStartArgs_t* pArgs = new(std::nothrow) ThreadStartArgs_t{ pfnStart, pArg };
+    if(pArgs == nullptr)
+        return EAGAIN;
+
+    int iResult = s_pfnRealPthreadCreate(pThread, pAttr, ThreadTrampoline, pArgs);
+    if(iResult != 0)
+        delete pArgs;
+
+    return iResult;
+}
+#endif
@@ -0,0 +1,55 @@
+//=========================================================================
+//                      Alternate Signal Stack
+//=========================================================================
+// by      : INSANE
+// created : 16/10/2026
+//
+// purpose : Per thread alternate signal stacks ( with guard pages ), so we can
+//           still log crashes caused by stack overflows.
+//-------------------------------------------------------------------------
+#pragma once
+#include "../../Include/Alias.h"
+#include <cstddef>
+#include <cstdint>
+
+
+
+namespace DEADSTOP_NAMESPACE
+{
+    ///////////////////////////////////////////////////////////////////////////
+    ///////////////////////////////////////////////////////////////////////////
+    struct ThreadStackInfo_t
+    {
+        // Thread's normal stack, as reported by pthread. [ Low, High )
+        uintptr_t m_iStackLow      = 0;
+        uintptr_t m_iStackHigh     = 0;
+        size_t    m_iGuardSize     = 0;
+
+        // Alternate signal stack, excluding guard pages. [ Low, High )
+        uintptr_t m_iAltStackLow   = 0;
+        uintptr_t m_iAltStackHigh  = 0;
+
+        bool      m_bInstalled     = false;
+    };
+
+
+    // Usable size of each alternate stack. Crash path keeps all of its big buffers in the crash
+    // arena, so this only has to fit the call chain + decoder. Only pages that get touched cost
+    // memory, idle threads just pay for the address space.
+    constexpr size_t ALT_STACK_SIZE = 128 * 1024;
+
+
+    // Start / stop giving new threads an alternate stack automatically. Only flips a flag.
+    void EnableAltStacks(bool bEnable);
+
+    // Map & install an alternate stack for the calling thread. Never call from a signal handler.
+    bool InstallAltStackForThisThread();
+    void UninstallAltStackForThisThread();
+
+    // Safe to call from signal handler. Never nullptr, check m_bInstalled.
+    const ThreadStackInfo_t* GetThisThreadStackInfo();
+
+    // Did iFaultAdrs land in the guard area right below this thread's stack, or in the part
+    // of the stack below rSP that the kernel refused to grow into?
+    bool IsStackGuardHit(const ThreadStackInfo_t& info, uintptr_t iFaultAdrs, uintptr_t iRSP);
+}
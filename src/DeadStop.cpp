@@ -8,6 +8,13 @@
 //-------------------------------------------------------------------------
 #include "../Include/DeadStop.h"
 #include "DeadStopImpl.h"
+#include "SignalHandler/SignalHandler.h"
+#include "Unwind/Unwinder.h"
+#include "Fiber/FiberRegistry.h"
+#include "Jit/JitRegistry.h"
+#include <stdio.h>
+#include <unistd.h>
+#include <ucontext.h>
 
 
 // Mind this...
@@ -17,16 +24,27 @@ using namespace DeadStop;
 
 ///////////////////////////////////////////////////////////////////////////
 ///////////////////////////////////////////////////////////////////////////
-ErrCodes_t DeadStop_InitializeEx(const char* szDumpFilePath, int iAsmDumpRangeInBytes, int iStringDumpSize, int iCallStackDepth, int iSignatureSize)
+ErrCodes_t DeadStop_InitializeEx(
+        const char* szDumpFilePath, int iAsmDumpRangeInBytes, int iStringDumpSize, int iCallStackDepth, int iSignatureSize, size_t iCrashMemoryBudget,
+        unsigned int iFlags)
 {
-    return DeadStop_t::GetInstance().Initialize(szDumpFilePath, iAsmDumpRangeInBytes, iStringDumpSize, iCallStackDepth, iSignatureSize);
+    return DeadStop_t::GetInstance().Initialize(
+            szDumpFilePath, iAsmDumpRangeInBytes, iStringDumpSize, iCallStackDepth, iSignatureSize, iCrashMemoryBudget, iFlags);
 }
 
 ///////////////////////////////////////////////////////////////////////////
 ///////////////////////////////////////////////////////////////////////////
 ErrCodes_t DeadStop_Initialize(const char* szDumpFilePath)
 {
-    return DeadStop_t::GetInstance().Initialize(szDumpFilePath, 50, 10, 3, 15);
+    return DeadStop_t::GetInstance().Initialize(szDumpFilePath, 50, 10, 3, 15, 0, DeadStopFlag_None);
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+ErrCodes_t DeadStop_InitializeThread()
+{
+    return DeadStop_t::GetInstance().InitializeThread();
 }
 
 
@@ -36,3 +54,177 @@ ErrCodes_t DeadStop_Uninitialize()
 {
     return DeadStop_t::GetInstance().Uninitialize();
 }
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+__attribute__((noinline)) // Our own frame is skipped, it must be a frame of its own.
+ErrCodes_t DeadStop_CaptureStack(DeadStopFrame_t* pFrames, int iMaxFrames, int* pFrameCountOut)
+{
+    DwarfRegs_t regs;
+    DwarfRegsFromHere(regs);
+
+    // Not returning UnwindStack() straight away keeps it from being a tail call, which would
+    // reuse the very frame it unwinds through.
+    int        nFrames  = 0;
+    ErrCodes_t iErrCode = UnwindStack(regs, 1, pFrames, iMaxFrames, nFrames);
+    if(pFrameCountOut != nullptr)
+        *pFrameCountOut = nFrames;
+
+    return iErrCode;
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+ErrCodes_t DeadStop_UnwindContext(const void* pContext, DeadStopFrame_t* pFrames, int iMaxFrames, int* pFrameCountOut)
+{
+    if(pFrameCountOut != nullptr)
+        *pFrameCountOut = 0;
+
+    if(pContext == nullptr)
+        return ErrCode_InvalidArgs;
+
+
+    DwarfRegs_t regs;
+    DwarfRegsFromContext(reinterpret_cast<const ucontext_t*>(pContext), regs);
+
+    int        nFrames  = 0;
+    ErrCodes_t iErrCode = UnwindStack(regs, 0, pFrames, iMaxFrames, nFrames);
+    if(pFrameCountOut != nullptr)
+        *pFrameCountOut = nFrames;
+
+    return iErrCode;
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+ErrCodes_t DeadStop_RegisterFiber(const void* pStackLow, size_t iStackSize, const void* pContext,
+        DeadStopFiberContext_t iContextKind, DeadStopFiberID_t* pFiberIDOut)
+{
+    if(pFiberIDOut != nullptr)
+        *pFiberIDOut = 0;
+
+    if(pStackLow == nullptr || iStackSize == 0 || pContext == nullptr || pFiberIDOut == nullptr)
+        return ErrCode_InvalidArgs;
+
+    if(iContextKind != DeadStopFiberContext_UContext && iContextKind != DeadStopFiberContext_Regs)
+        return ErrCode_InvalidArgs;
+
+
+    uintptr_t iStackLow = reinterpret_cast<uintptr_t>(pStackLow);
+    uint64_t  iFiberID  = 0;
+    if(RegisterFiber(iStackLow, iStackLow + iStackSize, pContext, iContextKind, iFiberID) == false)
+        return ErrCode_FailedToReserveMemory;
+
+    *pFiberIDOut = static_cast<DeadStopFiberID_t>(iFiberID);
+    return ErrCode_Success;
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+ErrCodes_t DeadStop_UnregisterFiber(DeadStopFiberID_t iFiberID)
+{
+    return UnregisterFiber(static_cast<uint64_t>(iFiberID)) == true ? ErrCode_Success : ErrCode_InvalidArgs;
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+ErrCodes_t DeadStop_SetFiberDumpLimits(int iMaxFibers, int iMaxFramesPerFiber)
+{
+    if(iMaxFibers < 0 || iMaxFramesPerFiber <= 0)
+        return ErrCode_InvalidArgs;
+
+    SetFiberDumpLimits(iMaxFibers, iMaxFramesPerFiber);
+    return ErrCode_Success;
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+ErrCodes_t DeadStop_RegisterJitCode(const void* pStart, size_t iSize, const char* szName,
+        const DeadStopJitFrame_t* pFrame, DeadStopJitID_t* pJitIDOut)
+{
+    if(pJitIDOut != nullptr)
+        *pJitIDOut = 0;
+
+    uintptr_t iStart = reinterpret_cast<uintptr_t>(pStart);
+    if(pStart == nullptr || iSize == 0 || iStart + iSize < iStart || pJitIDOut == nullptr)
+        return ErrCode_InvalidArgs;
+
+    if(pFrame != nullptr && (pFrame->m_iKind < DeadStopJitFrame_None || pFrame->m_iKind > DeadStopJitFrame_FixedSize))
+        return ErrCode_InvalidArgs;
+
+
+    uint64_t iJitID = 0;
+    if(RegisterJitCode(iStart, iStart + iSize, szName, MAX_JIT_NAME_LENGTH, pFrame, iJitID) == false)
+        return ErrCode_FailedToReserveMemory;
+
+    *pJitIDOut = static_cast<DeadStopJitID_t>(iJitID);
+    return ErrCode_Success;
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+ErrCodes_t DeadStop_UnregisterJitCode(DeadStopJitID_t iJitID)
+{
+    return UnregisterJitCode(static_cast<uint64_t>(iJitID)) == true ? ErrCode_Success : ErrCode_InvalidArgs;
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+ErrCodes_t DeadStop_LoadPerfMap(const char* szPath, int* pLoadedOut)
+{
+    if(pLoadedOut != nullptr)
+        *pLoadedOut = 0;
+
+
+    // Where perf looks for it.
+    char szDefaultPath[64];
+    if(szPath == nullptr)
+    {
+        snprintf(szDefaultPath, sizeof(szDefaultPath), "/tmp/perf-%d.map", static_cast<int>(getpid()));
+        szPath = szDefaultPath;
+    }
+
+    size_t nLoaded = 0;
+    if(LoadPerfMap(szPath, nLoaded) == false)
+        return ErrCode_FailedInit;
+
+    if(pLoadedOut != nullptr)
+        *pLoadedOut = static_cast<int>(nLoaded);
+
+    return ErrCode_Success;
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+ErrCodes_t DeadStop_SetDumpSlabLayout(size_t iSlotSize, int nSlots)
+{
+    if(nSlots <= 0)
+        return ErrCode_InvalidArgs;
+
+    return DeadStop_t::GetInstance().SetDumpSlabLayout(iSlotSize, static_cast<size_t>(nSlots));
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+ErrCodes_t DeadStop_SetMiniCoreLimits(size_t iStackSize, size_t iTotalSize)
+{
+    return DeadStop_t::GetInstance().SetMiniCoreLimits(iStackSize, iTotalSize);
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+ErrCodes_t DeadStop_RenderCrashRecords(const char* szRecordPath, const char* szOutputPath)
+{
+    return DeadStop_t::GetInstance().RenderCrashRecords(szRecordPath, szOutputPath);
+}
@@ -8,14 +8,22 @@
 //-------------------------------------------------------------------------
 #include "DeadStopImpl.h"
 #include <string.h>
+#include <vector>
 #include <signal.h>
+#include <time.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
 
 // Signal Handlers...
 #include "SignalHandler/SignalHandler.h"
+#include "AltStack/AltStack.h"
 
 // Util...
 #include "Util/Assertion/Assertion.h"
 #include "Util/Terminal/Terminal.h"
+#include "Util/Compressor/Compressor.h"
 
 // Disassebler...
 #include "../lib/IDASM/Include/INSANE_DisassemblerAMD64.h"
@@ -25,6 +33,26 @@ using namespace DeadStop;
 
 
 
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+namespace DEADSTOP_NAMESPACE
+{
+    // Fatal signals we dump on.
+    static const int s_iHandledSignals[] = {
+        SIGSEGV, // Segment fault.
+        SIGILL,  // Illegal instruction.
+        SIGTRAP, // breakpoint ( int3 )
+        SIGABRT, // abort() / assertion fail.
+        SIGFPE,  // devide by zero.
+        SIGBUS,  // hardware memory error, bad mmap.
+    };
+    static_assert(sizeof(s_iHandledSignals) / sizeof(s_iHandledSignals[0]) == HANDLED_SIGNAL_COUNT, "HANDLED_SIGNAL_COUNT out of sync");
+
+    static size_t CountMapsLines();
+}
+
+
+
 
 ///////////////////////////////////////////////////////////////////////////
 ///////////////////////////////////////////////////////////////////////////
@@ -37,14 +65,17 @@ DeadStop_t::DeadStop_t()
 
 ///////////////////////////////////////////////////////////////////////////
 ///////////////////////////////////////////////////////////////////////////
-ErrCodes_t DeadStop_t::Initialize(const char* szDumpFilePath, int iAsmDumpRangeinBytes, int iStringDumpSize, int iCallStackDepth, int iSignatureSize)
+ErrCodes_t DeadStop_t::Initialize(
+        const char* szDumpFilePath, int iAsmDumpRangeinBytes, int iStringDumpSize, int iCallStackDepth, int iSignatureSize, size_t iCrashMemoryBudget,
+        unsigned int iFlags)
 {
     assertion(m_bInitialized == false && "DeadStop is already initialized.");
     assertion(szDumpFilePath != nullptr && "Invalid dump file path");
     assertion(iAsmDumpRangeinBytes > 0 && "Invalid assembly dump range");
-    assertion(iAsmDumpRangeinBytes < 0x1000 && "Too big dump range");
+    assertion(iAsmDumpRangeinBytes < MAX_ASM_DUMP_RANGE && "Too big dump range");
     assertion(iStringDumpSize >= 0 && "Invalid string dump size. Must be more than 0");
     assertion(iCallStackDepth > 0 && "Invalid call stack depth");
+    assertion(iCallStackDepth <= MAX_CALL_STACK_DEPTH && "Too deep call stack depth");
     assertion(iSignatureSize >= 0 && "Invalig signature size. Use 0 for no signature");
 
 
@@ -52,6 +83,19 @@ ErrCodes_t DeadStop_t::Initialize(const char* szDumpFilePath, int iAsmDumpRangei
     m_iAsmDumpRange   = iAsmDumpRangeinBytes;
     m_iCallStackDepth = iCallStackDepth;
     m_iSignatureSize  = iSignatureSize;
+    m_iFlags          = iFlags;
+
+    // Mini core is a part of the binary record.
+    if((m_iFlags & DeadStopFlag_MiniCore) != 0)
+        m_iFlags |= DeadStopFlag_BinaryRecord;
+
+
+    // Signal handler can't call localtime(), so we store UTC offset now.
+    {
+        time_t now = time(nullptr);
+        tm     localTime;
+        m_iUTCOffset = localtime_r(&now, &localTime) != nullptr ? localTime.tm_gmtoff : 0;
+    }
 
 
     // Starting up submodules...
@@ -59,32 +103,109 @@ ErrCodes_t DeadStop_t::Initialize(const char* szDumpFilePath, int iAsmDumpRangei
         return ErrCode_FailedToStartSubModules;
 
 
+    // Anything failing from here on goes to InitFailed, which undoes all of it.
+    ErrCodes_t iErrCode = ErrCode_Success;
+
+
     // File path must be valid.
     if(szDumpFilePath == nullptr)
-        return ErrCode_FailedInit;
+    {
+        iErrCode = ErrCode_FailedInit;
+        goto InitFailed;
+    }
 
 
     m_szDumpFilePath = szDumpFilePath;
 
 
+    // Slab is mapped now, crashes only ever write into memory.
+    if((m_iFlags & DeadStopFlag_DumpSlab) != 0)
+    {
+        if(m_dumpSlab.Open(szDumpFilePath, m_iSlabSlotSize, m_nSlabSlots) == false)
+        {
+            iErrCode = ErrCode_FailedInit;
+            goto InitFailed;
+        }
+
+        LOG("Dump slab mapped, %zu slots of %zu bytes.", m_dumpSlab.GetSlotCount(), m_dumpSlab.GetSlotSize());
+    }
+
+
+    // Reserving crash time memory. Must happen before handlers are registered.
+    {
+        // Default grows with the process, room for twice the mappings it has now since threads & JIT
+        // code keep adding more. Budget given by the caller is used as is.
+        size_t nMapsLines = CountMapsLines();
+        if(iCrashMemoryBudget == 0)
+        {
+            iCrashMemoryBudget = DEFAULT_CRASH_MEMORY_BUDGET;
+            if(GetCrashMemoryBudget(2 * nMapsLines) > iCrashMemoryBudget)
+                iCrashMemoryBudget = GetCrashMemoryBudget(2 * nMapsLines);
+        }
+        else if(GetCrashMemoryBudget(nMapsLines) > iCrashMemoryBudget)
+        {
+            LOG("Crash memory budget of %zu bytes is too small for %zu mappings, dumps will leave some out. %zu bytes needed.",
+                    iCrashMemoryBudget, nMapsLines, GetCrashMemoryBudget(nMapsLines));
+        }
+
+        if(iCrashMemoryBudget < MIN_CRASH_MEMORY_BUDGET)
+            iCrashMemoryBudget = MIN_CRASH_MEMORY_BUDGET;
+
+        if(m_crashArena.Reserve(iCrashMemoryBudget) == false || PrepareCrashPath(m_crashArena, m_iAsmDumpRange) == false)
+        {
+            iErrCode = ErrCode_FailedToReserveMemory;
+            goto InitFailed;
+        }
+    }
+
+
+    // Pin crash path in memory. Failing to lock isn't fatal, its reported in the dump.
+    if((m_iFlags & DeadStopFlag_LockCrashPath) != 0)
+    {
+        LockCrashPath(m_memoryLock);
+
+        const MemoryLockStats_t& stats = m_memoryLock.GetStats();
+        LOG("Locked %zu bytes of crash path in memory. %zu bytes failed, %zu bytes skipped.",
+                stats.m_iLockedBytes, stats.m_iFailedBytes, stats.m_iSkippedBytes);
+    }
+
+
+    // Alternate signal stacks. Without one, a stack overflow leaves no stack for the handler to run on.
+    // This thread gets one now, threads created from now on get one as they start.
+    if(InstallAltStackForThisThread() == false)
+    {
+        iErrCode = ErrCode_FailedToReserveMemory;
+        goto InitFailed;
+    }
+    EnableAltStacks(true);
+
+
     // Setting up sigaction struct.
     {
         memset(&m_sigAction, 0, sizeof(struct sigaction));
-        m_sigAction.sa_flags     = SA_SIGINFO; // so we get addition signal information.
+        m_sigAction.sa_flags     = SA_SIGINFO | SA_ONSTACK; // so we get addition signal information & run on alternate stack.
         m_sigAction.sa_sigaction = MasterSignalHandler;
 
-        // Register our handler.
-        sigaction(SIGSEGV, &m_sigAction, nullptr); // Segment fault.
-        sigaction(SIGILL,  &m_sigAction, nullptr); // Illegal instruction.
-        sigaction(SIGTRAP, &m_sigAction, nullptr); // breakpoint ( int3 )
-        sigaction(SIGABRT, &m_sigAction, nullptr); // abort() / assertion fail.
-        sigaction(SIGFPE,  &m_sigAction, nullptr); // devide by zero.
-        sigaction(SIGBUS,  &m_sigAction, nullptr); // hardware memory error, bad mmap.
+        // Register our handler, keeping whatever was there.
+        for(int iSignal = 0; iSignal < HANDLED_SIGNAL_COUNT; iSignal++)
+            sigaction(s_iHandledSignals[iSignal], &m_sigAction, &m_oldSigActions[iSignal]);
     }
 
 
+    OpenCaptures();
     m_bInitialized   = true;
     return ErrCodes_t::ErrCode_Success;
+
+
+InitFailed:
+    // Reverse order of the above. Each of these is fine with being called for something that never happened.
+    m_memoryLock.UnlockAll();
+    ReleaseCrashPath();
+    m_crashArena.Release();
+    m_dumpSlab.Close();
+    m_szDumpFilePath.clear();
+    InsaneDASM64::UnInitialize();
+    return iErrCode;
 }
 
 
@@ -92,6 +213,19 @@ ErrCodes_t DeadStop_t::Initialize(const char* szDumpFilePath, int iAsmDumpRangei
 ///////////////////////////////////////////////////////////////////////////
 ErrCodes_t DeadStop_t::Uninitialize()
 {
+    // Previous handlers back first, then nothing new reaches ours & its safe to take its memory away.
+    for(int iSignal = 0; iSignal < HANDLED_SIGNAL_COUNT && m_bInitialized == true; iSignal++)
+        sigaction(s_iHandledSignals[iSignal], &m_oldSigActions[iSignal], nullptr);
+
+    // Stack captures still running are let finish, they read crash memory.
+    m_bInitialized = false;
+    CloseCaptures();
+    EnableAltStacks(false);
+    m_memoryLock.UnlockAll();
+    ReleaseCrashPath();
+    m_crashArena.Release();
+    m_dumpSlab.Close();
+
     // Closing submodules...
     InsaneDASM64::UnInitialize();
 
@@ -100,6 +234,134 @@ ErrCodes_t DeadStop_t::Uninitialize()
 }
 
 
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+ErrCodes_t DeadStop_t::InitializeThread()
+{
+    if(m_bInitialized == false)
+        return ErrCode_FailedInit;
+
+    if(InstallAltStackForThisThread() == false)
+        return ErrCode_FailedToReserveMemory;
+
+    return ErrCode_Success;
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+ErrCodes_t DeadStop_t::SetDumpSlabLayout(size_t iSlotSize, size_t nSlots)
+{
+    // Slab is mapped with the layout it had at Initialize().
+    if(m_bInitialized == true)
+        return ErrCode_Busy;
+
+    if(iSlotSize == 0 || nSlots == 0 || iSlotSize > MAX_DUMP_SLAB_SIZE / nSlots)
+        return ErrCode_InvalidArgs;
+
+    m_iSlabSlotSize = iSlotSize;
+    m_nSlabSlots    = nSlots;
+    return ErrCode_Success;
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+ErrCodes_t DeadStop_t::SetMiniCoreLimits(size_t iStackSize, size_t iTotalSize)
+{
+    // Crash path copies these at Initialize().
+    if(m_bInitialized == true)
+        return ErrCode_Busy;
+
+    if(iTotalSize < MIN_MINI_CORE_SIZE || iTotalSize > MAX_MINI_CORE_SIZE || iStackSize > iTotalSize)
+        return ErrCode_InvalidArgs;
+
+    m_iMiniCoreStackSize = (iStackSize + MINI_CORE_PAGE_SIZE - 1) & ~(MINI_CORE_PAGE_SIZE - 1);
+    m_iMiniCoreSize      = (iTotalSize + MINI_CORE_PAGE_SIZE - 1) & ~(MINI_CORE_PAGE_SIZE - 1);
+    return ErrCode_Success;
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+ErrCodes_t DeadStop_t::RenderCrashRecords(const char* szRecordPath, const char* szOutputPath)
+{
+    // Rendering runs on the crash path's memory.
+    if(m_bInitialized == true)
+        return ErrCode_Busy;
+
+    if(szRecordPath == nullptr)
+        return ErrCode_InvalidArgs;
+
+
+    int iRecordFd = open(szRecordPath, O_RDONLY | O_CLOEXEC);
+    if(iRecordFd < 0)
+        return ErrCode_FailedInit;
+
+    struct stat fileInfo;
+    if(fstat(iRecordFd, &fileInfo) != 0 || fileInfo.st_size <= 0)
+    {
+        close(iRecordFd);
+        return ErrCode_InvalidArgs;
+    }
+
+    size_t iRecordSize = static_cast<size_t>(fileInfo.st_size);
+    void*  pRecords    = mmap(nullptr, iRecordSize, PROT_READ, MAP_PRIVATE, iRecordFd, 0);
+    close(iRecordFd);
+    if(pRecords == MAP_FAILED)
+        return ErrCode_FailedInit;
+
+
+    // Everything a crash would set up, sized for any record. UTC offset is unused, records carry local time.
+    ErrCodes_t iErrCode = ErrCode_Success;
+    if(InsaneDASM64::Initialize() != InsaneDASM64::IDASMErrorCode_Success)
+    {
+        iErrCode = ErrCode_FailedToStartSubModules;
+    }
+    else
+    {
+        if(m_crashArena.Reserve(RENDER_MEMORY_BUDGET) == false || PrepareCrashPath(m_crashArena, MAX_ASM_DUMP_RANGE - 1) == false)
+        {
+            iErrCode = ErrCode_FailedToReserveMemory;
+        }
+        else
+        {
+            int iOutputFd = szOutputPath != nullptr ? open(szOutputPath, O_WRONLY | O_CREAT | O_APPEND | O_CLOEXEC, 0644) : STDOUT_FILENO;
+            if(iOutputFd < 0)
+            {
+                iErrCode = ErrCode_FailedInit;
+            }
+            else
+            {
+                // Compressed dumps ( DeadStopFlag_Compress ) are inflated first, as a whole.
+                const uint8_t*       pData = static_cast<const uint8_t*>(pRecords);
+                size_t               iSize = iRecordSize;
+                std::vector<uint8_t> vecInflated;
+                if(InflateDump(pData, iSize, vecInflated) > 0)
+                {
+                    pData = vecInflated.data();
+                    iSize = vecInflated.size();
+                }
+
+                size_t nRendered = 0;
+                if(DeadStop::RenderCrashRecords(pData, iSize, iOutputFd, nRendered) == false)
+                    iErrCode = ErrCode_InvalidArgs;
+
+                if(iOutputFd != STDOUT_FILENO)
+                    close(iOutputFd);
+            }
+        }
+
+        ReleaseCrashPath();
+        m_crashArena.Release();
+        InsaneDASM64::UnInitialize();
+    }
+
+    munmap(pRecords, iRecordSize);
+    return iErrCode;
+}
+
+
 ///////////////////////////////////////////////////////////////////////////
 ///////////////////////////////////////////////////////////////////////////
 bool DeadStop_t::IsInitialized() const
@@ -146,3 +408,84 @@ int DeadStop_t::GetSignatureSize() const
 {
     return m_iSignatureSize;
 }
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+long DeadStop_t::GetUTCOffset() const
+{
+    return m_iUTCOffset;
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+CrashArena_t& DeadStop_t::GetCrashArena()
+{
+    return m_crashArena;
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+DumpSlab_t& DeadStop_t::GetDumpSlab()
+{
+    return m_dumpSlab;
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+size_t DeadStop_t::GetMiniCoreStackSize() const
+{
+    return m_iMiniCoreStackSize;
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+size_t DeadStop_t::GetMiniCoreSize() const
+{
+    return m_iMiniCoreSize;
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+unsigned int DeadStop_t::GetFlags() const
+{
+    return m_iFlags;
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+const MemoryLockStats_t& DeadStop_t::GetMemoryLockStats() const
+{
+    return m_memoryLock.GetStats();
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+static size_t DeadStop::CountMapsLines()
+{
+    int iFd = open("/proc/self/maps", O_RDONLY | O_CLOEXEC);
+    if(iFd < 0)
+        return 0;
+
+    size_t nLines = 0;
+    char   buffer[4096];
+    for(;;)
+    {
+        ssize_t iRead = read(iFd, buffer, sizeof(buffer));
+        if(iRead <= 0)
+            break;
+
+        for(ssize_t iIndex = 0; iIndex < iRead; iIndex++)
+            nLines += buffer[iIndex] == '\n' ? 1 : 0;
+    }
+
+    close(iFd);
+    return nLines;
+}
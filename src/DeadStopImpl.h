@@ -9,13 +9,28 @@
 #pragma once
 #include "../Include/Alias.h"
 #include "../Include/DeadStop.h"
+#include "Util/Arena/CrashArena.h"
+#include "Util/MemoryLock/MemoryLock.h"
+#include "DumpSlab/DumpSlab.h"
+#include "Record/MiniCore.h"
 #include <string>
+#include <cstddef>
 #include <signal.h>
 
 
 
 namespace DEADSTOP_NAMESPACE
 {
+    // Crash path works out of fixed size storage, these are the limits.
+    constexpr int    MAX_CALL_STACK_DEPTH        = 256;
+    constexpr int    MAX_ASM_DUMP_RANGE          = 0x1000; // Exclusive.
+    constexpr size_t DEFAULT_CRASH_MEMORY_BUDGET = 4 * 1024 * 1024; // ~8k mappings, more if the process has more. See Initialize().
+    constexpr size_t MIN_CRASH_MEMORY_BUDGET     = 256 * 1024;
+    constexpr size_t RENDER_MEMORY_BUDGET        = 4 * DEFAULT_CRASH_MEMORY_BUDGET; // Records are rendered with any dump range, maps of any size.
+    constexpr int    HANDLED_SIGNAL_COUNT        = 6; // See s_iHandledSignals.
+    constexpr size_t MAX_LOCKED_MODULE_SIZE      = 64 * 1024 * 1024; // Bigger modules aren't locked, see DeadStopFlag_LockCrashPath.
+
+
     ///////////////////////////////////////////////////////////////////////////
     ///////////////////////////////////////////////////////////////////////////
     class DeadStop_t
@@ -25,8 +40,19 @@ namespace DEADSTOP_NAMESPACE
             static DeadStop_t& GetInstance() { static DeadStop_t instance; return instance; }
 
             ErrCodes_t Initialize(
-                 const char* szDumpFilePath, int iAsmDumpRangeinBytes, int iStringDumpSize, int iCallStackDepth, int iSignatureSize);
+                 const char* szDumpFilePath, int iAsmDumpRangeinBytes, int iStringDumpSize, int iCallStackDepth, int iSignatureSize,
+                 size_t iCrashMemoryBudget, unsigned int iFlags);
             ErrCodes_t Uninitialize();
+            ErrCodes_t InitializeThread();
+
+            // See DeadStopFlag_DumpSlab, only before Initialize().
+            ErrCodes_t SetDumpSlabLayout(size_t iSlotSize, size_t nSlots);
+
+            // See DeadStopFlag_MiniCore, only before Initialize().
+            ErrCodes_t SetMiniCoreLimits(size_t iStackSize, size_t iTotalSize);
+
+            // Binary records -> text reports, see DeadStop_RenderCrashRecords().
+            ErrCodes_t RenderCrashRecords(const char* szRecordPath, const char* szOutputPath);
 
             bool IsInitialized() const;
             const std::string& GetDumpFilePath() const;
@@ -34,6 +60,13 @@ namespace DEADSTOP_NAMESPACE
             int GetStringDumpSize() const;
             int GetCallStackDepth() const;
             int GetSignatureSize()  const;
+            long GetUTCOffset()     const; // Local time - UTC, in seconds.
+            unsigned int GetFlags() const;
+            CrashArena_t& GetCrashArena();
+            DumpSlab_t& GetDumpSlab();
+            size_t GetMiniCoreStackSize() const;
+            size_t GetMiniCoreSize()      const;
+            const MemoryLockStats_t& GetMemoryLockStats() const;
 
         private:
             // Singleton.
@@ -50,7 +83,23 @@ namespace DEADSTOP_NAMESPACE
             int         m_iStringDumpSize = 0;
             int         m_iCallStackDepth = 0;
             int         m_iSignatureSize  = 0;
+            long        m_iUTCOffset      = 0;
+            unsigned    m_iFlags          = DeadStopFlag_None;
+
+            // All crash time memory.
+            CrashArena_t m_crashArena;
+            MemoryLock_t m_memoryLock;
+
+            // Dump file itself, with DeadStopFlag_DumpSlab.
+            DumpSlab_t   m_dumpSlab;
+            size_t       m_iSlabSlotSize = DEFAULT_DUMP_SLAB_SLOT_SIZE;
+            size_t       m_nSlabSlots    = DEFAULT_DUMP_SLAB_SLOTS;
+
+            // Raw memory kept in records, with DeadStopFlag_MiniCore.
+            size_t       m_iMiniCoreStackSize = DEFAULT_MINI_CORE_STACK_SIZE;
+            size_t       m_iMiniCoreSize      = DEFAULT_MINI_CORE_SIZE;
 
             struct sigaction m_sigAction;
+            struct sigaction m_oldSigActions[HANDLED_SIGNAL_COUNT]; // Whatever was there before us, put back on Uninitialize().
     };
 }
@@ -0,0 +1,130 @@
+//=========================================================================
+//                      Code Window
+//=========================================================================
+// by      : INSANE
+// created : 16/10/2026
+//
+// purpose : Reads a chunk of code once & hands out views into it, so retrying
+//           a decode at a different offset never copies or re-reads bytes.
+//-------------------------------------------------------------------------
+#include "CodeWindow.h"
+#include "../Util/SafeRead/SafeRead.h"
+#include "../Util/MemoryLock/MemoryLock.h"
+
+
+// Mind this...
+using namespace DeadStop;
+
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+DEADSTOP_CRASH_PATH
+DeadStop::CodeSpan_t DeadStop::CodeSpan_t::Subspan(size_t iOffset, size_t iSize) const
+{
+    if(iOffset >= m_iSize)
+        return CodeSpan_t{ nullptr, m_iAdrs + m_iSize, 0 };
+
+    size_t iLeft = m_iSize - iOffset;
+    return CodeSpan_t{ m_pBytes + iOffset, m_iAdrs + iOffset, iSize < iLeft ? iSize : iLeft };
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+DeadStop::CodeWindow_t::CodeWindow_t()
+{
+    SetReader(nullptr);
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+void DeadStop::CodeWindow_t::SetStorage(uint8_t* pBuffer, size_t iCapacity)
+{
+    m_pBuffer   = pBuffer;
+    m_iCapacity = pBuffer == nullptr ? 0 : iCapacity;
+    m_nFills    = 0;
+    m_nHits     = 0;
+    Invalidate();
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+DEADSTOP_CRASH_PATH
+void DeadStop::CodeWindow_t::Invalidate()
+{
+    m_iAdrs = 0;
+    m_iSize = 0;
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+void DeadStop::CodeWindow_t::SetReader(ReadFn_t pfnRead)
+{
+    m_pfnRead = pfnRead != nullptr ? pfnRead : SafeRead;
+    Invalidate();
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+DEADSTOP_CRASH_PATH
+DeadStop::CodeSpan_t DeadStop::CodeWindow_t::Get(uintptr_t iAdrs, size_t iSize)
+{
+    if(iSize > m_iCapacity)
+        iSize = m_iCapacity;
+
+
+    // Already have these bytes? Only ever moves a pointer.
+    if(m_iSize != 0 && iAdrs >= m_iAdrs && iAdrs - m_iAdrs <= m_iSize)
+    {
+        size_t iOffset = iAdrs - m_iAdrs;
+        size_t iLeft   = m_iSize - iOffset;
+
+        // Window ran short because memory ended there, refilling won't get us more.
+        bool bWindowFull = m_iSize == m_iCapacity;
+        if(iLeft >= iSize || bWindowFull == false)
+        {
+            m_nHits++;
+            return CodeSpan_t{ m_pBuffer + iOffset, iAdrs, iSize < iLeft ? iSize : iLeft };
+        }
+    }
+
+
+    // Refill, reading a whole window from iAdrs. Later batches usually land in here too.
+    m_nFills++;
+    m_iAdrs = iAdrs;
+    m_iSize = m_pfnRead(m_pBuffer, iAdrs, m_iCapacity);
+
+    return CodeSpan_t{ m_pBuffer, iAdrs, iSize < m_iSize ? iSize : m_iSize };
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+DEADSTOP_CRASH_PATH
+size_t DeadStop::CodeWindow_t::GetCapacity() const
+{
+    return m_iCapacity;
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+DEADSTOP_CRASH_PATH
+size_t DeadStop::CodeWindow_t::GetFillCount() const
+{
+    return m_nFills;
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+DEADSTOP_CRASH_PATH
+size_t DeadStop::CodeWindow_t::GetHitCount() const
+{
+    return m_nHits;
+}
@@ -0,0 +1,75 @@
+//=========================================================================
+//                      Code Window
+//=========================================================================
+// by      : INSANE
+// created : 16/10/2026
+//
+// purpose : Reads a chunk of code once & hands out views into it, so retrying
+//           a decode at a different offset never copies or re-reads bytes.
+//-------------------------------------------------------------------------
+#pragma once
+#include "../../Include/Alias.h"
+#include <cstddef>
+#include <cstdint>
+
+
+
+namespace DEADSTOP_NAMESPACE
+{
+    ///////////////////////////////////////////////////////////////////////////
+    ///////////////////////////////////////////////////////////////////////////
+    // Non owning view of code bytes, along with the address they were read from.
+    struct CodeSpan_t
+    {
+        const uint8_t* m_pBytes = nullptr;
+        uintptr_t      m_iAdrs  = 0; // Process address of m_pBytes[0].
+        size_t         m_iSize  = 0;
+
+        // Bytes [ iOffset, iOffset + iSize ) of this span, clamped to what we have.
+        CodeSpan_t Subspan(size_t iOffset, size_t iSize) const;
+        CodeSpan_t Subspan(size_t iOffset)               const { return Subspan(iOffset, m_iSize); }
+
+        bool       IsEmpty()                             const { return m_iSize == 0; }
+        uintptr_t  GetEndAdrs()                          const { return m_iAdrs + m_iSize; }
+    };
+
+
+    ///////////////////////////////////////////////////////////////////////////
+    ///////////////////////////////////////////////////////////////////////////
+    class CodeWindow_t
+    {
+        public:
+            // Same contract as SafeRead(), bytes copied till the first one that can't be read.
+            typedef size_t (*ReadFn_t)(void* pDest, uintptr_t iSrcAdrs, size_t iSize);
+
+            CodeWindow_t();
+
+            // Window is read into caller provided memory, so nothing gets allocated at crash time.
+            void       SetStorage(uint8_t* pBuffer, size_t iCapacity);
+            void       Invalidate();
+
+            // Where bytes come from, SafeRead() unless set. nullptr goes back to SafeRead().
+            void       SetReader(ReadFn_t pfnRead);
+
+            // Span over [ iAdrs, iAdrs + iSize ). Served straight from the window if it already holds those
+            // bytes, otherwise the window is refilled starting at iAdrs with a single read. Span is
+            // shorter than iSize if memory stops being readable, or if iSize is bigger than the window.
+            // Caller is expected to have checked the range against memory maps already.
+            CodeSpan_t Get(uintptr_t iAdrs, size_t iSize);
+
+            size_t     GetCapacity()  const;
+            size_t     GetFillCount() const; // Reads made so far. Only used for the report.
+            size_t     GetHitCount()  const; // Get() calls that didn't need a refill.
+
+        private:
+            uint8_t*   m_pBuffer   = nullptr;
+            size_t     m_iCapacity = 0;
+            ReadFn_t   m_pfnRead   = nullptr;
+
+            uintptr_t  m_iAdrs     = 0; // Bytes currently held : [ m_iAdrs, m_iAdrs + m_iSize )
+            size_t     m_iSize     = 0;
+
+            size_t     m_nFills    = 0;
+            size_t     m_nHits     = 0;
+    };
+}
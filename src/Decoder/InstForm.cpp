@@ -0,0 +1,378 @@
+//=========================================================================
+//                      Instruction Form
+//=========================================================================
+// by      : INSANE
+// created : 16/10/2026
+//
+// purpose : Splits an x86_64 instruction's bytes into prefixes, opcode, ModRM,
+//           SIB, displacement & immediate. Nothing more, for code that only
+//           needs to know how long an instruction is, which registers & what
+//           memory it touches.
+//-------------------------------------------------------------------------
+#include "InstForm.h"
+#include "../Util/MemoryLock/MemoryLock.h"
+
+
+// Mind this...
+using namespace DeadStop;
+
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+namespace DEADSTOP_NAMESPACE
+{
+    // 256 bit set of opcodes, built at compile time from [ first, last ] ranges.
+    struct OpCodeSet_t
+    {
+        uint32_t m_iBits[8] = {};
+
+        constexpr bool Has(uint8_t iOpCode) const { return (m_iBits[iOpCode >> 5] & (1u << (iOpCode & 31))) != 0; }
+    };
+
+    template<size_t N>
+    static constexpr OpCodeSet_t MakeOpCodeSet(const uint8_t (&ranges)[N][2])
+    {
+        OpCodeSet_t set;
+        for(size_t iRange = 0; iRange < N; iRange++)
+        {
+            for(int iOpCode = ranges[iRange][0]; iOpCode <= ranges[iRange][1]; iOpCode++)
+                set.m_iBits[iOpCode >> 5] |= 1u << (iOpCode & 31);
+        }
+        return set;
+    }
+
+
+    // One byte opcodes that take a ModRM byte.
+    static constexpr uint8_t s_oneByteModRMRanges[][2] = {
+        { 0x00, 0x03 }, { 0x08, 0x0B }, { 0x10, 0x13 }, { 0x18, 0x1B },
+        { 0x20, 0x23 }, { 0x28, 0x2B }, { 0x30, 0x33 }, { 0x38, 0x3B },
+        { 0x63, 0x63 }, { 0x69, 0x69 }, { 0x6B, 0x6B }, { 0x80, 0x8F },
+        { 0xC0, 0xC1 }, { 0xC6, 0xC7 }, { 0xD0, 0xD3 }, { 0xD8, 0xDF },
+        { 0xF6, 0xF7 }, { 0xFE, 0xFF },
+    };
+
+    // 0x0F xx opcodes that DON'T take a ModRM byte, nearly all of them do.
+    static constexpr uint8_t s_twoByteNoModRMRanges[][2] = {
+        { 0x04, 0x09 }, { 0x0B, 0x0C }, { 0x0E, 0x0E }, { 0x30, 0x37 },
+        { 0x77, 0x77 }, { 0x80, 0x8F }, { 0xA0, 0xA2 }, { 0xA8, 0xAA },
+        { 0xC8, 0xCF },
+    };
+
+    // Lock, rep, segment, operand & address size.
+    static constexpr uint8_t s_legacyPrefixRanges[][2] = {
+        { 0xF0, 0xF0 }, { 0xF2, 0xF3 }, { 0x26, 0x26 }, { 0x2E, 0x2E }, { 0x36, 0x36 }, { 0x3E, 0x3E }, { 0x64, 0x67 },
+    };
+
+    static constexpr OpCodeSet_t s_legacyPrefixes  = MakeOpCodeSet(s_legacyPrefixRanges);
+    static constexpr OpCodeSet_t s_oneByteModRM    = MakeOpCodeSet(s_oneByteModRMRanges);
+    static constexpr OpCodeSet_t s_twoByteNoModRM  = MakeOpCodeSet(s_twoByteNoModRMRanges);
+
+
+    // Immediate that follows ModRM / SIB / displacement. Low bits are its size in bytes, high bits
+    // the few cases where prefixes or ModRM change that.
+    enum ImmSize_t : uint8_t
+    {
+        ImmSize_SizeMask = 0x0F,
+        ImmSize_Z        = 0x10, // 2 bytes with 0x66.
+        ImmSize_W        = 0x20, // 8 bytes with REX.W ( MOV r, imm64 ).
+        ImmSize_MOffs    = 0x40, // 8 byte address, 4 with 0x67.
+        ImmSize_TestOnly = 0x80, // Only ModRM.reg /0 & /1 ( TEST ) of group 3 have one.
+    };
+
+    struct ImmSizeRange_t
+    {
+        uint8_t m_iFirst;
+        uint8_t m_iLast;
+        uint8_t m_iImmSize;
+    };
+
+    struct ImmSizeTable_t
+    {
+        uint8_t m_iImmSize[256] = {};
+    };
+
+    template<size_t N>
+    static constexpr ImmSizeTable_t MakeImmSizeTable(const ImmSizeRange_t (&ranges)[N])
+    {
+        ImmSizeTable_t table;
+        for(size_t iRange = 0; iRange < N; iRange++)
+        {
+            for(int iOpCode = ranges[iRange].m_iFirst; iOpCode <= ranges[iRange].m_iLast; iOpCode++)
+                table.m_iImmSize[iOpCode] = ranges[iRange].m_iImmSize;
+        }
+        return table;
+    }
+
+
+    static constexpr uint8_t IMM_1 = 1, IMM_2 = 2, IMM_4 = 4, IMM_Z = 4 | ImmSize_Z;
+    static constexpr ImmSizeRange_t s_oneByteImmRanges[] = {
+        { 0x04, 0x04, IMM_1 }, { 0x05, 0x05, IMM_Z }, { 0x0C, 0x0C, IMM_1 }, { 0x0D, 0x0D, IMM_Z }, // ALU al / eax, imm
+        { 0x14, 0x14, IMM_1 }, { 0x15, 0x15, IMM_Z }, { 0x1C, 0x1C, IMM_1 }, { 0x1D, 0x1D, IMM_Z },
+        { 0x24, 0x24, IMM_1 }, { 0x25, 0x25, IMM_Z }, { 0x2C, 0x2C, IMM_1 }, { 0x2D, 0x2D, IMM_Z },
+        { 0x34, 0x34, IMM_1 }, { 0x35, 0x35, IMM_Z }, { 0x3C, 0x3C, IMM_1 }, { 0x3D, 0x3D, IMM_Z },
+        { 0x68, 0x68, IMM_Z }, { 0x69, 0x69, IMM_Z }, { 0x6A, 0x6A, IMM_1 }, { 0x6B, 0x6B, IMM_1 }, // PUSH / IMUL imm
+        { 0x70, 0x7F, IMM_1 },                                                                      // Jcc rel8
+        { 0x80, 0x80, IMM_1 }, { 0x81, 0x81, IMM_Z }, { 0x83, 0x83, IMM_1 },                        // Group 1
+        { 0xA0, 0xA3, 8 | ImmSize_MOffs }, { 0xA8, 0xA8, IMM_1 }, { 0xA9, 0xA9, IMM_Z },
+        { 0xB0, 0xB7, IMM_1 }, { 0xB8, 0xBF, IMM_Z | ImmSize_W },                                   // MOV r, imm
+        { 0xC0, 0xC1, IMM_1 }, { 0xC2, 0xC2, IMM_2 }, { 0xC6, 0xC6, IMM_1 }, { 0xC7, 0xC7, IMM_Z },
+        { 0xC8, 0xC8, 3     }, { 0xCA, 0xCA, IMM_2 }, { 0xCD, 0xCD, IMM_1 },                        // ENTER is iw, ib
+        { 0xE0, 0xE7, IMM_1 }, { 0xE8, 0xE9, IMM_4 }, { 0xEB, 0xEB, IMM_1 },                        // LOOP, IN / OUT, CALL / JMP rel32 ( 0x66 doesn't shrink it )
+        { 0xF6, 0xF6, IMM_1 | ImmSize_TestOnly }, { 0xF7, 0xF7, IMM_Z | ImmSize_TestOnly },
+    };
+
+    static constexpr ImmSizeRange_t s_twoByteImmRanges[] = {
+        { 0x0F, 0x0F, IMM_1 }, // 3DNow! opcode suffix
+        { 0x70, 0x73, IMM_1 }, { 0x80, 0x8F, IMM_4 }, { 0xA4, 0xA4, IMM_1 }, { 0xAC, 0xAC, IMM_1 },
+        { 0xBA, 0xBA, IMM_1 }, { 0xC2, 0xC2, IMM_1 }, { 0xC4, 0xC6, IMM_1 },
+    };
+
+    static constexpr ImmSizeTable_t s_oneByteImmSizes = MakeImmSizeTable(s_oneByteImmRanges);
+    static constexpr ImmSizeTable_t s_twoByteImmSizes = MakeImmSizeTable(s_twoByteImmRanges);
+
+    // Longest instruction the CPU accepts.
+    static constexpr size_t MAX_INST_LENGTH = 15;
+
+
+    static void    SetImpliedPrefix(uint8_t iPP, InstForm_t& formOut);
+    static uint8_t GetImmSize(const InstForm_t& form);
+    static bool    SetLength(InstForm_t& formOut, size_t iImmOffset, size_t iSize);
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+DEADSTOP_CRASH_PATH
+bool DeadStop::ParseInstForm(const uint8_t* pBytes, size_t iSize, InstForm_t& formOut)
+{
+    formOut = InstForm_t();
+
+    size_t iPos = 0;
+    while(iPos < iSize && s_legacyPrefixes.Has(pBytes[iPos]) == true)
+    {
+        if(pBytes[iPos] == 0x66) formOut.m_bOpSize16   = true;
+        if(pBytes[iPos] == 0x67) formOut.m_bAdrsSize32 = true;
+        if(pBytes[iPos] == 0xF3) formOut.m_bRepF3      = true;
+        if(pBytes[iPos] == 0xF2) formOut.m_bRepF2      = true;
+        iPos++;
+    }
+
+    if(iPos >= iSize)
+        return false;
+
+
+    // REX has to be right before the opcode, anything else after it makes it a no-op.
+    if((pBytes[iPos] & 0xF0) == 0x40)
+    {
+        uint8_t iREX = pBytes[iPos++];
+        formOut.m_bRexW = (iREX & 8) != 0;
+        formOut.m_bRexR = (iREX & 4) != 0;
+        formOut.m_bRexX = (iREX & 2) != 0;
+        formOut.m_bRexB = (iREX & 1) != 0;
+
+        if(iPos >= iSize)
+            return false;
+    }
+
+
+    uint8_t iByte = pBytes[iPos];
+    if(iByte == 0xC5 || iByte == 0xC4 || iByte == 0x62)
+    {
+        // VEX & EVEX always have a ModRM ( vzeroupper / vzeroall aside ), & they carry REX bits inverted.
+        if(iByte == 0xC5)
+        {
+            if(iPos + 3 > iSize)
+                return false;
+
+            uint8_t iVEX1 = pBytes[iPos + 1];
+            formOut.m_iEncoding = InstEncoding_VEX;
+            formOut.m_iMap      = InstMap_0F;
+            formOut.m_bRexR     = (iVEX1 & 0x80) == 0;
+            formOut.m_iVEXReg   = (~iVEX1 >> 3) & 0xF;
+            SetImpliedPrefix(iVEX1 & 3, formOut);
+            iPos += 2;
+        }
+        else if(iByte == 0xC4)
+        {
+            if(iPos + 4 > iSize)
+                return false;
+
+            uint8_t iVEX1 = pBytes[iPos + 1];
+            uint8_t iVEX2 = pBytes[iPos + 2];
+            formOut.m_iEncoding = InstEncoding_VEX;
+            formOut.m_iMap      = iVEX1 & 0x1F;
+            formOut.m_bRexR     = (iVEX1 & 0x80) == 0;
+            formOut.m_bRexX     = (iVEX1 & 0x40) == 0;
+            formOut.m_bRexB     = (iVEX1 & 0x20) == 0;
+            formOut.m_bRexW     = (iVEX2 & 0x80) != 0;
+            formOut.m_iVEXReg   = (~iVEX2 >> 3) & 0xF;
+            SetImpliedPrefix(iVEX2 & 3, formOut);
+            iPos += 3;
+        }
+        else
+        {
+            if(iPos + 5 > iSize)
+                return false;
+
+            uint8_t iEVEX1 = pBytes[iPos + 1];
+            uint8_t iEVEX2 = pBytes[iPos + 2];
+            formOut.m_iEncoding = InstEncoding_EVEX;
+            formOut.m_iMap      = iEVEX1 & 0x07;
+            formOut.m_bRexR     = (iEVEX1 & 0x80) == 0;
+            formOut.m_bRexX     = (iEVEX1 & 0x40) == 0;
+            formOut.m_bRexB     = (iEVEX1 & 0x20) == 0;
+            formOut.m_bRexW     = (iEVEX2 & 0x80) != 0;
+            formOut.m_iVEXReg   = (~iEVEX2 >> 3) & 0xF;
+            SetImpliedPrefix(iEVEX2 & 3, formOut);
+            iPos += 4;
+        }
+
+        if(formOut.m_iMap < InstMap_0F || formOut.m_iMap > InstMap_0F3A)
+            return false;
+
+        formOut.m_iOpCode   = pBytes[iPos++];
+        formOut.m_bHasModRM = !(formOut.m_iMap == InstMap_0F && formOut.m_iOpCode == 0x77);
+    }
+    else if(iByte == 0x0F)
+    {
+        if(iPos + 2 > iSize)
+            return false;
+
+        iPos++;
+        if(pBytes[iPos] == 0x38 || pBytes[iPos] == 0x3A)
+        {
+            formOut.m_iMap = pBytes[iPos] == 0x38 ? InstMap_0F38 : InstMap_0F3A;
+            iPos++;
+            if(iPos >= iSize)
+                return false;
+
+            formOut.m_iOpCode   = pBytes[iPos++];
+            formOut.m_bHasModRM = true;
+        }
+        else
+        {
+            formOut.m_iMap      = InstMap_0F;
+            formOut.m_iOpCode   = pBytes[iPos++];
+            formOut.m_bHasModRM = s_twoByteNoModRM.Has(formOut.m_iOpCode) == false;
+        }
+    }
+    else
+    {
+        formOut.m_iMap      = InstMap_OneByte;
+        formOut.m_iOpCode   = pBytes[iPos++];
+        formOut.m_bHasModRM = s_oneByteModRM.Has(formOut.m_iOpCode);
+    }
+
+
+    if(formOut.m_bHasModRM == false)
+    {
+        return SetLength(formOut, iPos, iSize);
+    }
+
+    if(iPos >= iSize)
+        return false;
+
+    formOut.m_iModRM = pBytes[iPos++];
+
+    uint8_t iMod = formOut.Mod();
+    uint8_t iRM  = formOut.m_iModRM & 7;
+    if(iMod != 3 && iRM == 4)
+    {
+        if(iPos >= iSize)
+            return false;
+
+        formOut.m_bHasSIB = true;
+        formOut.m_iSIB    = pBytes[iPos++];
+    }
+
+
+    if(iMod == 1)
+        formOut.m_iDispSize = 1;
+    else if(iMod == 2)
+        formOut.m_iDispSize = 4;
+    else if(iMod == 0 && (iRM == 5 || (formOut.m_bHasSIB == true && (formOut.m_iSIB & 7) == 5)))
+        formOut.m_iDispSize = 4;
+
+    if(iPos + formOut.m_iDispSize > iSize)
+        return false;
+
+    if(formOut.m_iDispSize == 1)
+    {
+        formOut.m_iDisp = static_cast<int8_t>(pBytes[iPos]);
+    }
+    else if(formOut.m_iDispSize == 4)
+    {
+        uint32_t iDisp = static_cast<uint32_t>(pBytes[iPos]) | static_cast<uint32_t>(pBytes[iPos + 1]) << 8 |
+            static_cast<uint32_t>(pBytes[iPos + 2]) << 16 | static_cast<uint32_t>(pBytes[iPos + 3]) << 24;
+        formOut.m_iDisp = static_cast<int32_t>(iDisp);
+    }
+
+    iPos += formOut.m_iDispSize;
+    return SetLength(formOut, iPos, iSize);
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+DEADSTOP_CRASH_PATH
+static void DeadStop::SetImpliedPrefix(uint8_t iPP, InstForm_t& formOut)
+{
+    // VEX / EVEX pp : 0 none, 1 0x66, 2 0xF3, 3 0xF2
+    formOut.m_bOpSize16 = iPP == 1;
+    formOut.m_bRepF3    = iPP == 2;
+    formOut.m_bRepF2    = iPP == 3;
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+DEADSTOP_CRASH_PATH
+static uint8_t DeadStop::GetImmSize(const InstForm_t& form)
+{
+    uint8_t iImmSize = 0;
+    if(form.m_iMap == InstMap_OneByte)
+        iImmSize = s_oneByteImmSizes.m_iImmSize[form.m_iOpCode];
+    else if(form.m_iMap == InstMap_0F3A)
+        return 1;
+    else if(form.m_iMap == InstMap_0F)
+        iImmSize = s_twoByteImmSizes.m_iImmSize[form.m_iOpCode];
+
+    // Most instructions end here.
+    if((iImmSize & ~ImmSize_SizeMask) == 0)
+    {
+        // Only the SSE / AVX forms exist under VEX & EVEX, no Jcc rel32.
+        return form.m_iEncoding != InstEncoding_Legacy && iImmSize == 4 ? 0 : iImmSize;
+    }
+
+
+    if((iImmSize & ImmSize_TestOnly) != 0 && form.RegField() > 1)
+        return 0;
+
+    if((iImmSize & ImmSize_W) != 0 && form.m_bRexW == true)
+        return 8;
+
+    if((iImmSize & ImmSize_Z) != 0 && form.m_bOpSize16 == true)
+        return 2;
+
+    if((iImmSize & ImmSize_MOffs) != 0 && form.m_bAdrsSize32 == true)
+        return 4;
+
+    return iImmSize & ImmSize_SizeMask;
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+DEADSTOP_CRASH_PATH
+static bool DeadStop::SetLength(InstForm_t& formOut, size_t iImmOffset, size_t iSize)
+{
+    size_t iLength = iImmOffset + GetImmSize(formOut);
+    if(iLength > iSize || iLength > MAX_INST_LENGTH)
+        return false;
+
+    formOut.m_iImmOffset = static_cast<uint8_t>(iImmOffset);
+    formOut.m_iLength    = static_cast<uint8_t>(iLength);
+    return true;
+}
@@ -0,0 +1,83 @@
+//=========================================================================
+//                      Instruction Form
+//=========================================================================
+// by      : INSANE
+// created : 16/10/2026
+//
+// purpose : Splits an x86_64 instruction's bytes into prefixes, opcode, ModRM,
+//           SIB, displacement & immediate. Nothing more, for code that only
+//           needs to know how long an instruction is, which registers & what
+//           memory it touches.
+//-------------------------------------------------------------------------
+#pragma once
+#include "../../Include/Alias.h"
+#include <cstddef>
+#include <cstdint>
+
+
+
+namespace DEADSTOP_NAMESPACE
+{
+    ///////////////////////////////////////////////////////////////////////////
+    ///////////////////////////////////////////////////////////////////////////
+    enum InstMap_t : uint8_t
+    {
+        InstMap_OneByte = 0,
+        InstMap_0F,
+        InstMap_0F38,
+        InstMap_0F3A,
+    };
+
+    enum InstEncoding_t : uint8_t
+    {
+        InstEncoding_Legacy = 0,
+        InstEncoding_VEX,
+        InstEncoding_EVEX,
+    };
+
+
+    ///////////////////////////////////////////////////////////////////////////
+    ///////////////////////////////////////////////////////////////////////////
+    // Register numbers here are x86 encoding numbers ( rAX = 0, rCX = 1 ... r15 = 15 ), REX / VEX bits included.
+    struct InstForm_t
+    {
+        uint8_t  m_iEncoding    = InstEncoding_Legacy;
+        uint8_t  m_iMap         = InstMap_OneByte;
+        uint8_t  m_iOpCode      = 0;
+
+        bool     m_bOpSize16    = false; // 0x66, or VEX / EVEX pp saying so.
+        bool     m_bAdrsSize32  = false; // 0x67
+        bool     m_bRepF3       = false; // 0xF3, or VEX / EVEX pp saying so.
+        bool     m_bRepF2       = false; // 0xF2, same.
+        bool     m_bRexW        = false; // REX.W or VEX / EVEX .W
+        bool     m_bRexR        = false;
+        bool     m_bRexX        = false;
+        bool     m_bRexB        = false;
+        uint8_t  m_iVEXReg      = 0;     // VEX / EVEX vvvv, already inverted.
+
+        bool     m_bHasModRM    = false;
+        uint8_t  m_iModRM       = 0;
+        bool     m_bHasSIB      = false;
+        uint8_t  m_iSIB         = 0;
+        int32_t  m_iDisp        = 0;     // Sign extended. EVEX disp8 is not scaled.
+        uint8_t  m_iDispSize    = 0;
+
+        uint8_t  m_iImmOffset   = 0;     // Immediate, if this instruction has one, starts here.
+        uint8_t  m_iLength      = 0;     // Whole instruction, prefixes to immediate.
+
+        uint8_t  Mod()          const { return m_iModRM >> 6; }
+        uint8_t  RegField()     const { return (m_iModRM >> 3) & 7; }                              // ModRM.reg without REX, opcode extensions ( /0 ... /7 ).
+        uint8_t  Reg()          const { return ((m_iModRM >> 3) & 7) | (m_bRexR == true ? 8 : 0); }
+        uint8_t  RM()           const { return (m_iModRM & 7)        | (m_bRexB == true ? 8 : 0); } // Register operand, only when Mod() == 3.
+        uint8_t  OpCodeReg()    const { return (m_iOpCode & 7)       | (m_bRexB == true ? 8 : 0); } // Register encoded in the opcode ( PUSH r, MOV r, imm ... ).
+        bool     IsMemory()     const { return m_bHasModRM == true && Mod() != 3; }
+        bool     IsRIPRelative()const { return IsMemory() == true && m_bHasSIB == false && Mod() == 0 && (m_iModRM & 7) == 5; }
+    };
+
+
+    // Parses the instruction at pBytes, length included. Table driven, no decoder & no allocations, so its
+    // cheap enough to walk code with. Parsing never reads past iSize. Returns false if the bytes run out
+    // before the instruction ends, or it would be longer than 15 bytes. Says nothing about whether the
+    // opcode is a valid one.
+    bool ParseInstForm(const uint8_t* pBytes, size_t iSize, InstForm_t& formOut);
+}
@@ -9,7 +9,11 @@
 //-------------------------------------------------------------------------
 #include "MemRegion_t.h"
 #include "../Util/Assertion/Assertion.h"
-#include <fstream>
+#include "../Util/MemoryLock/MemoryLock.h"
+#include <fcntl.h>
+#include <unistd.h>
+#include <errno.h>
+#include <algorithm>
 
 
 // Mind this...
@@ -19,122 +23,459 @@ using namespace DeadStop;
 
 ///////////////////////////////////////////////////////////////////////////
 ///////////////////////////////////////////////////////////////////////////
+DEADSTOP_CRASH_PATH
 DeadStop::MemRegion_t::MemRegion_t()
 {
-    m_iStart = 0; m_iEnd = 0;
+    m_iStart = 0; m_iEnd = 0; m_iOffset = 0; m_iInode = 0; m_szPath = nullptr; m_iPathLength = 0; m_iFlags = MemRegionFlag_None;
 }
 
 
 ///////////////////////////////////////////////////////////////////////////
 ///////////////////////////////////////////////////////////////////////////
-DeadStop::MemRegion_t::MemRegion_t(uintptr_t iStart, uintptr_t iEnd)
+DEADSTOP_CRASH_PATH
+DeadStop::MemRegion_t::MemRegion_t(uintptr_t iStart, uintptr_t iEnd, uint32_t iFlags)
 {
-    m_iStart = iStart; m_iEnd = iEnd;
+    m_iStart = iStart; m_iEnd = iEnd; m_iOffset = 0; m_iInode = 0; m_szPath = nullptr; m_iPathLength = 0; m_iFlags = iFlags;
 }
 
 
 ///////////////////////////////////////////////////////////////////////////
 ///////////////////////////////////////////////////////////////////////////
+DEADSTOP_CRASH_PATH
 DeadStop::MemRegionHandler_t::MemRegionHandler_t()
 {
-    m_vecAllRegions.clear();
+    SetStorage(nullptr, 0);
 }
 
 
 ///////////////////////////////////////////////////////////////////////////
 ///////////////////////////////////////////////////////////////////////////
-bool DeadStop::MemRegionHandler_t::InitializeFromFile(const char* szFile)
+DEADSTOP_CRASH_PATH
+void DeadStop::MemRegionHandler_t::SetStorage(void* pMemory, size_t iSizeInBytes)
+{
+    assertion((reinterpret_cast<uintptr_t>(pMemory) % alignof(MemRegion_t)) == 0 && "Misaligned region storage");
+
+    // Layout : [ regions ][ index ][ eytzinger keys ( n + 1 ) ][ code starts ][ code ends ][ eytzinger -> index ( n + 1 ) ]
+    size_t iFixedSize = sizeof(uintptr_t) + sizeof(uint32_t);
+    m_iCapacity = pMemory == nullptr || iSizeInBytes <= iFixedSize ? 0 : (iSizeInBytes - iFixedSize) / STORAGE_PER_REGION;
+
+    // Eytzinger -> index map is 32 bit.
+    if(m_iCapacity > UINT32_MAX)
+        m_iCapacity = UINT32_MAX;
+
+    if(m_iCapacity == 0)
+    {
+        m_pRegions = nullptr; m_pIndex = nullptr; m_pEytzKeys = nullptr; m_pEytzToIndex = nullptr;
+        m_pCodeStarts = nullptr; m_pCodeEnds = nullptr;
+    }
+    else
+    {
+        uint8_t* pCursor = reinterpret_cast<uint8_t*>(pMemory);
+        m_pRegions     = reinterpret_cast<MemRegion_t*>(pCursor); pCursor += sizeof(MemRegion_t) * m_iCapacity;
+        m_pIndex       = reinterpret_cast<MemRegion_t*>(pCursor); pCursor += sizeof(MemRegion_t) * m_iCapacity;
+        m_pEytzKeys    = reinterpret_cast<uintptr_t*>  (pCursor); pCursor += sizeof(uintptr_t)   * (m_iCapacity + 1);
+        m_pCodeStarts  = reinterpret_cast<uintptr_t*>  (pCursor); pCursor += sizeof(uintptr_t)   * m_iCapacity;
+        m_pCodeEnds    = reinterpret_cast<uintptr_t*>  (pCursor); pCursor += sizeof(uintptr_t)   * m_iCapacity;
+        m_pEytzToIndex = reinterpret_cast<uint32_t*>   (pCursor);
+    }
+
+    Clear();
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+DEADSTOP_CRASH_PATH
+void DeadStop::MemRegionHandler_t::Clear()
+{
+    m_nRegions       = 0;
+    m_nIndex         = 0;
+    m_nCodeRanges    = 0;
+    m_bOverflow      = false;
+    m_bIndexDirty    = false;
+    m_pText          = nullptr;
+    m_iTextSize      = 0;
+    m_bTextTruncated = false;
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+DEADSTOP_CRASH_PATH
+bool DeadStop::MemRegionHandler_t::InitializeFromFile(const char* szFile, char* pTextBuffer, size_t iTextBufferSize)
 {
     assertion(szFile != nullptr && "Invalid file");
-    
-    std::ifstream hMaps(szFile);
+    assertion(pTextBuffer != nullptr && iTextBufferSize > 0 && "Invalid maps text buffer");
+
+    // NOTE : This runs inside the signal handler, so raw syscalls only. No streams.
+    int hMaps = open(szFile, O_RDONLY | O_CLOEXEC);
 
     // If we can't open this, something must be really wrong.
-    if(hMaps.is_open() == false)
+    if(hMaps < 0)
         return false;
 
 
-    std::string szLine;
-    while(std::getline(hMaps, szLine))
+    Clear();
+    m_pText = pTextBuffer;
+
+    // Whole file lands in pTextBuffer back to back. Every read only parses the lines it completed,
+    // a partial line at the end waits for the next read. So each byte is read from the kernel once,
+    // & the dump is just this buffer.
+    size_t iTextSize  = 0;
+    size_t iLineStart = 0;
+    while(true)
     {
-        // /proc/self/maps should have "[startadrs]-[EndAdrs]" format.
-        
-        uintptr_t iStartAdrs = 0;
-        uintptr_t iEndAdrs   = 0;
+        if(iTextSize >= iTextBufferSize)
+        {
+            m_bTextTruncated = true;
+            break;
+        }
+
+        ssize_t nBytes = read(hMaps, pTextBuffer + iTextSize, iTextBufferSize - iTextSize);
+        if(nBytes < 0 && errno == EINTR)
+            continue;
 
-        size_t iterator = 0;
-        size_t nChars = szLine.size();
+        if(nBytes <= 0)
+            break;
 
-        // Discarding leading spaces.
-        while(iterator < nChars && szLine[iterator] == ' ') iterator++;
 
-        // Get the first hex number from string.
-        for(; iterator < nChars; iterator++)
+        size_t iScanEnd = iTextSize + static_cast<size_t>(nBytes);
+        for(size_t iCursor = iTextSize; iCursor < iScanEnd; iCursor++)
         {
-            char c = szLine[iterator];
-            int iNum = 0;
+            if(pTextBuffer[iCursor] != '\n')
+                continue;
+
+            ParseLine(pTextBuffer + iLineStart, pTextBuffer + iCursor);
+            iLineStart = iCursor + 1;
+        }
+
+        iTextSize = iScanEnd;
+    }
+
+    close(hMaps);
 
 
-            if(c >= '0' && c <= '9')
-                iNum = c - '0';
-            else if(c >= 'A' && c <= 'F')
-                iNum = c - 'A' + 10;
-            else if(c >= 'a' && c <= 'f')
-                iNum = c - 'a' + 10;
+    if(iLineStart < iTextSize)
+    {
+        // Cut off mid line? Drop it, both from regions & the text.
+        if(m_bTextTruncated == true)
+            iTextSize = iLineStart;
+        else
+            ParseLine(pTextBuffer + iLineStart, pTextBuffer + iTextSize); // Last line without a '\n'
+    }
+
+    m_iTextSize = iTextSize;
+
+    BuildIndex();
+    return true;
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+void DeadStop::MemRegionHandler_t::SetText(const char* pText, size_t iTextSize, bool bTruncated)
+{
+    m_pText          = pText;
+    m_iTextSize      = pText == nullptr ? 0 : iTextSize;
+    m_bTextTruncated = bTruncated;
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+DEADSTOP_CRASH_PATH
+bool DeadStop::MemRegionHandler_t::ParseLine(const char* pLine, const char* pLineEnd)
+{
+    // "start-end perms offset dev inode        path"
+    // e.g. "7f1c2a000000-7f1c2a021000 r-xp 00002000 08:01 1835019    /usr/lib/libc.so.6"
+    const char* p = pLine;
+
+    auto skipSpaces = [&]() { while(p < pLineEnd && (*p == ' ' || *p == '\t')) p++; };
+    auto parseHex   = [&]() -> uint64_t
+    {
+        uint64_t iValue = 0;
+        for(; p < pLineEnd; p++)
+        {
+            char c = *p;
+            if(c >= '0' && c <= '9')      iValue = (iValue << 4) | static_cast<uint64_t>(c - '0');
+            else if(c >= 'a' && c <= 'f') iValue = (iValue << 4) | static_cast<uint64_t>(c - 'a' + 10);
+            else if(c >= 'A' && c <= 'F') iValue = (iValue << 4) | static_cast<uint64_t>(c - 'A' + 10);
             else break;
+        }
+        return iValue;
+    };
+
+
+    MemRegion_t region;
+
+    skipSpaces();
+    const char* pFieldStart = p;
+    region.m_iStart = parseHex();
+    if(p == pFieldStart || p >= pLineEnd || *p != '-')
+        return false;
+
+    p++;
+    region.m_iEnd = parseHex();
+
+
+    // Permissions, always 4 characters.
+    skipSpaces();
+    if(pLineEnd - p >= 4)
+    {
+        if(p[0] == 'r') region.m_iFlags |= MemRegionFlag_Read;
+        if(p[1] == 'w') region.m_iFlags |= MemRegionFlag_Write;
+        if(p[2] == 'x') region.m_iFlags |= MemRegionFlag_Exec;
+        if(p[3] == 'p') region.m_iFlags |= MemRegionFlag_Private;
+        p += 4;
+    }
 
-            iStartAdrs *= 0x10;
-            iStartAdrs += iNum;
+
+    skipSpaces(); region.m_iOffset = parseHex();
+
+    // Device "major:minor", not needed.
+    skipSpaces(); while(p < pLineEnd && *p != ' ' && *p != '\t') p++;
+
+    skipSpaces();
+    for(; p < pLineEnd && *p >= '0' && *p <= '9'; p++)
+        region.m_iInode = region.m_iInode * 10 + static_cast<uint64_t>(*p - '0');
+
+
+    // Rest of the line is the path, if any.
+    skipSpaces();
+    if(p < pLineEnd)
+    {
+        region.m_szPath      = p;
+        region.m_iPathLength = static_cast<uint32_t>(pLineEnd - p);
+    }
+
+
+    return RegisterRegion(region);
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+DEADSTOP_CRASH_PATH
+void DeadStop::MemRegionHandler_t::BuildIndex()
+{
+    m_bIndexDirty = false;
+    m_nIndex      = 0;
+    m_nCodeRanges = 0;
+
+    if(m_nRegions == 0)
+        return;
+
+
+    // /proc/self/maps is already sorted, but RegisterRegion() can be called by anyone. Sorted copy goes
+    // to the back of m_pIndex, the index is built from the front. Room in between is for splitting
+    // overlaps, output never catches up with regions not read yet.
+    MemRegion_t* pSorted = m_pIndex + (m_iCapacity - m_nRegions);
+    for(size_t iRegionIndex = 0; iRegionIndex < m_nRegions; iRegionIndex++)
+        pSorted[iRegionIndex] = m_pRegions[iRegionIndex];
+
+    std::sort(pSorted, pSorted + m_nRegions, [](const MemRegion_t& a, const MemRegion_t& b) { return a.m_iStart < b.m_iStart; });
+
+
+    // Merge touching / overlapping regions with the same access, keeps the index small. Mappings
+    // of one file usually change permissions every few pages, so those stay separate.
+    for(size_t iRegionIndex = 0; iRegionIndex < m_nRegions; iRegionIndex++)
+    {
+        MemRegion_t region = pSorted[iRegionIndex];
+        if(AddIndexRegion(region, m_iCapacity - m_nRegions + iRegionIndex + 1) == false)
+            m_bOverflow = true;
+    }
+
+
+    m_pEytzKeys[0]    = 0;
+    m_pEytzToIndex[0] = static_cast<uint32_t>(m_nIndex);
+    BuildEytzinger(0, 1);
+
+
+    // Code ranges, read-only & read-write executable neighbours count as one.
+    for(size_t iIndex = 0; iIndex < m_nIndex; iIndex++)
+    {
+        const MemRegion_t& region = m_pIndex[iIndex];
+        if((region.m_iFlags & (MemRegionFlag_Read | MemRegionFlag_Exec)) != (MemRegionFlag_Read | MemRegionFlag_Exec))
+            continue;
+
+        if(m_nCodeRanges > 0 && m_pCodeEnds[m_nCodeRanges - 1] >= region.m_iStart)
+        {
+            if(region.m_iEnd > m_pCodeEnds[m_nCodeRanges - 1])
+                m_pCodeEnds[m_nCodeRanges - 1] = region.m_iEnd;
+
+            continue;
         }
 
-        // So we are past whatever character cause "break;" in the loop above.
-        iterator++;
+        m_pCodeStarts[m_nCodeRanges] = region.m_iStart;
+        m_pCodeEnds  [m_nCodeRanges] = region.m_iEnd;
+        m_nCodeRanges++;
+    }
+}
+
 
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+DEADSTOP_CRASH_PATH
+bool DeadStop::MemRegionHandler_t::AddIndexRegion(const MemRegion_t& region, size_t iIndexLimit)
+{
+    // Index is sorted & its entries never overlap, so only the last few can overlap region.
+    size_t iFirst = m_nIndex;
+    while(iFirst > 0 && m_pIndex[iFirst - 1].m_iEnd > region.m_iStart)
+        iFirst--;
 
-        // Get the second hex number from string.
-        for(; iterator < nChars; iterator++)
+    if(iFirst == m_nIndex)
+    {
+        MemRegion_t* pLast = m_nIndex > 0 ? &m_pIndex[m_nIndex - 1] : nullptr;
+        if(pLast != nullptr && pLast->m_iEnd == region.m_iStart && (pLast->m_iFlags & MemRegionFlag_Access) == (region.m_iFlags & MemRegionFlag_Access))
         {
-            char c = szLine[iterator];
-            int iNum = 0;
+            pLast->m_iEnd = region.m_iEnd;
+            return true;
+        }
+
+        m_pIndex[m_nIndex++] = region;
+        return true;
+    }
 
 
-            if(c >= '0' && c <= '9')
-                iNum = c - '0';
-            else if(c >= 'A' && c <= 'F')
-                iNum = c - 'A' + 10;
-            else if(c >= 'a' && c <= 'f')
-                iNum = c - 'a' + 10;
-            else break;
+    // Overlaps are rare ( e.g. JIT code registered inside a rw- mapping ), & cut into pieces. Where
+    // they overlap, the piece has both of their access.
+    constexpr size_t MAX_OVERLAPPED = 4;
+    if(m_nIndex - iFirst > MAX_OVERLAPPED)
+        return false;
+
+    MemRegion_t pieces[2 * MAX_OVERLAPPED + 1];
+    size_t      nPieces = 0;
+    auto addPiece = [&](const MemRegion_t& source, uintptr_t iStart, uintptr_t iEnd, uint32_t iFlags)
+    {
+        if(iStart >= iEnd)
+            return;
 
-            iEndAdrs *= 0x10;
-            iEndAdrs += iNum;
+        MemRegion_t* pLast = nPieces > 0 ? &pieces[nPieces - 1] : nullptr;
+        if(pLast != nullptr && pLast->m_iEnd == iStart && (pLast->m_iFlags & MemRegionFlag_Access) == (iFlags & MemRegionFlag_Access))
+        {
+            pLast->m_iEnd = iEnd;
+            return;
         }
 
-        // Store em in "out" array.
-        RegisterRegion(iStartAdrs, iEndAdrs);
+        pieces[nPieces]          = source;
+        pieces[nPieces].m_iStart = iStart;
+        pieces[nPieces].m_iEnd   = iEnd;
+        pieces[nPieces].m_iFlags = iFlags;
+        nPieces++;
+    };
+
+    uintptr_t iCursor = region.m_iStart; // region is in the pieces up to here.
+    for(size_t iIndex = iFirst; iIndex < m_nIndex; iIndex++)
+    {
+        const MemRegion_t& current = m_pIndex[iIndex];
+        uintptr_t iOverlapStart = current.m_iStart > region.m_iStart ? current.m_iStart : region.m_iStart;
+        uintptr_t iOverlapEnd   = current.m_iEnd   < region.m_iEnd   ? current.m_iEnd   : region.m_iEnd;
+
+        addPiece(current, current.m_iStart, current.m_iEnd < region.m_iStart ? current.m_iEnd : region.m_iStart, current.m_iFlags);
+        addPiece(region,  iCursor, current.m_iStart < region.m_iEnd ? current.m_iStart : region.m_iEnd, region.m_iFlags);
+        addPiece(current, iOverlapStart, iOverlapEnd, current.m_iFlags | region.m_iFlags);
+        addPiece(current, current.m_iStart > region.m_iEnd ? current.m_iStart : region.m_iEnd, current.m_iEnd, current.m_iFlags);
+
+        if(iOverlapEnd > iCursor)
+            iCursor = iOverlapEnd;
     }
+    addPiece(region, iCursor, region.m_iEnd, region.m_iFlags);
+
+
+    if(iFirst + nPieces > iIndexLimit)
+        return false;
 
+    for(size_t iPiece = 0; iPiece < nPieces; iPiece++)
+        m_pIndex[iFirst + iPiece] = pieces[iPiece];
 
-    hMaps.close();
+    m_nIndex = iFirst + nPieces;
     return true;
 }
 
 
 ///////////////////////////////////////////////////////////////////////////
 ///////////////////////////////////////////////////////////////////////////
-DeadStop::MemRegion_t* DeadStop::MemRegionHandler_t::FindParentRegion(const MemRegion_t& region)
+DEADSTOP_CRASH_PATH
+size_t DeadStop::MemRegionHandler_t::BuildEytzinger(size_t iSortedIndex, size_t iNode)
+{
+    // In-order walk of the implicit tree hands out sorted entries left to right.
+    if(iNode > m_nIndex)
+        return iSortedIndex;
+
+    iSortedIndex = BuildEytzinger(iSortedIndex, 2 * iNode);
+
+    m_pEytzKeys[iNode]    = m_pIndex[iSortedIndex].m_iStart;
+    m_pEytzToIndex[iNode] = static_cast<uint32_t>(iSortedIndex);
+    iSortedIndex++;
+
+    return BuildEytzinger(iSortedIndex, 2 * iNode + 1);
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+DEADSTOP_CRASH_PATH
+intptr_t DeadStop::MemRegionHandler_t::FindIndex(uintptr_t iAdrs) const
+{
+    if(m_nIndex == 0)
+        return -1;
+
+
+    // Descend to the first key > iAdrs. No data dependent branches, & we prefetch a few
+    // levels ahead since the children of node k live right next to each other at 8k.
+    size_t iNode = 1;
+    while(iNode <= m_nIndex)
+    {
+        __builtin_prefetch(m_pEytzKeys + 8 * iNode);
+        iNode = 2 * iNode + (m_pEytzKeys[iNode] <= iAdrs ? 1 : 0);
+    }
+
+    // Undo the trailing right turns, what's left is the node we last went left at ( 0 if none ).
+    iNode >>= __builtin_ffsll(static_cast<long long>(~iNode));
+
+
+    // Region before the first start > iAdrs is the only one that can hold it.
+    size_t iUpperBound = m_pEytzToIndex[iNode];
+    if(iUpperBound == 0)
+        return -1;
+
+    size_t iCandidate = iUpperBound - 1;
+    return iAdrs < m_pIndex[iCandidate].m_iEnd ? static_cast<intptr_t>(iCandidate) : -1;
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+DEADSTOP_CRASH_PATH
+DeadStop::MemRegion_t* DeadStop::MemRegionHandler_t::FindParentRegion(const MemRegion_t& region, uint32_t iRequiredFlags)
 {
     assertion(region.m_iStart <= region.m_iEnd && "Invalid Memory Regoin.");
 
-    for(MemRegion_t& parentRegion : m_vecAllRegions)
+    if(m_bIndexDirty == true)
+        BuildIndex();
+
+    intptr_t iIndex = FindIndex(region.m_iStart);
+    if(iIndex < 0)
+        return nullptr;
+
+
+    // NOTE : End address of a memory region is not included according to /proc/self/maps.
+    //        Hence is not part of the memory region.
+    MemRegion_t* pParentRegion = &m_pIndex[iIndex];
+    for(size_t iCursor = static_cast<size_t>(iIndex); iCursor < m_nIndex; iCursor++)
     {
-        // NOTE : End address of a memory region is not included according to /proc/self/maps.
-        //        Hence is not part of the memory region.
-        bool bStartValid = region.m_iStart >= parentRegion.m_iStart && region.m_iStart < parentRegion.m_iEnd;
-        bool bEndValid   = region.m_iEnd   >= parentRegion.m_iStart && region.m_iEnd   < parentRegion.m_iEnd;
+        const MemRegion_t& current = m_pIndex[iCursor];
+
+        // PROT_NONE guards & such live in the maps too, being mapped isn't enough.
+        if((current.m_iFlags & iRequiredFlags) != iRequiredFlags)
+            return nullptr;
 
-        if(bStartValid == true && bEndValid == true)
-            return &parentRegion;
+        if(region.m_iEnd < current.m_iEnd)
+            return pParentRegion;
+
+        // Range runs past this region, next one must start right where this one ends.
+        if(iCursor + 1 >= m_nIndex || m_pIndex[iCursor + 1].m_iStart != current.m_iEnd)
+            return nullptr;
     }
 
     return nullptr;
@@ -143,22 +484,25 @@ DeadStop::MemRegion_t* DeadStop::MemRegionHandler_t::FindParentRegion(const MemR
 
 ///////////////////////////////////////////////////////////////////////////
 ///////////////////////////////////////////////////////////////////////////
-DeadStop::MemRegion_t* DeadStop::MemRegionHandler_t::FindParentRegion(uintptr_t iStart, uintptr_t iEnd)
+DEADSTOP_CRASH_PATH
+DeadStop::MemRegion_t* DeadStop::MemRegionHandler_t::FindParentRegion(uintptr_t iStart, uintptr_t iEnd, uint32_t iRequiredFlags)
 {
-    return FindParentRegion(MemRegion_t(iStart, iEnd));
+    return FindParentRegion(MemRegion_t(iStart, iEnd), iRequiredFlags);
 }
 
 
 ///////////////////////////////////////////////////////////////////////////
 ///////////////////////////////////////////////////////////////////////////
-DeadStop::MemRegion_t* DeadStop::MemRegionHandler_t::FindParentRegion(uintptr_t iAdrs)
+DEADSTOP_CRASH_PATH
+DeadStop::MemRegion_t* DeadStop::MemRegionHandler_t::FindParentRegion(uintptr_t iAdrs, uint32_t iRequiredFlags)
 {
-    return FindParentRegion(MemRegion_t(iAdrs, iAdrs));
+    return FindParentRegion(MemRegion_t(iAdrs, iAdrs), iRequiredFlags);
 }
 
 
 ///////////////////////////////////////////////////////////////////////////
 ///////////////////////////////////////////////////////////////////////////
+DEADSTOP_CRASH_PATH
 bool DeadStop::MemRegionHandler_t::HasParentRegion(const MemRegion_t& region)
 {
     return FindParentRegion(region) != nullptr;
@@ -167,6 +511,7 @@ bool DeadStop::MemRegionHandler_t::HasParentRegion(const MemRegion_t& region)
 
 ///////////////////////////////////////////////////////////////////////////
 ///////////////////////////////////////////////////////////////////////////
+DEADSTOP_CRASH_PATH
 bool DeadStop::MemRegionHandler_t::HasParentRegion(uintptr_t iStart, uintptr_t iEnd)
 {
     return FindParentRegion(iStart, iEnd) != nullptr;
@@ -175,6 +520,7 @@ bool DeadStop::MemRegionHandler_t::HasParentRegion(uintptr_t iStart, uintptr_t i
 
 ///////////////////////////////////////////////////////////////////////////
 ///////////////////////////////////////////////////////////////////////////
+DEADSTOP_CRASH_PATH
 bool DeadStop::MemRegionHandler_t::HasParentRegion(uintptr_t iAdrs)
 {
     return FindParentRegion(iAdrs) != nullptr;
@@ -183,15 +529,204 @@ bool DeadStop::MemRegionHandler_t::HasParentRegion(uintptr_t iAdrs)
 
 ///////////////////////////////////////////////////////////////////////////
 ///////////////////////////////////////////////////////////////////////////
-void DeadStop::MemRegionHandler_t::RegisterRegion(uintptr_t iStart, uintptr_t iEnd)
+DEADSTOP_CRASH_PATH
+bool DeadStop::MemRegionHandler_t::HasExecutableRegion(uintptr_t iStart, uintptr_t iEnd)
+{
+    // Execute only pages can't be read, & we read code to disassemble it.
+    return FindParentRegion(iStart, iEnd, MemRegionFlag_Read | MemRegionFlag_Exec) != nullptr;
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+DEADSTOP_CRASH_PATH
+bool DeadStop::MemRegionHandler_t::HasExecutableRegion(uintptr_t iAdrs)
+{
+    return HasExecutableRegion(iAdrs, iAdrs);
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+DEADSTOP_CRASH_PATH
+bool DeadStop::MemRegionHandler_t::IsCodeAdrs(uintptr_t iAdrs)
+{
+    if(m_bIndexDirty == true)
+        BuildIndex();
+
+    // Most values aren't anywhere near code, those never get to the search.
+    if(m_nCodeRanges == 0 || iAdrs < m_pCodeStarts[0] || iAdrs >= m_pCodeEnds[m_nCodeRanges - 1])
+        return false;
+
+
+    // Last range starting at or below iAdrs, without data dependent branches.
+    const uintptr_t* pBase = m_pCodeStarts;
+    size_t           nLeft = m_nCodeRanges;
+    while(nLeft > 1)
+    {
+        size_t iHalf = nLeft / 2;
+        pBase  = pBase[iHalf] <= iAdrs ? pBase + iHalf : pBase;
+        nLeft -= iHalf;
+    }
+
+    return iAdrs < m_pCodeEnds[pBase - m_pCodeStarts];
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+DEADSTOP_CRASH_PATH
+size_t DeadStop::MemRegionHandler_t::FindParentRegions(const uintptr_t* pAdrs, size_t nAdrs, MemRegion_t** pOut, uint32_t iRequiredFlags)
+{
+    if(m_bIndexDirty == true)
+        BuildIndex();
+
+    if(m_nIndex == 0)
+    {
+        for(size_t iAdrsIndex = 0; iAdrsIndex < nAdrs; iAdrsIndex++)
+            pOut[iAdrsIndex] = nullptr;
+
+        return 0;
+    }
+
+
+    // Same search as FindIndex(), but LANES of them step through the tree together. Every level
+    // issues LANES independent loads, so their cache misses overlap instead of queuing up.
+    constexpr size_t LANES = 8;
+    size_t nHits = 0;
+
+    for(size_t iBatchStart = 0; iBatchStart < nAdrs; iBatchStart += LANES)
+    {
+        size_t nLanes = nAdrs - iBatchStart < LANES ? nAdrs - iBatchStart : LANES;
+        size_t iNodes[LANES];
+        for(size_t iLane = 0; iLane < nLanes; iLane++)
+            iNodes[iLane] = 1;
+
+
+        // Every lane takes the same number of steps, give or take one.
+        bool bActive = true;
+        while(bActive == true)
+        {
+            bActive = false;
+            for(size_t iLane = 0; iLane < nLanes; iLane++)
+            {
+                size_t iNode = iNodes[iLane];
+                if(iNode > m_nIndex)
+                    continue;
+
+                __builtin_prefetch(m_pEytzKeys + 8 * iNode);
+                iNodes[iLane] = 2 * iNode + (m_pEytzKeys[iNode] <= pAdrs[iBatchStart + iLane] ? 1 : 0);
+                bActive       = true;
+            }
+        }
+
+
+        for(size_t iLane = 0; iLane < nLanes; iLane++)
+        {
+            uintptr_t iAdrs       = pAdrs[iBatchStart + iLane];
+            size_t    iNode       = iNodes[iLane] >> __builtin_ffsll(static_cast<long long>(~iNodes[iLane]));
+            size_t    iUpperBound = m_pEytzToIndex[iNode];
+
+            MemRegion_t* pRegion = nullptr;
+            if(iUpperBound != 0 && iAdrs < m_pIndex[iUpperBound - 1].m_iEnd &&
+                    (m_pIndex[iUpperBound - 1].m_iFlags & iRequiredFlags) == iRequiredFlags)
+            {
+                pRegion = &m_pIndex[iUpperBound - 1];
+                nHits++;
+            }
+
+            pOut[iBatchStart + iLane] = pRegion;
+        }
+    }
+
+    return nHits;
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+DEADSTOP_CRASH_PATH
+bool DeadStop::MemRegionHandler_t::RegisterRegion(uintptr_t iStart, uintptr_t iEnd, uint32_t iFlags)
+{
+    return RegisterRegion(MemRegion_t(iStart, iEnd, iFlags));
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+DEADSTOP_CRASH_PATH
+bool DeadStop::MemRegionHandler_t::RegisterRegion(const MemRegion_t& region)
+{
+    if(m_nRegions >= m_iCapacity)
+    {
+        m_bOverflow = true;
+        return false;
+    }
+
+    m_pRegions[m_nRegions++] = region;
+    m_bIndexDirty            = true;
+    return true;
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+DEADSTOP_CRASH_PATH
+const MemRegion_t* DeadStop::MemRegionHandler_t::GetAllRegions() const
+{
+    return m_pRegions;
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+DEADSTOP_CRASH_PATH
+size_t DeadStop::MemRegionHandler_t::GetRegionCount() const
+{
+    return m_nRegions;
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+DEADSTOP_CRASH_PATH
+size_t DeadStop::MemRegionHandler_t::GetRegionCapacity() const
+{
+    return m_iCapacity;
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+DEADSTOP_CRASH_PATH
+bool DeadStop::MemRegionHandler_t::HasOverflowed() const
+{
+    return m_bOverflow;
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+DEADSTOP_CRASH_PATH
+const char* DeadStop::MemRegionHandler_t::GetText() const
+{
+    return m_pText;
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+DEADSTOP_CRASH_PATH
+size_t DeadStop::MemRegionHandler_t::GetTextSize() const
 {
-    m_vecAllRegions.push_back(MemRegion_t(iStart, iEnd));
+    return m_iTextSize;
 }
 
 
 ///////////////////////////////////////////////////////////////////////////
 ///////////////////////////////////////////////////////////////////////////
-const std::vector<MemRegion_t>& DeadStop::MemRegionHandler_t::GetAllRegions() const
+DEADSTOP_CRASH_PATH
+bool DeadStop::MemRegionHandler_t::IsTextTruncated() const
 {
-    return m_vecAllRegions;
+    return m_bTextTruncated;
 }
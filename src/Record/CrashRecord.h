@@ -0,0 +1,282 @@
+//=========================================================================
+//                      Crash Record
+//=========================================================================
+// by      : INSANE
+// created : 16/10/2026
+//
+// purpose : Compact binary crash dump, written instead of the text report
+//           with DeadStopFlag_BinaryRecord & turned into one offline.
+//-------------------------------------------------------------------------
+#pragma once
+#include "../../Include/Alias.h"
+#include <cstddef>
+#include <cstdint>
+#include <sys/ucontext.h>
+
+
+
+namespace DEADSTOP_NAMESPACE
+{
+    class Writer_t;
+
+    // A record is a RecordHeader_t, then sections ( RecordSection_t + payload, padded to 8 bytes ) up
+    // to a RecordSection_End one. Records are appended to the dump file one after another.
+    //
+    // Version goes up only when an existing section changes in a way old readers would misread. Fields
+    // are only ever added at the end of a section, readers take the part they know & skip the rest, &
+    // skip section kinds they don't know altogether.
+    constexpr uint32_t CRASH_RECORD_MAGIC      = 0x52435344; // "DSCR"
+    constexpr uint32_t CRASH_RECORD_VERSION    = 1;
+    constexpr size_t   RECORD_ALIGNMENT        = 8;
+    constexpr size_t   RECORD_STACK_SLICE_SIZE = 16 * 1024;  // Crashing stack kept from rSP up, red zone included.
+    constexpr size_t   RECORD_REG_WINDOW_SIZE  = 256;        // Memory kept at each register that points somewhere mapped.
+    constexpr uint32_t RECORD_NO_PATH          = 0xFFFFFFFF;
+
+
+    ///////////////////////////////////////////////////////////////////////////
+    ///////////////////////////////////////////////////////////////////////////
+    enum RecordSectionKind_t : uint32_t
+    {
+        RecordSection_End = 0,      // RecordEnd_t, last section of every record.
+        RecordSection_Crash,        // RecordCrash_t. Records without one only hold late followers.
+        RecordSection_Context,      // uint64_t[ __NGREG ], crashing thread's gregs as is.
+        RecordSection_SigInfo,      // siginfo_t as is.
+        RecordSection_MapsText,     // /proc/self/maps, as read at crash time.
+        RecordSection_Regions,      // RecordRegion_t[], what the maps were parsed into & JIT code added.
+        RecordSection_CallStack,    // RecordCallStack_t, then RecordFrame_t[ m_nFrames ].
+        RecordSection_Memory,       // RecordMemory_t, then m_iSize bytes.
+        RecordSection_JitCode,      // RecordJitCode_t, registered JIT code some recorded frame is in.
+        RecordSection_Follower,     // RecordFollower_t
+        RecordSection_Fiber,        // RecordFiber_t, then RecordFrame_t[ m_nFrames ].
+        RecordSection_FiberSummary, // RecordFiberSummary_t, only if suspended fibers were dumped.
+        RecordSection_MiniCore,     // RecordMiniCore_t, only with DeadStopFlag_MiniCore. Memory is in the Memory sections.
+    };
+
+
+    enum RecordCrashFlags_t : uint32_t
+    {
+        RecordCrashFlag_None              = 0,
+        RecordCrashFlag_OnAltStack        = (1 << 0), // Handler ran on the alternate signal stack.
+        RecordCrashFlag_MapsTruncated     = (1 << 1),
+        RecordCrashFlag_RegionsOverflowed = (1 << 2),
+    };
+
+
+    enum RecordMemoryKind_t : uint32_t
+    {
+        RecordMemory_Code = 0, // Around a frame, what its disassembly is made from.
+        RecordMemory_Stack,
+        RecordMemory_Register, // At a register's value.
+        RecordMemory_Fault,    // At the fault address.
+    };
+
+
+    ///////////////////////////////////////////////////////////////////////////
+    ///////////////////////////////////////////////////////////////////////////
+    struct RecordHeader_t
+    {
+        uint32_t m_iMagic;
+        uint32_t m_iVersion;
+    };
+
+
+    struct RecordSection_t
+    {
+        uint32_t m_iKind;
+        uint32_t m_iSize;     // Payload only, without padding.
+    };
+
+
+    struct RecordCrash_t
+    {
+        int32_t  m_iSignalID;
+        int32_t  m_iProcessID;
+        int32_t  m_iThreadID;
+        uint32_t m_iFlags;          // RecordCrashFlags_t
+        uint64_t m_iCrashFiberID;   // 0 if it wasn't on a registered fiber.
+        int64_t  m_iStartTime;      // Local time, seconds since 1970.
+        int32_t  m_iAsmDumpRange;   // Settings it was captured with.
+        int32_t  m_iStringDumpSize;
+        int32_t  m_iSignatureSize;
+        int32_t  m_iReserved;
+        uint64_t m_iStackLow;       // Crashing thread's stack, 0 if unknown.
+        uint64_t m_iStackHigh;
+        uint64_t m_iGuardSize;
+    };
+
+
+    struct RecordRegion_t
+    {
+        uint64_t m_iStart;
+        uint64_t m_iEnd;
+        uint64_t m_iOffset;
+        uint64_t m_iInode;
+        uint32_t m_iFlags;          // MemRegionFlags_t
+        uint32_t m_iPathOffset;     // Into the maps text, RECORD_NO_PATH if none.
+        uint32_t m_iPathLength;
+        uint32_t m_iReserved;
+    };
+
+
+    struct RecordCallStack_t
+    {
+        uint64_t m_iUnwindTimeNs;
+        uint64_t m_nCachedPlans;
+        uint32_t m_nFrames;
+        uint32_t m_iReserved;
+    };
+
+
+    struct RecordFrame_t
+    {
+        uint64_t m_iAdrs;
+        uint32_t m_iMethod;         // UnwindMethod_t
+        uint32_t m_iReserved;
+    };
+
+
+    struct RecordMemory_t
+    {
+        uint64_t m_iAdrs;
+        uint32_t m_iSize;
+        uint32_t m_iKind;           // RecordMemoryKind_t
+    };
+
+
+    struct RecordJitCode_t
+    {
+        uint64_t m_iStart;
+        uint64_t m_iEnd;
+        char     m_szName[64];
+    };
+
+
+    struct RecordFollower_t
+    {
+        int32_t  m_iThreadID;
+        int32_t  m_iSignalID;
+        int32_t  m_iSignalCode;
+        int32_t  m_nFrames;
+        uint64_t m_iFaultAdrs;
+        uint64_t m_gregs[__NGREG];
+        uint64_t m_iFrames[32];
+    };
+
+
+    struct RecordFiber_t
+    {
+        uint64_t m_iFiberID;
+        uint64_t m_iStackLow;
+        uint64_t m_iStackHigh;
+        uint32_t m_nFrames;
+        uint32_t m_bHasContext;     // 0 if it was never switched out, no frames then.
+    };
+
+
+    struct RecordFiberSummary_t
+    {
+        uint64_t m_nUnwound;
+        uint64_t m_nSkipped;        // Over the dump limits.
+        uint64_t m_iUnwindTimeNs;
+    };
+
+
+    struct RecordMiniCore_t
+    {
+        uint64_t m_iStackLimit;     // Limits it was captured with.
+        uint64_t m_iSizeLimit;
+        uint64_t m_iCapturedBytes;
+        uint64_t m_iSkippedBytes;   // Planned, but over the limit or unreadable.
+        uint64_t m_iCaptureTimeNs;
+    };
+
+
+    struct RecordEnd_t
+    {
+        int64_t  m_iEndTime;        // Local time, seconds since 1970.
+        uint64_t m_iHandlerLatencyNs;
+        uint64_t m_nDroppedFollowers;
+        uint64_t m_iArenaPeak;
+        uint64_t m_iArenaCapacity;
+        uint64_t m_nFailedAllocs;
+        uint64_t m_nRegions;
+        uint64_t m_iRegionCapacity;
+        uint64_t m_nSafeReadSyscalls;
+        uint64_t m_nSafeReadFails;
+    };
+
+
+    ///////////////////////////////////////////////////////////////////////////
+    ///////////////////////////////////////////////////////////////////////////
+    // Crash path. Streams a record through a Writer_t, sections are written as they are made.
+    class RecordWriter_t
+    {
+        public:
+            RecordWriter_t(Writer_t& hFile);
+
+            // Writes the record header, only the first call does anything.
+            void Begin();
+            bool HasBegun() const;
+            void WriteSection(RecordSectionKind_t iKind, const void* pData, size_t iSize);
+
+            // Section made of a fixed part & whatever follows it, e.g. RecordCallStack_t & its frames.
+            void BeginSection(RecordSectionKind_t iKind, size_t iSize);
+            void WriteBytes  (const void* pData, size_t iSize);
+            void EndSection  ();
+
+            void End(const RecordEnd_t& end);
+
+        private:
+            Writer_t& m_hFile;
+            bool      m_bBegun       = false;
+            size_t    m_iSectionLeft = 0; // Payload bytes the open section is still owed.
+            size_t    m_iPadding     = 0;
+    };
+
+
+    ///////////////////////////////////////////////////////////////////////////
+    ///////////////////////////////////////////////////////////////////////////
+    // Offline. A record read back from a dump, sections are found by walking it.
+    class CrashRecordReader_t
+    {
+        public:
+            CrashRecordReader_t();
+            ~CrashRecordReader_t();
+
+            // False if pData doesn't start with a whole record this version can read. bAllowTruncated takes
+            // one without its End too ( dump slab slot it didn't fit in ), as far as its last whole section.
+            bool           Parse(const uint8_t* pData, size_t iSize, bool bAllowTruncated = false);
+            size_t         GetRecordSize() const; // Next record starts this far in.
+            uint32_t       GetVersion()    const;
+            bool           IsTruncated()   const;
+
+            // iIndex-th section of a kind, in written order. nullptr if there's no such section.
+            const uint8_t* GetSection(RecordSectionKind_t iKind, size_t iIndex, size_t& iSizeOut) const;
+
+            // Same, but nullptr if its too short to hold a T.
+            template<typename T>
+            const T*       Get(RecordSectionKind_t iKind, size_t iIndex = 0) const
+            {
+                size_t         iSize = 0;
+                const uint8_t* pData = GetSection(iKind, iIndex, iSize);
+                return pData != nullptr && iSize >= sizeof(T) ? reinterpret_cast<const T*>(pData) : nullptr;
+            }
+
+            // Process memory at iAdrs, as many bytes as were recorded in one run from there. Read only
+            // mappings of files that nothing recorded covers are read from the file, if its still the same
+            // file ( inode ) it was at crash time. Returns bytes copied, same as SafeRead().
+            size_t         ReadMemory(void* pDest, uintptr_t iAdrs, size_t iSize) const;
+
+        private:
+            size_t         ReadModuleFile(void* pDest, uintptr_t iAdrs, size_t iSize) const;
+
+            const uint8_t*   m_pData        = nullptr;
+            size_t           m_iSize        = 0;
+            uint32_t         m_iVersion     = 0;
+            bool             m_bTruncated   = false;
+
+            // Last module file read, most reads land in the same one.
+            mutable int      m_iModuleFd    = -1;
+            mutable uint64_t m_iModuleInode = 0;
+    };
+}
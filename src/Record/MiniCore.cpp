@@ -0,0 +1,144 @@
+//=========================================================================
+//                      Mini Core
+//=========================================================================
+// by      : INSANE
+// created : 16/10/2026
+//
+// purpose : Picks the raw memory a crash record keeps with
+//           DeadStopFlag_MiniCore. Crashing stack, pages the registers &
+//           fault address point at, code around each frame, most
+//           important first till the size limit is used up.
+//-------------------------------------------------------------------------
+#include "MiniCore.h"
+#include "../Util/MemoryLock/MemoryLock.h"
+
+
+// Mind this...
+using namespace DeadStop;
+
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+DeadStop::MiniCorePlan_t::MiniCorePlan_t()
+{
+    Reset(nullptr, 0, 0);
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+DEADSTOP_CRASH_PATH
+void DeadStop::MiniCorePlan_t::Reset(MiniCoreRange_t* pStorage, size_t nCapacity, size_t iSizeLimit)
+{
+    m_pRanges       = pStorage;
+    m_nRanges       = 0;
+    m_iCapacity     = pStorage != nullptr ? nCapacity : 0;
+    m_iSizeLimit    = iSizeLimit;
+    m_iPlannedBytes = 0;
+    m_iSkippedBytes = 0;
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+DEADSTOP_CRASH_PATH
+size_t DeadStop::MiniCorePlan_t::Add(uintptr_t iStart, uintptr_t iEnd, uint32_t iKind)
+{
+    size_t iPlanned = 0;
+    while(iStart < iEnd)
+    {
+        // Lowest planned range overlapping what's left, gap before it is new.
+        const MiniCoreRange_t* pOverlap = nullptr;
+        for(size_t iRange = 0; iRange < m_nRanges; iRange++)
+        {
+            const MiniCoreRange_t& range = m_pRanges[iRange];
+            if(range.m_iStart < iEnd && range.m_iEnd > iStart && (pOverlap == nullptr || range.m_iStart < pOverlap->m_iStart))
+                pOverlap = &range;
+        }
+
+        if(pOverlap == nullptr)
+            return iPlanned + Insert(iStart, iEnd, iKind);
+
+        if(pOverlap->m_iStart > iStart)
+            iPlanned += Insert(iStart, pOverlap->m_iStart, iKind);
+
+        iStart = pOverlap->m_iEnd;
+    }
+
+    return iPlanned;
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+DEADSTOP_CRASH_PATH
+size_t DeadStop::MiniCorePlan_t::Insert(uintptr_t iStart, uintptr_t iEnd, uint32_t iKind)
+{
+    size_t iSize = iEnd - iStart;
+    size_t iLeft = m_iSizeLimit - m_iPlannedBytes;
+    if(iSize > iLeft)
+    {
+        m_iSkippedBytes += iSize - iLeft;
+        iSize            = iLeft;
+    }
+
+    if(iSize == 0)
+        return 0;
+
+
+    // Carrying on from the last range ( code window running into the next page ) costs no new one.
+    if(m_nRanges > 0 && m_pRanges[m_nRanges - 1].m_iEnd == iStart && m_pRanges[m_nRanges - 1].m_iKind == iKind)
+    {
+        m_pRanges[m_nRanges - 1].m_iEnd += iSize;
+    }
+    else
+    {
+        if(m_nRanges >= m_iCapacity)
+        {
+            m_iSkippedBytes += iSize;
+            return 0;
+        }
+
+        m_pRanges[m_nRanges++] = { iStart, iStart + iSize, iKind };
+    }
+
+    m_iPlannedBytes += iSize;
+    return iSize;
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+DEADSTOP_CRASH_PATH
+const DeadStop::MiniCoreRange_t* DeadStop::MiniCorePlan_t::GetRanges() const
+{
+    return m_pRanges;
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+DEADSTOP_CRASH_PATH
+size_t DeadStop::MiniCorePlan_t::GetRangeCount() const
+{
+    return m_nRanges;
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+DEADSTOP_CRASH_PATH
+size_t DeadStop::MiniCorePlan_t::GetPlannedBytes() const
+{
+    return m_iPlannedBytes;
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+DEADSTOP_CRASH_PATH
+size_t DeadStop::MiniCorePlan_t::GetSkippedBytes() const
+{
+    return m_iSkippedBytes;
+}
@@ -0,0 +1,69 @@
+//=========================================================================
+//                      Mini Core
+//=========================================================================
+// by      : INSANE
+// created : 16/10/2026
+//
+// purpose : Picks the raw memory a crash record keeps with
+//           DeadStopFlag_MiniCore. Crashing stack, pages the registers &
+//           fault address point at, code around each frame, most
+//           important first till the size limit is used up.
+//-------------------------------------------------------------------------
+#pragma once
+#include "../../Include/Alias.h"
+#include <cstddef>
+#include <cstdint>
+
+
+
+namespace DEADSTOP_NAMESPACE
+{
+    constexpr size_t MINI_CORE_PAGE_SIZE           = 4096;
+    constexpr size_t DEFAULT_MINI_CORE_STACK_SIZE  = 256 * 1024;
+    constexpr size_t DEFAULT_MINI_CORE_SIZE        = 1024 * 1024;
+    constexpr size_t MIN_MINI_CORE_SIZE            = 64 * 1024;
+    constexpr size_t MAX_MINI_CORE_SIZE            = 64 * 1024 * 1024;
+    constexpr size_t MINI_CORE_CHUNK_SIZE          = 16 * 1024; // Memory is read & written this much at a time.
+    constexpr size_t MINI_CORE_STRADDLE_SIZE       = 256;       // Register this close to its page's end takes the next page too.
+
+
+    ///////////////////////////////////////////////////////////////////////////
+    ///////////////////////////////////////////////////////////////////////////
+    struct MiniCoreRange_t
+    {
+        uintptr_t m_iStart;
+        uintptr_t m_iEnd;
+        uint32_t  m_iKind; // RecordMemoryKind_t
+    };
+
+
+    ///////////////////////////////////////////////////////////////////////////
+    ///////////////////////////////////////////////////////////////////////////
+    // Crash path. Ranges are kept in the order they were added, nothing is planned twice. Once the
+    // size limit or range storage runs out, whatever else gets added is only counted.
+    class MiniCorePlan_t
+    {
+        public:
+            MiniCorePlan_t();
+
+            void   Reset(MiniCoreRange_t* pStorage, size_t nCapacity, size_t iSizeLimit);
+
+            // Plans the part of [ iStart, iEnd ) nothing planned covers yet. Returns bytes planned.
+            size_t Add(uintptr_t iStart, uintptr_t iEnd, uint32_t iKind);
+
+            const MiniCoreRange_t* GetRanges()       const;
+            size_t                 GetRangeCount()   const;
+            size_t                 GetPlannedBytes() const;
+            size_t                 GetSkippedBytes() const; // Asked for, but over the limit.
+
+        private:
+            size_t Insert(uintptr_t iStart, uintptr_t iEnd, uint32_t iKind);
+
+            MiniCoreRange_t* m_pRanges       = nullptr;
+            size_t           m_nRanges       = 0;
+            size_t           m_iCapacity     = 0;
+            size_t           m_iSizeLimit    = 0;
+            size_t           m_iPlannedBytes = 0;
+            size_t           m_iSkippedBytes = 0;
+    };
+}
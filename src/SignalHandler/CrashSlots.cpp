@@ -0,0 +1,249 @@
+//=========================================================================
+//                      Crash Slots
+//=========================================================================
+// by      : INSANE
+// created : 16/10/2026
+//
+// purpose : Per thread crash records & leader election, for when more than
+//           one thread crashes at the same time.
+//-------------------------------------------------------------------------
+#include "CrashSlots.h"
+#include "../AltStack/AltStack.h"
+#include "../Util/Arena/CrashArena.h"
+#include "../Util/SafeRead/SafeRead.h"
+#include "../Util/MemoryLock/MemoryLock.h"
+#include <new>
+#include <time.h>
+
+
+// Mind this...
+using namespace DeadStop;
+
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+bool DeadStop::CrashSlotTable_t::Initialize(CrashArena_t& arena)
+{
+    m_pSlots = arena.AllocateArray<CrashSlot_t>(MAX_CRASH_SLOTS);
+    if(m_pSlots == nullptr)
+        return false;
+
+    for(size_t iSlotIndex = 0; iSlotIndex < MAX_CRASH_SLOTS; iSlotIndex++)
+    {
+        CrashSlot_t* pSlot = new(&m_pSlots[iSlotIndex]) CrashSlot_t();
+        pSlot->m_iState.store(CrashSlotState_Free, std::memory_order_relaxed);
+        pSlot->m_iThreadID.store(0, std::memory_order_relaxed);
+        pSlot->m_nFrames   = 0;
+    }
+
+    m_iLeaderThreadID.store(0, std::memory_order_relaxed);
+    m_bLeaderDone.store(false, std::memory_order_relaxed);
+    m_nDropped.store(0, std::memory_order_relaxed);
+    return true;
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+void DeadStop::CrashSlotTable_t::Release()
+{
+    // Memory belongs to the arena.
+    m_pSlots = nullptr;
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+DEADSTOP_CRASH_PATH
+CrashSlot_t* DeadStop::CrashSlotTable_t::Claim(pid_t iThreadID, bool& bAlreadyCrashed)
+{
+    bAlreadyCrashed = false;
+    if(m_pSlots == nullptr)
+        return nullptr;
+
+
+    // Thread IDs are only written by the thread that claimed the slot, before it publishes anything
+    // else. So a slot holding our ID can only mean we claimed it, & we are back in here.
+    for(size_t iSlotIndex = 0; iSlotIndex < MAX_CRASH_SLOTS; iSlotIndex++)
+    {
+        CrashSlot_t& slot = m_pSlots[iSlotIndex];
+        if(slot.m_iState.load(std::memory_order_acquire) != CrashSlotState_Free && slot.m_iThreadID.load(std::memory_order_relaxed) == iThreadID)
+        {
+            bAlreadyCrashed = true;
+            return nullptr;
+        }
+    }
+
+
+    for(size_t iSlotIndex = 0; iSlotIndex < MAX_CRASH_SLOTS; iSlotIndex++)
+    {
+        CrashSlot_t& slot     = m_pSlots[iSlotIndex];
+        int          iExpected = CrashSlotState_Free;
+        if(slot.m_iState.compare_exchange_strong(iExpected, CrashSlotState_Claimed, std::memory_order_acq_rel) == true)
+        {
+            slot.m_iThreadID.store(iThreadID, std::memory_order_relaxed);
+            return &slot;
+        }
+    }
+
+
+    m_nDropped.fetch_add(1, std::memory_order_relaxed);
+    return nullptr;
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+DEADSTOP_CRASH_PATH
+void DeadStop::CrashSlotTable_t::CaptureAndPublish(CrashSlot_t& slot, int iSignalID, const siginfo_t* pSigInfo, const ucontext_t* pContext)
+{
+    slot.m_iSignalID   = iSignalID;
+    slot.m_iSignalCode = pSigInfo != nullptr ? pSigInfo->si_code : 0;
+    slot.m_iFaultAdrs  = pSigInfo != nullptr ? reinterpret_cast<uintptr_t>(pSigInfo->si_addr) : 0;
+    slot.m_nFrames     = 0;
+
+    for(int iReg = 0; iReg < __NGREG; iReg++)
+        slot.m_gregs[iReg] = pContext != nullptr ? pContext->uc_mcontext.gregs[iReg] : 0;
+
+
+    if(pContext != nullptr)
+    {
+        slot.m_iFrames[slot.m_nFrames++] = static_cast<uintptr_t>(slot.m_gregs[REG_RIP]);
+
+
+        // Plain rBP chain. Cheap & good enough for a secondary record, full analysis is the leader's job.
+        // Frames must stay on this thread's stack & keep going up, else chain is broken.
+        const ThreadStackInfo_t* pStackInfo = GetThisThreadStackInfo();
+        uintptr_t iStackLow  = pStackInfo->m_iStackLow  != 0 ? pStackInfo->m_iStackLow  : static_cast<uintptr_t>(slot.m_gregs[REG_RSP]);
+        uintptr_t iStackHigh = pStackInfo->m_iStackHigh != 0 ? pStackInfo->m_iStackHigh : UINTPTR_MAX;
+        uintptr_t iFrame     = static_cast<uintptr_t>(slot.m_gregs[REG_RBP]);
+
+        while(slot.m_nFrames < static_cast<int>(MAX_SLOT_FRAMES))
+        {
+            if(iFrame < iStackLow || iFrame >= iStackHigh || (iFrame & 0x7) != 0)
+                break;
+
+            uintptr_t frame[2] = { 0, 0 }; // { saved rBP, return address }
+            if(SafeRead(frame, iFrame, sizeof(frame)) != sizeof(frame) || frame[1] == 0)
+                break;
+
+            slot.m_iFrames[slot.m_nFrames++] = frame[1];
+
+            if(frame[0] <= iFrame)
+                break;
+
+            iFrame = frame[0];
+        }
+    }
+
+
+    slot.m_iState.store(CrashSlotState_Published, std::memory_order_release);
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+DEADSTOP_CRASH_PATH
+bool DeadStop::CrashSlotTable_t::TryBecomeLeader(pid_t iThreadID)
+{
+    pid_t iExpected = 0;
+    return m_iLeaderThreadID.compare_exchange_strong(iExpected, iThreadID, std::memory_order_acq_rel);
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+DEADSTOP_CRASH_PATH
+pid_t DeadStop::CrashSlotTable_t::GetLeader() const
+{
+    return m_iLeaderThreadID.load(std::memory_order_acquire);
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+DEADSTOP_CRASH_PATH
+void DeadStop::CrashSlotTable_t::WaitForFollowers(uint64_t iTimeoutNs) const
+{
+    if(m_pSlots == nullptr)
+        return;
+
+
+    // Followers only do a short walk, they should be done long before the leader is. 
+    constexpr uint64_t POLL_INTERVAL_NS = 1000 * 1000;
+    for(uint64_t iWaited = 0; iWaited < iTimeoutNs; iWaited += POLL_INTERVAL_NS)
+    {
+        bool bAnyCapturing = false;
+        for(size_t iSlotIndex = 0; iSlotIndex < MAX_CRASH_SLOTS; iSlotIndex++)
+        {
+            if(m_pSlots[iSlotIndex].m_iState.load(std::memory_order_acquire) == CrashSlotState_Claimed &&
+                    m_pSlots[iSlotIndex].m_iThreadID.load(std::memory_order_relaxed) != GetLeader())
+            {
+                bAnyCapturing = true;
+                break;
+            }
+        }
+
+        if(bAnyCapturing == false)
+            return;
+
+        timespec pollInterval = { 0, static_cast<long>(POLL_INTERVAL_NS) };
+        nanosleep(&pollInterval, nullptr);
+    }
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+DEADSTOP_CRASH_PATH
+void DeadStop::CrashSlotTable_t::MarkLeaderDone()
+{
+    m_bLeaderDone.store(true, std::memory_order_seq_cst);
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+DEADSTOP_CRASH_PATH
+bool DeadStop::CrashSlotTable_t::IsLeaderDone() const
+{
+    return m_bLeaderDone.load(std::memory_order_seq_cst);
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+DEADSTOP_CRASH_PATH
+bool DeadStop::CrashSlotTable_t::TakeForWriting(CrashSlot_t& slot)
+{
+    int iExpected = CrashSlotState_Published;
+    return slot.m_iState.compare_exchange_strong(iExpected, CrashSlotState_Written, std::memory_order_acq_rel);
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+DEADSTOP_CRASH_PATH
+CrashSlot_t* DeadStop::CrashSlotTable_t::GetSlot(size_t iIndex)
+{
+    return m_pSlots != nullptr && iIndex < MAX_CRASH_SLOTS ? &m_pSlots[iIndex] : nullptr;
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+DEADSTOP_CRASH_PATH
+size_t DeadStop::CrashSlotTable_t::GetSlotCount() const
+{
+    return m_pSlots != nullptr ? MAX_CRASH_SLOTS : 0;
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+DEADSTOP_CRASH_PATH
+size_t DeadStop::CrashSlotTable_t::GetDroppedCount() const
+{
+    return m_nDropped.load(std::memory_order_relaxed);
+}
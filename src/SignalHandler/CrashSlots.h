@@ -0,0 +1,96 @@
+//=========================================================================
+//                      Crash Slots
+//=========================================================================
+// by      : INSANE
+// created : 16/10/2026
+//
+// purpose : Per thread crash records & leader election, for when more than
+//           one thread crashes at the same time.
+//-------------------------------------------------------------------------
+#pragma once
+#include "../../Include/Alias.h"
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <signal.h>
+#include <ucontext.h>
+#include <sys/types.h>
+
+
+
+namespace DEADSTOP_NAMESPACE
+{
+    class CrashArena_t;
+
+    constexpr size_t MAX_CRASH_SLOTS = 32; // Threads crashing at once beyond this are only counted.
+    constexpr size_t MAX_SLOT_FRAMES = 32; // Frame pointer chain depth kept for each follower.
+
+
+    ///////////////////////////////////////////////////////////////////////////
+    ///////////////////////////////////////////////////////////////////////////
+    enum CrashSlotState_t : int
+    {
+        CrashSlotState_Free = 0,
+        CrashSlotState_Claimed,    // Thread is capturing its record.
+        CrashSlotState_Published,  // Record is complete, waiting to be written.
+        CrashSlotState_Written,
+    };
+
+
+    ///////////////////////////////////////////////////////////////////////////
+    ///////////////////////////////////////////////////////////////////////////
+    struct CrashSlot_t
+    {
+        std::atomic<int>   m_iState;
+        std::atomic<pid_t> m_iThreadID;
+        int                m_iSignalID;
+        int                m_iSignalCode;
+        uintptr_t          m_iFaultAdrs;
+        greg_t             m_gregs[__NGREG];
+        uintptr_t          m_iFrames[MAX_SLOT_FRAMES];
+        int                m_nFrames;
+    };
+
+
+    ///////////////////////////////////////////////////////////////////////////
+    ///////////////////////////////////////////////////////////////////////////
+    // First thread to crash becomes the leader & writes the full report. Everyone after that
+    // only captures context + a frame pointer walk into their own slot, which the leader appends
+    // to the same dump. Nothing here ever takes a lock.
+    class CrashSlotTable_t
+    {
+        public:
+            bool         Initialize(CrashArena_t& arena);
+            void         Release();
+
+            // nullptr if every slot is taken. Thread that already owns a slot gets nullptr too & 
+            // bAlreadyCrashed set, that means we crashed inside our own handler.
+            CrashSlot_t* Claim(pid_t iThreadID, bool& bAlreadyCrashed);
+
+            // Fill slot from signal info & context, & walk rBP chain with safe reads. Then publish.
+            void         CaptureAndPublish(CrashSlot_t& slot, int iSignalID, const siginfo_t* pSigInfo, const ucontext_t* pContext);
+
+            bool         TryBecomeLeader(pid_t iThreadID);
+            pid_t        GetLeader() const;
+
+            // Leader : wait ( bounded ) for followers that are still capturing.
+            void         WaitForFollowers(uint64_t iTimeoutNs) const;
+
+            // Leader marks its report as done, followers that show up after this write their own record.
+            void         MarkLeaderDone();
+            bool         IsLeaderDone() const;
+
+            // Exactly one caller gets true per published slot.
+            bool         TakeForWriting(CrashSlot_t& slot);
+
+            CrashSlot_t* GetSlot(size_t iIndex);
+            size_t       GetSlotCount()     const;
+            size_t       GetDroppedCount()  const; // Crashed, but found no free slot.
+
+        private:
+            CrashSlot_t*        m_pSlots = nullptr;
+            std::atomic<pid_t>  m_iLeaderThreadID{0};
+            std::atomic<bool>   m_bLeaderDone{false};
+            std::atomic<size_t> m_nDropped{0};
+    };
+}
@@ -11,12 +11,15 @@
 #include "../DeadStopImpl.h"
 
 #include <cstring>
-#include <iomanip>
-#include <iostream>
-#include <fstream>
-#include <string>
 #include <vector>
-#include <deque>
+#include <fcntl.h>
+#include <unistd.h>
+#include <time.h>
+#include <errno.h>
+#include <sys/syscall.h>
+#include <sched.h>
+#include <atomic>
+#include <new>
 
 // Disassembler.
 #include "../../lib/IDASM/Include/INSANE_DisassemblerAMD64.h"
@@ -28,7 +31,25 @@
 // Utility
 #include "../Util/Assertion/Assertion.h"
 #include "../Util/Terminal/Terminal.h"
+#include "../Util/Writer/Writer.h"
+#include "../Util/Arena/CrashArena.h"
+#include "../Util/SafeRead/SafeRead.h"
+#include "../Util/MemoryLock/MemoryLock.h"
+#include "../Util/Compressor/Compressor.h"
+#include "../Decoder/CodeWindow.h"
+#include "../Decoder/InstForm.h"
+#include "../Unwind/Unwinder.h"
+#include "../Unwind/StackEffect.h"
+#include "../Unwind/PlanCache.h"
+#include "../Unwind/ReturnPath.h"
+#include "CrashSlots.h"
+#include "../AltStack/AltStack.h"
 #include "../Defs/MemRegion_t.h"
+#include "../Fiber/FiberRegistry.h"
+#include "../Jit/JitRegistry.h"
+#include "../Record/CrashRecord.h"
+#include "../Record/MiniCore.h"
+#include "../DumpSlab/DumpSlab.h"
 
 
 // Mind this...
@@ -40,11 +61,35 @@ using namespace DeadStop;
 ///////////////////////////////////////////////////////////////////////////
 namespace DEADSTOP_NAMESPACE
 {
+    // GetReturnAdrs() takes a frame's registers ( rIP in DwarfReg_RA ) & turns them into its caller's.
     struct StackFrame_t
     {
-        greg_t m_rSP = 0;
-        greg_t m_rBP = 0;
+        DwarfRegs_t m_regs;
+        bool        m_bFramePointer = false; // Set by GetReturnAdrs() when it found a normal stack frame.
     };
+
+
+    struct CallStack_t
+    {
+        uintptr_t m_iFrames [MAX_CALL_STACK_DEPTH + 1]; // +1 for the crash location itself.
+        uint8_t   m_iMethods[MAX_CALL_STACK_DEPTH + 1]; // UnwindMethod_t each frame was found with.
+        int       m_nFrames = 0;
+        uint64_t  m_iUnwindTimeNs = 0;
+        size_t    m_nCachedPlans  = 0; // Frames stepped with a plan from the unwind plan cache.
+        uintptr_t m_iUnknownAdrs  = 0; // Return address Analyze() stopped at, that no mapped region holds.
+
+        uintptr_t Back() const { return m_iFrames[m_nFrames - 1]; }
+        bool      Push(uintptr_t iAdrs, UnwindMethod_t iMethod = UnwindMethod_None)
+        {
+            if(m_nFrames >= MAX_CALL_STACK_DEPTH + 1) 
+                return false; 
+
+            m_iFrames[m_nFrames] = iAdrs; m_iMethods[m_nFrames] = iMethod; m_nFrames++;
+            return true;
+        }
+    };
+
+
 }
 
 
@@ -52,171 +97,650 @@ namespace DEADSTOP_NAMESPACE
 ///////////////////////////////////////////////////////////////////////////
 namespace DEADSTOP_NAMESPACE
 {
-    // Global vars...
+    // Global vars... Only the leader thread ( see CrashSlotTable_t ) ever touches these.
     MemRegionHandler_t g_memRegionHandler;
     siginfo_t*         g_pSigInfo = nullptr;
     ucontext_t*        g_pContext = nullptr;
 
 
+    // Threads that crash while the leader is writing its report.
+    static CrashSlotTable_t s_crashSlots;
+    static constexpr uint64_t FOLLOWER_WAIT_NS = 100ull * 1000 * 1000;       // Leader waits this long for followers to publish.
+    static constexpr uint64_t LEADER_WAIT_NS   = 30ull * 1000 * 1000 * 1000; // Followers give up on the leader after this.
+
+
+    // Stack captures run side by side, each on its own call stack & code window. All they share is the
+    // g_memRegionHandler snapshot ( & the lock free unwind caches ). Captures count themselves in while
+    // s_iMapsSequence is even, whoever reloads the snapshot makes it odd first & waits for them to leave.
+    // Crash leader reloads it too, & takes it over from a capture that won't let go in time.
+    static std::atomic<uint32_t> s_iMapsSequence(0);
+    static std::atomic<int>      s_nActiveCaptures(0);
+    static std::atomic<bool>     s_bCapturesOpen(false);  // See OpenCaptures() & CloseCaptures().
+    static std::atomic<pid_t>    s_iMapsWriter(0);        // Thread ID of whoever made s_iMapsSequence odd.
+    static thread_local int      t_nCaptureDepth = 0;     // Captures this thread is inside of, signal handlers can nest them.
+    static constexpr uint64_t    CAPTURE_WAIT_NS          = 10ull * 1000 * 1000; // Captures give up on a maps reload after this.
+    static constexpr size_t      CAPTURE_CODE_WINDOW_SIZE = 1024;                // Each capture's code window, on its own stack.
+    static bool                  s_bCaptureMapsLoaded     = false;               // g_memRegionHandler holds a snapshot captures can use.
+
+    // Captured frames carry UnwindMethod_t as is.
+    static_assert(static_cast<int>(DeadStopUnwind_JitFrame) == static_cast<int>(UnwindMethod_JitFrame), "DeadStopUnwindMethod_t out of sync with UnwindMethod_t");
+
+
+    // Everything the crash path writes to. Carved from the crash arena at initialization, 
+    // nothing in here is allocated at crash time.
+    static constexpr size_t OUTPUT_BUFFER_SIZE   = 64 * 1024;
+    static constexpr size_t DASM_BUFFER_SIZE     = 16 * 1024; // per DumpAssembly() call, released after.
+    static constexpr size_t DASM_BATCH_SIZE      = 200;       // Decoder buffers are never sized below this.
+    static constexpr size_t MAX_STRING_DUMP_SIZE = 256;       // String dumps are read into a stack buffer this big.
+    static constexpr size_t MIN_CODE_WINDOW_SIZE = 4 * 1024;  // Code is read this much at a time, see CodeWindow_t.
+    static constexpr size_t MAPS_LINE_SIZE       = 128;       // Roomy average of a /proc/self/maps line, paths included.
+    static constexpr size_t MAX_MINI_CORE_RANGES = 2 * MAX_CALL_STACK_DEPTH + 32; // Code around every frame, stack & registers.
+    struct CrashResources_t
+    {
+        CrashArena_t*     m_pArena            = nullptr;
+        char*             m_pOutputBuffer     = nullptr;
+        void*             m_pRegionStorage    = nullptr; // Regions + their search index, see MemRegionHandler_t::SetStorage().
+        size_t            m_iRegionMemSize    = 0;
+        char*             m_pMapsText         = nullptr; // /proc/self/maps is read into this once, regions point into it.
+        size_t            m_iMapsTextSize     = 0;
+        CallStack_t*      m_pCallStack        = nullptr;
+        ArenaAllocator_t* m_pDecoderAllocator = nullptr; // Decoder's own arenas, warmed up at initialization.
+        CodeWindow_t      m_codeWindow;                  // All code we decode is read through this.
+        Compressor_t      m_compressor;                  // Dump output goes through this with DeadStopFlag_Compress.
+        MiniCorePlan_t    m_miniCore;                    // Memory a mini core keeps, see DeadStopFlag_MiniCore.
+        MiniCoreRange_t*  m_pMiniCoreRanges   = nullptr; // nullptr without a mini core, records keep the usual slices then.
+        size_t            m_iMiniCoreStack    = 0;       // Limits, see DeadStop_SetMiniCoreLimits().
+        size_t            m_iMiniCoreSize     = 0;
+        size_t            m_nDecodeCalls      = 0;
+        size_t            m_nDasmCalls        = 0;
+
+        // Settings the report is written with. DeadStop's own, or the record's while rendering one.
+        int               m_iAsmDumpRange     = 0;
+        int               m_iStringDumpSize   = 0;
+        int               m_iSignatureSize    = 0;
+
+        // Decoder only takes std::vectors. These are reserved for the worst case at initialization
+        // & only ever cleared, so they never reallocate while crashing. m_vecBytes is just a staging
+        // copy of a CodeSpan_t, filled in one go by DecodeSpan().
+        std::vector<InsaneDASM64::Byte>          m_vecBytes;
+        std::vector<InsaneDASM64::Instruction_t> m_vecInst;
+        std::vector<InsaneDASM64::DASMInst_t>    m_vecDasmInst;
+        size_t                                   m_iReservedInst = 0;
+        size_t                                   m_iPeakInst     = 0;
+    };
+    static CrashResources_t s_crash;
+
+
     // Table to get ModRM.RM or ModRM.Reg to ucontext_t register index.
     static int s_regIndexToEnum[] = { REG_RAX, REG_RCX, REG_RDX, REG_RBX, REG_RBP, REG_RSI, REG_RDI, 
         REG_R8, REG_R9, REG_R10, REG_R11, REG_R12, REG_R13, REG_R14, REG_R15 };
 
 
+    // Whatever the general registers point at is worth keeping in records. rSP is the stack itself.
+    static const int s_iPointerRegs[] = { REG_RAX, REG_RBX, REG_RCX, REG_RDX, REG_RSI, REG_RDI, REG_RBP,
+        REG_R8, REG_R9, REG_R10, REG_R11, REG_R12, REG_R13, REG_R14, REG_R15 };
+    static constexpr uintptr_t STACK_RED_ZONE_SIZE = 128;
+
+
+    // Record being rendered, process memory is read from it instead. nullptr while running for real.
+    static const CrashRecordReader_t* s_pRenderRecord = nullptr;
+
+
     // Generate formatted assembly instructions around a memory address.
-    static bool DumpAssembly(std::fstream& hFile, uintptr_t pPivotLocation, int iAsmDumpRangeInBytes, const char* szRipMsg = nullptr);
+    static bool DumpAssembly(Writer_t& hFile, uintptr_t pPivotLocation, int iAsmDumpRangeInBytes, const char* szRipMsg = nullptr);
     static bool GenerateDasmOutput( // This is a internal function used by DumpAssembly ( above ).
-            std::stringstream& ssOut, uintptr_t iStartAdrs, const std::vector<InsaneDASM64::Byte>& vecBytes, uintptr_t pCrashLocation, const char* szRipMsg);
+            Writer_t& ssOut, const CodeSpan_t& codeSpan, uintptr_t pCrashLocation, const char* szRipMsg);
+    static InsaneDASM64::IDASMErrorCode_t DecodeSpan     (const CodeSpan_t& codeSpan, ArenaAllocator_t& allocator);
+    static InsaneDASM64::IDASMErrorCode_t DisassembleSpan(const CodeSpan_t& codeSpan, ArenaAllocator_t& allocator);
     static bool MakeSignature(
-            std::stringstream& sigOut, const std::vector<InsaneDASM64::Instruction_t>& vecInst, size_t iStartIndex, size_t iSignatureSizeInBytes);
+            Writer_t& sigOut, const std::vector<InsaneDASM64::Instruction_t>& vecInst, size_t iStartIndex, size_t iSignatureSizeInBytes);
 
     static void* GetPointerFromModrm(InsaneDASM64::Instruction_t& inst, uintptr_t iStartAdrs);
     static void* GetPointerFromModrm(InsaneDASM64::Legacy::LegacyInst_t* pLegacyInst, uintptr_t iStartAdrs);
+    static size_t ReadCrashMemory(void* pDest, uintptr_t iSrcAdrs, size_t iSize);
 
     // Call stack analysis.
-    static bool Analyze(std::vector<uintptr_t>& vecCallStack);
-    static bool WriteFnChainToFile(std::fstream& hFile, const std::vector<uintptr_t>& vecCallStack);
-    static uintptr_t GetReturnAdrs(uintptr_t iStartPos, ArenaAllocator_t& allocator, StackFrame_t& iStackFrame);
+    static bool Analyze(CallStack_t& callStack, CodeWindow_t& codeWindow, const DwarfRegs_t& startRegs, int iMaxDepth, bool bLiveStack = true);
+    static bool WriteFnChainToFile(Writer_t& hFile, const CallStack_t& callStack);
+    static void WriteJitName(Writer_t& hFile, uintptr_t iAdrs, bool bReturnAdrs);
+    static uintptr_t GetReturnAdrs(CodeWindow_t& codeWindow, uintptr_t iStartPos, bool bExactPC, StackFrame_t& stackFrame);
 
     // String Utility.
-    static bool CaseInsensitiveStringMatch(const char* szString1, const char* szString2);
     static bool IsCharPrintable(char c);
 
     // Write to File.
-    static void WriteSelfMaps       (std::fstream& hFile);
-    static void DumpGeneralRegisters(std::fstream& hFile);
-    static void DumpDateTime        (std::fstream& hFile);
-    static void DoBranding          (std::fstream& hFile);
-    static void StartBanner         (std::fstream& hFile, const char* szMsg);
-    static void EndBanner           (std::fstream& hFile, const char* szMsg);
+    static bool WriteTextReport     (Writer_t& hFile, int iSignalID, pid_t iThreadID, uint64_t iCrashFiberID, int64_t iStartTime, uint64_t iHandlerStartTime);
+    static bool WriteReportPrologue (Writer_t& hFile, int iSignalID, pid_t iThreadID, uint64_t iCrashFiberID, int64_t iStartTime);
+    static void WriteSelfMaps       (Writer_t& hFile);
+    static void DumpFaultInfo       (Writer_t& hFile, int iSignalID, const ThreadStackInfo_t& stackInfo, bool bOnAltStack);
+    static void DumpGeneralRegisters(Writer_t& hFile);
+    static void DumpDateTime        (Writer_t& hFile, int64_t iLocalTime);
+    static void DoBranding          (Writer_t& hFile);
+    static bool OpenDump            (Writer_t& hFile, char* pBuffer, size_t iBufferSize, int& iFdOut, DumpSlabClaim_t& slabClaimOut);
+    static void CloseDump           (Writer_t& hFile, int iFd, const DumpSlabClaim_t& slabClaim);
+    static void StartBanner         (Writer_t& hFile, const char* szMsg);
+    static void EndBanner           (Writer_t& hFile, const char* szMsg);
+
+    // Time.
+    static uint64_t GetMonotonicTimeInNs();
+    static int64_t  GetLocalTime();
+
+    // Crash memory.
+    static void WriteMemoryUsage(Writer_t& hFile);
+    static void NoteDecoderUsage();
+
+    // Stack captures.
+    static ErrCodes_t EnterCapture(pid_t iThreadID, uint32_t& iMapsSequenceOut);
+    static void       LeaveCapture();
+    static ErrCodes_t ReloadCaptureMaps(pid_t iThreadID, uint32_t& iMapsSequence);
+    static bool       BeginMapsReload(pid_t iThreadID, uint64_t iTimeoutNs, bool bForce, uint32_t* pPrevSequenceOut);
+    static void       EndMapsReload(pid_t iThreadID);
+    static bool       LoadCaptureMaps();
+
+    // Crash snapshot, shared by the text report & binary records.
+    static bool LoadCrashMaps();
+    static void UnwindCrashStack();
+    static bool IsHandlerOnAltStack(const ThreadStackInfo_t& stackInfo);
+
+    // Simultaneous crashes.
+    [[noreturn]] static void HandleFollowerCrash(CrashSlot_t* pSlot, int iSignalID, siginfo_t* pSigInfo, ucontext_t* pContext);
+    static void WriteFollowerRecords(Writer_t& hFile, RecordWriter_t* pRecord);
+    static void WriteCrashSlot      (Writer_t& hFile, const CrashSlot_t& slot);
+    static const char* GetSignalName(int iSignalID);
+
+
+    // Registered fibers, other than the one we crashed on.
+    static void WriteFiberStacks (Writer_t& hFile, uint64_t iCrashFiberID, RecordWriter_t* pRecord);
+    static void WriteFiberStack  (Writer_t& hFile, const FiberInfo_t& fiber, const CallStack_t* pCallStack);
+    static void WriteFiberSummary(Writer_t& hFile, int nUnwound, uint64_t iUnwindTimeNs, size_t nSkipped);
+
+
+    // Binary records ( DeadStopFlag_BinaryRecord ). Sections mirror the text report's.
+    static bool WriteCrashRecord (Writer_t& hFile, int iSignalID, pid_t iThreadID, uint64_t iCrashFiberID, int64_t iStartTime, uint64_t iHandlerStartTime);
+    static void RecordCallStack  (RecordWriter_t& record, const CallStack_t& callStack);
+    static void RecordFrames     (RecordWriter_t& record, const CallStack_t& callStack);
+    static void RecordCode       (RecordWriter_t& record, const CallStack_t& callStack);
+    static void RecordStackMemory(RecordWriter_t& record);
+    static void RecordMiniCore   (RecordWriter_t& record, const CallStack_t& callStack, int iSignalID, size_t iRoom);
+    static size_t GetRecordTailSize();
+    static void PlanMiniCorePages(MiniCorePlan_t& plan, uintptr_t iAdrs, RecordMemoryKind_t iKind);
+    static uintptr_t GetCrashStackHigh(uintptr_t iRSP);
+    static void RecordJitCode    (RecordWriter_t& record, const CallStack_t& callStack);
+    static void RecordMemory     (RecordWriter_t& record, RecordMemoryKind_t iKind, uintptr_t iAdrs, const void* pBytes, size_t iSize);
+    static void RecordCrashSlot  (RecordWriter_t& record, const CrashSlot_t& slot);
+    static void RecordFiberStack (RecordWriter_t& record, const FiberInfo_t& fiber, const CallStack_t* pCallStack);
+    static void EndRecord        (RecordWriter_t& record, uint64_t iHandlerStartTime);
+
+    // Offline, record -> text report.
+    static size_t RenderRecords         (Writer_t& hFile, const uint8_t* pData, size_t iSize, bool bAllowTruncated);
+    static bool   WriteSkippedBytes     (Writer_t& hFile, const uint8_t* pData, size_t iSize);
+    static void   RenderRecord          (Writer_t& hFile, const CrashRecordReader_t& record);
+    static void   LoadRecordedRegions   (const CrashRecordReader_t& record, const RecordCrash_t& crash);
+    static void   LoadRecordedFrames    (CallStack_t& callStack, const uint8_t* pFrames, size_t nFrames);
+    static void   WriteRecordedFollowers(Writer_t& hFile, const CrashRecordReader_t& record);
+    static void   WriteRecordedFibers   (Writer_t& hFile, const CrashRecordReader_t& record);
+    static void   WriteRecordedMiniCore (Writer_t& hFile, const CrashRecordReader_t& record);
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+bool DeadStop::PrepareCrashPath(CrashArena_t& arena, int iMaxAsmDumpRange)
+{
+    s_crash.m_pArena = &arena;
+
+    const DeadStop_t& deadStop = DeadStop_t::GetInstance();
+    s_crash.m_iAsmDumpRange    = deadStop.GetAsmDumpRange();
+    s_crash.m_iStringDumpSize  = deadStop.GetStringDumpSize();
+    s_crash.m_iSignatureSize   = deadStop.GetSignatureSize();
+
+    // Every crash time read goes through this.
+    InitializeSafeRead();
+
+
+    // Persistent buffers, these live for the whole crash.
+    s_crash.m_pOutputBuffer     = arena.AllocateArray<char>(OUTPUT_BUFFER_SIZE);
+    s_crash.m_pCallStack        = arena.AllocateArray<CallStack_t>(1);
+    void* pDecoderAllocatorMem  = arena.Allocate(sizeof(ArenaAllocator_t), alignof(ArenaAllocator_t));
+    if(s_crash.m_pOutputBuffer == nullptr || s_crash.m_pCallStack == nullptr || pDecoderAllocatorMem == nullptr)
+        return false;
+
+    new(s_crash.m_pCallStack) CallStack_t();
+
+    if(s_crashSlots.Initialize(arena) == false)
+        return false;
+    s_crash.m_pDecoderAllocator = new(pDecoderAllocatorMem) ArenaAllocator_t(8 * 1024); // 8 KiB arenas.
+
+
+    // Region table gets a quarter of the whole budget. Rest is left for the per phase scratch buffers.
+    s_crash.m_iRegionMemSize  = arena.GetCapacity() / 4;
+    s_crash.m_pRegionStorage  = arena.Allocate(s_crash.m_iRegionMemSize, alignof(MemRegion_t));
+    if(s_crash.m_pRegionStorage == nullptr)
+        return false;
+
+    // Maps text gets another quarter, ~100 bytes a line. See GetCrashMemoryBudget().
+    s_crash.m_iMapsTextSize = arena.GetCapacity() / 4;
+    s_crash.m_pMapsText     = arena.AllocateArray<char>(s_crash.m_iMapsTextSize);
+    if(s_crash.m_pMapsText == nullptr)
+        return false;
+
+
+    // Code window must hold a whole dump range ( both sides of the pivot ) in one read.
+    size_t iCodeWindowSize = static_cast<size_t>(iMaxAsmDumpRange) * 2;
+    if(iCodeWindowSize < MIN_CODE_WINDOW_SIZE)
+        iCodeWindowSize = MIN_CODE_WINDOW_SIZE;
+
+    uint8_t* pCodeWindow = arena.AllocateArray<uint8_t>(iCodeWindowSize);
+    if(pCodeWindow == nullptr)
+        return false;
+    s_crash.m_codeWindow.SetStorage(pCodeWindow, iCodeWindowSize);
+
+
+    // Phase scratch must fit at least one DumpAssembly() call.
+    if(arena.GetCapacity() - arena.GetUsed() < DASM_BUFFER_SIZE)
+        return false;
+
+
+    // Compressor is fixed size, it goes first. Dumps are still written without it.
+    if((deadStop.GetFlags() & DeadStopFlag_Compress) != 0)
+    {
+        if(arena.GetCapacity() - arena.GetUsed() < DASM_BUFFER_SIZE + Compressor_t::GetMemorySize() || s_crash.m_compressor.Initialize(arena) == false)
+            LOG("No room for the compressor, dumps will be written uncompressed.");
+    }
+
+
+    // Mini core's range list, its memory is read a chunk at a time out of phase scratch. Records keep
+    // the usual slices without it.
+    s_crash.m_iMiniCoreStack = deadStop.GetMiniCoreStackSize();
+    s_crash.m_iMiniCoreSize  = deadStop.GetMiniCoreSize();
+    if((deadStop.GetFlags() & DeadStopFlag_MiniCore) != 0)
+    {
+        if(arena.GetCapacity() - arena.GetUsed() >= DASM_BUFFER_SIZE + MAX_MINI_CORE_RANGES * sizeof(MiniCoreRange_t))
+            s_crash.m_pMiniCoreRanges = arena.AllocateArray<MiniCoreRange_t>(MAX_MINI_CORE_RANGES);
+
+        if(s_crash.m_pMiniCoreRanges == nullptr)
+            LOG("No room for the mini core, records will keep only the usual stack & code slices.");
+    }
+
+
+    // Worst case byte count we ever feed the decoder, & worst case instruction count ( 1 byte per inst. ).
+    size_t iMaxBytes = static_cast<size_t>(iMaxAsmDumpRange) * 2;
+    if(iMaxBytes < DASM_BATCH_SIZE)
+        iMaxBytes = DASM_BATCH_SIZE;
+
+    s_crash.m_vecBytes.reserve(iMaxBytes);
+    s_crash.m_vecInst.reserve(iMaxBytes);
+    s_crash.m_vecDasmInst.reserve(iMaxBytes);
+    s_crash.m_iReservedInst = iMaxBytes;
+    s_crash.m_iPeakInst     = 0;
+
+
+    // Warm up, so the decoder's arenas are already grown to the worst case instruction count.
+    s_crash.m_vecBytes.assign(iMaxBytes, 0x90); // NOPs
+    if(InsaneDASM64::Decode(s_crash.m_vecBytes, s_crash.m_vecInst, *s_crash.m_pDecoderAllocator) == InsaneDASM64::IDASMErrorCode_Success)
+        InsaneDASM64::Disassemble(s_crash.m_vecInst, s_crash.m_vecDasmInst);
+
+    s_crash.m_vecBytes.clear(); s_crash.m_vecInst.clear(); s_crash.m_vecDasmInst.clear();
+    s_crash.m_pDecoderAllocator->ResetAllArena();
+
+
+    return true;
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+size_t DeadStop::GetCrashMemoryBudget(size_t nMapsLines)
+{
+    // Region table & maps text get a quarter of the arena each, see PrepareCrashPath().
+    size_t iRegionMemSize = nMapsLines * MemRegionHandler_t::STORAGE_PER_REGION + sizeof(uintptr_t) + sizeof(uint32_t);
+    size_t iMapsTextSize  = nMapsLines * MAPS_LINE_SIZE;
+    return 4 * (iRegionMemSize > iMapsTextSize ? iRegionMemSize : iMapsTextSize);
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+bool DeadStop::LockCrashPath(MemoryLock_t& memoryLock)
+{
+    bool bAllLocked = true;
+
+    // Arena holds the output buffer, region tables, maps text & code window.
+    bAllLocked &= memoryLock.LockRange(s_crash.m_pArena->GetBase(), s_crash.m_pArena->GetCapacity());
+
+    // Decoder's input / output buffers live on the heap.
+    bAllLocked &= memoryLock.LockRange(s_crash.m_vecBytes.data(),    s_crash.m_vecBytes.capacity()    * sizeof(InsaneDASM64::Byte));
+    bAllLocked &= memoryLock.LockRange(s_crash.m_vecInst.data(),     s_crash.m_vecInst.capacity()     * sizeof(InsaneDASM64::Instruction_t));
+    bAllLocked &= memoryLock.LockRange(s_crash.m_vecDasmInst.data(), s_crash.m_vecDasmInst.capacity() * sizeof(InsaneDASM64::DASMInst_t));
+
+    // Our own handler code.
+    bAllLocked &= memoryLock.LockCrashPathText();
+
+    // Disassembler's code & opcode tables, not the program its linked into.
+    bAllLocked &= memoryLock.LockDisassembler(reinterpret_cast<const void*>(&InsaneDASM64::Decode), MAX_LOCKED_MODULE_SIZE);
+
+    return bAllLocked;
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+void DeadStop::ReleaseCrashPath()
+{
+    if(s_crash.m_pDecoderAllocator != nullptr)
+    {
+        s_crash.m_pDecoderAllocator->FreeAll();
+        s_crash.m_pDecoderAllocator->~ArenaAllocator_t();
+    }
+
+    // Vectors give their memory back only on swap.
+    std::vector<InsaneDASM64::Byte>().swap(s_crash.m_vecBytes);
+    std::vector<InsaneDASM64::Instruction_t>().swap(s_crash.m_vecInst);
+    std::vector<InsaneDASM64::DASMInst_t>().swap(s_crash.m_vecDasmInst);
+
+    s_crash.m_compressor.Release();
+    s_crash.m_codeWindow.SetStorage(nullptr, 0);
+    s_crashSlots.Release();
+
+    s_crash.m_pArena            = nullptr;
+    s_crash.m_pOutputBuffer     = nullptr;
+    s_crash.m_pRegionStorage    = nullptr;
+    s_crash.m_iRegionMemSize    = 0;
+    s_crash.m_pMapsText         = nullptr;
+    s_crash.m_iMapsTextSize     = 0;
+    s_crash.m_pCallStack        = nullptr;
+    s_crash.m_pDecoderAllocator = nullptr;
+    s_crash.m_pMiniCoreRanges   = nullptr;
 }
 
 
 
 ///////////////////////////////////////////////////////////////////////////
 ///////////////////////////////////////////////////////////////////////////
+DEADSTOP_CRASH_PATH
 void DeadStop::MasterSignalHandler(int iSignalID, siginfo_t* pSigInfo, void* pContext)
 {
-    // Is initialized?
+    // NOTE : Everything reachable from here must be async-signal-safe. We might have crashed inside
+    //        malloc or while holding a stdio lock. So no heap, no stdio, no locale. Raw syscalls only.
+    uint64_t iHandlerStartTime = GetMonotonicTimeInNs();
+
+    // Faulted inside a SafeRead()? That jumps straight back into it.
+    if(RecoverFromSafeReadFault(iSignalID) == true)
+        return;
+
+    // Not ours anymore ( raced Uninitialize() ). Returning would just run the faulting instruction
+    // again, so the default action gets it, pending till we return.
     if(DeadStop_t::GetInstance().IsInitialized() == false)
-        return; 
+    {
+        struct sigaction defaultAction;
+        memset(&defaultAction, 0, sizeof(defaultAction));
+        defaultAction.sa_handler = SIG_DFL;
+        sigaction(iSignalID, &defaultAction, nullptr);
+        raise(iSignalID);
+        return;
+    }
+
+
+    // Every crashing thread takes a slot, first one in becomes the leader & writes the full report.
+    // Everyone else leaves a short record for the leader to append, no locks involved.
+    pid_t        iThreadID       = static_cast<pid_t>(syscall(SYS_gettid));
+    bool         bAlreadyCrashed = false;
+    CrashSlot_t* pSlot           = s_crashSlots.Claim(iThreadID, bAlreadyCrashed);
+
+    // Crashed inside our own handler? Nothing sane left to do.
+    if(bAlreadyCrashed == true)
+        _exit(1);
+
+    if(s_crashSlots.TryBecomeLeader(iThreadID) == false)
+        HandleFollowerCrash(pSlot, iSignalID, pSigInfo, reinterpret_cast<ucontext_t*>(pContext));
 
-    std::fstream hFile(DeadStop_t::GetInstance().GetDumpFilePath(), std::ios::app);
 
     // Failed to open file?
-    if(hFile.is_open() == false)
+    Writer_t        hFile;
+    int             iFd = -1;
+    DumpSlabClaim_t slabClaim;
+    if(OpenDump(hFile, s_crash.m_pOutputBuffer, OUTPUT_BUFFER_SIZE, iFd, slabClaim) == false)
         return;
 
+    // Only the leader compresses, followers writing their own records are small & would share its tables.
+    if(iFd >= 0 && s_crash.m_compressor.IsInitialized() == true)
+        hFile.SetFlushFn(Compressor_t::FlushFn, &s_crash.m_compressor);
 
-    // Writting date & time to file before writting anything else.
-    hFile << "///////////////////////////////////////////////////////////////////////////\n";
-    hFile << "///////////////////////////////////////////////////////////////////////////\n";
-    DoBranding(hFile); hFile << "Fatal signal received, this program will terminate now.\n";
-    DoBranding(hFile); hFile << "Starting log dump @ ";
-    DumpDateTime(hFile);
-    hFile << '\n';
+    int64_t iStartTime = GetLocalTime();
 
+    g_pContext = reinterpret_cast<ucontext_t*>(pContext);
+    g_pSigInfo = pSigInfo;
 
-    // Write the signal ID.
-    switch(iSignalID)
+    // Running some registered fiber?
+    FiberInfo_t crashFiber;
+    uintptr_t   iCrashRSP = static_cast<uintptr_t>(g_pContext->uc_mcontext.gregs[REG_RSP]);
+    if(GetFiberSlotCount() > 0)
+        FindFiberByStack(iCrashRSP, crashFiber);
+
+
+    // Binary record is the same snapshot, copied out as is. Nothing gets disassembled or formatted.
+    bool bBinaryRecord = (DeadStop_t::GetInstance().GetFlags() & DeadStopFlag_BinaryRecord) != 0;
+    bool bWritten      = bBinaryRecord == true ?
+        WriteCrashRecord(hFile, iSignalID, iThreadID, crashFiber.m_iFiberID, iStartTime, iHandlerStartTime) :
+        WriteTextReport (hFile, iSignalID, iThreadID, crashFiber.m_iFiberID, iStartTime, iHandlerStartTime);
+
+    if(bWritten == false)
     {
-        case SIGSEGV:  DoBranding(hFile); hFile << "Signal received [ SIGSEGV ] i.e. Segfault\n";                        break;
-        case SIGILL:   DoBranding(hFile); hFile << "Signal received [ SIGILL ] i.e. Invalid Instruction\n";              break;
-        case SIGTRAP:  DoBranding(hFile); hFile << "Signal Received [ SIGTRAP ] i.e. Trap Debugger\n";                   break;
-        case SIGABRT:  DoBranding(hFile); hFile << "Signal Received [ SIGABRT ] i.e. abort()\n";                         break; 
-        case SIGFPE:   DoBranding(hFile); hFile << "Signal Received [ SIGFPE ] i.e. Devide By Zero\n";                   break;  
-        case SIGBUS:   DoBranding(hFile); hFile << "Signal Received [ SIGBUS ] i.e. Hardware memory error, bad mmap.\n"; break; 
+        CloseDump(hFile, iFd, slabClaim);
+        return;
+    }
+
 
-        default: assertion(false && "Invalid signal ID"); return;
+    // Followers that only showed up now write their own records.
+    s_crashSlots.MarkLeaderDone();
+    if(bBinaryRecord == true)
+    {
+        RecordWriter_t lateRecord(hFile);
+        WriteFollowerRecords(hFile, &lateRecord);
+        if(lateRecord.HasBegun() == true)
+            EndRecord(lateRecord, 0);
     }
-    hFile << "\n\n";
-    /* Prologue ends here */
+    else
+    {
+        WriteFollowerRecords(hFile, nullptr);
+    }
+    CloseDump(hFile, iFd, slabClaim);
 
+    // NOTE : _exit() & not exit(), exit() runs atexit handlers & flushes stdio, neither is safe in here.
+    _exit(1);
+}
 
-    g_pContext = reinterpret_cast<ucontext_t*>(pContext);
-    g_pSigInfo = pSigInfo;
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+DEADSTOP_CRASH_PATH
+static bool DeadStop::WriteTextReport(Writer_t& hFile, int iSignalID, pid_t iThreadID, uint64_t iCrashFiberID, int64_t iStartTime, uint64_t iHandlerStartTime)
+{
+    if(WriteReportPrologue(hFile, iSignalID, iThreadID, iCrashFiberID, iStartTime) == false)
+    {
+        assertion(false && "Invalid signal ID");
+        return false;
+    }
 
 
+    // Fault address & whether it looks like a stack overflow.
+    const ThreadStackInfo_t* pStackInfo = GetThisThreadStackInfo();
+    DumpFaultInfo(hFile, iSignalID, *pStackInfo, IsHandlerOnAltStack(*pStackInfo));
+    hFile.Write("\n\n");
+
+
+    // Stack captures might be reading the maps snapshot. They're given a little while to leave, we take
+    // over after that, or right away if one was this thread's ( crashed inside of it ). Never given back,
+    // we exit after this.
+    BeginMapsReload(iThreadID, FOLLOWER_WAIT_NS, true, nullptr);
+
     // Getting "this" process's memory regions.
-    std::vector<MemRegion_t> vecSelfMaps; 
-    if(g_memRegionHandler.InitializeFromFile("/proc/self/maps") == false)
+    if(LoadCrashMaps() == false)
     {
-        DoBranding(hFile); hFile << "Failed to open \"/proc/self/maps\". Cannot proceed any further.\n";
-        return;
+        DoBranding(hFile); hFile.Write("Failed to open \"/proc/self/maps\". Cannot proceed any further.\n");
+        EndMapsReload(iThreadID);
+        return false;
     }
     WriteSelfMaps(hFile);
+
+    if(g_memRegionHandler.HasOverflowed() == true || g_memRegionHandler.IsTextTruncated() == true)
+    {
+        DoBranding(hFile); hFile.Format("Only first %zu memory regions are used for analysis.\n", g_memRegionHandler.GetRegionCount());
+    }
     WIN_LOG("Got processes memory regions.");
-    hFile << "\n\n";
+    hFile.Write("\n\n");
 
 
     // GPR values -> file.
     DumpGeneralRegisters(hFile);
     WIN_LOG("Dumped registers.");
-    hFile << "\n\n";
+    hFile.Write("\n\n");
 
 
-    std::vector<uintptr_t> vecCallStack;
-    Analyze(vecCallStack);
+    UnwindCrashStack();
+    WriteFnChainToFile(hFile, *s_crash.m_pCallStack);
 
-    WriteFnChainToFile(hFile, vecCallStack);
+
+    // Other threads that crashed meanwhile.
+    WriteFollowerRecords(hFile, nullptr);
+
+
+    // Whatever else the program was in the middle of.
+    WriteFiberStacks(hFile, iCrashFiberID, nullptr);
 
 
     // Epilogue
-    DoBranding(hFile); hFile << "Log dump ended @ ";
-    DumpDateTime(hFile);
-    hFile << '\n';
-    hFile << "///////////////////////////////////////////////////////////////////////////\n";
-    hFile.close();
-    exit(1);
+    DoBranding(hFile); hFile.Write("Log dump ended @ ");
+    DumpDateTime(hFile, GetLocalTime());
+    hFile.Write('\n');
+    DoBranding(hFile); hFile.Format("Handler latency : %lu us\n", (GetMonotonicTimeInNs() - iHandlerStartTime) / 1000);
+    WriteMemoryUsage(hFile);
+    hFile.Write("///////////////////////////////////////////////////////////////////////////\n");
+    hFile.Flush();
+
+    return true;
 }
 
 
 ///////////////////////////////////////////////////////////////////////////
 ///////////////////////////////////////////////////////////////////////////
-static void DeadStop::WriteSelfMaps(std::fstream& hFile)
+DEADSTOP_CRASH_PATH
+static bool DeadStop::WriteReportPrologue(Writer_t& hFile, int iSignalID, pid_t iThreadID, uint64_t iCrashFiberID, int64_t iStartTime)
 {
-    std::ifstream hMaps("/proc/self/maps");
+    // Writting date & time to file before writting anything else.
+    hFile.Write("///////////////////////////////////////////////////////////////////////////\n");
+    hFile.Write("///////////////////////////////////////////////////////////////////////////\n");
+    DoBranding(hFile); hFile.Write("Fatal signal received, this program will terminate now.\n");
+    DoBranding(hFile); hFile.Write("Starting log dump @ ");
+    DumpDateTime(hFile, iStartTime);
+    hFile.Write('\n');
 
-    // If we can't open this, something must be really wrong.
-    if(hMaps.is_open() == false)
-        return;
 
-    StartBanner(hFile, "Mapped Memory Regions");
+    // Write the signal ID.
+    switch(iSignalID)
+    {
+        case SIGSEGV:  DoBranding(hFile); hFile.Write("Signal received [ SIGSEGV ] i.e. Segfault\n");                        break;
+        case SIGILL:   DoBranding(hFile); hFile.Write("Signal received [ SIGILL ] i.e. Invalid Instruction\n");              break;
+        case SIGTRAP:  DoBranding(hFile); hFile.Write("Signal Received [ SIGTRAP ] i.e. Trap Debugger\n");                   break;
+        case SIGABRT:  DoBranding(hFile); hFile.Write("Signal Received [ SIGABRT ] i.e. abort()\n");                         break; 
+        case SIGFPE:   DoBranding(hFile); hFile.Write("Signal Received [ SIGFPE ] i.e. Devide By Zero\n");                   break;  
+        case SIGBUS:   DoBranding(hFile); hFile.Write("Signal Received [ SIGBUS ] i.e. Hardware memory error, bad mmap.\n"); break; 
+
+        default: return false;
+    }
+    DoBranding(hFile); hFile.Format("Crashing thread : %d\n", static_cast<int>(iThreadID));
 
-    std::string szLine;
-    while(std::getline(hMaps, szLine))
+    if(iCrashFiberID != 0)
     {
-        hFile << szLine << std::endl;
+        DoBranding(hFile); hFile.Format("Crashing fiber : 0x%lx\n", iCrashFiberID);
     }
+    hFile.Write("\n\n");
+    /* Prologue ends here */
 
-    EndBanner(hFile, "Mapped Memory Regions");
+    return true;
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+DEADSTOP_CRASH_PATH
+static bool DeadStop::LoadCrashMaps()
+{
+    s_bCaptureMapsLoaded = false;
+    g_memRegionHandler.SetStorage(s_crash.m_pRegionStorage, s_crash.m_iRegionMemSize);
+    if(g_memRegionHandler.InitializeFromFile("/proc/self/maps", s_crash.m_pMapsText, s_crash.m_iMapsTextSize) == false)
+        return false;
+
+    // JIT code mapped in ways maps doesn't show as code, & perf map lines written since it was loaded.
+    RefreshPerfMap();
+    BuildJitIndex();
+    AddJitRegions(g_memRegionHandler);
+    return true;
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+DEADSTOP_CRASH_PATH
+static void DeadStop::UnwindCrashStack()
+{
+    // Unwind info is looked up through this crash's maps snapshot.
+    DwarfRegs_t crashRegs;
+    DwarfRegsFromContext(g_pContext, crashRegs);
+    ClearUnwindModuleCache();
+    Analyze(*s_crash.m_pCallStack, s_crash.m_codeWindow, crashRegs, DeadStop_t::GetInstance().GetCallStackDepth());
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+DEADSTOP_CRASH_PATH
+static bool DeadStop::IsHandlerOnAltStack(const ThreadStackInfo_t& stackInfo)
+{
+    // Any local will do, its on whatever stack this handler runs on.
+    uintptr_t iHandlerSP = reinterpret_cast<uintptr_t>(&iHandlerSP);
+    return iHandlerSP >= stackInfo.m_iAltStackLow && iHandlerSP < stackInfo.m_iAltStackHigh;
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+DEADSTOP_CRASH_PATH
+static void DeadStop::WriteSelfMaps(Writer_t& hFile)
+{
+    StartBanner(hFile, "Mapped Memory Regions");
+
+    // Same text the regions were parsed from, /proc/self/maps is already one region per line.
+    hFile.Write(g_memRegionHandler.GetText(), g_memRegionHandler.GetTextSize());
+    if(g_memRegionHandler.IsTextTruncated() == true)
+        hFile.Write("... ( truncated, increase crash memory budget )\n");
 
-    hMaps.close();
-    return;
+    EndBanner(hFile, "Mapped Memory Regions");
 }
 
 
 ///////////////////////////////////////////////////////////////////////////
 ///////////////////////////////////////////////////////////////////////////
-static bool DeadStop::DumpAssembly(std::fstream& hFile, uintptr_t pPivotLocation, int iAsmDumpRangeInBytes, const char* szRipMsg)
+DEADSTOP_CRASH_PATH
+static bool DeadStop::DumpAssembly(Writer_t& hFile, uintptr_t pPivotLocation, int iAsmDumpRangeInBytes, const char* szRipMsg)
 {
     // Does the crash location belong to the process?
-    if(g_memRegionHandler.HasParentRegion(pPivotLocation) == false)
+    if(g_memRegionHandler.HasExecutableRegion(pPivotLocation) == false)
     {
-        FAIL_LOG("Crash location [ %p ] is not a redable memory location. Cannot dump crash logs.", pPivotLocation);
+        FAIL_LOG("Crash location [ %p ] is not a readable code location. Cannot dump crash logs.", pPivotLocation);
         return false;
     }
 
 
     assertion(pPivotLocation > iAsmDumpRangeInBytes && "Invalid dump range or crash location?");
-    assertion(iAsmDumpRangeInBytes > 0 && iAsmDumpRangeInBytes < 0x1000 && "invalid or Too big dump range");
+    assertion(iAsmDumpRangeInBytes > 0 && iAsmDumpRangeInBytes < MAX_ASM_DUMP_RANGE && "invalid or Too big dump range");
     uintptr_t iAsmDumpStart = pPivotLocation - iAsmDumpRangeInBytes;
     uintptr_t iAsmDumpEnd   = pPivotLocation + iAsmDumpRangeInBytes;
-    if(g_memRegionHandler.HasParentRegion(iAsmDumpStart, iAsmDumpEnd) == false)
+    if(g_memRegionHandler.HasExecutableRegion(iAsmDumpStart, iAsmDumpEnd) == false)
     {
-        hFile << "Some parts of the dump regions [ " << 
-            std::hex << iAsmDumpStart << " - " << iAsmDumpEnd << 
-            " ] can't be read, reducing dump region to 100 byte above & below\n";
+        hFile.Write("Some parts of the dump regions [ ").WriteHex(iAsmDumpStart, 0, false).Write(" - ").WriteHex(iAsmDumpEnd, 0, false).
+            Write(" ] can't be read, reducing dump region to 100 byte above & below\n");
 
 
         if(iAsmDumpRangeInBytes > 100)
@@ -228,9 +752,9 @@ static bool DeadStop::DumpAssembly(std::fstream& hFile, uintptr_t pPivotLocation
         
 
         // Checking aginst modified region.
-        if(g_memRegionHandler.HasParentRegion(iAsmDumpStart, iAsmDumpEnd) == false)
+        if(g_memRegionHandler.HasExecutableRegion(iAsmDumpStart, iAsmDumpEnd) == false)
         {
-            hFile << "Dump region couldn't be read.\n";
+            hFile.Write("Dump region couldn't be read.\n");
             FAIL_LOG("Dump region couldn't be read.\n");
             return false;
         }
@@ -241,35 +765,44 @@ static bool DeadStop::DumpAssembly(std::fstream& hFile, uintptr_t pPivotLocation
     const int iAsmDumpRange = iAsmDumpRangeInBytes;
 
 
-    // Collecting some bytes from crash location to disassembler.
-    std::vector<InsaneDASM64::Byte> vecBytes;
-    for(int i = -iAsmDumpRange; i < iAsmDumpRange; i++) // unary minus ( - ) operator.
-        vecBytes.push_back(*(reinterpret_cast<InsaneDASM64::Byte*>(pPivotLocation) + i));
+    // Collecting some bytes from crash location to disassembler. Read once, every attempt below
+    // just starts a little further into the same bytes.
+    size_t     iBytesWanted = 2 * static_cast<size_t>(iAsmDumpRange);
+    CodeSpan_t codeSpan     = s_crash.m_codeWindow.Get(iAsmDumpStart, iBytesWanted);
+    if(codeSpan.m_iSize <= static_cast<size_t>(iAsmDumpRange))
+    {
+        DoBranding(hFile); hFile.Write("Memory around crash location couldn't be read.\n");
+        return false;
+    }
+
+    if(codeSpan.m_iSize < iBytesWanted)
+        hFile.Format("Only %zu of %zu bytes around crash location could be read.\n", codeSpan.m_iSize, iBytesWanted);
+
+
+    // Scratch buffer for this phase, only written to file if disassembly is valid.
+    size_t iArenaMarker = s_crash.m_pArena->GetMarker();
+    char*  pDasmBuffer  = s_crash.m_pArena->AllocateArray<char>(DASM_BUFFER_SIZE);
+    if(pDasmBuffer == nullptr)
+    {
+        DoBranding(hFile); hFile.Write("Out of crash memory, can't disassemble.\n");
+        return false;
+    }
 
 
     constexpr size_t  MAX_DISASSEMBLING_ATTEMPS = 10;
-    std::stringstream ssDasmOutput;
+    Writer_t          ssDasmOutput(pDasmBuffer, DASM_BUFFER_SIZE);
     bool              bDasmSucceded = false;
     for(int iAttempt = 0; iAttempt < MAX_DISASSEMBLING_ATTEMPS; iAttempt++)
     {
-        // Address of the first instruction.
-        uintptr_t iStartAdrs = static_cast<uintptr_t>(
-            static_cast<intptr_t>(pPivotLocation) - static_cast<intptr_t>(iAsmDumpRange) + static_cast<intptr_t>(iAttempt));
-
-
-        ssDasmOutput.clear(); ssDasmOutput.str("");
-        if(GenerateDasmOutput(ssDasmOutput, iStartAdrs, vecBytes, pPivotLocation, szRipMsg) == true)
+        // Skip one more byte each attempt, till we land on an instruction boundary.
+        ssDasmOutput.Clear();
+        if(GenerateDasmOutput(ssDasmOutput, codeSpan.Subspan(iAttempt), pPivotLocation, szRipMsg) == true)
         {
             WIN_LOG("Disassembly verified.");
             bDasmSucceded = true;
             break;
         }
 
-        // Remove the first element in case we fail.
-        // NOTE : This takes O(n), cause some smart ass nigga decided that std::vector<bytes> is a good way to feed bytes 
-        //        into a disassembler.
-        vecBytes.erase(vecBytes.begin()); 
-
         FAIL_LOG("Disssembly Failed. Attempt number %d", iAttempt);
     }
 
@@ -277,42 +810,35 @@ static bool DeadStop::DumpAssembly(std::fstream& hFile, uintptr_t pPivotLocation
     // We failed all disassembling attempts?
     if(bDasmSucceded == false)
     {
-        DoBranding(hFile); hFile << "Disassembly Failed.\n";
+        DoBranding(hFile); hFile.Write("Disassembly Failed.\n");
+        s_crash.m_pArena->ResetToMarker(iArenaMarker);
         return false;
     }
 
 
-    hFile << ssDasmOutput.str();
+    hFile.Append(ssDasmOutput);
+    s_crash.m_pArena->ResetToMarker(iArenaMarker);
     return true;
 }
 
 
 ///////////////////////////////////////////////////////////////////////////
 ///////////////////////////////////////////////////////////////////////////
+DEADSTOP_CRASH_PATH
 static bool DeadStop::GenerateDasmOutput(
-        std::stringstream& ssOut, uintptr_t iStartAdrs, const std::vector<InsaneDASM64::Byte>& vecBytes, uintptr_t pCrashLocation, const char* szRipMsg)
+        Writer_t& ssOut, const CodeSpan_t& codeSpan, uintptr_t pCrashLocation, const char* szRipMsg)
 {
     // Decoder & Disassembler.
-    std::vector<InsaneDASM64::Instruction_t> vecDecodedInst;
-    std::vector<InsaneDASM64::DASMInst_t>    vecDisassembledInst; 
-    ArenaAllocator_t allocator(8 * 1024); // 8 KiB arenas.
-
-
-    // Decode...
-    InsaneDASM64::IDASMErrorCode_t iDecodingErrCode = InsaneDASM64::Decode(vecBytes, vecDecodedInst, allocator);
-    if(iDecodingErrCode != InsaneDASM64::IDASMErrorCode_t::IDASMErrorCode_Success)
-    {
-        ssOut << InsaneDASM64::GetErrorMessage(iDecodingErrCode) << std::endl;
-        return false;
-    }
-    WIN_LOG("Decoding done.");
+    std::vector<InsaneDASM64::Instruction_t>& vecDecodedInst      = s_crash.m_vecInst;
+    std::vector<InsaneDASM64::DASMInst_t>&    vecDisassembledInst = s_crash.m_vecDasmInst; 
+    ArenaAllocator_t&                         allocator           = *s_crash.m_pDecoderAllocator;
 
 
-    // Disassemble...
-    InsaneDASM64::IDASMErrorCode_t iDasmErrCode = InsaneDASM64::Disassemble(vecDecodedInst, vecDisassembledInst);
+    // Decode & Disassemble...
+    InsaneDASM64::IDASMErrorCode_t iDasmErrCode = DisassembleSpan(codeSpan, allocator);
     if(iDasmErrCode != InsaneDASM64::IDASMErrorCode_t::IDASMErrorCode_Success)
     {
-        ssOut << InsaneDASM64::GetErrorMessage(iDasmErrCode) << std::endl;
+        ssOut.Write(InsaneDASM64::GetErrorMessage(iDasmErrCode)).Write('\n');
         return false;
     }
     WIN_LOG("Disassembing done.");
@@ -321,14 +847,15 @@ static bool DeadStop::GenerateDasmOutput(
     // Disasesmbled data must be valid.
     if(vecDecodedInst.size() != vecDisassembledInst.size())
     {
-        ssOut << "Decoded instructions and disassembled instruction count is not same.";
-        ssOut << "Where did you get this dog crap disassembler from?" << std::endl;
+        ssOut.Write("Decoded instructions and disassembled instruction count is not same.");
+        ssOut.Write("Where did you get this dog crap disassembler from?\n");
         return false;
     }
 
 
-    std::stringstream ssTemp;
-    size_t            iInstAdrs        = iStartAdrs;
+    char              szInstBytes[64];
+    Writer_t          ssTemp(szInstBytes, sizeof(szInstBytes));
+    size_t            iInstAdrs        = codeSpan.m_iAdrs;
     bool              bPasssedCrashLoc = false; // Did we pass by the instruction that caused signal?
 
     for(size_t iInstIndex = 0; iInstIndex < vecDecodedInst.size(); iInstIndex++)
@@ -336,15 +863,13 @@ static bool DeadStop::GenerateDasmOutput(
         if(iInstAdrs == pCrashLocation)
             bPasssedCrashLoc = true;
 
-        ssTemp.clear();
-        ssTemp.str("");
+        ssTemp.Clear();
 
         InsaneDASM64::Instruction_t* pInst     = &vecDecodedInst[iInstIndex];
         InsaneDASM64::DASMInst_t*    pDasmInst = &vecDisassembledInst[iInstIndex];
 
         size_t iTotalBytes = 0;
         
-        ssTemp << std::uppercase << std::hex << std::setfill('0');
         switch(pInst->m_iInstEncodingType)
         {
             case InsaneDASM64::Instruction_t::InstEncodingType_Legacy: 
@@ -355,31 +880,31 @@ static bool DeadStop::GenerateDasmOutput(
                     
                     // Legacy prefixies
                     for(int iPrefixIndex = 0; iPrefixIndex < pLegacyInst->m_legacyPrefix.m_nPrefix; iPrefixIndex++)
-                        ssTemp << std::setw(2) << static_cast<int>(pLegacyInst->m_legacyPrefix.m_legacyPrefix[iPrefixIndex]);
+                        ssTemp.WriteHex(pLegacyInst->m_legacyPrefix.m_legacyPrefix[iPrefixIndex], 2);
 
                     // REX byte
                     if(pLegacyInst->m_bHasREX == true)
-                        ssTemp << std::setw(2) << static_cast<int>(pLegacyInst->m_iREX);
+                        ssTemp.WriteHex(pLegacyInst->m_iREX, 2);
 
                     // OpCodes
                     for(int iOpCodeIndex = 0; iOpCodeIndex < pLegacyInst->m_opCode.m_nOpBytes; iOpCodeIndex++)
-                        ssTemp << std::setw(2) << static_cast<int>(pLegacyInst->m_opCode.m_opBytes[iOpCodeIndex]);
+                        ssTemp.WriteHex(pLegacyInst->m_opCode.m_opBytes[iOpCodeIndex], 2);
 
                     // ModRm
                     if(pLegacyInst->m_bHasModRM == true)
-                        ssTemp << std::setw(2) << static_cast<int>(pLegacyInst->m_modrm.Get());
+                        ssTemp.WriteHex(pLegacyInst->m_modrm.Get(), 2);
 
                     // SIB
                     if(pLegacyInst->m_bHasSIB == true)
-                        ssTemp << std::setw(2) << static_cast<int>(pLegacyInst->m_SIB.Get());
+                        ssTemp.WriteHex(pLegacyInst->m_SIB.Get(), 2);
 
                     // Displacement
                     for(int iDispByteIndex = 0; iDispByteIndex < pLegacyInst->m_displacement.ByteCount(); iDispByteIndex++)
-                        ssTemp << std::setw(2) << static_cast<int>(pLegacyInst->m_displacement.m_iDispBytes[iDispByteIndex]);
+                        ssTemp.WriteHex(pLegacyInst->m_displacement.m_iDispBytes[iDispByteIndex], 2);
 
                     // Immediate
                     for(int iImmByteIndex = 0; iImmByteIndex < pLegacyInst->m_immediate.ByteCount(); iImmByteIndex++)
-                        ssTemp << std::setw(2) << static_cast<int>(pLegacyInst->m_immediate.m_immediateByte[iImmByteIndex]);
+                        ssTemp.WriteHex(pLegacyInst->m_immediate.m_immediateByte[iImmByteIndex], 2);
                 }
                 break;
 
@@ -390,29 +915,29 @@ static bool DeadStop::GenerateDasmOutput(
                     iTotalBytes += pVEXInst->GetInstLengthInBytes();
 
                     // VEX prefix
-                    ssTemp << std::setw(2) << static_cast<int>(pVEXInst->m_vexPrefix.m_iPrefix);
+                    ssTemp.WriteHex(pVEXInst->m_vexPrefix.m_iPrefix, 2);
                     
                     // VEX bytes
                     for(int iVEXByteIndex = 0; iVEXByteIndex < pVEXInst->m_vexPrefix.m_nVEXBytes; iVEXByteIndex++)
-                        ssTemp << std::setw(2) << static_cast<int>(pVEXInst->m_vexPrefix.m_iVEX[iVEXByteIndex]);
+                        ssTemp.WriteHex(pVEXInst->m_vexPrefix.m_iVEX[iVEXByteIndex], 2);
 
                     // OpCode byte.
-                    ssTemp << std::setw(2) << static_cast<int>(pVEXInst->m_opcode.GetMostSignificantOpCode());
+                    ssTemp.WriteHex(pVEXInst->m_opcode.GetMostSignificantOpCode(), 2);
 
                     // ModRM
-                    ssTemp << std::setw(2) << static_cast<int>(pVEXInst->m_modrm.Get());
+                    ssTemp.WriteHex(pVEXInst->m_modrm.Get(), 2);
 
                     // SIB
                     if(pVEXInst->m_bHasSIB == true)
-                        ssTemp << std::setw(2) << static_cast<int>(pVEXInst->m_SIB.Get());
+                        ssTemp.WriteHex(pVEXInst->m_SIB.Get(), 2);
 
                     // Displacement
                     for(int iDispByteIndex = 0; iDispByteIndex < pVEXInst->m_disp.ByteCount(); iDispByteIndex++)
-                        ssTemp << std::setw(2) << static_cast<int>(pVEXInst->m_disp.m_iDispBytes[iDispByteIndex]);
+                        ssTemp.WriteHex(pVEXInst->m_disp.m_iDispBytes[iDispByteIndex], 2);
 
                     // Immediate
                     for(int iImmByteIndex = 0; iImmByteIndex < pVEXInst->m_immediate.ByteCount(); iImmByteIndex++)
-                        ssTemp << std::setw(2) << static_cast<int>(pVEXInst->m_immediate.m_immediateByte[iImmByteIndex]);
+                        ssTemp.WriteHex(pVEXInst->m_immediate.m_immediateByte[iImmByteIndex], 2);
                 }
                 break;
 
@@ -423,63 +948,58 @@ static bool DeadStop::GenerateDasmOutput(
                     iTotalBytes += pEVEXInst->GetInstLengthInBytes();
 
                     // EVEX prefix
-                    ssTemp << std::setw(2) << static_cast<int>(pEVEXInst->m_evexPrefix.m_iPrefix);
+                    ssTemp.WriteHex(pEVEXInst->m_evexPrefix.m_iPrefix, 2);
 
                     // EVEX payload
-                    ssTemp << std::setw(2) << static_cast<int>(pEVEXInst->m_evexPrefix.m_iPayload1);
-                    ssTemp << std::setw(2) << static_cast<int>(pEVEXInst->m_evexPrefix.m_iPayload2);
-                    ssTemp << std::setw(2) << static_cast<int>(pEVEXInst->m_evexPrefix.m_iPayload3);
+                    ssTemp.WriteHex(pEVEXInst->m_evexPrefix.m_iPayload1, 2);
+                    ssTemp.WriteHex(pEVEXInst->m_evexPrefix.m_iPayload2, 2);
+                    ssTemp.WriteHex(pEVEXInst->m_evexPrefix.m_iPayload3, 2);
 
                     // OpCode byte.
-                    ssTemp << std::setw(2) << static_cast<int>(pEVEXInst->m_opcode.GetMostSignificantOpCode());
+                    ssTemp.WriteHex(pEVEXInst->m_opcode.GetMostSignificantOpCode(), 2);
 
                     // ModRM
-                    ssTemp << std::setw(2) << static_cast<int>(pEVEXInst->m_modrm.Get());
+                    ssTemp.WriteHex(pEVEXInst->m_modrm.Get(), 2);
 
                     // SIB
                     if(pEVEXInst->m_bHasSIB == true)
-                        ssTemp << std::setw(2) << static_cast<int>(pEVEXInst->m_SIB.Get());
+                        ssTemp.WriteHex(pEVEXInst->m_SIB.Get(), 2);
 
                     // Displacement
                     for(int iDispByteIndex = 0; iDispByteIndex < pEVEXInst->m_disp.ByteCount(); iDispByteIndex++)
-                        ssTemp << std::setw(2) << static_cast<int>(pEVEXInst->m_disp.m_iDispBytes[iDispByteIndex]);
+                        ssTemp.WriteHex(pEVEXInst->m_disp.m_iDispBytes[iDispByteIndex], 2);
 
                     // Immediate
                     for(int iImmByteIndex = 0; iImmByteIndex < pEVEXInst->m_immediate.ByteCount(); iImmByteIndex++)
-                        ssTemp << std::setw(2) << static_cast<int>(pEVEXInst->m_immediate.m_immediateByte[iImmByteIndex]);
+                        ssTemp.WriteHex(pEVEXInst->m_immediate.m_immediateByte[iImmByteIndex], 2);
                 }
                 break;
 
             default: break;
         }
-        ssTemp << std::nouppercase << std::dec << std::setfill(' ');
-        ssOut << "0x" << std::hex << iInstAdrs << std::dec << "    " << std::left << std::setw(32) << ssTemp.str();
+        ssOut.Write("0x").WriteHex(iInstAdrs, 0, false).Write("    ");
+        ssOut.Write(ssTemp.Data(), ssTemp.Size()).WriteFill(' ', 32 - static_cast<int>(ssTemp.Size()));
 
 
-        switch(pDasmInst->m_nOperands)
+        if(pDasmInst->m_nOperands >= 0 && pDasmInst->m_nOperands <= 4)
         {
-            case 0: ssOut << std::setw(10) << pDasmInst->m_szMnemonic; break;
-            case 1: ssOut << std::setw(10) << pDasmInst->m_szMnemonic << ' ' << pDasmInst->m_szOperands[0]; break; 
-            case 2: ssOut << std::setw(10) << pDasmInst->m_szMnemonic << ' ' << pDasmInst->m_szOperands[0] << ", " << pDasmInst->m_szOperands[1]; break;
-            case 3: ssOut << std::setw(10) << pDasmInst->m_szMnemonic << ' ' << pDasmInst->m_szOperands[0] << ", " << pDasmInst->m_szOperands[1]
-                    << ", " << pDasmInst->m_szOperands[2]; break;
-            case 4: ssOut << std::setw(10) << pDasmInst->m_szMnemonic << ' ' << pDasmInst->m_szOperands[0] << ", " << pDasmInst->m_szOperands[1]
-                    << ", " << pDasmInst->m_szOperands[2] << ", " << pDasmInst->m_szOperands[3]; break;
+            ssOut.WritePadded(pDasmInst->m_szMnemonic, 10);
 
-            default: break;
+            for(int iOperandIndex = 0; iOperandIndex < pDasmInst->m_nOperands; iOperandIndex++)
+                ssOut.Write(iOperandIndex == 0 ? " " : ", ").Write(pDasmInst->m_szOperands[iOperandIndex]);
         }
 
         // if at crash inst. address, mark it.
         if(iInstAdrs == pCrashLocation)
         {
-            ssOut << "  <--[ " << szRipMsg << " ]";
+            ssOut.Write("  <--[ ").Write(szRipMsg).Write(" ]");
 
             // Generating signature.
-            int iSignatureSize = DeadStop_t::GetInstance().GetSignatureSize();
+            int iSignatureSize = s_crash.m_iSignatureSize;
             if(iSignatureSize > 0)
             {
-                ssOut << " Sig : ";
-                MakeSignature(ssOut, vecDecodedInst, iInstIndex, DeadStop_t::GetInstance().GetSignatureSize());
+                ssOut.Write(" Sig : ");
+                MakeSignature(ssOut, vecDecodedInst, iInstIndex, static_cast<size_t>(iSignatureSize));
             }
         }
 
@@ -489,36 +1009,39 @@ static bool DeadStop::GenerateDasmOutput(
 
         if(szPotentialString != nullptr)
         {
-            ssOut << " ; ";
+            ssOut.Write(" ; ");
 
             // Checking if we can read 20 bytes of this potential string.
-            int iCharsToRead = DeadStop_t::GetInstance().GetStringDumpSize();
+            int iCharsToRead = s_crash.m_iStringDumpSize;
+
+            char szString[MAX_STRING_DUMP_SIZE];
+            if(iCharsToRead > static_cast<int>(sizeof(szString)))
+                iCharsToRead = static_cast<int>(sizeof(szString));
 
+            // Strings can end right before an unmapped page, so take whatever part of it we can read.
             uintptr_t iPotentialStringAdrs = reinterpret_cast<uintptr_t>(szPotentialString);
-            if(g_memRegionHandler.HasParentRegion(iPotentialStringAdrs, iPotentialStringAdrs + iCharsToRead) == true)
+            size_t    nCharsRead           = 0;
+            if(iCharsToRead > 0 && g_memRegionHandler.HasParentRegion(iPotentialStringAdrs) == true)
+                nCharsRead = ReadCrashMemory(szString, iPotentialStringAdrs, static_cast<size_t>(iCharsToRead));
+
+            for(size_t i = 0; i < nCharsRead; i++)
             {
-                for(int i = 0; i < iCharsToRead; i++)
-                {
-                    if(szPotentialString[i] == '\0')
-                        break;
+                if(szString[i] == '\0')
+                    break;
 
-                    if(IsCharPrintable(szPotentialString[i]) == false)
-                        break;
+                if(IsCharPrintable(szString[i]) == false)
+                    break;
 
-                    ssOut << szPotentialString[i];
-                }
+                ssOut.Write(szString[i]);
             }
         }
 
         iInstAdrs += iTotalBytes;
 
-        ssOut << '\n';
+        ssOut.Write('\n');
     }
 
 
-    // Deallocate all arenas...
-    allocator.FreeAll();
-
     // Return whehter this disassembly was valid or not.
     return bPasssedCrashLoc;
 }
@@ -526,15 +1049,14 @@ static bool DeadStop::GenerateDasmOutput(
 
 ///////////////////////////////////////////////////////////////////////////
 ///////////////////////////////////////////////////////////////////////////
+DEADSTOP_CRASH_PATH
 static bool DeadStop::MakeSignature(
-        std::stringstream& sigOut, const std::vector<InsaneDASM64::Instruction_t>& vecInst, size_t iStartIndex, size_t iSignatureSizeInBytes)
+        Writer_t& sigOut, const std::vector<InsaneDASM64::Instruction_t>& vecInst, size_t iStartIndex, size_t iSignatureSizeInBytes)
 {
     if(vecInst.empty() == true)
         return false;
 
 
-    sigOut << std::uppercase << std::hex << std::setfill('0');
-
     int nInstCount = vecInst.size();
     int iSigSize   = 0;
     for(int iInstIndex = iStartIndex; iInstIndex < nInstCount; iInstIndex++)
@@ -555,31 +1077,31 @@ static bool DeadStop::MakeSignature(
 
                     // Legacy prefixies
                     for(int iPrefixIndex = 0; iPrefixIndex < pLegacyInst->m_legacyPrefix.m_nPrefix; iPrefixIndex++)
-                        sigOut << std::setw(2) << static_cast<int>(pLegacyInst->m_legacyPrefix.m_legacyPrefix[iPrefixIndex]) << ' ';
+                        sigOut.WriteHex(pLegacyInst->m_legacyPrefix.m_legacyPrefix[iPrefixIndex], 2).Write(' ');
 
                     // REX byte
                     if(pLegacyInst->m_bHasREX == true)
-                        sigOut << std::setw(2) << static_cast<int>(pLegacyInst->m_iREX) << ' ';
+                        sigOut.WriteHex(pLegacyInst->m_iREX, 2).Write(' ');
 
                     // OpCodes
                     for(int iOpCodeIndex = 0; iOpCodeIndex < pLegacyInst->m_opCode.m_nOpBytes; iOpCodeIndex++)
-                        sigOut << std::setw(2) << static_cast<int>(pLegacyInst->m_opCode.m_opBytes[iOpCodeIndex]) << ' ';
+                        sigOut.WriteHex(pLegacyInst->m_opCode.m_opBytes[iOpCodeIndex], 2).Write(' ');
 
                     // ModRm
                     if(pLegacyInst->m_bHasModRM == true)
-                        sigOut << std::setw(2) << static_cast<int>(pLegacyInst->m_modrm.Get()) << ' ';
+                        sigOut.WriteHex(pLegacyInst->m_modrm.Get(), 2).Write(' ');
 
                     // SIB
                     if(pLegacyInst->m_bHasSIB == true)
-                        sigOut << std::setw(2) << static_cast<int>(pLegacyInst->m_SIB.Get()) << ' ';
+                        sigOut.WriteHex(pLegacyInst->m_SIB.Get(), 2).Write(' ');
 
                     // Displacement
                     for(int iDispByteIndex = 0; iDispByteIndex < pLegacyInst->m_displacement.ByteCount(); iDispByteIndex++)
-                        sigOut << "? ";
+                        sigOut.Write("? ");
 
                     // Immediate
                     for(int iImmByteIndex = 0; iImmByteIndex < pLegacyInst->m_immediate.ByteCount(); iImmByteIndex++)
-                        sigOut << "? ";
+                        sigOut.Write("? ");
                 }
                 break;
 
@@ -589,29 +1111,29 @@ static bool DeadStop::MakeSignature(
                     iSigSize += pVEXInst->GetInstLengthInBytes();
 
                     // VEX prefix
-                    sigOut << std::setw(2) << static_cast<int>(pVEXInst->m_vexPrefix.m_iPrefix) << ' ';
+                    sigOut.WriteHex(pVEXInst->m_vexPrefix.m_iPrefix, 2).Write(' ');
                     
                     // VEX bytes
                     for(int iVEXByteIndex = 0; iVEXByteIndex < pVEXInst->m_vexPrefix.m_nVEXBytes; iVEXByteIndex++)
-                        sigOut << std::setw(2) << static_cast<int>(pVEXInst->m_vexPrefix.m_iVEX[iVEXByteIndex]) << ' ';
+                        sigOut.WriteHex(pVEXInst->m_vexPrefix.m_iVEX[iVEXByteIndex], 2).Write(' ');
 
                     // OpCode byte.
-                    sigOut << std::setw(2) << static_cast<int>(pVEXInst->m_opcode.GetMostSignificantOpCode()) << ' ';
+                    sigOut.WriteHex(pVEXInst->m_opcode.GetMostSignificantOpCode(), 2).Write(' ');
 
                     // ModRM
-                    sigOut << std::setw(2) << static_cast<int>(pVEXInst->m_modrm.Get()) << ' ';
+                    sigOut.WriteHex(pVEXInst->m_modrm.Get(), 2).Write(' ');
 
                     // SIB
                     if(pVEXInst->m_bHasSIB == true)
-                        sigOut << std::setw(2) << static_cast<int>(pVEXInst->m_SIB.Get()) << ' ';
+                        sigOut.WriteHex(pVEXInst->m_SIB.Get(), 2).Write(' ');
 
                     // Displacement
                     for(int iDispByteIndex = 0; iDispByteIndex < pVEXInst->m_disp.ByteCount(); iDispByteIndex++)
-                        sigOut << "? ";
+                        sigOut.Write("? ");
 
                     // Immediate
                     for(int iImmByteIndex = 0; iImmByteIndex < pVEXInst->m_immediate.ByteCount(); iImmByteIndex++)
-                        sigOut << "? ";
+                        sigOut.Write("? ");
                 }
                 break;
 
@@ -621,30 +1143,30 @@ static bool DeadStop::MakeSignature(
                     iSigSize = pEVEXInst->GetInstLengthInBytes();
 
                     // EVEX prefix
-                    sigOut << std::setw(2) << static_cast<int>(pEVEXInst->m_evexPrefix.m_iPrefix) << ' ';
+                    sigOut.WriteHex(pEVEXInst->m_evexPrefix.m_iPrefix, 2).Write(' ');
 
                     // EVEX payload
-                    sigOut << std::setw(2) << static_cast<int>(pEVEXInst->m_evexPrefix.m_iPayload1) << ' ';
-                    sigOut << std::setw(2) << static_cast<int>(pEVEXInst->m_evexPrefix.m_iPayload2) << ' ';
-                    sigOut << std::setw(2) << static_cast<int>(pEVEXInst->m_evexPrefix.m_iPayload3) << ' ';
+                    sigOut.WriteHex(pEVEXInst->m_evexPrefix.m_iPayload1, 2).Write(' ');
+                    sigOut.WriteHex(pEVEXInst->m_evexPrefix.m_iPayload2, 2).Write(' ');
+                    sigOut.WriteHex(pEVEXInst->m_evexPrefix.m_iPayload3, 2).Write(' ');
 
                     // OpCode byte.
-                    sigOut << std::setw(2) << static_cast<int>(pEVEXInst->m_opcode.GetMostSignificantOpCode()) << ' ';
+                    sigOut.WriteHex(pEVEXInst->m_opcode.GetMostSignificantOpCode(), 2).Write(' ');
 
                     // ModRM
-                    sigOut << std::setw(2) << static_cast<int>(pEVEXInst->m_modrm.Get()) << ' ';
+                    sigOut.WriteHex(pEVEXInst->m_modrm.Get(), 2).Write(' ');
 
                     // SIB
                     if(pEVEXInst->m_bHasSIB == true)
-                        sigOut << std::setw(2) << static_cast<int>(pEVEXInst->m_SIB.Get()) << ' ';
+                        sigOut.WriteHex(pEVEXInst->m_SIB.Get(), 2).Write(' ');
 
                     // Displacement
                     for(int iDispByteIndex = 0; iDispByteIndex < pEVEXInst->m_disp.ByteCount(); iDispByteIndex++)
-                        sigOut << "? ";
+                        sigOut.Write("? ");
 
                     // Immediate
                     for(int iImmByteIndex = 0; iImmByteIndex < pEVEXInst->m_immediate.ByteCount(); iImmByteIndex++)
-                        sigOut << "? ";
+                        sigOut.Write("? ");
                 }
                 break;
 
@@ -652,7 +1174,6 @@ static bool DeadStop::MakeSignature(
         }
     }
 
-    sigOut << std::nouppercase << std::dec << std::setfill(' ');
 
 
     return true;
@@ -661,6 +1182,7 @@ static bool DeadStop::MakeSignature(
 
 ///////////////////////////////////////////////////////////////////////////
 ///////////////////////////////////////////////////////////////////////////
+DEADSTOP_CRASH_PATH
 static void* DeadStop::GetPointerFromModrm(InsaneDASM64::Instruction_t& inst, uintptr_t iStartAdrs)
 {
     if(inst.m_iInstEncodingType != InsaneDASM64::Instruction_t::InstEncodingType_Legacy)
@@ -672,6 +1194,7 @@ static void* DeadStop::GetPointerFromModrm(InsaneDASM64::Instruction_t& inst, ui
 
 ///////////////////////////////////////////////////////////////////////////
 ///////////////////////////////////////////////////////////////////////////
+DEADSTOP_CRASH_PATH
 static void* DeadStop::GetPointerFromModrm(InsaneDASM64::Legacy::LegacyInst_t* pLegacyInst, uintptr_t iStartAdrs)
 {
     int iInstLengthInBytes = pLegacyInst->GetInstLengthInBytes(); // instruction length in bytes.
@@ -719,7 +1242,8 @@ static void* DeadStop::GetPointerFromModrm(InsaneDASM64::Legacy::LegacyInst_t* p
             if(g_memRegionHandler.HasParentRegion(iBaseReg) == false)
                 return nullptr;
 
-            iBaseReg = *reinterpret_cast<intptr_t*>(iBaseReg);
+            if(ReadCrashMemory(&iBaseReg, static_cast<uintptr_t>(iBaseReg), sizeof(iBaseReg)) != sizeof(iBaseReg))
+                return nullptr;
         }
 
 
@@ -782,7 +1306,8 @@ static void* DeadStop::GetPointerFromModrm(InsaneDASM64::Legacy::LegacyInst_t* p
         if(g_memRegionHandler.HasParentRegion(reinterpret_cast<uintptr_t>(szFinalPointer)) == false)
             return nullptr;
 
-        szFinalPointer = *reinterpret_cast<void**>(szFinalPointer);
+        if(ReadCrashMemory(&szFinalPointer, reinterpret_cast<uintptr_t>(szFinalPointer), sizeof(szFinalPointer)) != sizeof(szFinalPointer))
+            return nullptr;
 
         WIN_LOG("Found a potential string pointer [ %p ]", szFinalPointer);
     }
@@ -803,500 +1328,544 @@ static void* DeadStop::GetPointerFromModrm(InsaneDASM64::Legacy::LegacyInst_t* p
 
 ///////////////////////////////////////////////////////////////////////////
 ///////////////////////////////////////////////////////////////////////////
-static bool DeadStop::Analyze(std::vector<uintptr_t>& vecCallStack)
+DEADSTOP_CRASH_PATH
+static size_t DeadStop::ReadCrashMemory(void* pDest, uintptr_t iSrcAdrs, size_t iSize)
+{
+    // Rendering a record, the process is long gone.
+    if(s_pRenderRecord != nullptr)
+        return s_pRenderRecord->ReadMemory(pDest, iSrcAdrs, iSize);
+
+    return SafeRead(pDest, iSrcAdrs, iSize);
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+DEADSTOP_CRASH_PATH
+static bool DeadStop::Analyze(CallStack_t& callStack, CodeWindow_t& codeWindow, const DwarfRegs_t& startRegs, int iMaxDepth, bool bLiveStack)
 {
-    uintptr_t pCrashLoc = static_cast<uintptr_t>(g_pContext->uc_mcontext.gregs[REG_RIP]);
+    uint64_t  iStartTime = GetMonotonicTimeInNs();
+    size_t    nStartHits = GetUnwindPlanHitCount();
 
-    vecCallStack.clear(); 
-    vecCallStack.push_back(pCrashLoc);
+    callStack.m_nFrames      = 0;
+    callStack.m_iUnknownAdrs = 0;
+    callStack.Push(startRegs.Get(DwarfReg_RA));
 
 
-    StackFrame_t iStackFrame; 
-    iStackFrame.m_rSP = g_pContext->uc_mcontext.gregs[REG_RSP];
-    iStackFrame.m_rBP = g_pContext->uc_mcontext.gregs[REG_RBP];
+    DwarfRegs_t regs     = startRegs;
+    bool        bExactPC = true; // Crash location is where we actually were, every frame after is a return address.
 
+    // Frame pointer steps must stay on the crashed thread's stack, everything from rSP up is mapped. Thread
+    // might be running a fiber, its stack is the live one then. Suspended fibers' stacks are only read safely.
+    const ThreadStackInfo_t* pStackInfo = GetThisThreadStackInfo();
+    uintptr_t iLiveStackLow  = regs.Get(DwarfReg_RSP);
+    uintptr_t iLiveStackHigh = pStackInfo->m_iStackHigh;
+    if(iLiveStackLow < pStackInfo->m_iStackLow || iLiveStackLow >= iLiveStackHigh)
+    {
+        FiberInfo_t fiber;
+        iLiveStackHigh = FindFiberByStack(iLiveStackLow, fiber) == true ? fiber.m_iStackHigh : 0;
+    }
 
-    ArenaAllocator_t allocator(8 * 1024); // 8 KiB arenas.
-                                          
-    int iCallStackDepth = DeadStop_t::GetInstance().GetCallStackDepth();
-    for(int i = 0; i < iCallStackDepth; i++)
+    if(bLiveStack == false || iLiveStackHigh == 0)
     {
-        allocator.ResetAllArena();
+        iLiveStackLow  = 0;
+        iLiveStackHigh = 0;
+    }
+
 
+    for(int i = 0; i < iMaxDepth; i++)
+    {
         LOG("Processing call index : %d", i);
-        uintptr_t iReturnAdrs = GetReturnAdrs(vecCallStack.back(), allocator, iStackFrame);
-        LOG("Call index %d processed. Return address detected : %p\n", i, iReturnAdrs);
 
-        if(iReturnAdrs == 0)
-            break;
 
-        vecCallStack.push_back(iReturnAdrs);
-    }
+        // rBP chain first if this module keeps frame pointers, just a read. Then .eh_frame, no decoding & 
+        // exact even without frame pointers.
+        DwarfRegs_t        callerRegs;
+        bool               bCallerExactPC = false;
+        UnwindMethod_t     iMethod        = UnwindMethod_FramePointer;
+        UnwindStepResult_t iStepResult    = StepWithFramePointer(g_memRegionHandler, regs, bExactPC, 
+                iLiveStackLow, iLiveStackHigh, callerRegs);
 
-    allocator.FreeAll();
+        if(iStepResult != UnwindStep_Ok)
+        {
+            iMethod     = UnwindMethod_CFI;
+            iStepResult = StepWithCFI(g_memRegionHandler, regs, bExactPC, callerRegs, bCallerExactPC, iLiveStackLow, iLiveStackHigh);
+            if(iStepResult == UnwindStep_EndOfStack)
+                break;
+        }
 
-    return true;
-}
+        // JIT code has no unwind info, but might have been registered with its frame layout.
+        if(iStepResult != UnwindStep_Ok && StepWithJitFrame(g_memRegionHandler, regs, bExactPC, iLiveStackLow, iLiveStackHigh, callerRegs) == UnwindStep_Ok)
+        {
+            iMethod        = UnwindMethod_JitFrame;
+            iStepResult    = UnwindStep_Ok;
+            bCallerExactPC = false;
+        }
 
+        uintptr_t iReturnAdrs = callerRegs.Get(DwarfReg_RA);
+        if(iStepResult != UnwindStep_Ok)
+        {
+            // No usable unwind info, follow the code to its RETN & work out the frame from that.
+            StackFrame_t stackFrame;
+            stackFrame.m_regs = regs;
 
-///////////////////////////////////////////////////////////////////////////
-///////////////////////////////////////////////////////////////////////////
-static bool DeadStop::WriteFnChainToFile(std::fstream& hFile, const std::vector<uintptr_t>& vecCallStack)
-{
-    if(vecCallStack.empty() == true)
-        return false;
+            iReturnAdrs    = GetReturnAdrs(codeWindow, callStack.Back(), bExactPC, stackFrame);
+            iMethod        = UnwindMethod_Heuristic;
+            callerRegs     = stackFrame.m_regs;
+            bCallerExactPC = false;
 
+            if(bExactPC == false && iReturnAdrs != 0)
+                NoteFramePointerUse(g_memRegionHandler, regs.Get(DwarfReg_RA), stackFrame.m_bFramePointer);
+        }
 
-    DoBranding(hFile); hFile << "Call Stack : \n";
-    for(size_t iFnIndex = 0; iFnIndex < vecCallStack.size(); iFnIndex++)
-    {
-        hFile << "    "; // Indentation.
-        hFile << iFnIndex << ". ";
-        hFile << std::uppercase << std::hex << "0x" << vecCallStack[iFnIndex] << std::nouppercase << std::dec;
-        if(iFnIndex == 0)
-            hFile << " <--[ crashed here ]";
+        // Nothing could step this frame. Whatever a call left up the stack is a guess, but keeps the rest of the stack.
+        if(iReturnAdrs == 0 || g_memRegionHandler.HasExecutableRegion(iReturnAdrs) == false)
+        {
+            if(StepWithStackScan(g_memRegionHandler, regs, iLiveStackLow, iLiveStackHigh, callerRegs) != UnwindStep_Ok)
+            {
+                // Maps snapshot might just be older than the code it came from.
+                if(iReturnAdrs != 0 && g_memRegionHandler.FindParentRegion(iReturnAdrs, MemRegionFlag_None) == nullptr)
+                    callStack.m_iUnknownAdrs = iReturnAdrs;
 
-        hFile << '\n';
-    }
-    hFile << '\n';
+                break;
+            }
 
+            iReturnAdrs    = callerRegs.Get(DwarfReg_RA);
+            iMethod        = UnwindMethod_StackScan;
+            bCallerExactPC = false;
+        }
 
-    std::stringstream ssTemp;
-    int iAsmDumpRange = DeadStop_t::GetInstance().GetAsmDumpRange();
-    for(size_t iFnIndex = 0; iFnIndex < vecCallStack.size(); iFnIndex++)
-    {
-        ssTemp.clear(); ssTemp.str("");
-        ssTemp << "Function Index : " << iFnIndex << ". Adrs : 0x" << std::uppercase << std::hex << vecCallStack[iFnIndex] << std::nouppercase << std::dec;
-        StartBanner(hFile, ssTemp.str().c_str());
+        LOG("Call index %d processed. Return address detected : %p ( %s )\n", i, iReturnAdrs, GetUnwindMethodName(iMethod));
 
-        if(DumpAssembly(hFile, vecCallStack[iFnIndex], iAsmDumpRange, iFnIndex == 0 ? "Crashed Here" : "Return Adrs") == false)
+        if(callStack.Push(iReturnAdrs, iMethod) == false)
             break;
 
-        EndBanner(hFile, ssTemp.str().c_str());
-        hFile << '\n';
+        regs     = callerRegs;
+        bExactPC = bCallerExactPC;
     }
 
-    
+    callStack.m_iUnwindTimeNs = GetMonotonicTimeInNs() - iStartTime;
+    callStack.m_nCachedPlans  = GetUnwindPlanHitCount() - nStartHits;
     return true;
 }
 
 
 ///////////////////////////////////////////////////////////////////////////
 ///////////////////////////////////////////////////////////////////////////
-static uintptr_t DeadStop::GetReturnAdrs(uintptr_t iStartPos, ArenaAllocator_t& allocator, StackFrame_t& iStackFrame)
+DEADSTOP_CRASH_PATH
+ErrCodes_t DeadStop::UnwindStack(const DwarfRegs_t& regs, int iSkipFrames, DeadStopFrame_t* pFrames, int iMaxFrames, int& nFramesOut)
 {
-    if(DeadStop_t::GetInstance().IsInitialized() == false)
-        return 0;
+    nFramesOut = 0;
+    if(DeadStop_t::GetInstance().IsInitialized() == false || s_crash.m_pCallStack == nullptr)
+        return ErrCode_NotInitialized;
+
+    if(pFrames == nullptr || iMaxFrames <= 0 || iSkipFrames < 0 || regs.IsValid(DwarfReg_RA) == false)
+        return ErrCode_InvalidArgs;
 
-    
-    // Rolling buffer for valid instruction pointers.
-    constexpr size_t MAX_ADRS_BUFFER = 10;
-    std::deque<uintptr_t> qValidInstAdrs;
-    qValidInstAdrs.push_back(iStartPos);
 
+    pid_t      iThreadID     = static_cast<pid_t>(syscall(SYS_gettid));
+    uint32_t   iMapsSequence = 0;
+    ErrCodes_t iErrCode      = EnterCapture(iThreadID, iMapsSequence);
+    if(iErrCode != ErrCode_Success)
+        return iErrCode;
 
-    constexpr size_t DASM_BATCH_SIZE = 200;
-    std::vector<InsaneDASM64::Byte> vecBytes(DASM_BATCH_SIZE);
-    std::vector<InsaneDASM64::Instruction_t> vecInst;
+    // Captures aren't crashes, nobody wants every frame on the console.
+    bool bWasMuted = Console::SetThreadMuted(true);
 
+    // This capture's own scratch, nothing in here is shared with other captures or the crash path.
+    CallStack_t  callStack;
+    uint8_t      iCodeBytes[CAPTURE_CODE_WINDOW_SIZE];
+    CodeWindow_t codeWindow;
+    codeWindow.SetStorage(iCodeBytes, sizeof(iCodeBytes));
 
-    int64_t iPushPopOffset = 0; // How much have Push & Pop instuctions moved RSP in between StartPos to RETN inst.
-    bool    bRetFound      = false;
-    size_t  iTotalValidInst = 0;
-    for(int i = 0; i < 100; i++)
+
+    // Maps are only read again when the stack leads somewhere they don't know about, i.e. into
+    // something mapped since. Reading them is most of what a capture costs otherwise.
+    bool bMapsReloaded = false;
+    if(s_bCaptureMapsLoaded == false || g_memRegionHandler.FindParentRegion(regs.Get(DwarfReg_RA), MemRegionFlag_None) == nullptr)
     {
-        uintptr_t iBatchStartAdrs = qValidInstAdrs.back();
-        uintptr_t iBatchEndAdrs   = iBatchStartAdrs + DASM_BATCH_SIZE;
+        iErrCode = ReloadCaptureMaps(iThreadID, iMapsSequence);
+        if(iErrCode != ErrCode_Success)
+        {
+            Console::SetThreadMuted(bWasMuted);
+            return iErrCode;
+        }
 
-        // Check if batch lies in valid memory or not.
-        if(g_memRegionHandler.HasParentRegion(iBatchStartAdrs, iBatchEndAdrs) == false)
-            break;
+        bMapsReloaded = true;
+    }
 
+    int iMaxDepth = iMaxFrames + iSkipFrames - 1;
+    if(iMaxDepth > MAX_CALL_STACK_DEPTH)
+        iMaxDepth = MAX_CALL_STACK_DEPTH;
 
-        // Store bytes.
-        vecBytes.clear();
-        for(size_t iByteIndex = 0; iByteIndex < DASM_BATCH_SIZE; iByteIndex++)
+    Analyze(callStack, codeWindow, regs, iMaxDepth);
+    if(callStack.m_iUnknownAdrs != 0 && bMapsReloaded == false)
+    {
+        // Stack we have is still good if the maps can't be had now.
+        iErrCode = ReloadCaptureMaps(iThreadID, iMapsSequence);
+        if(iErrCode == ErrCode_NotInitialized)
         {
-            vecBytes.push_back(*(reinterpret_cast<InsaneDASM64::Byte*>(iBatchStartAdrs) + iByteIndex));
+            Console::SetThreadMuted(bWasMuted);
+            return iErrCode;
         }
-        assertion(vecBytes.size() == DASM_BATCH_SIZE);
- 
 
-        // Decoder using bytes.
-        vecInst.clear(); allocator.ResetAllArena();
-        if(InsaneDASM64::Decode(vecBytes, vecInst, allocator) != InsaneDASM64::IDASMErrorCode_Success)
-            break;
+        if(iErrCode == ErrCode_Success)
+            Analyze(callStack, codeWindow, regs, iMaxDepth);
+    }
 
 
-        iTotalValidInst += vecInst.size();
+    for(int iFrame = iSkipFrames; iFrame < callStack.m_nFrames && nFramesOut < iMaxFrames; iFrame++)
+    {
+        pFrames[nFramesOut].m_pAdrs   = reinterpret_cast<void*>(callStack.m_iFrames[iFrame]);
+        pFrames[nFramesOut].m_iMethod = static_cast<DeadStopUnwindMethod_t>(callStack.m_iMethods[iFrame]);
+        nFramesOut++;
+    }
 
-        // Find return statement.
-        for(size_t iInstIndex = 0; iInstIndex < vecInst.size(); iInstIndex++)
-        {
-            InsaneDASM64::Instruction_t& inst = vecInst[iInstIndex];
-            int iInstLength = 0;
-            switch (inst.m_iInstEncodingType) 
-            {
-                case InsaneDASM64::Instruction_t::InstEncodingType_Legacy:
-                    {
-                        InsaneDASM64::Legacy::LegacyInst_t* pLegacyInst =
-                            reinterpret_cast<InsaneDASM64::Legacy::LegacyInst_t*>(inst.m_pInst);
-
-                        if(InsaneDASM64::Standard::OpCodeDesc_t* pOpcdDesc = pLegacyInst->m_opCode.m_pOpCodeDesc; pOpcdDesc != nullptr)
-                        {
-                            if(CaseInsensitiveStringMatch(pOpcdDesc->m_szName, "PUSH") == true)
-                                iPushPopOffset -= 8;
-                            else if(CaseInsensitiveStringMatch(pOpcdDesc->m_szName, "POP") == true)
-                                iPushPopOffset += 8;
-                        }
-
-
-                        iInstLength += pLegacyInst->GetInstLengthInBytes();
-                    }
-                    break;
-                case InsaneDASM64::Instruction_t::InstEncodingType_VEX:
-                    iInstLength += reinterpret_cast<InsaneDASM64::VEX::VEXInst_t*>(inst.m_pInst)->GetInstLengthInBytes();
-                    break;
-                case InsaneDASM64::Instruction_t::InstEncodingType_EVEX:
-                    iInstLength += reinterpret_cast<InsaneDASM64::EVEX::EVEXInst_t*>(inst.m_pInst)->GetInstLengthInBytes();
-                    break;
-
-                    // Can happen for instructions whose full byte weren't feed.
-                case InsaneDASM64::Instruction_t::InstEncodingType_Invalid: iInstLength = 1; break;
-                default: continue;
-            }
-            
-
-            qValidInstAdrs.push_back(qValidInstAdrs.back() + iInstLength);
-            if(qValidInstAdrs.size() > MAX_ADRS_BUFFER)
-                qValidInstAdrs.pop_front();
+    Console::SetThreadMuted(bWasMuted);
+    if(iErrCode == ErrCode_Success)
+        LeaveCapture();
 
+    return ErrCode_Success;
+}
 
-            if(inst.m_iInstEncodingType != InsaneDASM64::Instruction_t::InstEncodingType_Legacy)
-                continue;
 
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+void DeadStop::OpenCaptures()
+{
+    s_bCaptureMapsLoaded = false;
+    s_bCapturesOpen.store(true, std::memory_order_seq_cst);
+}
 
-            InsaneDASM64::Legacy::LegacyInst_t* pInst = reinterpret_cast<InsaneDASM64::Legacy::LegacyInst_t*>(inst.m_pInst);
-            if(pInst->m_opCode.m_pOpCodeDesc == nullptr)
-            {
-                FAIL_LOG("Incomplete inst found. Skipping.");
-                continue;
-            }
 
-            // RETN instuction.
-            // if(pInst->m_opCode.m_pOpCodeDesc->m_iByte == 0xC3 && pInst->m_opCode.m_nOpBytes == 1)
-            if(strcmp(pInst->m_opCode.m_pOpCodeDesc->m_szName, "RETN") == 0)
-            {
-                LOG("Found \"RETN\" instruction @ address : %p. [ %zu / %zu ] OpCode : 0x%02X",
-                        qValidInstAdrs.back() - static_cast<uintptr_t>(iInstLength), 
-                        iInstIndex + iTotalValidInst, vecInst.size() + iTotalValidInst,
-                        pInst->m_opCode.m_opBytes[0]);
-                bRetFound = true;
-                break;
-            }
-        }
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+void DeadStop::CloseCaptures()
+{
+    s_bCapturesOpen.store(false, std::memory_order_seq_cst);
 
-        if(bRetFound == true)
-            break;
+    // Captures that got in before, & reloads they started. One this thread is inside of ( called from a
+    // handler that interrupted it ) can't be waited for.
+    pid_t iThreadID = static_cast<pid_t>(syscall(SYS_gettid));
+    while(s_nActiveCaptures.load(std::memory_order_seq_cst) > t_nCaptureDepth ||
+            ((s_iMapsSequence.load(std::memory_order_seq_cst) & 1) != 0 && s_iMapsWriter.load(std::memory_order_relaxed) != iThreadID))
+    {
+        sched_yield();
     }
+}
 
 
-    if(bRetFound == false)
-        return 0;
-
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+DEADSTOP_CRASH_PATH
+static ErrCodes_t DeadStop::EnterCapture(pid_t iThreadID, uint32_t& iMapsSequenceOut)
+{
+    uint64_t iDeadline = GetMonotonicTimeInNs() + CAPTURE_WAIT_NS;
+    while(true)
+    {
+        // Counted in first, then checked. Reloads & CloseCaptures() do it the other way around, so
+        // either they see us or we see them.
+        s_nActiveCaptures.fetch_add(1, std::memory_order_seq_cst);
+        t_nCaptureDepth++;
 
-    LOG("A PushPop offset of [ %ld ] is determined", iPushPopOffset);
+        if(s_bCapturesOpen.load(std::memory_order_seq_cst) == false)
+        {
+            LeaveCapture();
+            return ErrCode_NotInitialized;
+        }
 
+        iMapsSequenceOut = s_iMapsSequence.load(std::memory_order_seq_cst);
+        if((iMapsSequenceOut & 1) == 0)
+            return ErrCode_Success;
 
-    // Store fresh bytes, till RETN inst.
-    vecBytes.clear();
-    vecInst.clear();
-    allocator.ResetAllArena();
-    for(uintptr_t iBatchStart = qValidInstAdrs.front(); iBatchStart < qValidInstAdrs.back(); iBatchStart++)
-        vecBytes.push_back(*reinterpret_cast<InsaneDASM64::Byte*>(iBatchStart));
+        LeaveCapture();
 
 
-    if(InsaneDASM64::Decode(vecBytes, vecInst, allocator) != InsaneDASM64::IDASMErrorCode_Success)
-    {
-        FAIL_LOG("Decoder failed after running over these bytes once. What kind of decoder is this?");
-        return 0;
-    }
+        // Reload is this thread's, a signal handler interrupted it. It won't finish before we do.
+        if(s_iMapsWriter.load(std::memory_order_relaxed) == iThreadID || GetMonotonicTimeInNs() >= iDeadline)
+            return ErrCode_Busy;
 
-    std::vector<InsaneDASM64::DASMInst_t> vecDasmInst;
-    if(InsaneDASM64::Disassemble(vecInst, vecDasmInst) != InsaneDASM64::IDASMErrorCode_Success)
-    {
-        FAIL_LOG("Theortically this can't fail, but I'm afraid this stands no chance against you.");
-        return 0;
+        sched_yield();
     }
+}
 
-    assertion(vecInst.size() == vecDasmInst.size() && "Decoded & Disasembled instruction count doens't match.");
-    // qValidInstAdrs holds memory addresses of consecutive instrutions. when we disassemble from first
-    // entry of qValidInstAdrs to the last entry we get one less instruction than the total entries in qValidInstAdrs, because :
-    // 0, 1, 2, 3, 4, 5         Total 6
-    // 0-1, 1-2, 2-3, 3-4, 4-5, Total 5
-    // i.e. no bytes for last instruction pointer in qValidInstAdrs although the inst. is valid.
-    assertion(qValidInstAdrs.size() - 1 == vecDasmInst.size() && "Valid instruction addresses don't line up with disassembled inst count.");
-
-
-    // Verifying decoding results. Final instruction in the output must be RETN
-    if(strcmp(vecDasmInst.back().m_szMnemonic, "RETN") != 0)
-    {
-        FAIL_LOG("Expected a RETN statement @ the end. But got \"%s\"", vecDasmInst.back().m_szMnemonic);
-        return 0;
-    }
 
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+DEADSTOP_CRASH_PATH
+static void DeadStop::LeaveCapture()
+{
+    t_nCaptureDepth--;
+    s_nActiveCaptures.fetch_sub(1, std::memory_order_seq_cst);
+}
 
-    // if less than 2 instructions between start adrs & RETN inst adrs.
-    // then we caused "signal" in stack frame's epilogue. and thats BS.
-    if(vecInst.size() <= 2)
-        return 0;
 
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+DEADSTOP_CRASH_PATH
+static ErrCodes_t DeadStop::ReloadCaptureMaps(pid_t iThreadID, uint32_t& iMapsSequence)
+{
+    // Reloading means being the only one in, so we step out for it & come back after. Another capture
+    // that reloaded since we got in saves us the trouble.
+    LeaveCapture();
 
-    bool bStackFrameOmitted = true;
-    for(int iInstOffset = 0; iInstOffset < 3; iInstOffset++)
+    bool     bLoaded       = true;
+    uint32_t iPrevSequence = 0;
+    if(BeginMapsReload(iThreadID, CAPTURE_WAIT_NS, false, &iPrevSequence) == true)
     {
-        // This will iterate over index size - 2, size - 3, size - 4.
-        // i.e. second last, before second last, and before before second last.
-        int iInstIndex = static_cast<int>(vecInst.size()) - 2 - iInstOffset;
-
-        if(iInstIndex < 0)
-            break;
+        if(iPrevSequence == iMapsSequence)
+            bLoaded = LoadCaptureMaps();
 
-        InsaneDASM64::Instruction_t* pMagicInst = &vecInst[iInstIndex];
-
-        // Must only have Legacy encoded instructions in stack frame epilogue. 
-        if(pMagicInst->m_iInstEncodingType != InsaneDASM64::Instruction_t::InstEncodingType_Legacy)
-            return 0;
-
-
-        InsaneDASM64::Legacy::LegacyInst_t* pSecondLastInst = 
-            reinterpret_cast<InsaneDASM64::Legacy::LegacyInst_t*>(pMagicInst->m_pInst);
-
-        // If this instrucion is "LEAVE" or "POP rbp", then stack frame is not omitted.
-        int  iInstLength = pSecondLastInst->GetInstLengthInBytes();
-        bool bLeaveInst  = iInstLength == 1 && pSecondLastInst->m_opCode.GetMostSignificantOpCode() == 0xC9; // "LEAVE" inst
-        bool bPopRBP     = iInstLength == 1 && pSecondLastInst->m_opCode.GetMostSignificantOpCode() == 0x5D; // "POP rbp" inst
-
-        if(bLeaveInst == true || bPopRBP == true)
-        {
-            bStackFrameOmitted = false;
-            break;
-        }
+        EndMapsReload(iThreadID);
     }
 
+    ErrCodes_t iErrCode = EnterCapture(iThreadID, iMapsSequence);
+    if(iErrCode != ErrCode_Success)
+        return iErrCode;
 
-    if(bStackFrameOmitted == false)
+    // Whatever snapshot there is will do, as long as there is one.
+    if(s_bCaptureMapsLoaded == false)
     {
-        WIN_LOG("This function has a normal stack frame.");
+        LeaveCapture();
+        return bLoaded == false ? ErrCode_FailedInit : ErrCode_Busy;
+    }
 
-        // At rBP is the pushed rBP (from stack frame prologue.). Next to that is the return adrs.
-        uintptr_t pReturnAdrs = static_cast<uintptr_t>(iStackFrame.m_rBP) + 8;
-        if(g_memRegionHandler.HasParentRegion(pReturnAdrs) == false)
-            return 0;
+    return ErrCode_Success;
+}
 
-        uintptr_t iReturnAdrs = *reinterpret_cast<uintptr_t*>(pReturnAdrs);
-        if(g_memRegionHandler.HasParentRegion(iReturnAdrs) == false)
-            return 0;
 
-        // Modifying stack frame before leaving.
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+DEADSTOP_CRASH_PATH
+static bool DeadStop::BeginMapsReload(pid_t iThreadID, uint64_t iTimeoutNs, bool bForce, uint32_t* pPrevSequenceOut)
+{
+    // One reload at a time. bForce takes over one that doesn't end in time, or right away if its this
+    // thread's ( crashed inside of it ).
+    uint64_t iDeadline = GetMonotonicTimeInNs() + iTimeoutNs;
+    uint32_t iSequence = s_iMapsSequence.load(std::memory_order_acquire);
+    while(true)
+    {
+        if((iSequence & 1) == 0)
         {
-            uintptr_t iOldRBP = *reinterpret_cast<uintptr_t*>(static_cast<uintptr_t>(iStackFrame.m_rBP));
-            if(g_memRegionHandler.HasParentRegion(iOldRBP) == true)
-            {
-                iStackFrame.m_rSP = iStackFrame.m_rBP + 0x10;
-                iStackFrame.m_rBP = static_cast<greg_t>(iOldRBP);
-            }
-        }
+            if(s_iMapsSequence.compare_exchange_weak(iSequence, iSequence + 1, std::memory_order_seq_cst) == true)
+                break;
 
-        return iReturnAdrs;
-    }
+            continue;
+        }
 
-    for(int i = 0; i < vecDasmInst.size(); i++)
-    {
-        printf("%p  ", reinterpret_cast<void*>(qValidInstAdrs[i]));
+        if(s_iMapsWriter.load(std::memory_order_relaxed) == iThreadID || GetMonotonicTimeInNs() >= iDeadline)
+        {
+            if(bForce == false)
+                return false;
 
+            break;
+        }
 
-        InsaneDASM64::DASMInst_t& inst = vecDasmInst[i];
-        printf("%s ", inst.m_szMnemonic);
-        for(int i = 0; i < inst.m_nOperands; i++)
-            printf("%s, ", inst.m_szOperands[i]);
-        printf("\n");
+        sched_yield();
+        iSequence = s_iMapsSequence.load(std::memory_order_acquire);
     }
+    s_iMapsWriter.store(iThreadID, std::memory_order_relaxed);
 
+    if(pPrevSequenceOut != nullptr)
+        *pPrevSequenceOut = iSequence;
 
 
-    // Stack frame omitted.
-    // Iterate from second last to front, and find the first instruction which
-    // modifies the rSP register. Should be the second inst itself in most cases.
-    InsaneDASM64::Legacy::LegacyInst_t* pStackRestoringInst     = nullptr;
-    uintptr_t                           iAdrsStackRestoringInst = 0;
-    for(int iInstIndex = static_cast<int>(vecInst.size()) - 2; iInstIndex >= 0; iInstIndex--)
+    // Captures closed meanwhile, their memory is about to go. Crash leader goes on regardless.
+    if(bForce == false && s_bCapturesOpen.load(std::memory_order_seq_cst) == false)
     {
-        InsaneDASM64::DASMInst_t*    pDasmInst = &vecDasmInst[iInstIndex];
-        InsaneDASM64::Instruction_t* pInst     = &vecInst[iInstIndex];
-        uintptr_t                    iInstAdrs = qValidInstAdrs[iInstIndex];
+        EndMapsReload(iThreadID);
+        return false;
+    }
 
-        // Break @ first rSP modifying instruction.
-        if(pInst->m_iInstEncodingType == InsaneDASM64::Instruction_t::InstEncodingType_Legacy)
+    // Captures that got in before the sequence went odd. This thread's own ( interrupted ) never leave.
+    while(s_nActiveCaptures.load(std::memory_order_seq_cst) > t_nCaptureDepth)
+    {
+        if(GetMonotonicTimeInNs() >= iDeadline)
         {
-            if(pDasmInst->m_nOperands >= 1 && CaseInsensitiveStringMatch(pDasmInst->m_szOperands[0], "rsp") == true)
-            {
-                WIN_LOG("This function has a omitted stack frame. Found rsp modifying instruction. @ %p", iInstAdrs);
-                LOG("%s %s, %s", pDasmInst->m_szMnemonic, pDasmInst->m_szOperands[0], pDasmInst->m_szOperands[1]);
-
-                pStackRestoringInst     = reinterpret_cast<InsaneDASM64::Legacy::LegacyInst_t*>(pInst->m_pInst);
-                iAdrsStackRestoringInst = iInstAdrs;
+            if(bForce == true)
                 break;
-            }
+
+            EndMapsReload(iThreadID);
+            return false;
         }
-    }
 
+        sched_yield();
+    }
 
-    // This function failed both "Normal Stack Frame" & "Omitted Stack Check"
-    // This function must be a leaf function, hence rsp is unchanged.
-    if(pStackRestoringInst == nullptr)
-    {
-        WIN_LOG("This function is a leaf funtion, rSP is constant in this fuction");
+    return true;
+}
 
-        // Push Pop can still occur in leaf fns?
-        uintptr_t pReturnAdrs = static_cast<uintptr_t>(iStackFrame.m_rSP + iPushPopOffset); 
-        if(g_memRegionHandler.HasParentRegion(pReturnAdrs) == false)
-            return 0;
 
-        uintptr_t iReturnAdrs = *reinterpret_cast<uintptr_t*>(pReturnAdrs);
-        if(g_memRegionHandler.HasParentRegion(iReturnAdrs) == false)
-            return 0;
-        
-        // NOTE : No need to modify stack frame here.
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+DEADSTOP_CRASH_PATH
+static void DeadStop::EndMapsReload(pid_t iThreadID)
+{
+    // Crash leader might have taken it over from us, its the leader's then.
+    if(s_iMapsWriter.compare_exchange_strong(iThreadID, 0, std::memory_order_relaxed) == false)
+        return;
 
-        return iReturnAdrs;
-    }
+    s_iMapsSequence.fetch_add(1, std::memory_order_release);
+}
 
 
-    if(pStackRestoringInst->m_opCode.m_pOpCodeDesc == nullptr)
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+DEADSTOP_CRASH_PATH
+static bool DeadStop::LoadCaptureMaps()
+{
+    g_memRegionHandler.SetStorage(s_crash.m_pRegionStorage, s_crash.m_iRegionMemSize);
+    s_bCaptureMapsLoaded = g_memRegionHandler.InitializeFromFile("/proc/self/maps", s_crash.m_pMapsText, s_crash.m_iMapsTextSize);
+    if(s_bCaptureMapsLoaded == true)
     {
-        FAIL_LOG("OpCode description of a Stack restoring instruction for an omitted stack frame function is invalid.");
-        return 0;
+        BuildJitIndex();
+        AddJitRegions(g_memRegionHandler);
     }
 
-    // If stack restoring inst is a "LEA" instruction.
-    if(CaseInsensitiveStringMatch(pStackRestoringInst->m_opCode.m_pOpCodeDesc->m_szName, "LEA") == true)
-    {
-        // No Push Pop offset here, LEA will load the correct adrs at once.
-        uintptr_t pReturnAdrs = reinterpret_cast<uintptr_t>(GetPointerFromModrm(pStackRestoringInst, iAdrsStackRestoringInst));
-        if(g_memRegionHandler.HasParentRegion(pReturnAdrs) == false) // Failed to get return address. 
-            return 0;
+    // Modules could have come, gone or moved, nothing learned about the old ones holds anymore.
+    ClearUnwindModuleCache();
+    ClearUnwindPlanCache();
 
+    return s_bCaptureMapsLoaded;
+}
 
-        iStackFrame.m_rSP = pReturnAdrs + 8;
 
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+DEADSTOP_CRASH_PATH
+static bool DeadStop::WriteFnChainToFile(Writer_t& hFile, const CallStack_t& callStack)
+{
+    if(callStack.m_nFrames <= 0)
+        return false;
 
-        // NOTE: That since this is an omitted stack frame, there is no "push rbp" hence the rsp value
-        // that the LEA inst sets, should point to the return adrs.
-        uintptr_t iReturnAdrs = *reinterpret_cast<uintptr_t*>(pReturnAdrs);
-        if(g_memRegionHandler.HasParentRegion(iReturnAdrs) == false) // We got something, but it seems to be invalid.
-            return 0;
 
-        return iReturnAdrs;
-    }
-    else if(CaseInsensitiveStringMatch(pStackRestoringInst->m_opCode.m_pOpCodeDesc->m_szName, "ADD") == true)
+    DoBranding(hFile); hFile.Write("Call Stack : \n");
+    for(int iFnIndex = 0; iFnIndex < callStack.m_nFrames; iFnIndex++)
     {
-        // just for ease of writting.
-        InsaneDASM64::Legacy::LegacyInst_t* pInst = pStackRestoringInst;
-
-        if(pInst->m_opCode.m_pOpCodeDesc->m_nOperands != 2)
-           return 0;
-
-        InsaneDASM64::Standard::OpCodeDesc_t* pOpcdDesc = pInst->m_opCode.m_pOpCodeDesc;
-
-        if(pOpcdDesc->m_operands[1].m_iOperandCatagory != InsaneDASM64::Standard::Operand_t::OperandCatagory_Legacy)
-            return 0;
+        hFile.Write("    "); // Indentation.
+        hFile.WriteDec(iFnIndex).Write(". ");
+        hFile.Write("0x").WriteHex(callStack.m_iFrames[iFnIndex]);
+        if(iFnIndex == 0)
+            hFile.Write(" <--[ crashed here ]");
+        else
+            hFile.Write(" ( ").Write(GetUnwindMethodName(static_cast<UnwindMethod_t>(callStack.m_iMethods[iFnIndex]))).Write(" )");
 
+        WriteJitName(hFile, callStack.m_iFrames[iFnIndex], iFnIndex != 0);
+        if(callStack.m_iMethods[iFnIndex] == UnwindMethod_StackScan)
+            hFile.Write(" <--[ low confidence ]");
 
-        // NOTE : I have checked and only these 3 types of operand addressing methods are 
-        // available for "ADD" instruction's second operand.
-        intptr_t iRSPOffset = 0;
-        if(pOpcdDesc->m_operands[1].m_iOperandMode == InsaneDASM64::Standard::OperandMode_G)
-        {
-            if(pInst->m_bHasModRM == false)
-                return 0;
+        hFile.Write('\n');
+    }
 
-            iRSPOffset = g_pContext->uc_mcontext.gregs[s_regIndexToEnum[pInst->ModRM_Reg()]];
-        }
-        else if(pOpcdDesc->m_operands[1].m_iOperandMode == InsaneDASM64::Standard::OperandMode_E)
-        {
-            iRSPOffset = reinterpret_cast<intptr_t>(GetPointerFromModrm(pInst, iAdrsStackRestoringInst));
-        }
-        else if(pOpcdDesc->m_operands[1].m_iOperandMode == InsaneDASM64::Standard::OperandMode_I)
-        {
-            // NOTE : Doing it this way, will handle sign/zero extension & endian.
-            int64_t iImmediate = 0;
-            switch(pInst->m_immediate.ByteCount())
-            {
-                case 1: iImmediate = static_cast<intptr_t>(static_cast<int8_t>(pInst->m_immediate.m_immediateByte[0])); break;
-                case 2: iImmediate = static_cast<intptr_t>(*reinterpret_cast<int16_t*>(&pInst->m_immediate.m_immediateByte[0])); break;
-                case 4: iImmediate = static_cast<intptr_t>(*reinterpret_cast<int32_t*>(&pInst->m_immediate.m_immediateByte[0])); break;
-                case 8: iImmediate = *reinterpret_cast<intptr_t*>(&pInst->m_immediate.m_immediateByte[0]); break;
 
-                default: iImmediate = 0; break;
-            }
+    int nMethodFrames[UnwindMethod_JitFrame + 1] = {};
+    for(int iFnIndex = 1; iFnIndex < callStack.m_nFrames; iFnIndex++)
+        nMethodFrames[callStack.m_iMethods[iFnIndex]]++;
 
-            iRSPOffset = iImmediate;
-        }
+    hFile.Write("    Unwound in ").WriteDec(callStack.m_iUnwindTimeNs / 1000).Write(" us : ");
+    hFile.WriteDec(nMethodFrames[UnwindMethod_FramePointer]).Write(" frame pointer, ");
+    hFile.WriteDec(nMethodFrames[UnwindMethod_CFI]).Write(" cfi, ");
+    hFile.WriteDec(nMethodFrames[UnwindMethod_Heuristic]).Write(" heuristic, ");
+    hFile.WriteDec(nMethodFrames[UnwindMethod_StackScan]).Write(" stack scan, ");
+    if(nMethodFrames[UnwindMethod_JitFrame] > 0)
+        hFile.WriteDec(nMethodFrames[UnwindMethod_JitFrame]).Write(" jit frame, ");
+    hFile.WriteDec(callStack.m_nCachedPlans).Write(" from plan cache\n\n");
 
 
-        uintptr_t pReturnAdrs = iStackFrame.m_rSP + iRSPOffset + iPushPopOffset;
-        if(g_memRegionHandler.HasParentRegion(pReturnAdrs) == false) // Failed to get return address. 
-            return 0;
+    char     szBanner[128];
+    Writer_t ssTemp(szBanner, sizeof(szBanner) - 1); // -1 so we always have room for the null terminator.
+    int iAsmDumpRange = s_crash.m_iAsmDumpRange;
+    for(int iFnIndex = 0; iFnIndex < callStack.m_nFrames; iFnIndex++)
+    {
+        ssTemp.Clear();
+        ssTemp.Write("Function Index : ").WriteDec(iFnIndex).Write(". Adrs : 0x").WriteHex(callStack.m_iFrames[iFnIndex]);
+        szBanner[ssTemp.Size()] = '\0';
+        StartBanner(hFile, szBanner);
 
-        iStackFrame.m_rSP = pReturnAdrs + 8;
+        if(DumpAssembly(hFile, callStack.m_iFrames[iFnIndex], iAsmDumpRange, iFnIndex == 0 ? "Crashed Here" : "Return Adrs") == false)
+            break;
 
-        uintptr_t iReturnAdrs = *reinterpret_cast<uintptr_t*>(pReturnAdrs);
-        if(g_memRegionHandler.HasParentRegion(iReturnAdrs) == false) // We got something, but it seems to be invalid.
-            return 0;
+        EndBanner(hFile, szBanner);
+        hFile.Write('\n');
+    }
 
+    
+    return true;
+}
 
-        return iReturnAdrs;
-    }
 
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+DEADSTOP_CRASH_PATH
+static void DeadStop::WriteJitName(Writer_t& hFile, uintptr_t iAdrs, bool bReturnAdrs)
+{
+    // Return addresses might be right past the end of their range.
+    JitCodeInfo_t code;
+    if(FindJitCode(bReturnAdrs == true ? iAdrs - 1 : iAdrs, code) == false)
+        return;
 
-    return 0;
+    hFile.Write(" [ jit : ").Write(code.m_szName[0] != '\0' ? code.m_szName : "unnamed").Write(" + 0x").WriteHex(iAdrs - code.m_iStart).Write(" ]");
 }
 
 
 ///////////////////////////////////////////////////////////////////////////
 ///////////////////////////////////////////////////////////////////////////
-static bool DeadStop::CaseInsensitiveStringMatch(const char* szString1, const char* szString2)
+DEADSTOP_CRASH_PATH
+static uintptr_t DeadStop::GetReturnAdrs(CodeWindow_t& codeWindow, uintptr_t iStartPos, bool bExactPC, StackFrame_t& stackFrame)
 {
-    if(szString1 == szString2)
-        return true;
+    if(DeadStop_t::GetInstance().IsInitialized() == false)
+        return 0;
 
-    if(szString1 == nullptr ||szString2 == nullptr)
-        return false;
 
-    while(*szString1 != 0 && *szString2 != 0)
+    // Same return address again ( recursion, another capture ), code from it was already followed.
+    StackPlan_t plan;
+    if(FindUnwindPlan(iStartPos, UnwindMethod_Heuristic, plan) == false)
     {
-        char c1 = *szString1++;
-        char c2 = *szString2++;
-
-        // lower case all
-        if(c1 >= 'A' && c1 <= 'Z')
-            c1 = c1 - 'A' + 'a';
+        // Every instruction from here to a RETN goes through the interpreter, which keeps track of
+        // where rSP & the callee saved registers went. Branches & jumps are followed until some
+        // path gets there. Actual registers are only used when it has to.
+        ReturnPathStats_t stats;
+        if(FindReturnPath(g_memRegionHandler, codeWindow, iStartPos, bExactPC == false, &stackFrame.m_regs, plan, stats) == false)
+        {
+            FAIL_LOG("No path to a return from %p, %zu instructions over %zu paths", iStartPos, stats.m_nInsts, stats.m_nPaths);
+            return 0;
+        }
 
-        // lower case all
-        if(c2 >= 'A' && c2 <= 'Z')
-            c2 = c2 - 'A' + 'a';
+        LOG("Found %s @ address : %p, %zu instructions over %zu paths & %zu jumps from %p",
+                stats.m_bTailCall == true ? "tail call" : "\"RETN\" instruction", stats.m_iEndAdrs, stats.m_nInsts, stats.m_nPaths, stats.m_nJumps, iStartPos);
 
-        if(c1 != c2)
-            return false;
+        // Plans that needed actual registers are only good for this frame.
+        InsertUnwindPlan(iStartPos, UnwindMethod_Heuristic, plan);
     }
 
-    return *szString1 == 0 && *szString2 == 0;
+
+    DwarfRegs_t callerRegs;
+    if(ApplyStackPlan(plan, stackFrame.m_regs, callerRegs) == false)
+        return 0;
+
+    uintptr_t iReturnAdrs = callerRegs.Get(DwarfReg_RA);
+    if(g_memRegionHandler.HasExecutableRegion(iReturnAdrs) == false)
+        return 0;
+
+
+    // rBP & return address came off a [ rBP, rIP ] record at rBP, i.e. a normal stack frame.
+    const DwarfRegs_t& regs = stackFrame.m_regs;
+    stackFrame.m_bFramePointer =
+        regs.IsValid(DwarfReg_RBP) == true && callerRegs.IsValid(DwarfReg_RBP) == true &&
+        callerRegs.Get(DwarfReg_RSP) == regs.Get(DwarfReg_RBP) + 16 &&
+        plan.m_regs[DwarfReg_RBP].m_iKind == StackValue_Deref;
+
+    if(stackFrame.m_bFramePointer == true)
+        WIN_LOG("This function has a normal stack frame.");
+
+    stackFrame.m_regs = callerRegs;
+    return iReturnAdrs;
 }
 
 
 ///////////////////////////////////////////////////////////////////////////
 ///////////////////////////////////////////////////////////////////////////
+DEADSTOP_CRASH_PATH
 static bool DeadStop::IsCharPrintable(char c)
 {
     return c >= 32 && c <= 126;
@@ -1305,7 +1874,8 @@ static bool DeadStop::IsCharPrintable(char c)
     
 ///////////////////////////////////////////////////////////////////////////
 ///////////////////////////////////////////////////////////////////////////
-static void DeadStop::DumpGeneralRegisters(std::fstream& hFile)
+DEADSTOP_CRASH_PATH
+static void DeadStop::DumpGeneralRegisters(Writer_t& hFile)
 {
     static const char*  s_szGRegNames[__NGREG] = {
         "REG_R8", "REG_R9", "REG_R10", "REG_R11", "REG_R12", "REG_R13", "REG_R14", "REG_R15",
@@ -1323,23 +1893,16 @@ static void DeadStop::DumpGeneralRegisters(std::fstream& hFile)
 
     StartBanner(hFile, "General Purpose Registers");
 
-    hFile << std::uppercase << std::hex << std::setfill('0');
     for(int iRegIndex = 0; iRegIndex < __NGREG; iRegIndex++)
     {
-        // This register name's size.
-        size_t iRegNameSize = strlen(s_szGRegNames[iRegIndex]);
-
-        hFile << s_szGRegNames[iRegIndex];
-        for(int i = 0; i < iMaxRegNameSize - iRegNameSize; i++) hFile << ' ';
-        hFile << " : " << 
-            std::setfill('0') << std::setw(16) << g_pContext->uc_mcontext.gregs[iRegIndex];
+        hFile.WritePadded(s_szGRegNames[iRegIndex], static_cast<int>(iMaxRegNameSize));
+        hFile.Write(" : ").WriteHex(static_cast<uint64_t>(g_pContext->uc_mcontext.gregs[iRegIndex]), 16);
 
         if(g_pContext->uc_mcontext.gregs[iRegIndex] == 0)
-            hFile << " [ zero ]";
+            hFile.Write(" [ zero ]");
 
-        hFile << std::endl;
+        hFile.Write('\n');
     }
-    hFile << std::nouppercase << std::dec << std::setfill(' ');
 
     EndBanner(hFile, "General Purpose Registers");
 }
@@ -1347,63 +1910,1441 @@ static void DeadStop::DumpGeneralRegisters(std::fstream& hFile)
 
 ///////////////////////////////////////////////////////////////////////////
 ///////////////////////////////////////////////////////////////////////////
-static void DeadStop::DumpDateTime(std::fstream& hFile)
+DEADSTOP_CRASH_PATH
+static void DeadStop::DumpFaultInfo(Writer_t& hFile, int iSignalID, const ThreadStackInfo_t& stackInfo, bool bOnAltStack)
 {
-    std::time_t now       = std::time(nullptr);
-    std::tm*    localTime = std::localtime(&now);
+    // Which stack is this handler running on?
+    DoBranding(hFile); hFile.Write("Handler stack : ").Write(bOnAltStack == true ? "alternate signal stack\n" : "thread's own stack\n");
 
 
-    // Writing date.
-    hFile << "Date { " << localTime->tm_mday << " ";
-    switch(localTime->tm_mon)
+    // Only these two carry a meaningful fault address.
+    if(iSignalID != SIGSEGV && iSignalID != SIGBUS)
+        return;
+
+
+    uintptr_t iFaultAdrs = reinterpret_cast<uintptr_t>(g_pSigInfo->si_addr);
+    DoBranding(hFile); hFile.Write("Fault address : 0x").WriteHex(iFaultAdrs).Write('\n');
+
+    if(stackInfo.m_iStackLow == 0)
     {
-        case 0:  hFile << "January";   break;
-        case 1:  hFile << "Febuary";   break;
-        case 2:  hFile << "March";     break;
-        case 3:  hFile << "April";     break;
-        case 4:  hFile << "May";       break;
-        case 5:  hFile << "June";      break;
-        case 6:  hFile << "July";      break;
-        case 7:  hFile << "August";    break;
-        case 8:  hFile << "September"; break;
-        case 9:  hFile << "October";   break;
-        case 10: hFile << "November";  break;
-        case 11: hFile << "December";  break;
+        DoBranding(hFile); hFile.Write("This thread's stack bounds are unknown. Threads started before DeadStop must call DeadStop_InitializeThread().\n");
+        return;
+    }
+
+
+    uintptr_t iRSP = static_cast<uintptr_t>(g_pContext->uc_mcontext.gregs[REG_RSP]);
+    DoBranding(hFile); hFile.Write("Thread's stack : [ 0x").WriteHex(stackInfo.m_iStackLow).Write(" - 0x").WriteHex(stackInfo.m_iStackHigh).
+        Write(" ], guard size : 0x").WriteHex(stackInfo.m_iGuardSize).Write('\n');
+
+    DoBranding(hFile);
+    if(IsStackGuardHit(stackInfo, iFaultAdrs, iRSP) == true)
+        hFile.Write("Fault address hit the guard page next to this thread's stack. This is a STACK OVERFLOW.\n");
+    else
+        hFile.Write("Fault address is not next to this thread's stack guard.\n");
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+DEADSTOP_CRASH_PATH
+static void DeadStop::DumpDateTime(Writer_t& hFile, int64_t iLocalTime)
+{
+    // NOTE : std::localtime() takes locks & can read timezone files, so we can't use it here.
+    //        Calendar math is done by hand.
+    int64_t iDays      = iLocalTime / 86400;
+    int64_t iSecOfDay  = iLocalTime % 86400;
+    if(iSecOfDay < 0) { iSecOfDay += 86400; iDays--; }
+
+    // Days since 1970-01-01 -> year / month / day. ( Howard Hinnant's civil_from_days )
+    iDays += 719468;
+    int64_t  iEra  = (iDays >= 0 ? iDays : iDays - 146096) / 146097;
+    uint64_t iDoE  = static_cast<uint64_t>(iDays - iEra * 146097);
+    uint64_t iYoE  = (iDoE - iDoE / 1460 + iDoE / 36524 - iDoE / 146096) / 365;
+    uint64_t iDoY  = iDoE - (365 * iYoE + iYoE / 4 - iYoE / 100);
+    uint64_t iMP   = (5 * iDoY + 2) / 153;
+    int64_t  iDay  = static_cast<int64_t>(iDoY - (153 * iMP + 2) / 5 + 1);
+    int64_t  iMon  = static_cast<int64_t>(iMP < 10 ? iMP + 3 : iMP - 9) - 1; // 0 - 11
+    int64_t  iYear = static_cast<int64_t>(iYoE) + iEra * 400 + (iMon <= 1 ? 1 : 0);
+
+    int64_t iHour = iSecOfDay / 3600;
+    int64_t iMin  = (iSecOfDay / 60) % 60;
+    int64_t iSec  = iSecOfDay % 60;
 
-        default: hFile << "Bitch-Ass-Month"; break;
+
+    // Writing date.
+    hFile.Write("Date { ").WriteDec(iDay).Write(' ');
+    switch(iMon)
+    {
+        case 0:  hFile.Write("January");   break;
+        case 1:  hFile.Write("Febuary");   break;
+        case 2:  hFile.Write("March");     break;
+        case 3:  hFile.Write("April");     break;
+        case 4:  hFile.Write("May");       break;
+        case 5:  hFile.Write("June");      break;
+        case 6:  hFile.Write("July");      break;
+        case 7:  hFile.Write("August");    break;
+        case 8:  hFile.Write("September"); break;
+        case 9:  hFile.Write("October");   break;
+        case 10: hFile.Write("November");  break;
+        case 11: hFile.Write("December");  break;
+
+        default: hFile.Write("Bitch-Ass-Month"); break;
     }
-    hFile << " " << (localTime->tm_year + 1900) << " }";
+    hFile.Write(' ').WriteDec(iYear).Write(" }");
 
 
     // Writting time.
-    hFile << " Time { " 
-        << localTime->tm_hour % 12 << ':' 
-        << std::setw(2) << std::setfill('0') <<localTime->tm_min << ':' 
-        << std::setw(2) << std::setfill('0') <<localTime->tm_sec << " "
-        << (localTime->tm_hour >= 12 ? "PM" : "AM")
-        << " }" << std::setfill(' ');
+    hFile.Write(" Time { ").WriteDec(iHour % 12).Write(':')
+        .WriteUDec(static_cast<uint64_t>(iMin), 2).Write(':')
+        .WriteUDec(static_cast<uint64_t>(iSec), 2).Write(' ')
+        .Write(iHour >= 12 ? "PM" : "AM")
+        .Write(" }");
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+DEADSTOP_CRASH_PATH
+static void DeadStop::DoBranding(Writer_t& hFile)
+{
+    hFile.Write(" [ DeadStop ] ");
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+DEADSTOP_CRASH_PATH
+static bool DeadStop::OpenDump(Writer_t& hFile, char* pBuffer, size_t iBufferSize, int& iFdOut, DumpSlabClaim_t& slabClaimOut)
+{
+    iFdOut = -1;
+
+    // Slab? Report goes straight into a slot of it, pBuffer isn't needed.
+    DumpSlab_t& dumpSlab = DeadStop_t::GetInstance().GetDumpSlab();
+    if(dumpSlab.IsOpen() == true)
+    {
+        if(dumpSlab.Claim(slabClaimOut, static_cast<int32_t>(getpid())) == false)
+            return false;
+
+        hFile.Reset(slabClaimOut.m_pData, slabClaimOut.m_iCapacity);
+        return true;
+    }
+
+
+    iFdOut = open(DeadStop_t::GetInstance().GetDumpFilePath().c_str(), O_WRONLY | O_CREAT | O_APPEND | O_CLOEXEC, 0644);
+    if(iFdOut < 0)
+        return false;
+
+    hFile.Reset(pBuffer, iBufferSize, iFdOut);
+    return true;
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+DEADSTOP_CRASH_PATH
+static void DeadStop::CloseDump(Writer_t& hFile, int iFd, const DumpSlabClaim_t& slabClaim)
+{
+    if(iFd >= 0)
+    {
+        hFile.Flush();
+        close(iFd);
+        return;
+    }
+
+    // Slot is full when the writer overflowed, whatever didn't fit is gone.
+    DeadStop_t::GetInstance().GetDumpSlab().Commit(slabClaim, hFile.Size(), hFile.HasOverflowed(), GetLocalTime());
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+DEADSTOP_CRASH_PATH
+static void DeadStop::StartBanner(Writer_t& hFile, const char* szMsg)
+{
+    hFile.Write("[ Start ]------------------------------->  ").Write(szMsg).Write('\n');
 }
 
 
 ///////////////////////////////////////////////////////////////////////////
 ///////////////////////////////////////////////////////////////////////////
-static void DeadStop::DoBranding(std::fstream& hFile)
+DEADSTOP_CRASH_PATH
+static void DeadStop::EndBanner(Writer_t& hFile, const char* szMsg)
 {
-    hFile << " [ DeadStop ] ";
+    hFile.Write("[  End  ]------------------------------->  ").Write(szMsg).Write('\n');
 }
 
 
 ///////////////////////////////////////////////////////////////////////////
 ///////////////////////////////////////////////////////////////////////////
-static void DeadStop::StartBanner(std::fstream& hFile, const char* szMsg)
+DEADSTOP_CRASH_PATH
+static uint64_t DeadStop::GetMonotonicTimeInNs()
 {
-    hFile << "[ Start ]------------------------------->  " << szMsg << std::endl;
+    timespec now; clock_gettime(CLOCK_MONOTONIC, &now);
+    return static_cast<uint64_t>(now.tv_sec) * 1000000000ull + static_cast<uint64_t>(now.tv_nsec);
 }
 
 
 ///////////////////////////////////////////////////////////////////////////
 ///////////////////////////////////////////////////////////////////////////
-static void DeadStop::EndBanner(std::fstream& hFile, const char* szMsg)
+DEADSTOP_CRASH_PATH
+static int64_t DeadStop::GetLocalTime()
 {
-    hFile << "[  End  ]------------------------------->  " << szMsg << std::endl;
+    // UTC offset was saved at initialization.
+    timespec now; clock_gettime(CLOCK_REALTIME, &now);
+    return static_cast<int64_t>(now.tv_sec) + DeadStop_t::GetInstance().GetUTCOffset();
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+DEADSTOP_CRASH_PATH
+static InsaneDASM64::IDASMErrorCode_t DeadStop::DecodeSpan(const CodeSpan_t& codeSpan, ArenaAllocator_t& allocator)
+{
+    // Decoder only reads std::vectors, so the span is staged into m_vecBytes with one bulk copy.
+    // Capacity is reserved for the biggest span we ever decode, so this never allocates.
+    assertion(codeSpan.m_iSize <= s_crash.m_vecBytes.capacity() && "Span is bigger than the reserved decoder input");
+    s_crash.m_vecBytes.assign(codeSpan.m_pBytes, codeSpan.m_pBytes + codeSpan.m_iSize);
+
+    s_crash.m_vecInst.clear(); allocator.ResetAllArena();
+    InsaneDASM64::IDASMErrorCode_t iErrCode = InsaneDASM64::Decode(s_crash.m_vecBytes, s_crash.m_vecInst, allocator);
+    s_crash.m_nDecodeCalls++;
+    NoteDecoderUsage();
+
+    return iErrCode;
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+DEADSTOP_CRASH_PATH
+static InsaneDASM64::IDASMErrorCode_t DeadStop::DisassembleSpan(const CodeSpan_t& codeSpan, ArenaAllocator_t& allocator)
+{
+    s_crash.m_vecDasmInst.clear();
+
+    InsaneDASM64::IDASMErrorCode_t iErrCode = DecodeSpan(codeSpan, allocator);
+    if(iErrCode != InsaneDASM64::IDASMErrorCode_Success)
+        return iErrCode;
+
+    iErrCode = InsaneDASM64::Disassemble(s_crash.m_vecInst, s_crash.m_vecDasmInst);
+    s_crash.m_nDasmCalls++;
+    return iErrCode;
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+DEADSTOP_CRASH_PATH
+static void DeadStop::NoteDecoderUsage()
+{
+    if(s_crash.m_vecInst.size() > s_crash.m_iPeakInst)
+        s_crash.m_iPeakInst = s_crash.m_vecInst.size();
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+DEADSTOP_CRASH_PATH
+static void DeadStop::WriteMemoryUsage(Writer_t& hFile)
+{
+    const CrashArena_t& arena = *s_crash.m_pArena;
+
+    // High water mark, so budget can be sized using real crashes.
+    DoBranding(hFile); hFile.Format("Crash memory : %zu / %zu bytes used at peak", arena.GetHighWaterMark(), arena.GetCapacity());
+    if(arena.GetFailedAllocations() > 0)
+        hFile.Format(", %zu allocations refused. Increase crash memory budget", arena.GetFailedAllocations());
+    hFile.Write('\n');
+
+    DoBranding(hFile); hFile.Format("Memory regions : %zu / %zu", g_memRegionHandler.GetRegionCount(), g_memRegionHandler.GetRegionCapacity());
+    if(g_memRegionHandler.HasOverflowed() == true)
+        hFile.Write(", some regions were dropped. Increase crash memory budget");
+    hFile.Write('\n');
+
+    DoBranding(hFile); hFile.Format("Decoder buffers : %zu / %zu instructions used at peak", s_crash.m_iPeakInst, s_crash.m_iReservedInst);
+    if(s_crash.m_vecInst.capacity() > s_crash.m_iReservedInst || s_crash.m_vecDasmInst.capacity() > s_crash.m_iReservedInst)
+        hFile.Write(", decoder buffers grew while crashing");
+    hFile.Write('\n');
+
+    DoBranding(hFile); hFile.Format("Code window : %zu bytes, %zu reads, %zu served without reading\n",
+            s_crash.m_codeWindow.GetCapacity(), s_crash.m_codeWindow.GetFillCount(), s_crash.m_codeWindow.GetHitCount());
+
+    DoBranding(hFile); hFile.Format("Decoder calls : %zu decode, %zu disassemble\n", s_crash.m_nDecodeCalls, s_crash.m_nDasmCalls);
+
+    DoBranding(hFile); hFile.Format("Unwind plans : %zu / %zu cached, %zu hits, %zu misses",
+            GetUnwindPlanCount(), GetUnwindPlanCapacity(), GetUnwindPlanHitCount(), GetUnwindPlanMissCount());
+    if(GetUnwindPlanFullCount() > 0)
+        hFile.Format(", %zu plans didn't fit", GetUnwindPlanFullCount());
+    hFile.Write('\n');
+
+    if((DeadStop_t::GetInstance().GetFlags() & DeadStopFlag_LockCrashPath) != 0)
+    {
+        const MemoryLockStats_t& lockStats = DeadStop_t::GetInstance().GetMemoryLockStats();
+        DoBranding(hFile); hFile.Format("Locked memory : %zu bytes locked, %zu bytes failed, %zu bytes skipped\n",
+                lockStats.m_iLockedBytes, lockStats.m_iFailedBytes, lockStats.m_iSkippedBytes);
+    }
+
+    DoBranding(hFile); hFile.Format("Safe reads : %s, %zu syscalls, %zu partial / failed reads\n",
+            GetSafeReadMode() == SafeReadMode_ProcessVMReadv ? "process_vm_readv" : "recovery point",
+            GetSafeReadSyscallCount(), GetSafeReadFailCount());
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+DEADSTOP_CRASH_PATH
+[[noreturn]] static void DeadStop::HandleFollowerCrash(CrashSlot_t* pSlot, int iSignalID, siginfo_t* pSigInfo, ucontext_t* pContext)
+{
+    if(pSlot != nullptr)
+        s_crashSlots.CaptureAndPublish(*pSlot, iSignalID, pSigInfo, pContext);
+
+
+    // Leader appends our record & takes the whole process down with _exit(). We never return, returning
+    // would just run the faulting instruction again. We only write our own record if the leader already
+    // finished its report, or seems to be stuck.
+    uint64_t iWaitStart = GetMonotonicTimeInNs();
+    while(true)
+    {
+        bool bTimedOut = GetMonotonicTimeInNs() - iWaitStart > LEADER_WAIT_NS;
+
+        if((s_crashSlots.IsLeaderDone() == true || bTimedOut == true) && pSlot != nullptr && s_crashSlots.TakeForWriting(*pSlot) == true)
+        {
+            // Fits the buffer, so its a single write() & O_APPEND keeps it in one piece.
+            char            szBuffer[4096];
+            Writer_t        hRecord;
+            int             iFd = -1;
+            DumpSlabClaim_t slabClaim;
+            if(OpenDump(hRecord, szBuffer, sizeof(szBuffer), iFd, slabClaim) == true)
+            {
+                if((DeadStop_t::GetInstance().GetFlags() & DeadStopFlag_BinaryRecord) != 0)
+                {
+                    RecordWriter_t record(hRecord);
+                    RecordCrashSlot(record, *pSlot);
+                    EndRecord(record, 0);
+                }
+                else
+                {
+                    WriteCrashSlot(hRecord, *pSlot);
+                }
+                CloseDump(hRecord, iFd, slabClaim);
+            }
+        }
+
+        if(bTimedOut == true)
+            _exit(1);
+
+        timespec pollInterval = { 0, 1000 * 1000 };
+        nanosleep(&pollInterval, nullptr);
+    }
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+DEADSTOP_CRASH_PATH
+static void DeadStop::WriteFollowerRecords(Writer_t& hFile, RecordWriter_t* pRecord)
+{
+    s_crashSlots.WaitForFollowers(s_crashSlots.IsLeaderDone() == true ? 0 : FOLLOWER_WAIT_NS);
+
+    for(size_t iSlotIndex = 0; iSlotIndex < s_crashSlots.GetSlotCount(); iSlotIndex++)
+    {
+        CrashSlot_t* pSlot = s_crashSlots.GetSlot(iSlotIndex);
+        if(s_crashSlots.TakeForWriting(*pSlot) == false)
+            continue;
+
+        if(pRecord != nullptr)
+            RecordCrashSlot(*pRecord, *pSlot);
+        else
+            WriteCrashSlot(hFile, *pSlot);
+    }
+
+    // Only said once, by the sweep before the leader is done. Records keep the count in RecordEnd_t.
+    if(pRecord == nullptr && s_crashSlots.IsLeaderDone() == false && s_crashSlots.GetDroppedCount() > 0)
+    {
+        DoBranding(hFile); hFile.Format("%zu more threads crashed, but all crash slots were taken.\n", s_crashSlots.GetDroppedCount());
+    }
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+DEADSTOP_CRASH_PATH
+static void DeadStop::WriteCrashSlot(Writer_t& hFile, const CrashSlot_t& slot)
+{
+    StartBanner(hFile, "Concurrent Crash");
+
+    DoBranding(hFile); hFile.Format("Thread %d received [ %s ], fault address : 0x%lx\n", 
+            static_cast<int>(slot.m_iThreadID.load(std::memory_order_relaxed)), GetSignalName(slot.m_iSignalID), slot.m_iFaultAdrs);
+    DoBranding(hFile); hFile.Format("rip : 0x%lx  rsp : 0x%lx  rbp : 0x%lx\n", 
+            static_cast<uintptr_t>(slot.m_gregs[REG_RIP]), static_cast<uintptr_t>(slot.m_gregs[REG_RSP]), static_cast<uintptr_t>(slot.m_gregs[REG_RBP]));
+
+    for(int iFrame = 0; iFrame < slot.m_nFrames; iFrame++)
+    {
+        DoBranding(hFile); hFile.Format("  #%-2d 0x%lx\n", iFrame, slot.m_iFrames[iFrame]);
+    }
+
+    EndBanner(hFile, "Concurrent Crash");
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+DEADSTOP_CRASH_PATH
+static const char* DeadStop::GetSignalName(int iSignalID)
+{
+    switch(iSignalID)
+    {
+        case SIGSEGV: return "SIGSEGV";
+        case SIGILL:  return "SIGILL";
+        case SIGTRAP: return "SIGTRAP";
+        case SIGABRT: return "SIGABRT";
+        case SIGFPE:  return "SIGFPE";
+        case SIGBUS:  return "SIGBUS";
+
+        default: break;
+    }
+
+    return "Unknown";
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+DEADSTOP_CRASH_PATH
+static void DeadStop::WriteFiberStacks(Writer_t& hFile, uint64_t iCrashFiberID, RecordWriter_t* pRecord)
+{
+    int iMaxFibers = GetMaxDumpedFibers();
+    if(iMaxFibers <= 0 || GetFiberSlotCount() == 0)
+        return;
+
+    int iMaxFrames = GetMaxFiberFrames();
+    if(iMaxFrames > MAX_CALL_STACK_DEPTH + 1)
+        iMaxFrames = MAX_CALL_STACK_DEPTH + 1;
+
+
+    if(pRecord == nullptr)
+        StartBanner(hFile, "Suspended Fibers");
+    uint64_t iStartTime = GetMonotonicTimeInNs();
+
+    // Crash's own call stack is written already, its storage is reused for every fiber.
+    CallStack_t& callStack = *s_crash.m_pCallStack;
+    int          nUnwound  = 0;
+    size_t       nSkipped  = 0;
+    size_t       nSlots    = GetFiberSlotCount();
+    for(size_t iSlot = 0; iSlot < nSlots; iSlot++)
+    {
+        FiberInfo_t fiber;
+        if(GetFiber(iSlot, fiber) == false || fiber.m_iFiberID == iCrashFiberID)
+            continue;
+
+        if(nUnwound >= iMaxFibers)
+        {
+            nSkipped++;
+            continue;
+        }
+        nUnwound++;
+
+
+        DwarfRegs_t fiberRegs;
+        bool        bHasContext = ReadFiberRegs(fiber, fiberRegs);
+        if(bHasContext == true)
+            Analyze(callStack, s_crash.m_codeWindow, fiberRegs, iMaxFrames - 1, false);
+
+        if(pRecord != nullptr)
+            RecordFiberStack(*pRecord, fiber, bHasContext == true ? &callStack : nullptr);
+        else
+            WriteFiberStack(hFile, fiber, bHasContext == true ? &callStack : nullptr);
+    }
+
+    uint64_t iUnwindTimeNs = GetMonotonicTimeInNs() - iStartTime;
+    if(pRecord != nullptr)
+    {
+        RecordFiberSummary_t summary = { static_cast<uint64_t>(nUnwound), nSkipped, iUnwindTimeNs };
+        pRecord->WriteSection(RecordSection_FiberSummary, &summary, sizeof(summary));
+        return;
+    }
+
+    WriteFiberSummary(hFile, nUnwound, iUnwindTimeNs, nSkipped);
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+DEADSTOP_CRASH_PATH
+static void DeadStop::WriteFiberStack(Writer_t& hFile, const FiberInfo_t& fiber, const CallStack_t* pCallStack)
+{
+    DoBranding(hFile); hFile.Format("Fiber 0x%lx, stack [ 0x%lx, 0x%lx ) :\n", fiber.m_iFiberID, fiber.m_iStackLow, fiber.m_iStackHigh);
+
+    if(pCallStack == nullptr)
+    {
+        hFile.Write("    No saved context, never switched out or already gone.\n");
+        return;
+    }
+
+    const CallStack_t& callStack = *pCallStack;
+    for(int iFrame = 0; iFrame < callStack.m_nFrames; iFrame++)
+    {
+        hFile.Write("    ").WriteDec(iFrame).Write(". 0x").WriteHex(callStack.m_iFrames[iFrame]);
+        if(iFrame == 0)
+            hFile.Write(" <--[ suspended here ]");
+        else
+            hFile.Write(" ( ").Write(GetUnwindMethodName(static_cast<UnwindMethod_t>(callStack.m_iMethods[iFrame]))).Write(" )");
+
+        WriteJitName(hFile, callStack.m_iFrames[iFrame], iFrame != 0);
+        if(callStack.m_iMethods[iFrame] == UnwindMethod_StackScan)
+            hFile.Write(" <--[ low confidence ]");
+
+        hFile.Write('\n');
+    }
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+DEADSTOP_CRASH_PATH
+static void DeadStop::WriteFiberSummary(Writer_t& hFile, int nUnwound, uint64_t iUnwindTimeNs, size_t nSkipped)
+{
+    DoBranding(hFile); hFile.Format("%d fibers unwound in %lu us", nUnwound, iUnwindTimeNs / 1000);
+    if(nSkipped > 0)
+        hFile.Format(", %zu more registered ( see DeadStop_SetFiberDumpLimits() )", nSkipped);
+    hFile.Write('\n');
+
+    EndBanner(hFile, "Suspended Fibers");
+    hFile.Write("\n\n");
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+DEADSTOP_CRASH_PATH
+static bool DeadStop::WriteCrashRecord(Writer_t& hFile, int iSignalID, pid_t iThreadID, uint64_t iCrashFiberID, int64_t iStartTime, uint64_t iHandlerStartTime)
+{
+    // Same as WriteTextReport(), see there.
+    BeginMapsReload(iThreadID, FOLLOWER_WAIT_NS, true, nullptr);
+    if(LoadCrashMaps() == false)
+    {
+        EndMapsReload(iThreadID);
+        return false;
+    }
+
+    UnwindCrashStack();
+
+
+    RecordWriter_t record(hFile);
+    record.Begin();
+
+    const ThreadStackInfo_t* pStackInfo = GetThisThreadStackInfo();
+    RecordCrash_t crash   = {};
+    crash.m_iSignalID       = iSignalID;
+    crash.m_iProcessID      = static_cast<int32_t>(getpid());
+    crash.m_iThreadID       = static_cast<int32_t>(iThreadID);
+    crash.m_iCrashFiberID   = iCrashFiberID;
+    crash.m_iStartTime      = iStartTime;
+    crash.m_iAsmDumpRange   = s_crash.m_iAsmDumpRange;
+    crash.m_iStringDumpSize = s_crash.m_iStringDumpSize;
+    crash.m_iSignatureSize  = s_crash.m_iSignatureSize;
+    crash.m_iStackLow       = pStackInfo->m_iStackLow;
+    crash.m_iStackHigh      = pStackInfo->m_iStackHigh;
+    crash.m_iGuardSize      = pStackInfo->m_iGuardSize;
+    crash.m_iFlags          = RecordCrashFlag_None;
+    if(IsHandlerOnAltStack(*pStackInfo) == true)
+        crash.m_iFlags |= RecordCrashFlag_OnAltStack;
+    if(g_memRegionHandler.IsTextTruncated() == true)
+        crash.m_iFlags |= RecordCrashFlag_MapsTruncated;
+    if(g_memRegionHandler.HasOverflowed() == true)
+        crash.m_iFlags |= RecordCrashFlag_RegionsOverflowed;
+
+    record.WriteSection(RecordSection_Crash,    &crash, sizeof(crash));
+    record.WriteSection(RecordSection_Context,  g_pContext->uc_mcontext.gregs, sizeof(g_pContext->uc_mcontext.gregs));
+    record.WriteSection(RecordSection_SigInfo,  g_pSigInfo, sizeof(siginfo_t));
+    record.WriteSection(RecordSection_MapsText, g_memRegionHandler.GetText(), g_memRegionHandler.GetTextSize());
+
+
+    // Regions as parsed, paths point into the maps text. JIT regions added since have none.
+    const char*        pText    = g_memRegionHandler.GetText();
+    const MemRegion_t* pRegions = g_memRegionHandler.GetAllRegions();
+    size_t             nRegions = g_memRegionHandler.GetRegionCount();
+    record.BeginSection(RecordSection_Regions, nRegions * sizeof(RecordRegion_t));
+    for(size_t iRegion = 0; iRegion < nRegions; iRegion++)
+    {
+        const MemRegion_t& region = pRegions[iRegion];
+        RecordRegion_t     out    = {};
+        out.m_iStart      = region.m_iStart;
+        out.m_iEnd        = region.m_iEnd;
+        out.m_iOffset     = region.m_iOffset;
+        out.m_iInode      = region.m_iInode;
+        out.m_iFlags      = region.m_iFlags;
+        out.m_iPathOffset = region.m_szPath != nullptr ? static_cast<uint32_t>(region.m_szPath - pText) : RECORD_NO_PATH;
+        out.m_iPathLength = static_cast<uint32_t>(region.m_iPathLength);
+        record.WriteBytes(&out, sizeof(out));
+    }
+    record.EndSection();
+
+
+    // Frames, & everything rendering them will want to read.
+    const CallStack_t& callStack = *s_crash.m_pCallStack;
+    RecordCallStack(record, callStack);
+    RecordJitCode  (record, callStack);
+    if(s_crash.m_pMiniCoreRanges != nullptr)
+    {
+        // Slab slot is all the room there is. Mini core gets what's left after what still has to come,
+        // a record running past the slot's end loses its End & with it everything.
+        size_t iRoom = SIZE_MAX;
+        if(hFile.GetFd() < 0)
+        {
+            size_t iUsed = hFile.Size() + GetRecordTailSize();
+            iRoom        = hFile.Capacity() > iUsed ? hFile.Capacity() - iUsed : 0;
+        }
+
+        RecordMiniCore(record, callStack, iSignalID, iRoom);
+    }
+    else
+    {
+        RecordCode       (record, callStack);
+        RecordStackMemory(record);
+    }
+
+
+    WriteFollowerRecords(hFile, &record);
+    WriteFiberStacks(hFile, iCrashFiberID, &record);
+
+    EndRecord(record, iHandlerStartTime);
+    hFile.Flush();
+
+    return true;
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+DEADSTOP_CRASH_PATH
+static void DeadStop::RecordCallStack(RecordWriter_t& record, const CallStack_t& callStack)
+{
+    RecordCallStack_t header = {};
+    header.m_iUnwindTimeNs = callStack.m_iUnwindTimeNs;
+    header.m_nCachedPlans  = callStack.m_nCachedPlans;
+    header.m_nFrames       = static_cast<uint32_t>(callStack.m_nFrames);
+
+    record.BeginSection(RecordSection_CallStack, sizeof(header) + callStack.m_nFrames * sizeof(RecordFrame_t));
+    record.WriteBytes(&header, sizeof(header));
+    RecordFrames(record, callStack);
+    record.EndSection();
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+DEADSTOP_CRASH_PATH
+static void DeadStop::RecordFrames(RecordWriter_t& record, const CallStack_t& callStack)
+{
+    for(int iFrame = 0; iFrame < callStack.m_nFrames; iFrame++)
+    {
+        RecordFrame_t frame = { callStack.m_iFrames[iFrame], callStack.m_iMethods[iFrame], 0 };
+        record.WriteBytes(&frame, sizeof(frame));
+    }
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+DEADSTOP_CRASH_PATH
+static void DeadStop::RecordCode(RecordWriter_t& record, const CallStack_t& callStack)
+{
+    for(int iFrame = 0; iFrame < callStack.m_nFrames; iFrame++)
+    {
+        // Recursion, same code again.
+        uintptr_t iPivot    = callStack.m_iFrames[iFrame];
+        bool      bRecorded = false;
+        for(int iPrev = 0; iPrev < iFrame && bRecorded == false; iPrev++)
+            bRecorded = callStack.m_iFrames[iPrev] == iPivot;
+
+        if(bRecorded == true || g_memRegionHandler.HasExecutableRegion(iPivot) == false)
+            continue;
+
+
+        // Whatever DumpAssembly() will want, it shrinks to 100 bytes each side the same way.
+        uintptr_t iRange = static_cast<uintptr_t>(s_crash.m_iAsmDumpRange);
+        if(iPivot <= iRange)
+            continue;
+
+        if(g_memRegionHandler.HasExecutableRegion(iPivot - iRange, iPivot + iRange) == false && iRange > 100)
+            iRange = 100;
+
+        if(g_memRegionHandler.HasExecutableRegion(iPivot - iRange, iPivot + iRange) == false)
+            continue;
+
+        CodeSpan_t codeSpan = s_crash.m_codeWindow.Get(iPivot - iRange, 2 * iRange);
+        if(codeSpan.m_iSize > 0)
+            RecordMemory(record, RecordMemory_Code, codeSpan.m_iAdrs, codeSpan.m_pBytes, codeSpan.m_iSize);
+    }
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+DEADSTOP_CRASH_PATH
+static void DeadStop::RecordStackMemory(RecordWriter_t& record)
+{
+    uintptr_t iRSP       = static_cast<uintptr_t>(g_pContext->uc_mcontext.gregs[REG_RSP]);
+    uintptr_t iStackHigh = GetCrashStackHigh(iRSP);
+
+
+    // Red zone below rSP too, unless that's the guard page ( stack overflow ).
+    uintptr_t iStackLow = iRSP > STACK_RED_ZONE_SIZE ? iRSP - STACK_RED_ZONE_SIZE : iRSP;
+    size_t    nRead     = 0;
+    size_t    iMarker   = s_crash.m_pArena->GetMarker();
+    uint8_t*  pStack    = s_crash.m_pArena->AllocateArray<uint8_t>(RECORD_STACK_SLICE_SIZE);
+    for(int iAttempt = 0; iAttempt < 2 && pStack != nullptr && nRead == 0; iAttempt++)
+    {
+        if(iAttempt == 1)
+            iStackLow = iRSP;
+
+        size_t iSize = RECORD_STACK_SLICE_SIZE;
+        if(iStackHigh > iStackLow && iStackHigh - iStackLow < iSize)
+            iSize = iStackHigh - iStackLow;
+
+        nRead = SafeRead(pStack, iStackLow, iSize);
+    }
+
+    if(nRead > 0)
+        RecordMemory(record, RecordMemory_Stack, iStackLow, pStack, nRead);
+    s_crash.m_pArena->ResetToMarker(iMarker);
+
+
+    // Whatever the general registers point at, where string references in the disassembly lead.
+    constexpr int nPointerRegs = static_cast<int>(sizeof(s_iPointerRegs) / sizeof(s_iPointerRegs[0]));
+
+    for(int iReg = 0; iReg < nPointerRegs; iReg++)
+    {
+        uintptr_t iAdrs = static_cast<uintptr_t>(g_pContext->uc_mcontext.gregs[s_iPointerRegs[iReg]]);
+        if(iAdrs >= iStackLow && iAdrs < iStackLow + nRead)
+            continue;
+
+        bool bRecorded = false;
+        for(int iPrev = 0; iPrev < iReg && bRecorded == false; iPrev++)
+            bRecorded = static_cast<uintptr_t>(g_pContext->uc_mcontext.gregs[s_iPointerRegs[iPrev]]) == iAdrs;
+
+        if(bRecorded == true || g_memRegionHandler.HasParentRegion(iAdrs) == false)
+            continue;
+
+        uint8_t window[RECORD_REG_WINDOW_SIZE];
+        size_t  nWindow = SafeRead(window, iAdrs, sizeof(window));
+        if(nWindow > 0)
+            RecordMemory(record, RecordMemory_Register, iAdrs, window, nWindow);
+    }
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+DEADSTOP_CRASH_PATH
+static void DeadStop::RecordMiniCore(RecordWriter_t& record, const CallStack_t& callStack, int iSignalID, size_t iRoom)
+{
+    uint64_t        iStartTime = GetMonotonicTimeInNs();
+    size_t          iSizeLimit = s_crash.m_iMiniCoreSize < iRoom ? s_crash.m_iMiniCoreSize : iRoom;
+    MiniCorePlan_t& plan       = s_crash.m_miniCore;
+    plan.Reset(s_crash.m_pMiniCoreRanges, MAX_MINI_CORE_RANGES, iSizeLimit);
+
+
+    // Stack first, every frame's locals & spills live there. Red zone too, unless that's the guard
+    // page ( stack overflow ). Stack bounds unknown, its mapping will do.
+    const ThreadStackInfo_t* pStackInfo = GetThisThreadStackInfo();
+    uintptr_t iRSP        = static_cast<uintptr_t>(g_pContext->uc_mcontext.gregs[REG_RSP]);
+    uintptr_t iStackStart = iRSP;
+    uintptr_t iStackHigh  = GetCrashStackHigh(iRSP);
+    if(iStackHigh == 0 && iRSP < pStackInfo->m_iStackLow && IsStackGuardHit(*pStackInfo, iRSP, iRSP) == true)
+    {
+        // Overflowed, rSP is in the guard & the deepest frames start right above it.
+        iStackStart = pStackInfo->m_iStackLow;
+        iStackHigh  = pStackInfo->m_iStackHigh;
+    }
+    else if(iStackHigh == 0)
+    {
+        const MemRegion_t* pRegion = g_memRegionHandler.FindParentRegion(iRSP, MemRegionFlag_Read | MemRegionFlag_Write);
+        iStackHigh = pRegion != nullptr ? pRegion->m_iEnd : 0;
+    }
+
+    if(iStackHigh > iStackStart)
+    {
+        uintptr_t iStackLow = iStackStart;
+        if(iStackStart > STACK_RED_ZONE_SIZE && g_memRegionHandler.HasParentRegion(iStackStart - STACK_RED_ZONE_SIZE, iStackStart) == true)
+            iStackLow = iStackStart - STACK_RED_ZONE_SIZE;
+
+        uintptr_t iStackEnd = iStackHigh - iStackStart > s_crash.m_iMiniCoreStack ? iStackStart + s_crash.m_iMiniCoreStack : iStackHigh;
+        plan.Add(iStackLow, iStackEnd, RecordMemory_Stack);
+    }
+
+
+    // Fault address, then what the registers point at. Only the two signals with a meaningful one.
+    if(iSignalID == SIGSEGV || iSignalID == SIGBUS)
+        PlanMiniCorePages(plan, reinterpret_cast<uintptr_t>(g_pSigInfo->si_addr), RecordMemory_Fault);
+
+    for(int iReg : s_iPointerRegs)
+        PlanMiniCorePages(plan, static_cast<uintptr_t>(g_pContext->uc_mcontext.gregs[iReg]), RecordMemory_Register);
+
+
+    // Code pages around each frame, at least what DumpAssembly() will want. Innermost frames first.
+    uintptr_t iRange = static_cast<uintptr_t>(s_crash.m_iAsmDumpRange);
+    for(int iFrame = 0; iFrame < callStack.m_nFrames; iFrame++)
+    {
+        uintptr_t          iPivot  = callStack.m_iFrames[iFrame];
+        const MemRegion_t* pRegion = g_memRegionHandler.FindParentRegion(iPivot, MemRegionFlag_Read | MemRegionFlag_Exec);
+        if(pRegion == nullptr || iPivot <= iRange)
+            continue;
+
+        uintptr_t iStart = (iPivot - iRange) & ~(MINI_CORE_PAGE_SIZE - 1);
+        uintptr_t iEnd   = (iPivot + iRange + MINI_CORE_PAGE_SIZE - 1) & ~(MINI_CORE_PAGE_SIZE - 1);
+        plan.Add(iStart > pRegion->m_iStart ? iStart : pRegion->m_iStart, iEnd < pRegion->m_iEnd ? iEnd : pRegion->m_iEnd, RecordMemory_Code);
+    }
+
+
+    // Read out a chunk at a time. Pages that fail to read ( truncated file mapping ) are skipped.
+    RecordMiniCore_t miniCore = {};
+    miniCore.m_iStackLimit    = s_crash.m_iMiniCoreStack;
+    miniCore.m_iSizeLimit     = iSizeLimit;
+    miniCore.m_iSkippedBytes  = plan.GetSkippedBytes();
+
+    // Every chunk costs its section headers too, those come out of iRoom as well.
+    constexpr size_t iChunkOverhead = sizeof(RecordSection_t) + sizeof(RecordMemory_t) + RECORD_ALIGNMENT;
+    size_t           iWritten       = 0;
+
+    size_t   iMarker = s_crash.m_pArena->GetMarker();
+    uint8_t* pChunk  = s_crash.m_pArena->AllocateArray<uint8_t>(MINI_CORE_CHUNK_SIZE);
+    for(size_t iPlanned = 0; iPlanned < plan.GetRangeCount(); iPlanned++)
+    {
+        const MiniCoreRange_t& range   = plan.GetRanges()[iPlanned];
+        uintptr_t              iCursor = range.m_iStart;
+        while(iCursor < range.m_iEnd)
+        {
+            size_t iSize = range.m_iEnd - iCursor < MINI_CORE_CHUNK_SIZE ? range.m_iEnd - iCursor : MINI_CORE_CHUNK_SIZE;
+            if(iWritten + iChunkOverhead + iSize > iRoom)
+                iSize = iRoom > iWritten + iChunkOverhead ? iRoom - iWritten - iChunkOverhead : 0;
+
+            if(iSize == 0)
+            {
+                miniCore.m_iSkippedBytes += range.m_iEnd - iCursor;
+                break;
+            }
+
+            size_t nRead = pChunk != nullptr ? SafeRead(pChunk, iCursor, iSize) : 0;
+            if(nRead == 0)
+            {
+                uintptr_t iNextPage = (iCursor & ~(MINI_CORE_PAGE_SIZE - 1)) + MINI_CORE_PAGE_SIZE;
+                if(iNextPage > range.m_iEnd)
+                    iNextPage = range.m_iEnd;
+
+                miniCore.m_iSkippedBytes += iNextPage - iCursor;
+                iCursor                   = iNextPage;
+                continue;
+            }
+
+            RecordMemory(record, static_cast<RecordMemoryKind_t>(range.m_iKind), iCursor, pChunk, nRead);
+            miniCore.m_iCapturedBytes += nRead;
+            iCursor                   += nRead;
+            iWritten                  += iChunkOverhead + nRead;
+        }
+    }
+    s_crash.m_pArena->ResetToMarker(iMarker);
+
+    miniCore.m_iCaptureTimeNs = GetMonotonicTimeInNs() - iStartTime;
+    record.WriteSection(RecordSection_MiniCore, &miniCore, sizeof(miniCore));
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+DEADSTOP_CRASH_PATH
+static size_t DeadStop::GetRecordTailSize()
+{
+    // Most WriteCrashRecord() can still write after the mini core : followers, fibers ( each frame
+    // possibly a JIT name ), mini core & fiber summaries, End.
+    constexpr size_t iSection = sizeof(RecordSection_t) + RECORD_ALIGNMENT;
+    size_t iFrames = GetMaxFiberFrames() > 0 ? static_cast<size_t>(GetMaxFiberFrames()) : 0;
+    if(iFrames > MAX_CALL_STACK_DEPTH + 1)
+        iFrames = MAX_CALL_STACK_DEPTH + 1;
+
+    size_t nFibers = GetMaxDumpedFibers() > 0 ? static_cast<size_t>(GetMaxDumpedFibers()) : 0;
+    if(nFibers > GetFiberSlotCount())
+        nFibers = GetFiberSlotCount();
+
+    size_t iFiberSize = iSection + sizeof(RecordFiber_t) + iFrames * (sizeof(RecordFrame_t) + iSection + sizeof(RecordJitCode_t));
+
+    return s_crashSlots.GetSlotCount() * (iSection + sizeof(RecordFollower_t)) + nFibers * iFiberSize +
+        iSection + sizeof(RecordFiberSummary_t) + iSection + sizeof(RecordMiniCore_t) + iSection + sizeof(RecordEnd_t);
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+DEADSTOP_CRASH_PATH
+static void DeadStop::PlanMiniCorePages(MiniCorePlan_t& plan, uintptr_t iAdrs, RecordMemoryKind_t iKind)
+{
+    // Most values aren't pointers, the maps tell. PROT_NONE & unmapped memory is never touched.
+    const MemRegion_t* pRegion = g_memRegionHandler.FindParentRegion(iAdrs);
+    if(pRegion == nullptr)
+        return;
+
+    // Page it points into, & the next one too if whatever is there could run into it.
+    uintptr_t iStart = iAdrs & ~(MINI_CORE_PAGE_SIZE - 1);
+    uintptr_t iEnd   = iStart + MINI_CORE_PAGE_SIZE;
+    if(iEnd - iAdrs <= MINI_CORE_STRADDLE_SIZE)
+        iEnd += MINI_CORE_PAGE_SIZE;
+
+    plan.Add(iStart > pRegion->m_iStart ? iStart : pRegion->m_iStart, iEnd < pRegion->m_iEnd ? iEnd : pRegion->m_iEnd, iKind);
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+DEADSTOP_CRASH_PATH
+static uintptr_t DeadStop::GetCrashStackHigh(uintptr_t iRSP)
+{
+    // Same stack Analyze() unwinds on, the thread's own or the fiber running on it. 0 if unknown.
+    const ThreadStackInfo_t* pStackInfo = GetThisThreadStackInfo();
+    if(iRSP >= pStackInfo->m_iStackLow && iRSP < pStackInfo->m_iStackHigh)
+        return pStackInfo->m_iStackHigh;
+
+    FiberInfo_t fiber;
+    if(FindFiberByStack(iRSP, fiber) == true)
+        return fiber.m_iStackHigh;
+
+    return 0;
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+DEADSTOP_CRASH_PATH
+static void DeadStop::RecordJitCode(RecordWriter_t& record, const CallStack_t& callStack)
+{
+    // Only the names are needed later, frames were unwound already.
+    uintptr_t iLastStart = 0;
+    for(int iFrame = 0; iFrame < callStack.m_nFrames; iFrame++)
+    {
+        uintptr_t     iAdrs = callStack.m_iFrames[iFrame];
+        JitCodeInfo_t code;
+        if(FindJitCode(iFrame != 0 ? iAdrs - 1 : iAdrs, code) == false || code.m_iStart == iLastStart)
+            continue;
+        iLastStart = code.m_iStart;
+
+        RecordJitCode_t jitCode = {};
+        jitCode.m_iStart = code.m_iStart;
+        jitCode.m_iEnd   = code.m_iEnd;
+        memcpy(jitCode.m_szName, code.m_szName, sizeof(jitCode.m_szName));
+        record.WriteSection(RecordSection_JitCode, &jitCode, sizeof(jitCode));
+    }
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+DEADSTOP_CRASH_PATH
+static void DeadStop::RecordMemory(RecordWriter_t& record, RecordMemoryKind_t iKind, uintptr_t iAdrs, const void* pBytes, size_t iSize)
+{
+    RecordMemory_t memory = { iAdrs, static_cast<uint32_t>(iSize), iKind };
+
+    record.BeginSection(RecordSection_Memory, sizeof(memory) + iSize);
+    record.WriteBytes(&memory, sizeof(memory));
+    record.WriteBytes(pBytes, iSize);
+    record.EndSection();
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+DEADSTOP_CRASH_PATH
+static void DeadStop::RecordCrashSlot(RecordWriter_t& record, const CrashSlot_t& slot)
+{
+    RecordFollower_t follower = {};
+    follower.m_iThreadID   = static_cast<int32_t>(slot.m_iThreadID.load(std::memory_order_relaxed));
+    follower.m_iSignalID   = slot.m_iSignalID;
+    follower.m_iSignalCode = slot.m_iSignalCode;
+    follower.m_nFrames     = slot.m_nFrames;
+    follower.m_iFaultAdrs  = slot.m_iFaultAdrs;
+    memcpy(follower.m_gregs,   slot.m_gregs,   sizeof(follower.m_gregs));
+    memcpy(follower.m_iFrames, slot.m_iFrames, sizeof(follower.m_iFrames));
+
+    // Late followers get a record of their own.
+    record.Begin();
+    record.WriteSection(RecordSection_Follower, &follower, sizeof(follower));
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+DEADSTOP_CRASH_PATH
+static void DeadStop::RecordFiberStack(RecordWriter_t& record, const FiberInfo_t& fiber, const CallStack_t* pCallStack)
+{
+    RecordFiber_t header = {};
+    header.m_iFiberID    = fiber.m_iFiberID;
+    header.m_iStackLow   = fiber.m_iStackLow;
+    header.m_iStackHigh  = fiber.m_iStackHigh;
+    header.m_nFrames     = pCallStack != nullptr ? static_cast<uint32_t>(pCallStack->m_nFrames) : 0;
+    header.m_bHasContext = pCallStack != nullptr ? 1 : 0;
+
+    record.BeginSection(RecordSection_Fiber, sizeof(header) + header.m_nFrames * sizeof(RecordFrame_t));
+    record.WriteBytes(&header, sizeof(header));
+    if(pCallStack != nullptr)
+        RecordFrames(record, *pCallStack);
+    record.EndSection();
+
+    if(pCallStack != nullptr)
+        RecordJitCode(record, *pCallStack);
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+DEADSTOP_CRASH_PATH
+static void DeadStop::EndRecord(RecordWriter_t& record, uint64_t iHandlerStartTime)
+{
+    // Whatever the text report's epilogue would have said.
+    const CrashArena_t& arena = *s_crash.m_pArena;
+    RecordEnd_t end = {};
+    end.m_iEndTime          = GetLocalTime();
+    end.m_iHandlerLatencyNs = iHandlerStartTime != 0 ? GetMonotonicTimeInNs() - iHandlerStartTime : 0;
+    end.m_nDroppedFollowers = s_crashSlots.GetDroppedCount();
+    end.m_iArenaPeak        = arena.GetHighWaterMark();
+    end.m_iArenaCapacity    = arena.GetCapacity();
+    end.m_nFailedAllocs     = arena.GetFailedAllocations();
+    end.m_nRegions          = g_memRegionHandler.GetRegionCount();
+    end.m_iRegionCapacity   = g_memRegionHandler.GetRegionCapacity();
+    end.m_nSafeReadSyscalls = GetSafeReadSyscallCount();
+    end.m_nSafeReadFails    = GetSafeReadFailCount();
+
+    record.End(end);
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+bool DeadStop::RenderCrashRecords(const uint8_t* pData, size_t iSize, int iOutputFd, size_t& nRenderedOut)
+{
+    nRenderedOut = 0;
+    if(s_crash.m_pOutputBuffer == nullptr || pData == nullptr)
+        return false;
+
+    Writer_t hFile(s_crash.m_pOutputBuffer, OUTPUT_BUFFER_SIZE, iOutputFd);
+
+    // Same code the crash would have run, minus the console spam. Code is read from the record.
+    bool bWasMuted = Console::SetThreadMuted(true);
+    s_crash.m_codeWindow.SetReader(ReadCrashMemory);
+
+    std::vector<DumpSlabEntry_t> vecEntries;
+    size_t                       nIncomplete = 0;
+    if(ReadDumpSlab(pData, iSize, vecEntries, nIncomplete) == true)
+    {
+        // Slab, one report per slot. Text ones are copied out as they are.
+        for(const DumpSlabEntry_t& entry : vecEntries)
+        {
+            // Record that ran out of slot is rendered as far as it got.
+            if(entry.m_iSize >= sizeof(uint32_t) && *reinterpret_cast<const uint32_t*>(entry.m_pData) == CRASH_RECORD_MAGIC)
+            {
+                nRenderedOut += RenderRecords(hFile, entry.m_pData, entry.m_iSize, (entry.m_iFlags & DumpSlabSlotFlag_Truncated) != 0);
+            }
+            else
+            {
+                hFile.Write(reinterpret_cast<const char*>(entry.m_pData), entry.m_iSize);
+                nRenderedOut++;
+            }
+
+            if((entry.m_iFlags & DumpSlabSlotFlag_Truncated) != 0)
+            {
+                hFile.Write('\n'); DoBranding(hFile); hFile.Format("Report above ( process %d ) didn't fit its slot & was cut short.\n\n", entry.m_iProcessID);
+            }
+            hFile.Flush();
+        }
+
+        if(nIncomplete > 0)
+        {
+            DoBranding(hFile); hFile.Format("%zu slots never committed, their process died while writing them.\n", nIncomplete);
+        }
+    }
+    else
+    {
+        nRenderedOut = RenderRecords(hFile, pData, iSize, false);
+    }
+
+    s_crash.m_codeWindow.SetReader(nullptr);
+    Console::SetThreadMuted(bWasMuted);
+    hFile.Flush();
+
+    return nRenderedOut > 0;
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+static size_t DeadStop::RenderRecords(Writer_t& hFile, const uint8_t* pData, size_t iSize, bool bAllowTruncated)
+{
+    size_t nRendered = 0;
+    size_t iCursor   = 0;
+    size_t nSkipped  = 0;
+    while(iCursor < iSize)
+    {
+        // Whatever isn't a record ( text reports in the same file, a record cut short ) is skipped.
+        CrashRecordReader_t record;
+        if(record.Parse(pData + iCursor, iSize - iCursor, bAllowTruncated) == false)
+        {
+            iCursor++; nSkipped++;
+            continue;
+        }
+
+        if(nSkipped > 0)
+        {
+            nRendered += WriteSkippedBytes(hFile, pData + iCursor - nSkipped, nSkipped) == true ? 1 : 0;
+            nSkipped   = 0;
+        }
+
+        RenderRecord(hFile, record);
+        hFile.Flush();
+
+        nRendered++;
+        iCursor += record.GetRecordSize();
+    }
+
+    if(nSkipped > 0)
+        nRendered += WriteSkippedBytes(hFile, pData + iCursor - nSkipped, nSkipped) == true ? 1 : 0;
+
+    return nRendered;
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+static bool DeadStop::WriteSkippedBytes(Writer_t& hFile, const uint8_t* pData, size_t iSize)
+{
+    // Text reports are copied out as they are & count as rendered, anything else is only mentioned.
+    for(size_t i = 0; i < iSize; i++)
+    {
+        uint8_t c = pData[i];
+        if((c < 0x20 && c != '\n' && c != '\r' && c != '\t') || c == 0x7F)
+        {
+            DoBranding(hFile); hFile.Format("%zu bytes skipped, not a record this version can read.\n\n", iSize);
+            return false;
+        }
+    }
+
+    hFile.WriteThrough(reinterpret_cast<const char*>(pData), iSize);
+    return true;
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+static void DeadStop::RenderRecord(Writer_t& hFile, const CrashRecordReader_t& record)
+{
+    // Records without a crash only hold followers that showed up after the report.
+    const RecordCrash_t* pCrash = record.Get<RecordCrash_t>(RecordSection_Crash);
+    if(pCrash == nullptr)
+    {
+        WriteRecordedFollowers(hFile, record);
+        return;
+    }
+
+    const RecordEnd_t* pEnd = record.Get<RecordEnd_t>(RecordSection_End);
+    RecordEnd_t        end  = pEnd != nullptr ? *pEnd : RecordEnd_t{};
+
+
+    // Settings it was captured with, code recorded is sized for them.
+    s_pRenderRecord           = &record;
+    s_crash.m_iAsmDumpRange   = pCrash->m_iAsmDumpRange > 0 && pCrash->m_iAsmDumpRange < MAX_ASM_DUMP_RANGE ? pCrash->m_iAsmDumpRange : MAX_ASM_DUMP_RANGE - 1;
+    s_crash.m_iStringDumpSize = pCrash->m_iStringDumpSize;
+    s_crash.m_iSignatureSize  = pCrash->m_iSignatureSize;
+
+    // Registers & siginfo exactly as the handler got them.
+    ucontext_t context; memset(&context, 0, sizeof(context));
+    siginfo_t  sigInfo; memset(&sigInfo, 0, sizeof(sigInfo));
+    size_t         iSectionSize = 0;
+    const uint8_t* pSection     = record.GetSection(RecordSection_Context, 0, iSectionSize);
+    if(pSection != nullptr)
+        memcpy(context.uc_mcontext.gregs, pSection, iSectionSize < sizeof(context.uc_mcontext.gregs) ? iSectionSize : sizeof(context.uc_mcontext.gregs));
+
+    pSection = record.GetSection(RecordSection_SigInfo, 0, iSectionSize);
+    if(pSection != nullptr)
+        memcpy(&sigInfo, pSection, iSectionSize < sizeof(sigInfo) ? iSectionSize : sizeof(sigInfo));
+
+    g_pContext = &context;
+    g_pSigInfo = &sigInfo;
+
+
+    WriteReportPrologue(hFile, pCrash->m_iSignalID, pCrash->m_iThreadID, pCrash->m_iCrashFiberID, pCrash->m_iStartTime);
+
+    ThreadStackInfo_t stackInfo;
+    stackInfo.m_iStackLow  = pCrash->m_iStackLow;
+    stackInfo.m_iStackHigh = pCrash->m_iStackHigh;
+    stackInfo.m_iGuardSize = pCrash->m_iGuardSize;
+    DumpFaultInfo(hFile, pCrash->m_iSignalID, stackInfo, (pCrash->m_iFlags & RecordCrashFlag_OnAltStack) != 0);
+    hFile.Write("\n\n");
+
+
+    LoadRecordedRegions(record, *pCrash);
+    WriteSelfMaps(hFile);
+    if((pCrash->m_iFlags & RecordCrashFlag_RegionsOverflowed) != 0 || g_memRegionHandler.HasOverflowed() == true || g_memRegionHandler.IsTextTruncated() == true)
+    {
+        DoBranding(hFile); hFile.Format("Only first %zu memory regions are used for analysis.\n", g_memRegionHandler.GetRegionCount());
+    }
+    hFile.Write("\n\n");
+
+    DumpGeneralRegisters(hFile);
+    hFile.Write("\n\n");
+
+
+    // JIT code the frames were in, for their names.
+    std::vector<uint64_t> vecJitIDs;
+    for(size_t iJit = 0; const RecordJitCode_t* pJitCode = record.Get<RecordJitCode_t>(RecordSection_JitCode, iJit); iJit++)
+    {
+        uint64_t iJitID = 0;
+        if(RegisterJitCode(pJitCode->m_iStart, pJitCode->m_iEnd, pJitCode->m_szName, sizeof(pJitCode->m_szName), nullptr, iJitID) == true)
+            vecJitIDs.push_back(iJitID);
+    }
+
+    // Window only knows addresses, another record could have other code at the same ones.
+    s_crash.m_codeWindow.Invalidate();
+
+    CallStack_t& callStack = *s_crash.m_pCallStack;
+    callStack.m_nFrames = 0;
+    pSection = record.GetSection(RecordSection_CallStack, 0, iSectionSize);
+    if(pSection != nullptr && iSectionSize >= sizeof(RecordCallStack_t))
+    {
+        const RecordCallStack_t* pHeader = reinterpret_cast<const RecordCallStack_t*>(pSection);
+        size_t nFrames = (iSectionSize - sizeof(RecordCallStack_t)) / sizeof(RecordFrame_t);
+        LoadRecordedFrames(callStack, pSection + sizeof(RecordCallStack_t), pHeader->m_nFrames < nFrames ? pHeader->m_nFrames : nFrames);
+
+        callStack.m_iUnwindTimeNs = pHeader->m_iUnwindTimeNs;
+        callStack.m_nCachedPlans  = pHeader->m_nCachedPlans;
+    }
+    WriteFnChainToFile(hFile, callStack);
+
+
+    WriteRecordedFollowers(hFile, record);
+    if(end.m_nDroppedFollowers > 0)
+    {
+        DoBranding(hFile); hFile.Format("%lu more threads crashed, but all crash slots were taken.\n", end.m_nDroppedFollowers);
+    }
+
+    WriteRecordedFibers(hFile, record);
+    WriteRecordedMiniCore(hFile, record);
+
+
+    // Epilogue, with what the crash itself measured. Cut short, that's gone with the End.
+    if(record.IsTruncated() == true)
+    {
+        DoBranding(hFile); hFile.Format("Record stops after %zu bytes, the rest didn't fit. Sections above are all there is.\n", record.GetRecordSize());
+    }
+    else
+    {
+        DoBranding(hFile); hFile.Write("Log dump ended @ ");
+        DumpDateTime(hFile, end.m_iEndTime);
+        hFile.Write('\n');
+        DoBranding(hFile); hFile.Format("Handler latency : %lu us\n", end.m_iHandlerLatencyNs / 1000);
+
+        DoBranding(hFile); hFile.Format("Crash memory : %lu / %lu bytes used at peak", end.m_iArenaPeak, end.m_iArenaCapacity);
+        if(end.m_nFailedAllocs > 0)
+            hFile.Format(", %lu allocations refused. Increase crash memory budget", end.m_nFailedAllocs);
+        hFile.Write('\n');
+
+        DoBranding(hFile); hFile.Format("Memory regions : %lu / %lu", end.m_nRegions, end.m_iRegionCapacity);
+        if((pCrash->m_iFlags & RecordCrashFlag_RegionsOverflowed) != 0)
+            hFile.Write(", some regions were dropped. Increase crash memory budget");
+        hFile.Write('\n');
+
+        DoBranding(hFile); hFile.Format("Safe reads : %lu syscalls, %lu partial / failed reads\n", end.m_nSafeReadSyscalls, end.m_nSafeReadFails);
+    }
+
+    DoBranding(hFile); hFile.Format("Rendered from binary record ( version %u, %zu bytes ), disassembled by this build.\n",
+            record.GetVersion(), record.GetRecordSize());
+    hFile.Write("///////////////////////////////////////////////////////////////////////////\n");
+
+
+    for(uint64_t iJitID : vecJitIDs)
+        UnregisterJitCode(iJitID);
+
+    s_pRenderRecord = nullptr;
+    g_pContext      = nullptr;
+    g_pSigInfo      = nullptr;
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+static void DeadStop::LoadRecordedRegions(const CrashRecordReader_t& record, const RecordCrash_t& crash)
+{
+    g_memRegionHandler.SetStorage(s_crash.m_pRegionStorage, s_crash.m_iRegionMemSize);
+
+    size_t      iTextSize = 0;
+    const char* pText     = reinterpret_cast<const char*>(record.GetSection(RecordSection_MapsText, 0, iTextSize));
+    g_memRegionHandler.SetText(pText, pText != nullptr ? iTextSize : 0, (crash.m_iFlags & RecordCrashFlag_MapsTruncated) != 0);
+
+
+    // Parsed at crash time already, only paths need pointing back into the text.
+    size_t         iRegionsSize = 0;
+    const uint8_t* pRegions     = record.GetSection(RecordSection_Regions, 0, iRegionsSize);
+    for(size_t iRegion = 0; pRegions != nullptr && iRegion < iRegionsSize / sizeof(RecordRegion_t); iRegion++)
+    {
+        RecordRegion_t recorded;
+        memcpy(&recorded, pRegions + iRegion * sizeof(RecordRegion_t), sizeof(recorded));
+
+        MemRegion_t region(recorded.m_iStart, recorded.m_iEnd, recorded.m_iFlags);
+        region.m_iOffset = recorded.m_iOffset;
+        region.m_iInode  = recorded.m_iInode;
+        if(pText != nullptr && recorded.m_iPathOffset != RECORD_NO_PATH && static_cast<size_t>(recorded.m_iPathOffset) + recorded.m_iPathLength <= iTextSize)
+        {
+            region.m_szPath      = pText + recorded.m_iPathOffset;
+            region.m_iPathLength = recorded.m_iPathLength;
+        }
+
+        g_memRegionHandler.RegisterRegion(region);
+    }
+
+    g_memRegionHandler.BuildIndex();
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+static void DeadStop::LoadRecordedFrames(CallStack_t& callStack, const uint8_t* pFrames, size_t nFrames)
+{
+    callStack.m_nFrames = 0;
+    for(size_t iFrame = 0; iFrame < nFrames; iFrame++)
+    {
+        RecordFrame_t frame;
+        memcpy(&frame, pFrames + iFrame * sizeof(RecordFrame_t), sizeof(frame));
+
+        // Methods a newer writer knows & we don't are only a name.
+        UnwindMethod_t iMethod = frame.m_iMethod <= UnwindMethod_JitFrame ? static_cast<UnwindMethod_t>(frame.m_iMethod) : UnwindMethod_None;
+        if(callStack.Push(frame.m_iAdrs, iMethod) == false)
+            break;
+    }
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+static void DeadStop::WriteRecordedFollowers(Writer_t& hFile, const CrashRecordReader_t& record)
+{
+    for(size_t iFollower = 0; const RecordFollower_t* pFollower = record.Get<RecordFollower_t>(RecordSection_Follower, iFollower); iFollower++)
+    {
+        CrashSlot_t slot;
+        slot.m_iState.store(0, std::memory_order_relaxed);
+        slot.m_iThreadID.store(static_cast<pid_t>(pFollower->m_iThreadID), std::memory_order_relaxed);
+        slot.m_iSignalID   = pFollower->m_iSignalID;
+        slot.m_iSignalCode = pFollower->m_iSignalCode;
+        slot.m_iFaultAdrs  = pFollower->m_iFaultAdrs;
+        slot.m_nFrames     = pFollower->m_nFrames >= 0 && pFollower->m_nFrames <= static_cast<int32_t>(MAX_SLOT_FRAMES) ? pFollower->m_nFrames : 0;
+        memcpy(slot.m_gregs,   pFollower->m_gregs,   sizeof(slot.m_gregs));
+        memcpy(slot.m_iFrames, pFollower->m_iFrames, sizeof(slot.m_iFrames));
+
+        WriteCrashSlot(hFile, slot);
+    }
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+static void DeadStop::WriteRecordedFibers(Writer_t& hFile, const CrashRecordReader_t& record)
+{
+    // Only there if fibers were dumped at all.
+    const RecordFiberSummary_t* pSummary = record.Get<RecordFiberSummary_t>(RecordSection_FiberSummary);
+    if(pSummary == nullptr)
+        return;
+
+    StartBanner(hFile, "Suspended Fibers");
+
+    CallStack_t&   callStack    = *s_crash.m_pCallStack;
+    size_t         iSectionSize = 0;
+    const uint8_t* pSection     = nullptr;
+    for(size_t iFiber = 0; (pSection = record.GetSection(RecordSection_Fiber, iFiber, iSectionSize)) != nullptr; iFiber++)
+    {
+        if(iSectionSize < sizeof(RecordFiber_t))
+            continue;
+
+        const RecordFiber_t* pHeader = reinterpret_cast<const RecordFiber_t*>(pSection);
+        FiberInfo_t fiber;
+        fiber.m_iFiberID   = pHeader->m_iFiberID;
+        fiber.m_iStackLow  = pHeader->m_iStackLow;
+        fiber.m_iStackHigh = pHeader->m_iStackHigh;
+
+        if(pHeader->m_bHasContext == 0)
+        {
+            WriteFiberStack(hFile, fiber, nullptr);
+            continue;
+        }
+
+        size_t nFrames = (iSectionSize - sizeof(RecordFiber_t)) / sizeof(RecordFrame_t);
+        LoadRecordedFrames(callStack, pSection + sizeof(RecordFiber_t), pHeader->m_nFrames < nFrames ? pHeader->m_nFrames : nFrames);
+        WriteFiberStack(hFile, fiber, &callStack);
+    }
+
+    WriteFiberSummary(hFile, static_cast<int>(pSummary->m_nUnwound), pSummary->m_iUnwindTimeNs, static_cast<size_t>(pSummary->m_nSkipped));
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+static void DeadStop::WriteRecordedMiniCore(Writer_t& hFile, const CrashRecordReader_t& record)
+{
+    // Memory itself is read by everything above, this only lists what was kept.
+    const RecordMiniCore_t* pMiniCore = record.Get<RecordMiniCore_t>(RecordSection_MiniCore);
+    if(pMiniCore == nullptr)
+        return;
+
+    static const char* s_szKindNames[] = { "code", "stack", "register", "fault" };
+    constexpr uint32_t nKinds          = static_cast<uint32_t>(sizeof(s_szKindNames) / sizeof(s_szKindNames[0]));
+
+    StartBanner(hFile, "Mini Core");
+
+
+    // Blocks are written a chunk at a time, ones carrying on from the last are one range here.
+    const MemRegion_t* pRegions     = g_memRegionHandler.GetAllRegions();
+    size_t             nRegions     = g_memRegionHandler.GetRegionCount();
+    size_t             nRanges      = 0;
+    size_t             iSectionSize = 0;
+    const uint8_t*     pSection     = nullptr;
+    for(size_t iBlock = 0; (pSection = record.GetSection(RecordSection_Memory, iBlock, iSectionSize)) != nullptr; )
+    {
+        if(iSectionSize < sizeof(RecordMemory_t))
+        {
+            iBlock++;
+            continue;
+        }
+
+        RecordMemory_t range;
+        memcpy(&range, pSection, sizeof(range));
+
+        uint64_t iEnd = range.m_iAdrs + range.m_iSize;
+        for(iBlock++; (pSection = record.GetSection(RecordSection_Memory, iBlock, iSectionSize)) != nullptr && iSectionSize >= sizeof(RecordMemory_t); iBlock++)
+        {
+            RecordMemory_t next;
+            memcpy(&next, pSection, sizeof(next));
+            if(next.m_iAdrs != iEnd || next.m_iKind != range.m_iKind)
+                break;
+
+            iEnd += next.m_iSize;
+        }
+
+        hFile.Write("[ 0x").WriteHex(range.m_iAdrs).Write(" - 0x").WriteHex(iEnd).Format(" ] %8lu bytes  %-8s ",
+                iEnd - range.m_iAdrs, range.m_iKind < nKinds ? s_szKindNames[range.m_iKind] : "?");
+
+        for(size_t iRegion = 0; iRegion < nRegions; iRegion++)
+        {
+            if(range.m_iAdrs >= pRegions[iRegion].m_iStart && range.m_iAdrs < pRegions[iRegion].m_iEnd && pRegions[iRegion].m_szPath != nullptr)
+            {
+                hFile.Write(pRegions[iRegion].m_szPath, pRegions[iRegion].m_iPathLength);
+                break;
+            }
+        }
+        hFile.Write('\n');
+        nRanges++;
+    }
+
+
+    DoBranding(hFile); hFile.Format("%lu bytes kept in %zu ranges, in %lu us. Limits : %lu bytes of stack, %lu in all\n",
+            pMiniCore->m_iCapturedBytes, nRanges, pMiniCore->m_iCaptureTimeNs / 1000, pMiniCore->m_iStackLimit, pMiniCore->m_iSizeLimit);
+    if(pMiniCore->m_iSkippedBytes > 0)
+    {
+        DoBranding(hFile); hFile.Format("%lu more bytes were wanted, but didn't fit or couldn't be read ( see DeadStop_SetMiniCoreLimits() )\n", pMiniCore->m_iSkippedBytes);
+    }
+
+    EndBanner(hFile, "Mini Core");
+    hFile.Write("\n\n");
 }
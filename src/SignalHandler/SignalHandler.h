@@ -9,6 +9,7 @@
 #pragma once
 #include "../../Include/Alias.h"
 #include "../../Include/DeadStop.h"
+#include "../Unwind/DwarfCFI.h"
 #include <csignal>
 
 
@@ -17,5 +18,33 @@
 ///////////////////////////////////////////////////////////////////////////
 namespace DEADSTOP_NAMESPACE
 {
+    class CrashArena_t;
+    class MemoryLock_t;
+
     void MasterSignalHandler(int iSignalID, siginfo_t* pSigInfo, void* pContext);
+
+    // Carve everything the crash path needs out of the crash arena & warm up the decoder, for dumps of
+    // up to iMaxAsmDumpRange bytes each side. Must be called before handlers are registered.
+    bool PrepareCrashPath(CrashArena_t& arena, int iMaxAsmDumpRange);
+    void ReleaseCrashPath();
+
+    // Smallest crash arena whose region table & maps text hold nMapsLines lines of /proc/self/maps.
+    size_t GetCrashMemoryBudget(size_t nMapsLines);
+
+    // Prefault & mlock everything PrepareCrashPath() set up, plus the code that runs on it.
+    bool LockCrashPath(MemoryLock_t& memoryLock);
+
+    // Non fatal unwind from regs ( rIP in DwarfReg_RA ), for DeadStop_CaptureStack() & DeadStop_UnwindContext().
+    // First iSkipFrames frames are dropped. Any number run at once, only the crash path's maps snapshot is shared.
+    ErrCodes_t UnwindStack(const DwarfRegs_t& regs, int iSkipFrames, DeadStopFrame_t* pFrames, int iMaxFrames, int& nFramesOut);
+
+    // UnwindStack() only runs between these. Open once PrepareCrashPath() is done, close before ReleaseCrashPath(),
+    // closing waits for captures already running.
+    void OpenCaptures();
+    void CloseCaptures();
+
+    // Offline. Every binary record in pData as the text report it stands for, written to iOutputFd. Text
+    // reports in there are copied as is. Runs on what PrepareCrashPath() set up, never while handlers are
+    // registered. False if nothing was rendered.
+    bool RenderCrashRecords(const uint8_t* pData, size_t iSize, int iOutputFd, size_t& nRenderedOut);
 }
@@ -0,0 +1,926 @@
+//=========================================================================
+//                      DWARF Call Frame Information
+//=========================================================================
+// by      : INSANE
+// created : 16/10/2026
+//
+// purpose : Finds & evaluates .eh_frame unwind info ( through .eh_frame_hdr's
+//           sorted FDE table ) for x86_64 code. Every read is a SafeRead().
+//-------------------------------------------------------------------------
+#include "DwarfCFI.h"
+#include "../Util/SafeRead/SafeRead.h"
+#include "../Util/MemoryLock/MemoryLock.h"
+#include <cstring>
+
+
+// Mind this...
+using namespace DeadStop;
+
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+namespace DEADSTOP_NAMESPACE
+{
+    // Pointer encodings ( DW_EH_PE_* ). Low nibble is the format, next 3 bits how it's applied.
+    enum PointerEncoding_t : uint8_t
+    {
+        PtrEnc_AbsPtr   = 0x00, PtrEnc_ULEB128 = 0x01, PtrEnc_UData2 = 0x02, PtrEnc_UData4 = 0x03, PtrEnc_UData8 = 0x04,
+        PtrEnc_SLEB128  = 0x09, PtrEnc_SData2  = 0x0A, PtrEnc_SData4 = 0x0B, PtrEnc_SData8 = 0x0C,
+
+        PtrEnc_PCRel    = 0x10, PtrEnc_DataRel = 0x30,
+        PtrEnc_Indirect = 0x80,
+        PtrEnc_Omit     = 0xFF,
+    };
+
+
+    // FDEs & CIEs are copied whole into stack buffers this big. Bigger ones fall back to the heuristic.
+    static constexpr size_t   MAX_CFI_ENTRY_SIZE   = 2048;
+    static constexpr size_t   MAX_REMEMBERED_ROWS  = 8;
+    static constexpr size_t   MAX_EXPRESSION_SIZE  = 64;
+    static constexpr size_t   MAX_EXPRESSION_STACK = 32;
+    static constexpr size_t   MAX_EXPRESSION_STEPS = 256;
+
+
+    ///////////////////////////////////////////////////////////////////////////
+    ///////////////////////////////////////////////////////////////////////////
+    // Bounds checked reader over bytes copied out of the process. Knows where they were copied from,
+    // so pc relative pointers come out right. Reading past the end sets m_bFailed & returns 0.
+    struct CFIReader_t
+    {
+        const uint8_t* m_pData     = nullptr;
+        size_t         m_iSize     = 0;
+        size_t         m_iPos      = 0;
+        uintptr_t      m_iBaseAdrs = 0;
+        bool           m_bFailed   = false;
+
+        uintptr_t Adrs()      const { return m_iBaseAdrs + m_iPos; }
+        bool      AtEnd()     const { return m_iPos >= m_iSize; }
+        bool      Has(size_t n)     { if(m_iSize - m_iPos < n || m_iPos > m_iSize) { m_bFailed = true; return false; } return true; }
+        void      Skip(size_t n)    { if(Has(n) == true) m_iPos += n; }
+
+        template<typename T>
+        T         Read()            { T value = 0; if(Has(sizeof(T)) == true) { memcpy(&value, m_pData + m_iPos, sizeof(T)); m_iPos += sizeof(T); } return value; }
+
+        uint8_t   U8()              { return Read<uint8_t>(); }
+
+        uint64_t  ULEB()
+        {
+            uint64_t iResult = 0;
+            for(int iShift = 0; Has(1) == true; iShift += 7)
+            {
+                uint8_t iByte = m_pData[m_iPos++];
+                if(iShift < 64)
+                    iResult |= static_cast<uint64_t>(iByte & 0x7F) << iShift;
+                if((iByte & 0x80) == 0)
+                    return iResult;
+            }
+            return 0;
+        }
+
+        int64_t   SLEB()
+        {
+            int64_t iResult = 0;
+            int     iShift  = 0;
+            while(Has(1) == true)
+            {
+                uint8_t iByte = m_pData[m_iPos++];
+                if(iShift < 64)
+                    iResult |= static_cast<int64_t>(iByte & 0x7F) << iShift;
+                iShift += 7;
+
+                if((iByte & 0x80) == 0)
+                {
+                    if(iShift < 64 && (iByte & 0x40) != 0)
+                        iResult |= -(static_cast<int64_t>(1) << iShift);
+                    return iResult;
+                }
+            }
+            return 0;
+        }
+
+        uintptr_t EncodedPointer(uint8_t iEncoding, uintptr_t iDataRelBase = 0);
+    };
+
+
+    ///////////////////////////////////////////////////////////////////////////
+    ///////////////////////////////////////////////////////////////////////////
+    struct CIEInfo_t
+    {
+        uint64_t m_iCodeAlign     = 1;
+        int64_t  m_iDataAlign     = 1;
+        int      m_iReturnReg     = DwarfReg_RA;
+        uint8_t  m_iFDEEncoding   = PtrEnc_AbsPtr;
+        bool     m_bHasAugData    = false; // 'z', FDEs carry an augmentation data length.
+        bool     m_bSignalFrame   = false;
+
+        size_t   m_iProgramStart  = 0; // Initial instructions, offsets into the CIE's reader.
+        size_t   m_iProgramEnd    = 0;
+    };
+
+
+    static bool ReadCFIEntry(uintptr_t iAdrs, uint8_t* pBuffer, CFIReader_t& readerOut, bool& b64BitOut);
+    static bool ParseCIE    (CFIReader_t& reader, bool b64Bit, CIEInfo_t& cieOut);
+    static bool RunCFAProgram(CFIReader_t& reader, size_t iStart, size_t iEnd, const CIEInfo_t& cie,
+            uintptr_t iFuncStart, uintptr_t iPC, const UnwindRow_t* pInitialRow, UnwindRow_t& row);
+    static void SetRegRule  (UnwindRow_t& row, uint64_t iReg, uint8_t iType, int64_t iValue, uint32_t iExprLength = 0);
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+DEADSTOP_CRASH_PATH
+uintptr_t DeadStop::CFIReader_t::EncodedPointer(uint8_t iEncoding, uintptr_t iDataRelBase)
+{
+    if(iEncoding == PtrEnc_Omit)
+        return 0;
+
+
+    uintptr_t iFieldAdrs = Adrs();
+    uintptr_t iValue     = 0;
+    switch(iEncoding & 0x0F)
+    {
+        case PtrEnc_AbsPtr:  iValue = Read<uint64_t>(); break;
+        case PtrEnc_ULEB128: iValue = static_cast<uintptr_t>(ULEB()); break;
+        case PtrEnc_UData2:  iValue = Read<uint16_t>(); break;
+        case PtrEnc_UData4:  iValue = Read<uint32_t>(); break;
+        case PtrEnc_UData8:  iValue = Read<uint64_t>(); break;
+        case PtrEnc_SLEB128: iValue = static_cast<uintptr_t>(SLEB()); break;
+        case PtrEnc_SData2:  iValue = static_cast<uintptr_t>(static_cast<int64_t>(Read<int16_t>())); break;
+        case PtrEnc_SData4:  iValue = static_cast<uintptr_t>(static_cast<int64_t>(Read<int32_t>())); break;
+        case PtrEnc_SData8:  iValue = static_cast<uintptr_t>(Read<int64_t>()); break;
+        default: m_bFailed = true; return 0;
+    }
+
+
+    switch(iEncoding & 0x70)
+    {
+        case 0x00:           break;
+        case PtrEnc_PCRel:   iValue += iFieldAdrs;   break;
+        case PtrEnc_DataRel: iValue += iDataRelBase; break;
+
+        // textrel, funcrel & aligned never show up in .eh_frame on x86_64.
+        default: m_bFailed = true; return 0;
+    }
+
+
+    if((iEncoding & PtrEnc_Indirect) != 0)
+    {
+        uintptr_t iTarget = 0;
+        if(SafeReadValue(iValue, iTarget) == false)
+        {
+            m_bFailed = true;
+            return 0;
+        }
+        iValue = iTarget;
+    }
+
+    return iValue;
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+DEADSTOP_CRASH_PATH
+bool DeadStop::ParseEhFrameHdr(uintptr_t iHdrAdrs, EhFrameHdr_t& hdrOut)
+{
+    // version, eh_frame_ptr_enc, fde_count_enc, table_enc, then eh_frame_ptr & fde_count.
+    uint8_t hdr[4 + 8 + 8];
+    if(SafeRead(hdr, iHdrAdrs, sizeof(hdr)) != sizeof(hdr))
+        return false;
+
+    if(hdr[0] != 1)
+        return false;
+
+
+    CFIReader_t reader;
+    reader.m_pData     = hdr;
+    reader.m_iSize     = sizeof(hdr);
+    reader.m_iPos      = 4;
+    reader.m_iBaseAdrs = iHdrAdrs;
+
+    reader.EncodedPointer(hdr[1], iHdrAdrs); // .eh_frame itself, we only go through the table.
+    uintptr_t nFDEs = reader.EncodedPointer(hdr[2], iHdrAdrs);
+    if(reader.m_bFailed == true)
+        return false;
+
+
+    // Table must be datarel sdata4, or we can't binary search it.
+    if(hdr[3] != (PtrEnc_DataRel | PtrEnc_SData4) || nFDEs == 0)
+        return false;
+
+
+    hdrOut.m_iHdrAdrs   = iHdrAdrs;
+    hdrOut.m_iTableAdrs = reader.Adrs();
+    hdrOut.m_nFDEs      = static_cast<size_t>(nFDEs);
+    return true;
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+DEADSTOP_CRASH_PATH
+bool DeadStop::FindUnwindRow(const EhFrameHdr_t& hdr, uintptr_t iPC, UnwindRow_t& rowOut)
+{
+    if(hdr.m_nFDEs == 0)
+        return false;
+
+
+    // Last table entry starting at or before iPC. One 8 byte read per probe.
+    int32_t entry[2] = { 0, 0 };
+    size_t  iLow     = 0;
+    size_t  iHigh    = hdr.m_nFDEs; // [ iLow, iHigh )
+    bool    bFound   = false;
+    int32_t iFDEOffset = 0;
+    while(iLow < iHigh)
+    {
+        size_t iMid = iLow + (iHigh - iLow) / 2;
+        if(SafeRead(entry, hdr.m_iTableAdrs + iMid * sizeof(entry), sizeof(entry)) != sizeof(entry))
+            return false;
+
+        uintptr_t iInitialLoc = hdr.m_iHdrAdrs + static_cast<intptr_t>(entry[0]);
+        if(iInitialLoc <= iPC)
+        {
+            bFound     = true;
+            iFDEOffset = entry[1];
+            iLow       = iMid + 1;
+        }
+        else
+        {
+            iHigh = iMid;
+        }
+    }
+
+    if(bFound == false)
+        return false;
+
+
+    // FDE...
+    uint8_t     fdeBuffer[MAX_CFI_ENTRY_SIZE];
+    CFIReader_t fde;
+    bool        b64Bit   = false;
+    uintptr_t   iFDEAdrs = hdr.m_iHdrAdrs + static_cast<intptr_t>(iFDEOffset);
+    if(ReadCFIEntry(iFDEAdrs, fdeBuffer, fde, b64Bit) == false)
+        return false;
+
+    uintptr_t iCIEPtrAdrs = fde.Adrs();
+    uint64_t  iCIEPtr     = b64Bit == true ? fde.Read<uint64_t>() : fde.Read<uint32_t>();
+    if(iCIEPtr == 0 || fde.m_bFailed == true) // 0 would make this a CIE.
+        return false;
+
+
+    // ...its CIE...
+    uint8_t     cieBuffer[MAX_CFI_ENTRY_SIZE];
+    CFIReader_t cieReader;
+    bool        bCIE64Bit = false;
+    CIEInfo_t   cie;
+    if(ReadCFIEntry(iCIEPtrAdrs - static_cast<uintptr_t>(iCIEPtr), cieBuffer, cieReader, bCIE64Bit) == false)
+        return false;
+
+    if(ParseCIE(cieReader, bCIE64Bit, cie) == false)
+        return false;
+
+
+    // ...& the range it covers.
+    uintptr_t iFuncStart = fde.EncodedPointer(cie.m_iFDEEncoding);
+    uintptr_t iFuncRange = fde.EncodedPointer(cie.m_iFDEEncoding & 0x0F);
+    if(fde.m_bFailed == true || iPC < iFuncStart || iPC >= iFuncStart + iFuncRange)
+        return false;
+
+    if(cie.m_bHasAugData == true)
+        fde.Skip(static_cast<size_t>(fde.ULEB()));
+
+    if(fde.m_bFailed == true)
+        return false;
+
+
+    // Run CIE's initial instructions, then FDE's, stopping once we pass iPC.
+    UnwindRow_t row;
+    row.m_iReturnReg   = cie.m_iReturnReg;
+    row.m_bSignalFrame = cie.m_bSignalFrame;
+    row.m_iFuncStart   = iFuncStart;
+    row.m_iFuncEnd     = iFuncStart + iFuncRange;
+
+    // Callee saved registers are preserved unless told otherwise, rest are lost across a call.
+    row.m_rules[DwarfReg_RBX].m_iType = RegRule_SameValue;
+    row.m_rules[DwarfReg_RBP].m_iType = RegRule_SameValue;
+    row.m_rules[DwarfReg_R12].m_iType = RegRule_SameValue;
+    row.m_rules[DwarfReg_R13].m_iType = RegRule_SameValue;
+    row.m_rules[DwarfReg_R14].m_iType = RegRule_SameValue;
+    row.m_rules[DwarfReg_R15].m_iType = RegRule_SameValue;
+
+    if(RunCFAProgram(cieReader, cie.m_iProgramStart, cie.m_iProgramEnd, cie, iFuncStart, iPC, nullptr, row) == false)
+        return false;
+
+    UnwindRow_t initialRow = row;
+    if(RunCFAProgram(fde, fde.m_iPos, fde.m_iSize, cie, iFuncStart, iPC, &initialRow, row) == false)
+        return false;
+
+    if(row.m_iCFAType == CFARule_Invalid)
+        return false;
+
+
+    rowOut = row;
+    return true;
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+DEADSTOP_CRASH_PATH
+bool DeadStop::ApplyUnwindRow(const UnwindRow_t& row, const DwarfRegs_t& regsIn, DwarfRegs_t& regsOut)
+{
+    // CFA first, every other rule is relative to it.
+    uintptr_t iCFA = 0;
+    switch(row.m_iCFAType)
+    {
+        case CFARule_RegOffset:
+            if(row.m_iCFAReg < 0 || row.m_iCFAReg >= DwarfReg_Count || regsIn.IsValid(row.m_iCFAReg) == false)
+                return false;
+            iCFA = regsIn.Get(row.m_iCFAReg) + static_cast<uintptr_t>(row.m_iCFAOffset);
+            break;
+
+        case CFARule_Expression:
+            if(EvaluateDwarfExpression(row.m_iCFAExprAdrs, row.m_iCFAExprLength, regsIn, false, 0, iCFA) == false)
+                return false;
+            break;
+
+        default: return false;
+    }
+
+
+    DwarfRegs_t regs = regsIn;
+    for(int iReg = 0; iReg < DwarfReg_Count; iReg++)
+    {
+        const RegRule_t& rule = row.m_rules[iReg];
+        switch(rule.m_iType)
+        {
+            case RegRule_Undefined: regs.Invalidate(iReg); break;
+            case RegRule_SameValue: break;
+
+            case RegRule_Offset:
+                {
+                    uintptr_t iValue = 0;
+                    if(SafeReadValue(iCFA + static_cast<uintptr_t>(rule.m_iValue), iValue) == true)
+                        regs.Set(iReg, iValue);
+                    else
+                        regs.Invalidate(iReg);
+                }
+                break;
+
+            case RegRule_ValOffset: regs.Set(iReg, iCFA + static_cast<uintptr_t>(rule.m_iValue)); break;
+
+            case RegRule_Register:
+                if(rule.m_iValue >= 0 && rule.m_iValue < DwarfReg_Count && regsIn.IsValid(static_cast<int>(rule.m_iValue)) == true)
+                    regs.Set(iReg, regsIn.Get(static_cast<int>(rule.m_iValue)));
+                else
+                    regs.Invalidate(iReg);
+                break;
+
+            case RegRule_Expression:
+            case RegRule_ValExpression:
+                {
+                    uintptr_t iValue = 0;
+                    bool bOk = EvaluateDwarfExpression(static_cast<uintptr_t>(rule.m_iValue), rule.m_iExprLength, regsIn, true, iCFA, iValue);
+                    if(bOk == true && rule.m_iType == RegRule_Expression)
+                        bOk = SafeReadValue(iValue, iValue);
+
+                    if(bOk == true)
+                        regs.Set(iReg, iValue);
+                    else
+                        regs.Invalidate(iReg);
+                }
+                break;
+
+            default: regs.Invalidate(iReg); break;
+        }
+    }
+
+
+    // Caller's rSP is the CFA, by definition.
+    regs.Set(DwarfReg_RSP, iCFA);
+
+    // Return address might live in some other column.
+    if(row.m_iReturnReg != DwarfReg_RA)
+    {
+        if(row.m_iReturnReg < 0 || row.m_iReturnReg >= DwarfReg_Count || regs.IsValid(row.m_iReturnReg) == false)
+            return false;
+        regs.Set(DwarfReg_RA, regs.Get(row.m_iReturnReg));
+    }
+
+    if(regs.IsValid(DwarfReg_RA) == false)
+        return false;
+
+
+    regsOut = regs;
+    return true;
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+DEADSTOP_CRASH_PATH
+bool DeadStop::EvaluateDwarfExpression(uintptr_t iExprAdrs, uint32_t iExprLength, const DwarfRegs_t& regs,
+        bool bPushInitial, uintptr_t iInitial, uintptr_t& iResultOut)
+{
+    uint8_t expr[MAX_EXPRESSION_SIZE];
+    if(iExprLength == 0 || iExprLength > sizeof(expr) || SafeRead(expr, iExprAdrs, iExprLength) != iExprLength)
+        return false;
+
+
+    CFIReader_t reader;
+    reader.m_pData     = expr;
+    reader.m_iSize     = iExprLength;
+    reader.m_iBaseAdrs = iExprAdrs;
+
+    uintptr_t stack[MAX_EXPRESSION_STACK];
+    size_t    nStack = 0;
+    if(bPushInitial == true)
+        stack[nStack++] = iInitial;
+
+    #define EXPR_PUSH(value) { uintptr_t iPushed = static_cast<uintptr_t>(value); if(nStack >= MAX_EXPRESSION_STACK) return false; stack[nStack] = iPushed; nStack++; }
+    #define EXPR_NEED(count) { if(nStack < (count)) return false; }
+
+    for(size_t iStep = 0; reader.AtEnd() == false; iStep++)
+    {
+        if(iStep >= MAX_EXPRESSION_STEPS || reader.m_bFailed == true)
+            return false;
+
+
+        uint8_t iOp = reader.U8();
+
+        // DW_OP_lit0 - 31
+        if(iOp >= 0x30 && iOp <= 0x4F) { EXPR_PUSH(iOp - 0x30); continue; }
+
+        // DW_OP_breg0 - 31
+        if(iOp >= 0x70 && iOp <= 0x8F)
+        {
+            int     iReg    = iOp - 0x70;
+            int64_t iOffset = reader.SLEB();
+            if(iReg >= DwarfReg_Count || regs.IsValid(iReg) == false)
+                return false;
+            EXPR_PUSH(regs.Get(iReg) + static_cast<uintptr_t>(iOffset));
+            continue;
+        }
+
+        switch(iOp)
+        {
+            case 0x03: EXPR_PUSH(reader.Read<uint64_t>()); break;                     // addr
+            case 0x08: EXPR_PUSH(reader.Read<uint8_t>());  break;                     // const1u
+            case 0x09: EXPR_PUSH(static_cast<int64_t>(reader.Read<int8_t>()));  break; // const1s
+            case 0x0A: EXPR_PUSH(reader.Read<uint16_t>()); break;                     // const2u
+            case 0x0B: EXPR_PUSH(static_cast<int64_t>(reader.Read<int16_t>())); break; // const2s
+            case 0x0C: EXPR_PUSH(reader.Read<uint32_t>()); break;                     // const4u
+            case 0x0D: EXPR_PUSH(static_cast<int64_t>(reader.Read<int32_t>())); break; // const4s
+            case 0x0E: EXPR_PUSH(reader.Read<uint64_t>()); break;                     // const8u
+            case 0x0F: EXPR_PUSH(reader.Read<int64_t>());  break;                     // const8s
+            case 0x10: EXPR_PUSH(reader.ULEB());           break;                     // constu
+            case 0x11: EXPR_PUSH(reader.SLEB());           break;                     // consts
+
+            case 0x12: EXPR_NEED(1); EXPR_PUSH(stack[nStack - 1]); break;             // dup
+            case 0x13: EXPR_NEED(1); nStack--; break;                                 // drop
+            case 0x14: EXPR_NEED(2); EXPR_PUSH(stack[nStack - 2]); break;             // over
+            case 0x15:                                                                // pick
+                {
+                    uint8_t iIndex = reader.U8();
+                    EXPR_NEED(static_cast<size_t>(iIndex) + 1);
+                    EXPR_PUSH(stack[nStack - 1 - iIndex]);
+                }
+                break;
+            case 0x16: EXPR_NEED(2); { uintptr_t t = stack[nStack - 1]; stack[nStack - 1] = stack[nStack - 2]; stack[nStack - 2] = t; } break; // swap
+            case 0x17:                                                                // rot
+                {
+                    EXPR_NEED(3);
+                    uintptr_t t = stack[nStack - 1];
+                    stack[nStack - 1] = stack[nStack - 2];
+                    stack[nStack - 2] = stack[nStack - 3];
+                    stack[nStack - 3] = t;
+                }
+                break;
+
+            case 0x06:                                                                // deref
+                {
+                    EXPR_NEED(1);
+                    uintptr_t iValue = 0;
+                    if(SafeReadValue(stack[nStack - 1], iValue) == false)
+                        return false;
+                    stack[nStack - 1] = iValue;
+                }
+                break;
+            case 0x94:                                                                // deref_size
+                {
+                    EXPR_NEED(1);
+                    uint8_t   iSize  = reader.U8();
+                    uintptr_t iValue = 0;
+                    if(iSize == 0 || iSize > sizeof(iValue) || SafeRead(&iValue, stack[nStack - 1], iSize) != iSize)
+                        return false;
+                    stack[nStack - 1] = iValue;
+                }
+                break;
+
+            case 0x19: EXPR_NEED(1); if(static_cast<intptr_t>(stack[nStack - 1]) < 0) stack[nStack - 1] = -stack[nStack - 1]; break; // abs
+            case 0x1F: EXPR_NEED(1); stack[nStack - 1] = -stack[nStack - 1]; break;   // neg
+            case 0x20: EXPR_NEED(1); stack[nStack - 1] = ~stack[nStack - 1]; break;   // not
+            case 0x23: EXPR_NEED(1); stack[nStack - 1] += reader.ULEB(); break;      // plus_uconst
+
+            // Binary operators, a = second from top, b = top.
+            case 0x1A: case 0x1B: case 0x1C: case 0x1D: case 0x1E: case 0x21: case 0x22:
+            case 0x24: case 0x25: case 0x26: case 0x27:
+            case 0x29: case 0x2A: case 0x2B: case 0x2C: case 0x2D: case 0x2E:
+                {
+                    EXPR_NEED(2);
+                    uintptr_t b = stack[--nStack];
+                    uintptr_t a = stack[nStack - 1];
+                    intptr_t  sa = static_cast<intptr_t>(a), sb = static_cast<intptr_t>(b);
+                    uintptr_t r  = 0;
+                    switch(iOp)
+                    {
+                        case 0x1A: r = a & b; break;
+                        case 0x1B: if(sb == 0) return false; r = static_cast<uintptr_t>(sa / sb); break;
+                        case 0x1C: r = a - b; break;
+                        case 0x1D: if(b == 0) return false; r = a % b; break;
+                        case 0x1E: r = a * b; break;
+                        case 0x21: r = a | b; break;
+                        case 0x22: r = a + b; break;
+                        case 0x24: r = b >= 64 ? 0 : a << b; break;
+                        case 0x25: r = b >= 64 ? 0 : a >> b; break;
+                        case 0x26: r = static_cast<uintptr_t>(b >= 64 ? (sa < 0 ? -1 : 0) : sa >> b); break;
+                        case 0x27: r = a ^ b; break;
+                        case 0x29: r = sa == sb; break;
+                        case 0x2A: r = sa >= sb; break;
+                        case 0x2B: r = sa >  sb; break;
+                        case 0x2C: r = sa <= sb; break;
+                        case 0x2D: r = sa <  sb; break;
+                        case 0x2E: r = sa != sb; break;
+                    }
+                    stack[nStack - 1] = r;
+                }
+                break;
+
+            case 0x2F:                                                                // skip
+            case 0x28:                                                                // bra
+                {
+                    int16_t iJump = reader.Read<int16_t>();
+                    bool    bTake = true;
+                    if(iOp == 0x28)
+                    {
+                        EXPR_NEED(1);
+                        bTake = stack[--nStack] != 0;
+                    }
+
+                    if(bTake == true)
+                    {
+                        intptr_t iTarget = static_cast<intptr_t>(reader.m_iPos) + iJump;
+                        if(iTarget < 0 || static_cast<size_t>(iTarget) > reader.m_iSize)
+                            return false;
+                        reader.m_iPos = static_cast<size_t>(iTarget);
+                    }
+                }
+                break;
+
+            case 0x92:                                                                // bregx
+                {
+                    uint64_t iReg    = reader.ULEB();
+                    int64_t  iOffset = reader.SLEB();
+                    if(iReg >= DwarfReg_Count || regs.IsValid(static_cast<int>(iReg)) == false)
+                        return false;
+                    EXPR_PUSH(regs.Get(static_cast<int>(iReg)) + static_cast<uintptr_t>(iOffset));
+                }
+                break;
+
+            case 0x96: break;                                                         // nop
+
+            // Register locations, pieces, frame base... none of it means anything for CFI.
+            default: return false;
+        }
+    }
+
+    #undef EXPR_PUSH
+    #undef EXPR_NEED
+
+
+    if(nStack == 0 || reader.m_bFailed == true)
+        return false;
+
+    iResultOut = stack[nStack - 1];
+    return true;
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+DEADSTOP_CRASH_PATH
+static bool DeadStop::ReadCFIEntry(uintptr_t iAdrs, uint8_t* pBuffer, CFIReader_t& readerOut, bool& b64BitOut)
+{
+    uint32_t iLength32 = 0;
+    if(SafeReadValue(iAdrs, iLength32) == false || iLength32 == 0) // 0 is the .eh_frame terminator.
+        return false;
+
+
+    size_t   iHeaderSize = sizeof(uint32_t);
+    uint64_t iLength     = iLength32;
+    b64BitOut            = false;
+    if(iLength32 == 0xFFFFFFFFu)
+    {
+        if(SafeReadValue(iAdrs + sizeof(uint32_t), iLength) == false)
+            return false;
+        iHeaderSize += sizeof(uint64_t);
+        b64BitOut    = true;
+    }
+
+    if(iLength > MAX_CFI_ENTRY_SIZE - iHeaderSize)
+        return false;
+
+
+    size_t iTotalSize = iHeaderSize + static_cast<size_t>(iLength);
+    if(SafeRead(pBuffer, iAdrs, iTotalSize) != iTotalSize)
+        return false;
+
+    readerOut.m_pData     = pBuffer;
+    readerOut.m_iSize     = iTotalSize;
+    readerOut.m_iPos      = iHeaderSize;
+    readerOut.m_iBaseAdrs = iAdrs;
+    readerOut.m_bFailed   = false;
+    return true;
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+DEADSTOP_CRASH_PATH
+static bool DeadStop::ParseCIE(CFIReader_t& reader, bool b64Bit, CIEInfo_t& cieOut)
+{
+    uint64_t iCIEID = b64Bit == true ? reader.Read<uint64_t>() : reader.Read<uint32_t>();
+    if(iCIEID != 0)
+        return false;
+
+    uint8_t iVersion = reader.U8();
+    if(iVersion != 1 && iVersion != 3)
+        return false;
+
+
+    // Augmentation string, null terminated.
+    char   szAugmentation[8] = {};
+    size_t nAugChars         = 0;
+    for(;;)
+    {
+        char c = static_cast<char>(reader.U8());
+        if(reader.m_bFailed == true)
+            return false;
+        if(c == '\0')
+            break;
+        if(nAugChars >= sizeof(szAugmentation) - 1)
+            return false;
+        szAugmentation[nAugChars++] = c;
+    }
+
+    // Ancient "eh" augmentation carries a pointer we don't care about.
+    if(szAugmentation[0] == 'e' && szAugmentation[1] == 'h')
+        reader.Skip(sizeof(uintptr_t));
+
+
+    cieOut.m_iCodeAlign = reader.ULEB();
+    cieOut.m_iDataAlign = reader.SLEB();
+    cieOut.m_iReturnReg = iVersion == 1 ? reader.U8() : static_cast<int>(reader.ULEB());
+
+
+    if(szAugmentation[0] == 'z')
+    {
+        cieOut.m_bHasAugData = true;
+
+        uint64_t iAugLength = reader.ULEB();
+        size_t   iAugEnd    = reader.m_iPos + static_cast<size_t>(iAugLength);
+        for(size_t i = 1; i < nAugChars; i++)
+        {
+            switch(szAugmentation[i])
+            {
+                case 'R': cieOut.m_iFDEEncoding = reader.U8(); break;
+                case 'L': reader.U8(); break;                               // LSDA encoding.
+                case 'P': reader.EncodedPointer(reader.U8()); break;        // Personality routine.
+                case 'S': cieOut.m_bSignalFrame = true; break;
+                default : i = nAugChars; break;                             // Unknown, rest is skipped via length.
+            }
+        }
+        reader.m_iPos = iAugEnd;
+    }
+    else if(nAugChars != 0)
+    {
+        // Can't know how much augmentation data there is without 'z'.
+        return false;
+    }
+
+    if(reader.m_bFailed == true || reader.m_iPos > reader.m_iSize)
+        return false;
+
+
+    cieOut.m_iProgramStart = reader.m_iPos;
+    cieOut.m_iProgramEnd   = reader.m_iSize;
+    return true;
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+DEADSTOP_CRASH_PATH
+static void DeadStop::SetRegRule(UnwindRow_t& row, uint64_t iReg, uint8_t iType, int64_t iValue, uint32_t iExprLength)
+{
+    // Vector / x87 registers etc. aren't tracked.
+    if(iReg >= DwarfReg_Count)
+        return;
+
+    RegRule_t& rule    = row.m_rules[iReg];
+    rule.m_iType       = iType;
+    rule.m_iValue      = iValue;
+    rule.m_iExprLength = iExprLength;
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+DEADSTOP_CRASH_PATH
+static bool DeadStop::RunCFAProgram(CFIReader_t& reader, size_t iStart, size_t iEnd, const CIEInfo_t& cie,
+        uintptr_t iFuncStart, uintptr_t iPC, const UnwindRow_t* pInitialRow, UnwindRow_t& row)
+{
+    UnwindRow_t rememberedRows[MAX_REMEMBERED_ROWS];
+    size_t      nRememberedRows = 0;
+
+    uintptr_t iLoc      = iFuncStart;
+    int64_t   iDataAlign = cie.m_iDataAlign;
+
+    reader.m_iPos = iStart;
+    while(reader.m_iPos < iEnd)
+    {
+        if(reader.m_bFailed == true)
+            return false;
+
+
+        uint8_t iOp      = reader.U8();
+        uint8_t iHighOp  = iOp & 0xC0;
+        uint8_t iLowBits = iOp & 0x3F;
+
+        // Advancing past iPC means the current row is the one we want.
+        uint64_t iAdvance = 0;
+        bool     bAdvance = false;
+
+        if(iHighOp == 0x40)      // advance_loc
+        {
+            iAdvance = iLowBits * cie.m_iCodeAlign; bAdvance = true;
+        }
+        else if(iHighOp == 0x80) // offset
+        {
+            SetRegRule(row, iLowBits, RegRule_Offset, static_cast<int64_t>(reader.ULEB()) * iDataAlign);
+        }
+        else if(iHighOp == 0xC0) // restore
+        {
+            if(pInitialRow != nullptr && iLowBits < DwarfReg_Count)
+                row.m_rules[iLowBits] = pInitialRow->m_rules[iLowBits];
+        }
+        else
+        {
+            switch(iOp)
+            {
+                case 0x00: break; // nop
+                case 0x01:        // set_loc
+                    {
+                        uintptr_t iNewLoc = reader.EncodedPointer(cie.m_iFDEEncoding);
+                        if(iNewLoc > iPC)
+                            return true;
+                        iLoc = iNewLoc;
+                    }
+                    break;
+                case 0x02: iAdvance = reader.Read<uint8_t>()  * cie.m_iCodeAlign; bAdvance = true; break; // advance_loc1
+                case 0x03: iAdvance = reader.Read<uint16_t>() * cie.m_iCodeAlign; bAdvance = true; break; // advance_loc2
+                case 0x04: iAdvance = reader.Read<uint32_t>() * cie.m_iCodeAlign; bAdvance = true; break; // advance_loc4
+
+                case 0x05: // offset_extended
+                    {
+                        uint64_t iReg = reader.ULEB();
+                        SetRegRule(row, iReg, RegRule_Offset, static_cast<int64_t>(reader.ULEB()) * iDataAlign);
+                    }
+                    break;
+                case 0x06: // restore_extended
+                    {
+                        uint64_t iReg = reader.ULEB();
+                        if(pInitialRow != nullptr && iReg < DwarfReg_Count)
+                            row.m_rules[iReg] = pInitialRow->m_rules[iReg];
+                    }
+                    break;
+                case 0x07: SetRegRule(row, reader.ULEB(), RegRule_Undefined, 0); break; // undefined
+                case 0x08: SetRegRule(row, reader.ULEB(), RegRule_SameValue, 0); break; // same_value
+                case 0x09: // register
+                    {
+                        uint64_t iReg = reader.ULEB();
+                        SetRegRule(row, iReg, RegRule_Register, static_cast<int64_t>(reader.ULEB()));
+                    }
+                    break;
+
+                case 0x0A: // remember_state
+                    if(nRememberedRows >= MAX_REMEMBERED_ROWS)
+                        return false;
+                    rememberedRows[nRememberedRows++] = row;
+                    break;
+                case 0x0B: // restore_state
+                    {
+                        if(nRememberedRows == 0)
+                            return false;
+
+                        // Function bounds & such belong to the current FDE, not the saved row.
+                        const UnwindRow_t& saved = rememberedRows[--nRememberedRows];
+                        row.m_iCFAType       = saved.m_iCFAType;
+                        row.m_iCFAReg        = saved.m_iCFAReg;
+                        row.m_iCFAOffset     = saved.m_iCFAOffset;
+                        row.m_iCFAExprAdrs   = saved.m_iCFAExprAdrs;
+                        row.m_iCFAExprLength = saved.m_iCFAExprLength;
+                        memcpy(row.m_rules, saved.m_rules, sizeof(row.m_rules));
+                    }
+                    break;
+
+                case 0x0C: // def_cfa
+                    row.m_iCFAType   = CFARule_RegOffset;
+                    row.m_iCFAReg    = static_cast<int>(reader.ULEB());
+                    row.m_iCFAOffset = static_cast<int64_t>(reader.ULEB());
+                    break;
+                case 0x12: // def_cfa_sf
+                    row.m_iCFAType   = CFARule_RegOffset;
+                    row.m_iCFAReg    = static_cast<int>(reader.ULEB());
+                    row.m_iCFAOffset = reader.SLEB() * iDataAlign;
+                    break;
+                case 0x0D: // def_cfa_register
+                    if(row.m_iCFAType != CFARule_RegOffset)
+                        return false;
+                    row.m_iCFAReg = static_cast<int>(reader.ULEB());
+                    break;
+                case 0x0E: // def_cfa_offset
+                    if(row.m_iCFAType != CFARule_RegOffset)
+                        return false;
+                    row.m_iCFAOffset = static_cast<int64_t>(reader.ULEB());
+                    break;
+                case 0x13: // def_cfa_offset_sf
+                    if(row.m_iCFAType != CFARule_RegOffset)
+                        return false;
+                    row.m_iCFAOffset = reader.SLEB() * iDataAlign;
+                    break;
+                case 0x0F: // def_cfa_expression
+                    {
+                        uint64_t iLength     = reader.ULEB();
+                        row.m_iCFAType       = CFARule_Expression;
+                        row.m_iCFAExprAdrs   = reader.Adrs();
+                        row.m_iCFAExprLength = static_cast<uint32_t>(iLength);
+                        reader.Skip(static_cast<size_t>(iLength));
+                    }
+                    break;
+
+                case 0x10: // expression
+                case 0x16: // val_expression
+                    {
+                        uint64_t iReg    = reader.ULEB();
+                        uint64_t iLength = reader.ULEB();
+                        SetRegRule(row, iReg, iOp == 0x10 ? RegRule_Expression : RegRule_ValExpression,
+                                static_cast<int64_t>(reader.Adrs()), static_cast<uint32_t>(iLength));
+                        reader.Skip(static_cast<size_t>(iLength));
+                    }
+                    break;
+
+                case 0x11: // offset_extended_sf
+                    {
+                        uint64_t iReg = reader.ULEB();
+                        SetRegRule(row, iReg, RegRule_Offset, reader.SLEB() * iDataAlign);
+                    }
+                    break;
+                case 0x14: // val_offset
+                    {
+                        uint64_t iReg = reader.ULEB();
+                        SetRegRule(row, iReg, RegRule_ValOffset, static_cast<int64_t>(reader.ULEB()) * iDataAlign);
+                    }
+                    break;
+                case 0x15: // val_offset_sf
+                    {
+                        uint64_t iReg = reader.ULEB();
+                        SetRegRule(row, iReg, RegRule_ValOffset, reader.SLEB() * iDataAlign);
+                    }
+                    break;
+
+                case 0x2E: reader.ULEB(); break; // GNU_args_size, only matters for landing pads.
+                case 0x2F: // GNU_negative_offset_extended
+                    {
+                        uint64_t iReg = reader.ULEB();
+                        SetRegRule(row, iReg, RegRule_Offset, -static_cast<int64_t>(reader.ULEB()) * iDataAlign);
+                    }
+                    break;
+
+                default: return false;
+            }
+        }
+
+
+        if(bAdvance == true)
+        {
+            if(iLoc + iAdvance > iPC)
+                return true;
+            iLoc += iAdvance;
+        }
+    }
+
+    return reader.m_bFailed == false;
+}
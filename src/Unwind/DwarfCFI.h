@@ -0,0 +1,128 @@
+//=========================================================================
+//                      DWARF Call Frame Information
+//=========================================================================
+// by      : INSANE
+// created : 16/10/2026
+//
+// purpose : Finds & evaluates .eh_frame unwind info ( through .eh_frame_hdr's
+//           sorted FDE table ) for x86_64 code. Every read is a SafeRead().
+//-------------------------------------------------------------------------
+#pragma once
+#include "../../Include/Alias.h"
+#include <cstddef>
+#include <cstdint>
+
+
+
+namespace DEADSTOP_NAMESPACE
+{
+    ///////////////////////////////////////////////////////////////////////////
+    ///////////////////////////////////////////////////////////////////////////
+    // DWARF register numbers for x86_64 ( SysV psABI ). Only general purpose registers & the
+    // return address are tracked, rules for anything else are parsed & dropped.
+    enum DwarfReg_t : int
+    {
+        DwarfReg_RAX = 0, DwarfReg_RDX, DwarfReg_RCX, DwarfReg_RBX,
+        DwarfReg_RSI,     DwarfReg_RDI, DwarfReg_RBP, DwarfReg_RSP,
+        DwarfReg_R8,      DwarfReg_R9,  DwarfReg_R10, DwarfReg_R11,
+        DwarfReg_R12,     DwarfReg_R13, DwarfReg_R14, DwarfReg_R15,
+        DwarfReg_RA,      // Return address column, holds rIP.
+
+        DwarfReg_Count
+    };
+
+
+    ///////////////////////////////////////////////////////////////////////////
+    ///////////////////////////////////////////////////////////////////////////
+    struct DwarfRegs_t
+    {
+        uintptr_t m_iRegs[DwarfReg_Count] = {};
+        uint32_t  m_iValidMask            = 0;
+
+        bool      IsValid(int iReg)                const { return (m_iValidMask & (1u << iReg)) != 0; }
+        uintptr_t Get(int iReg)                    const { return m_iRegs[iReg]; }
+        void      Set(int iReg, uintptr_t iValue)        { m_iRegs[iReg] = iValue; m_iValidMask |= (1u << iReg); }
+        void      Invalidate(int iReg)                   { m_iValidMask &= ~(1u << iReg); }
+    };
+
+
+    ///////////////////////////////////////////////////////////////////////////
+    ///////////////////////////////////////////////////////////////////////////
+    enum CFARuleType_t : uint8_t
+    {
+        CFARule_Invalid = 0,
+        CFARule_RegOffset,  // CFA = reg + offset
+        CFARule_Expression, // CFA = DWARF expression
+    };
+
+    enum RegRuleType_t : uint8_t
+    {
+        RegRule_Undefined = 0,
+        RegRule_SameValue,
+        RegRule_Offset,        // Saved at CFA + N
+        RegRule_ValOffset,     // Value is CFA + N
+        RegRule_Register,      // Value is in another register
+        RegRule_Expression,    // Saved at address given by expression
+        RegRule_ValExpression, // Value is the expression
+    };
+
+
+    // Expressions are kept as where they live in the module, not copied. Unwind info is
+    // read only & stays mapped as long as its module does.
+    struct RegRule_t
+    {
+        int64_t   m_iValue       = 0; // Offset, register, or expression address.
+        uint32_t  m_iExprLength  = 0;
+        uint8_t   m_iType        = RegRule_Undefined;
+    };
+
+
+    ///////////////////////////////////////////////////////////////////////////
+    ///////////////////////////////////////////////////////////////////////////
+    // CFI for one address, after running the CIE & FDE programs up to it. Everything
+    // needed to step one frame up, nothing points into the decoding state.
+    struct UnwindRow_t
+    {
+        uint8_t   m_iCFAType        = CFARule_Invalid;
+        int       m_iCFAReg         = DwarfReg_RSP;
+        int64_t   m_iCFAOffset      = 0;
+        uintptr_t m_iCFAExprAdrs    = 0;
+        uint32_t  m_iCFAExprLength  = 0;
+
+        RegRule_t m_rules[DwarfReg_Count];
+        int       m_iReturnReg      = DwarfReg_RA;
+        bool      m_bSignalFrame    = false; // 'S' augmentation, frame's address is exact, not a return address.
+
+        // [ Start, End ) of the function this row came from.
+        uintptr_t m_iFuncStart      = 0;
+        uintptr_t m_iFuncEnd        = 0;
+    };
+
+
+    ///////////////////////////////////////////////////////////////////////////
+    ///////////////////////////////////////////////////////////////////////////
+    // A loaded module's .eh_frame_hdr, with its search table located.
+    struct EhFrameHdr_t
+    {
+        uintptr_t m_iHdrAdrs    = 0;
+        uintptr_t m_iTableAdrs  = 0; // Sorted ( initial location, FDE ) pairs, 2x sdata4 each.
+        size_t    m_nFDEs       = 0;
+    };
+
+
+    // Reads .eh_frame_hdr at iHdrAdrs. Only the binary searchable table encoding ( datarel sdata4 )
+    // that every linker emits is handled, anything else returns false.
+    bool ParseEhFrameHdr(uintptr_t iHdrAdrs, EhFrameHdr_t& hdrOut);
+
+    // Binary search for the FDE covering iPC, then runs its CIE & FDE programs up to iPC.
+    // Pass the address that is actually inside the function, i.e. return address - 1 for callers.
+    bool FindUnwindRow(const EhFrameHdr_t& hdr, uintptr_t iPC, UnwindRow_t& rowOut);
+
+    // Computes the caller's registers from the callee's. Caller's rIP is left in DwarfReg_RA.
+    // Returns false if the row can't be applied with what we know.
+    bool ApplyUnwindRow(const UnwindRow_t& row, const DwarfRegs_t& regsIn, DwarfRegs_t& regsOut);
+
+    // Evaluates a DWARF expression living at iExprAdrs. Initial stack value, if any, is pushed first.
+    bool EvaluateDwarfExpression(uintptr_t iExprAdrs, uint32_t iExprLength, const DwarfRegs_t& regs,
+            bool bPushInitial, uintptr_t iInitial, uintptr_t& iResultOut);
+}
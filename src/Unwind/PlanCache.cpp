@@ -0,0 +1,230 @@
+//=========================================================================
+//                      Plan Cache
+//=========================================================================
+// by      : INSANE
+// created : 16/10/2026
+//
+// purpose : Remembers how to step up from an address, so a function seen again
+//           ( recursion, repeated captures ) costs one lookup, not a CFI
+//           search or another pass of the stack effect interpreter.
+//-------------------------------------------------------------------------
+#include "PlanCache.h"
+#include "../Util/MemoryLock/MemoryLock.h"
+#include <atomic>
+
+
+// Mind this...
+using namespace DeadStop;
+
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+namespace DEADSTOP_NAMESPACE
+{
+    // Open addressing, linear probing. Slots are never removed one by one, so an empty
+    // slot ends every probe chain.
+    static constexpr size_t MAX_UNWIND_PLANS = 512; // Power of 2.
+    static constexpr size_t MAX_PLAN_PROBES  = 16;
+
+
+    // Each slot is its own seqlock. Writers own a slot while m_iSequence is odd, & only get it
+    // with a compare exchange, never by waiting. Readers copy the slot & keep the copy only if
+    // m_iSequence was even & unchanged around it.
+    struct PlanSlot_t
+    {
+        std::atomic<uint32_t>  m_iSequence;
+        std::atomic<uintptr_t> m_iKey;      // ( address << 2 ) | method, 0 is empty.
+        StackPlan_t            m_plan;
+    };
+
+    static PlanSlot_t          s_planSlots[MAX_UNWIND_PLANS];
+    static std::atomic<size_t> s_nPlans(0);
+    static std::atomic<size_t> s_nPlanHits(0);
+    static std::atomic<size_t> s_nPlanMisses(0);
+    static std::atomic<size_t> s_nPlansRefused(0);
+
+
+    static uintptr_t MakePlanKey(uintptr_t iAdrs, UnwindMethod_t iMethod);
+    static size_t    GetPlanSlot(uintptr_t iKey);
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+DEADSTOP_CRASH_PATH
+bool DeadStop::FindUnwindPlan(uintptr_t iAdrs, UnwindMethod_t iMethod, StackPlan_t& planOut)
+{
+    uintptr_t iKey  = MakePlanKey(iAdrs, iMethod);
+    size_t    iSlot = GetPlanSlot(iKey);
+
+    for(size_t iProbe = 0; iProbe < MAX_PLAN_PROBES; iProbe++)
+    {
+        PlanSlot_t& slot = s_planSlots[(iSlot + iProbe) & (MAX_UNWIND_PLANS - 1)];
+
+        uint32_t iSequence = slot.m_iSequence.load(std::memory_order_acquire);
+        if((iSequence & 1) != 0)
+            continue; // Being written, can't tell what it holds.
+
+        uintptr_t iSlotKey = slot.m_iKey.load(std::memory_order_relaxed);
+        if(iSlotKey == 0)
+            break;
+
+        if(iSlotKey != iKey)
+            continue;
+
+        StackPlan_t plan = slot.m_plan;
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if(slot.m_iSequence.load(std::memory_order_relaxed) != iSequence)
+            break;
+
+        planOut = plan;
+        s_nPlanHits.fetch_add(1, std::memory_order_relaxed);
+        return true;
+    }
+
+    s_nPlanMisses.fetch_add(1, std::memory_order_relaxed);
+    return false;
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+DEADSTOP_CRASH_PATH
+bool DeadStop::InsertUnwindPlan(uintptr_t iAdrs, UnwindMethod_t iMethod, const StackPlan_t& plan)
+{
+    if(plan.m_bUsesState == true)
+        return false;
+
+    uintptr_t iKey  = MakePlanKey(iAdrs, iMethod);
+    size_t    iSlot = GetPlanSlot(iKey);
+
+    for(size_t iProbe = 0; iProbe < MAX_PLAN_PROBES; iProbe++)
+    {
+        PlanSlot_t& slot = s_planSlots[(iSlot + iProbe) & (MAX_UNWIND_PLANS - 1)];
+
+        uint32_t iSequence = slot.m_iSequence.load(std::memory_order_acquire);
+        if((iSequence & 1) != 0)
+            continue;
+
+        uintptr_t iSlotKey = slot.m_iKey.load(std::memory_order_relaxed);
+        if(iSlotKey == iKey)
+            return true;
+
+        if(iSlotKey != 0)
+            continue;
+
+
+        // Empty, try to own it. Whoever interrupted us or beat us to it might have just filled it.
+        if(slot.m_iSequence.compare_exchange_strong(iSequence, iSequence + 1, std::memory_order_acquire) == false)
+            continue;
+
+        if(slot.m_iKey.load(std::memory_order_relaxed) != 0)
+        {
+            bool bSame = slot.m_iKey.load(std::memory_order_relaxed) == iKey;
+            slot.m_iSequence.store(iSequence + 2, std::memory_order_release);
+            if(bSame == true)
+                return true;
+            continue;
+        }
+
+        std::atomic_thread_fence(std::memory_order_release);
+        slot.m_plan = plan;
+        slot.m_iKey.store(iKey, std::memory_order_relaxed);
+        slot.m_iSequence.store(iSequence + 2, std::memory_order_release);
+
+        s_nPlans.fetch_add(1, std::memory_order_relaxed);
+        return true;
+    }
+
+    s_nPlansRefused.fetch_add(1, std::memory_order_relaxed);
+    return false;
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+DEADSTOP_CRASH_PATH
+void DeadStop::ClearUnwindPlanCache()
+{
+    for(size_t iSlot = 0; iSlot < MAX_UNWIND_PLANS; iSlot++)
+    {
+        PlanSlot_t& slot = s_planSlots[iSlot];
+
+        // Slot being written is left to its writer, its plan is still a valid one.
+        uint32_t iSequence = slot.m_iSequence.load(std::memory_order_acquire);
+        if((iSequence & 1) != 0 || slot.m_iSequence.compare_exchange_strong(iSequence, iSequence + 1, std::memory_order_acquire) == false)
+            continue;
+
+        if(slot.m_iKey.exchange(0, std::memory_order_relaxed) != 0)
+            s_nPlans.fetch_sub(1, std::memory_order_relaxed);
+
+        slot.m_iSequence.store(iSequence + 2, std::memory_order_release);
+    }
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+DEADSTOP_CRASH_PATH
+size_t DeadStop::GetUnwindPlanCount()
+{
+    return s_nPlans.load(std::memory_order_relaxed);
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+DEADSTOP_CRASH_PATH
+size_t DeadStop::GetUnwindPlanCapacity()
+{
+    return MAX_UNWIND_PLANS;
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+DEADSTOP_CRASH_PATH
+size_t DeadStop::GetUnwindPlanHitCount()
+{
+    return s_nPlanHits.load(std::memory_order_relaxed);
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+DEADSTOP_CRASH_PATH
+size_t DeadStop::GetUnwindPlanMissCount()
+{
+    return s_nPlanMisses.load(std::memory_order_relaxed);
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+DEADSTOP_CRASH_PATH
+size_t DeadStop::GetUnwindPlanFullCount()
+{
+    return s_nPlansRefused.load(std::memory_order_relaxed);
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+DEADSTOP_CRASH_PATH
+static uintptr_t DeadStop::MakePlanKey(uintptr_t iAdrs, UnwindMethod_t iMethod)
+{
+    // User space addresses leave the top bits free. Method is never UnwindMethod_None, so keys are never 0.
+    return (iAdrs << 2) | (static_cast<uintptr_t>(iMethod) & 3);
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+DEADSTOP_CRASH_PATH
+static size_t DeadStop::GetPlanSlot(uintptr_t iKey)
+{
+    // Fibonacci hashing, return addresses are close together & would pile up otherwise.
+    return static_cast<size_t>((static_cast<uint64_t>(iKey) * 0x9E3779B97F4A7C15ull) >> 40);
+}
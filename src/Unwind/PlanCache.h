@@ -0,0 +1,41 @@
+//=========================================================================
+//                      Plan Cache
+//=========================================================================
+// by      : INSANE
+// created : 16/10/2026
+//
+// purpose : Remembers how to step up from an address, so a function seen again
+//           ( recursion, repeated captures ) costs one lookup, not a CFI
+//           search or another pass of the stack effect interpreter.
+//-------------------------------------------------------------------------
+#pragma once
+#include "../../Include/Alias.h"
+#include "Unwinder.h"
+#include "StackEffect.h"
+#include <cstddef>
+#include <cstdint>
+
+
+
+namespace DEADSTOP_NAMESPACE
+{
+    // Fixed size, lock free table. Lookups & inserts never block, so any thread or signal
+    // handler can use it, even one that interrupted an insert. Plans are keyed by address
+    // & by how they were found ( UnwindMethod_CFI, UnwindMethod_Heuristic ). Only cache
+    // plans that depend on nothing but the address, i.e. not StackPlan_t::m_bUsesState.
+    bool   FindUnwindPlan(uintptr_t iAdrs, UnwindMethod_t iMethod, StackPlan_t& planOut);
+
+    // Returns false if table is full around iAdrs, or another insert had its slot. Plan
+    // already cached for iAdrs counts as inserted.
+    bool   InsertUnwindPlan(uintptr_t iAdrs, UnwindMethod_t iMethod, const StackPlan_t& plan);
+
+    // Cache lives as long as the process does, code that got unmapped or rewritten since
+    // must be flushed by whoever knows about it.
+    void   ClearUnwindPlanCache();
+
+    size_t GetUnwindPlanCount();
+    size_t GetUnwindPlanCapacity();
+    size_t GetUnwindPlanHitCount();
+    size_t GetUnwindPlanMissCount();
+    size_t GetUnwindPlanFullCount(); // Inserts refused.
+}
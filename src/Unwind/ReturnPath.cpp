@@ -0,0 +1,353 @@
+//=========================================================================
+//                      Return Path
+//=========================================================================
+// by      : INSANE
+// created : 16/10/2026
+//
+// purpose : Finds a way from some address to its function's return, across
+//           jumps & branches, running the stack effect interpreter along it.
+//           For code without unwind info.
+//-------------------------------------------------------------------------
+#include "ReturnPath.h"
+#include "../Decoder/InstForm.h"
+#include "../Decoder/CodeWindow.h"
+#include "../Defs/MemRegion_t.h"
+#include "../Util/MemoryLock/MemoryLock.h"
+
+
+// Mind this...
+using namespace DeadStop;
+
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+namespace DEADSTOP_NAMESPACE
+{
+    // Work per frame, all paths together. Crash latency has to stay predictable.
+    static constexpr size_t    MAX_PATH_INSTS     = 2048;
+    static constexpr size_t    MAX_PENDING_PATHS  = 8;   // Branch targets waiting to be walked, ~1 KiB each.
+    static constexpr size_t    MAX_VISITED_BLOCKS = 256; // Power of 2.
+
+    // Jumps further than this from where we started are into some other function.
+    static constexpr uintptr_t MAX_FUNCTION_SPAN  = 16 * 1024;
+
+    static constexpr size_t    CODE_BATCH_SIZE    = 200; // Code is asked from the window this much at a time.
+    static constexpr size_t    MAX_INST_BYTES     = 15;
+
+
+    enum BranchType_t : uint8_t
+    {
+        BranchType_None = 0,
+        BranchType_Conditional, // Jcc, LOOP, JrCXZ
+        BranchType_Jump,        // JMP rel
+        BranchType_Indirect,    // JMP r/m
+    };
+
+
+    // Addresses paths started at. Walking into one again means that code is, or will be, walked already.
+    struct VisitedBlocks_t
+    {
+        uintptr_t m_iAdrs[MAX_VISITED_BLOCKS] = {};
+
+        bool Contains(uintptr_t iAdrs) const;
+        bool Insert(uintptr_t iAdrs); // false if already there, or no room left.
+    };
+
+
+    struct PendingPath_t
+    {
+        uintptr_t     m_iAdrs = 0;
+        StackEffect_t m_state;
+    };
+
+
+    static BranchType_t GetBranchType(const InstForm_t& form, const uint8_t* pInst, uintptr_t iAdrs, uintptr_t& iTargetOut);
+    static bool         IsPaddingOrEntry(const InstForm_t& form);
+    static bool         IsFunctionEntry(CodeWindow_t& codeWindow, MemRegionHandler_t& memRegions, uintptr_t iAdrs);
+    static bool         IsNearby(uintptr_t iAdrs, uintptr_t iStartPos);
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+DEADSTOP_CRASH_PATH
+bool DeadStop::FindReturnPath(MemRegionHandler_t& memRegions, CodeWindow_t& codeWindow, uintptr_t iStartPos, bool bReturnAdrs,
+        const DwarfRegs_t* pEntryRegs, StackPlan_t& planOut, ReturnPathStats_t& statsOut)
+{
+    statsOut = ReturnPathStats_t();
+
+    StackEffect_t   state;
+    PendingPath_t   pendingPaths[MAX_PENDING_PATHS];
+    size_t          nPendingPaths = 0;
+    VisitedBlocks_t visited;
+
+    state.Reset(pEntryRegs);
+    visited.Insert(iStartPos);
+
+    // First far jump seen, in case no path gets to a RETN.
+    StackPlan_t farJumpPlan;
+    uintptr_t   iFarJumpAdrs = 0;
+    bool        bHasFarJump  = false;
+
+
+    uintptr_t iPathStart = iStartPos;
+    uintptr_t iAdrs      = iStartPos;
+    bool      bAfterCall = bReturnAdrs;
+    statsOut.m_nPaths    = 1;
+    while(true)
+    {
+        CodeSpan_t batch;
+
+        // Walk one path, until it returns or dies.
+        while(statsOut.m_nInsts < MAX_PATH_INSTS)
+        {
+            // Ran into code some path already started at.
+            if(iAdrs != iPathStart && visited.Contains(iAdrs) == true)
+                break;
+
+            // Next instruction might not fit in what we have, move the batch up to it.
+            if(iAdrs < batch.m_iAdrs || iAdrs + MAX_INST_BYTES > batch.m_iAdrs + batch.m_iSize)
+            {
+                if(memRegions.HasExecutableRegion(iAdrs, iAdrs + CODE_BATCH_SIZE) == false)
+                    break;
+
+                batch = codeWindow.Get(iAdrs, CODE_BATCH_SIZE);
+                if(batch.m_iSize != CODE_BATCH_SIZE)
+                    break;
+            }
+
+            const uint8_t* pInst = batch.m_pBytes + (iAdrs - batch.m_iAdrs);
+            InstForm_t     form;
+            if(ParseInstForm(pInst, batch.m_iAdrs + batch.m_iSize - iAdrs, form) == false)
+                break;
+
+            // Call didn't come back here, its a noreturn one & this is past the function's end.
+            if(bAfterCall == true && IsPaddingOrEntry(form) == true)
+                break;
+
+
+            statsOut.m_nInsts++;
+            StackEffectStep_t iStep = state.Step(iAdrs, pInst, form);
+            if(iStep == StackEffectStep_Return)
+            {
+                statsOut.m_iEndAdrs = iAdrs;
+                planOut             = state.GetPlan();
+                return true;
+            }
+
+            if(iStep == StackEffectStep_Lost)
+                break;
+
+
+            bAfterCall = form.m_iEncoding == InstEncoding_Legacy && form.m_iMap == InstMap_OneByte &&
+                (form.m_iOpCode == 0xE8 || (form.m_iOpCode == 0xFF && form.RegField() == 2));
+
+            uintptr_t    iTarget = 0;
+            BranchType_t iBranch = GetBranchType(form, pInst, iAdrs, iTarget);
+            iAdrs += form.m_iLength;
+
+            if(iBranch == BranchType_Conditional)
+            {
+                // Far targets are cold code ( .text.unlikely ), the hot path has a return of its own.
+                if(nPendingPaths < MAX_PENDING_PATHS && IsNearby(iTarget, iStartPos) == true && visited.Insert(iTarget) == true)
+                {
+                    pendingPaths[nPendingPaths].m_iAdrs = iTarget;
+                    pendingPaths[nPendingPaths].m_state = state;
+                    nPendingPaths++;
+                }
+            }
+            else if(iBranch == BranchType_Jump || iBranch == BranchType_Indirect)
+            {
+                // JMP [ rip + x ] is a PLT / GOT jump & ENDBR64 starts a function, both are tail calls for sure.
+                // Far jumps most likely are too, but might be into cold code. Those are only taken if no path
+                // reaches a RETN.
+                bool bNear     = iBranch == BranchType_Jump && IsNearby(iTarget, iStartPos) == true;
+                bool bTailCall = iBranch == BranchType_Indirect ? form.IsRIPRelative() == true :
+                    bNear == true && IsFunctionEntry(codeWindow, memRegions, iTarget) == true;
+
+                if(bTailCall == true || (iBranch == BranchType_Jump && bNear == false))
+                {
+                    StackEffect_t tailCall = state;
+                    if(tailCall.TailCall() != StackEffectStep_Return)
+                        break;
+
+                    if(bTailCall == true)
+                    {
+                        statsOut.m_bTailCall = true;
+                        statsOut.m_iEndAdrs  = iAdrs - form.m_iLength;
+                        planOut              = tailCall.GetPlan();
+                        return true;
+                    }
+
+                    if(bHasFarJump == false)
+                    {
+                        farJumpPlan  = tailCall.GetPlan();
+                        iFarJumpAdrs = iAdrs - form.m_iLength;
+                        bHasFarJump  = true;
+                    }
+                    break;
+                }
+
+                // Jump tables & function pointers, nothing to follow.
+                if(iBranch == BranchType_Indirect || visited.Insert(iTarget) == false)
+                    break;
+
+                statsOut.m_nJumps++;
+                iPathStart = iTarget;
+                iAdrs      = iTarget;
+                batch      = CodeSpan_t(); // IsFunctionEntry() might have moved the window.
+            }
+        }
+
+
+        // This path is dead, try the last branch not taken.
+        if(nPendingPaths == 0 || statsOut.m_nInsts >= MAX_PATH_INSTS)
+        {
+            if(bHasFarJump == false)
+                return false;
+
+            statsOut.m_bTailCall = true;
+            statsOut.m_iEndAdrs  = iFarJumpAdrs;
+            planOut              = farJumpPlan;
+            return true;
+        }
+
+        nPendingPaths--;
+        iPathStart = pendingPaths[nPendingPaths].m_iAdrs;
+        iAdrs      = iPathStart;
+        bAfterCall = false;
+        state      = pendingPaths[nPendingPaths].m_state;
+        statsOut.m_nPaths++;
+    }
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+DEADSTOP_CRASH_PATH
+bool DeadStop::VisitedBlocks_t::Contains(uintptr_t iAdrs) const
+{
+    size_t iSlot = static_cast<size_t>((static_cast<uint64_t>(iAdrs) * 0x9E3779B97F4A7C15ull) >> 40);
+    for(size_t iProbe = 0; iProbe < MAX_VISITED_BLOCKS; iProbe++)
+    {
+        uintptr_t iSlotAdrs = m_iAdrs[(iSlot + iProbe) & (MAX_VISITED_BLOCKS - 1)];
+        if(iSlotAdrs == iAdrs)
+            return true;
+
+        if(iSlotAdrs == 0)
+            return false;
+    }
+
+    return false;
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+DEADSTOP_CRASH_PATH
+bool DeadStop::VisitedBlocks_t::Insert(uintptr_t iAdrs)
+{
+    // Keep a few slots empty, so lookups that miss still end quickly.
+    size_t iSlot = static_cast<size_t>((static_cast<uint64_t>(iAdrs) * 0x9E3779B97F4A7C15ull) >> 40);
+    for(size_t iProbe = 0; iProbe < MAX_VISITED_BLOCKS / 2; iProbe++)
+    {
+        uintptr_t& iSlotAdrs = m_iAdrs[(iSlot + iProbe) & (MAX_VISITED_BLOCKS - 1)];
+        if(iSlotAdrs == iAdrs)
+            return false;
+
+        if(iSlotAdrs == 0)
+        {
+            iSlotAdrs = iAdrs;
+            return true;
+        }
+    }
+
+    return false;
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+DEADSTOP_CRASH_PATH
+static DeadStop::BranchType_t DeadStop::GetBranchType(const InstForm_t& form, const uint8_t* pInst, uintptr_t iAdrs, uintptr_t& iTargetOut)
+{
+    if(form.m_iEncoding != InstEncoding_Legacy)
+        return BranchType_None;
+
+    BranchType_t iType    = BranchType_None;
+    size_t       iRelSize = 0;
+    if(form.m_iMap == InstMap_OneByte)
+    {
+        uint8_t iOpCode = form.m_iOpCode;
+        if((iOpCode >= 0x70 && iOpCode <= 0x7F) || (iOpCode >= 0xE0 && iOpCode <= 0xE3))
+        {
+            iType = BranchType_Conditional; iRelSize = 1;
+        }
+        else if(iOpCode == 0xEB || iOpCode == 0xE9)
+        {
+            iType = BranchType_Jump; iRelSize = iOpCode == 0xEB ? 1 : 4;
+        }
+        else if(iOpCode == 0xFF && form.RegField() == 4)
+        {
+            return BranchType_Indirect;
+        }
+    }
+    else if(form.m_iMap == InstMap_0F && form.m_iOpCode >= 0x80 && form.m_iOpCode <= 0x8F)
+    {
+        iType = BranchType_Conditional; iRelSize = 4;
+    }
+
+    if(iType == BranchType_None || form.m_iImmOffset + iRelSize != form.m_iLength)
+        return BranchType_None;
+
+
+    // rel8 / rel32, from the end of the instruction.
+    const uint8_t* pRel = pInst + form.m_iImmOffset;
+    int64_t iRel = iRelSize == 1 ? static_cast<int8_t>(pRel[0]) : static_cast<int32_t>(
+        static_cast<uint32_t>(pRel[0]) | static_cast<uint32_t>(pRel[1]) << 8 | static_cast<uint32_t>(pRel[2]) << 16 | static_cast<uint32_t>(pRel[3]) << 24);
+
+    iTargetOut = iAdrs + form.m_iLength + static_cast<uintptr_t>(iRel);
+    return iType;
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+DEADSTOP_CRASH_PATH
+static bool DeadStop::IsPaddingOrEntry(const InstForm_t& form)
+{
+    if(form.m_iEncoding != InstEncoding_Legacy)
+        return false;
+
+    // NOP ( not XCHG r8, rax ), multi byte NOP, ENDBR64.
+    if(form.m_iMap == InstMap_OneByte)
+        return form.m_iOpCode == 0x90 && form.m_bRexB == false;
+
+    return form.m_iMap == InstMap_0F &&
+        (form.m_iOpCode == 0x1F || (form.m_iOpCode == 0x1E && form.m_bRepF3 == true && form.m_iModRM == 0xFA));
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+DEADSTOP_CRASH_PATH
+static bool DeadStop::IsFunctionEntry(CodeWindow_t& codeWindow, MemRegionHandler_t& memRegions, uintptr_t iAdrs)
+{
+    // CET enabled builds start every function that can be called or jumped to indirectly with ENDBR64.
+    if(memRegions.HasExecutableRegion(iAdrs, iAdrs + 4) == false)
+        return false;
+
+    CodeSpan_t code = codeWindow.Get(iAdrs, 4);
+    return code.m_iSize == 4 && code.m_pBytes[0] == 0xF3 && code.m_pBytes[1] == 0x0F && code.m_pBytes[2] == 0x1E && code.m_pBytes[3] == 0xFA;
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+DEADSTOP_CRASH_PATH
+static bool DeadStop::IsNearby(uintptr_t iAdrs, uintptr_t iStartPos)
+{
+    return iAdrs + MAX_FUNCTION_SPAN >= iStartPos && iAdrs <= iStartPos + MAX_FUNCTION_SPAN;
+}
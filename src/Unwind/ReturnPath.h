@@ -0,0 +1,49 @@
+//=========================================================================
+//                      Return Path
+//=========================================================================
+// by      : INSANE
+// created : 16/10/2026
+//
+// purpose : Finds a way from some address to its function's return, across
+//           jumps & branches, running the stack effect interpreter along it.
+//           For code without unwind info.
+//-------------------------------------------------------------------------
+#pragma once
+#include "../../Include/Alias.h"
+#include "StackEffect.h"
+#include <cstddef>
+#include <cstdint>
+
+
+
+namespace DEADSTOP_NAMESPACE
+{
+    class MemRegionHandler_t;
+    class CodeWindow_t;
+
+
+    ///////////////////////////////////////////////////////////////////////////
+    ///////////////////////////////////////////////////////////////////////////
+    struct ReturnPathStats_t
+    {
+        size_t    m_nInsts    = 0;     // Instructions interpreted, every path tried included.
+        size_t    m_nPaths    = 0;     // Paths started, 1 + branches taken.
+        size_t    m_nJumps    = 0;     // Unconditional jumps followed.
+        uintptr_t m_iEndAdrs  = 0;     // RETN / tail call the path ended on.
+        bool      m_bTailCall = false; // Path ended jumping into another function, not on a RETN.
+    };
+
+
+    // Walks code from iStartPos until some path reaches a RETN ( or a tail call ), & gives the stack plan
+    // along that path. Conditional branches are followed fall through first, with the taken side kept for
+    // when a path dies. A path dies when the interpreter loses rSP, when it loops back into code already
+    // walked, at an indirect jump it can't follow, or right after a call that doesn't return ( padding
+    // or another function follows it ). Jumps onto an ENDBR64 or through the GOT are tail calls. Jumps
+    // further than a function could span are taken as tail calls only if no path reaches a RETN, as
+    // they might be into the function's cold code. Work is bounded, so this gives up on big functions
+    // rather than taking long.
+    // bReturnAdrs tells iStartPos is right after a call, which might not have been meant to return.
+    // pEntryRegs are the actual registers at iStartPos, if known. See StackEffect_t::Reset().
+    bool FindReturnPath(MemRegionHandler_t& memRegions, CodeWindow_t& codeWindow, uintptr_t iStartPos, bool bReturnAdrs,
+            const DwarfRegs_t* pEntryRegs, StackPlan_t& planOut, ReturnPathStats_t& statsOut);
+}
@@ -0,0 +1,983 @@
+//=========================================================================
+//                      Stack Effect
+//=========================================================================
+// by      : INSANE
+// created : 16/10/2026
+//
+// purpose : Follows what a run of instructions does to rSP & the callee saved
+//           registers, up to a return. For code without unwind info, the
+//           result tells where the return address & saved registers are.
+//-------------------------------------------------------------------------
+#include "StackEffect.h"
+#include "../Decoder/InstForm.h"
+#include "../Util/SafeRead/SafeRead.h"
+#include "../Util/MemoryLock/MemoryLock.h"
+#include <cstring>
+
+
+// Mind this...
+using namespace DeadStop;
+
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+namespace DEADSTOP_NAMESPACE
+{
+    // x86 encoding register number -> DWARF register number.
+    static constexpr int8_t s_x86ToDwarf[16] = {
+        DwarfReg_RAX, DwarfReg_RCX, DwarfReg_RDX, DwarfReg_RBX, DwarfReg_RSP, DwarfReg_RBP, DwarfReg_RSI, DwarfReg_RDI,
+        DwarfReg_R8,  DwarfReg_R9,  DwarfReg_R10, DwarfReg_R11, DwarfReg_R12, DwarfReg_R13, DwarfReg_R14, DwarfReg_R15 };
+
+    // Caller saved ( SysV ), nothing can be known about these after a call.
+    static constexpr int s_scratchRegs[] = {
+        DwarfReg_RAX, DwarfReg_RDX, DwarfReg_RCX, DwarfReg_RSI, DwarfReg_RDI, DwarfReg_R8, DwarfReg_R9, DwarfReg_R10, DwarfReg_R11 };
+
+    static constexpr int X86_RSP = 4;
+    static constexpr int X86_RBP = 5;
+
+    // Saved registers of a frame are read in one go if they are at most this far apart. Each read is
+    // a syscall, & frames usually keep them right next to each other.
+    static constexpr size_t MAX_PLAN_READ_SPAN = 256;
+
+
+    // General purpose registers an instruction we don't follow might write. Only used to forget what
+    // we knew about them, so claiming too much is harmless, missing one isn't.
+    enum GPRWrite_t : uint16_t
+    {
+        GPRWrite_RM        = 1 << 0,  // ModRM.rm, if it is a register.
+        GPRWrite_Reg       = 1 << 1,  // ModRM.reg
+        GPRWrite_OpCodeReg = 1 << 2,  // Low 3 bits of the opcode.
+        GPRWrite_VEXReg    = 1 << 3,  // VEX / EVEX vvvv
+        GPRWrite_RAX       = 1 << 4,
+        GPRWrite_RCX       = 1 << 5,
+        GPRWrite_RDX       = 1 << 6,
+        GPRWrite_RBX       = 1 << 7,
+        GPRWrite_RSI       = 1 << 8,
+        GPRWrite_RDI       = 1 << 9,
+        GPRWrite_R11       = 1 << 10,
+        GPRWrite_Group     = 1 << 11, // Depends on ModRM.reg, see ClobberWrittenRegs().
+        GPRWrite_Trap      = 1 << 12, // Never falls through ( int3, ud2, hlt ... ). We are past the function.
+        GPRWrite_IfScalar  = 1 << 13, // Only with a 0xF3 / 0xF2 prefix, otherwise its an MMX register.
+        GPRWrite_NotIfF3   = 1 << 14, // Not with a 0xF3 prefix, that form writes an XMM register.
+    };
+
+
+    struct GPRWriteRange_t
+    {
+        uint8_t  m_iFirst;
+        uint8_t  m_iLast;
+        uint16_t m_iWrites;
+    };
+
+    struct GPRWriteTable_t
+    {
+        uint16_t m_iWrites[256] = {};
+    };
+
+    template<size_t N>
+    static constexpr GPRWriteTable_t MakeGPRWriteTable(const GPRWriteRange_t (&ranges)[N])
+    {
+        GPRWriteTable_t table;
+        for(size_t iRange = 0; iRange < N; iRange++)
+        {
+            for(int iOpCode = ranges[iRange].m_iFirst; iOpCode <= ranges[iRange].m_iLast; iOpCode++)
+                table.m_iWrites[iOpCode] |= ranges[iRange].m_iWrites;
+        }
+        return table;
+    }
+
+
+    static constexpr GPRWriteRange_t s_oneByteWriteRanges[] = {
+        { 0x00, 0x01, GPRWrite_RM  }, { 0x02, 0x03, GPRWrite_Reg }, { 0x04, 0x05, GPRWrite_RAX }, // ADD
+        { 0x08, 0x09, GPRWrite_RM  }, { 0x0A, 0x0B, GPRWrite_Reg }, { 0x0C, 0x0D, GPRWrite_RAX }, // OR
+        { 0x10, 0x11, GPRWrite_RM  }, { 0x12, 0x13, GPRWrite_Reg }, { 0x14, 0x15, GPRWrite_RAX }, // ADC
+        { 0x18, 0x19, GPRWrite_RM  }, { 0x1A, 0x1B, GPRWrite_Reg }, { 0x1C, 0x1D, GPRWrite_RAX }, // SBB
+        { 0x20, 0x21, GPRWrite_RM  }, { 0x22, 0x23, GPRWrite_Reg }, { 0x24, 0x25, GPRWrite_RAX }, // AND
+        { 0x28, 0x29, GPRWrite_RM  }, { 0x2A, 0x2B, GPRWrite_Reg }, { 0x2C, 0x2D, GPRWrite_RAX }, // SUB
+        { 0x30, 0x31, GPRWrite_RM  }, { 0x32, 0x33, GPRWrite_Reg }, { 0x34, 0x35, GPRWrite_RAX }, // XOR
+        { 0x63, 0x63, GPRWrite_Reg }, { 0x69, 0x69, GPRWrite_Reg }, { 0x6B, 0x6B, GPRWrite_Reg },
+        { 0x6C, 0x6D, GPRWrite_RDI | GPRWrite_RCX }, { 0x6E, 0x6F, GPRWrite_RSI | GPRWrite_RCX },
+        { 0x80, 0x83, GPRWrite_Group },
+        { 0x86, 0x87, GPRWrite_Reg | GPRWrite_RM }, { 0x88, 0x89, GPRWrite_RM }, { 0x8A, 0x8B, GPRWrite_Reg },
+        { 0x8C, 0x8C, GPRWrite_RM  }, { 0x8D, 0x8D, GPRWrite_Reg },
+        { 0x91, 0x97, GPRWrite_OpCodeReg | GPRWrite_RAX }, { 0x98, 0x98, GPRWrite_RAX }, { 0x99, 0x99, GPRWrite_RDX },
+        { 0x9F, 0x9F, GPRWrite_RAX }, { 0xA0, 0xA1, GPRWrite_RAX },
+        { 0xA4, 0xA7, GPRWrite_RSI | GPRWrite_RDI | GPRWrite_RCX }, { 0xAA, 0xAB, GPRWrite_RDI | GPRWrite_RCX },
+        { 0xAC, 0xAD, GPRWrite_RSI | GPRWrite_RCX | GPRWrite_RAX }, { 0xAE, 0xAF, GPRWrite_RDI | GPRWrite_RCX },
+        { 0xB0, 0xBF, GPRWrite_OpCodeReg },
+        { 0xC0, 0xC1, GPRWrite_RM  }, { 0xC6, 0xC7, GPRWrite_RM },
+        { 0xCA, 0xCC, GPRWrite_Trap }, { 0xCF, 0xCF, GPRWrite_Trap },
+        { 0xD0, 0xD3, GPRWrite_RM  }, { 0xDF, 0xDF, GPRWrite_RAX },
+        { 0xE0, 0xE2, GPRWrite_RCX }, { 0xE4, 0xE5, GPRWrite_RAX }, { 0xEC, 0xED, GPRWrite_RAX },
+        { 0xF4, 0xF4, GPRWrite_Trap }, { 0xF6, 0xF7, GPRWrite_Group }, { 0xFE, 0xFF, GPRWrite_Group },
+    };
+
+    // Also used for VEX / EVEX map 1, the few of those that write a general purpose register line up.
+    static constexpr GPRWriteRange_t s_twoByteWriteRanges[] = {
+        { 0x00, 0x00, GPRWrite_RM  }, { 0x01, 0x01, GPRWrite_RAX | GPRWrite_RCX | GPRWrite_RDX },
+        { 0x02, 0x03, GPRWrite_Reg }, { 0x05, 0x05, GPRWrite_RAX | GPRWrite_RCX | GPRWrite_R11 },
+        { 0x0B, 0x0B, GPRWrite_Trap }, { 0x20, 0x21, GPRWrite_RM },
+        { 0x2C, 0x2D, GPRWrite_Reg | GPRWrite_IfScalar }, { 0x31, 0x33, GPRWrite_RAX | GPRWrite_RDX },
+        { 0x40, 0x4F, GPRWrite_Reg }, { 0x50, 0x50, GPRWrite_Reg }, { 0x78, 0x78, GPRWrite_RM },
+        { 0x7E, 0x7E, GPRWrite_RM | GPRWrite_NotIfF3 }, { 0x90, 0x9F, GPRWrite_RM },
+        { 0xA2, 0xA2, GPRWrite_RAX | GPRWrite_RBX | GPRWrite_RCX | GPRWrite_RDX },
+        { 0xA4, 0xA5, GPRWrite_RM  }, { 0xAB, 0xAE, GPRWrite_RM }, { 0xAF, 0xAF, GPRWrite_Reg },
+        { 0xB0, 0xB1, GPRWrite_RM | GPRWrite_RAX }, { 0xB2, 0xB2, GPRWrite_Reg }, { 0xB3, 0xB3, GPRWrite_RM },
+        { 0xB4, 0xB8, GPRWrite_Reg }, { 0xB9, 0xB9, GPRWrite_Trap }, { 0xBA, 0xBB, GPRWrite_RM },
+        { 0xBC, 0xBF, GPRWrite_Reg }, { 0xC0, 0xC1, GPRWrite_Reg | GPRWrite_RM }, { 0xC5, 0xC5, GPRWrite_Reg },
+        { 0xC7, 0xC7, GPRWrite_RM | GPRWrite_RAX | GPRWrite_RDX }, { 0xC8, 0xCF, GPRWrite_OpCodeReg },
+        { 0xD7, 0xD7, GPRWrite_Reg }, { 0xFF, 0xFF, GPRWrite_Trap },
+    };
+
+    static constexpr GPRWriteRange_t s_0F38WriteRanges[] = {
+        { 0xF0, 0xF2, GPRWrite_Reg }, { 0xF3, 0xF3, GPRWrite_VEXReg }, { 0xF5, 0xF5, GPRWrite_Reg },
+        { 0xF6, 0xF6, GPRWrite_Reg | GPRWrite_VEXReg }, { 0xF7, 0xF7, GPRWrite_Reg },
+    };
+
+    static constexpr GPRWriteRange_t s_0F3AWriteRanges[] = {
+        { 0x14, 0x17, GPRWrite_RM }, { 0x61, 0x61, GPRWrite_RCX }, { 0x63, 0x63, GPRWrite_RCX }, { 0xF0, 0xF0, GPRWrite_Reg },
+    };
+
+    static constexpr GPRWriteTable_t s_oneByteWrites = MakeGPRWriteTable(s_oneByteWriteRanges);
+    static constexpr GPRWriteTable_t s_twoByteWrites = MakeGPRWriteTable(s_twoByteWriteRanges);
+    static constexpr GPRWriteTable_t s_0F38Writes    = MakeGPRWriteTable(s_0F38WriteRanges);
+    static constexpr GPRWriteTable_t s_0F3AWrites    = MakeGPRWriteTable(s_0F3AWriteRanges);
+
+
+    static StackValue_t MakeConstant(int64_t iValue);
+    static bool         IsConstant(const StackValue_t& value);
+    static bool         IsSameValue(const StackValue_t& a, const StackValue_t& b);
+    static bool         ReadImmediate(const uint8_t* pBytes, size_t iLength, const InstForm_t& form, size_t iSize, int64_t& iImmOut);
+    static bool         EvaluateStackValue(const StackValue_t& value, const DwarfRegs_t& regs, uintptr_t& iValueOut);
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+DEADSTOP_CRASH_PATH
+void DeadStop::StackEffect_t::Reset(const DwarfRegs_t* pEntryRegs)
+{
+    for(int iReg = 0; iReg < 16; iReg++)
+    {
+        m_regs[iReg].m_iKind   = StackValue_RegOffset;
+        m_regs[iReg].m_iBase   = static_cast<int8_t>(iReg);
+        m_regs[iReg].m_iOffset = 0;
+    }
+
+    m_nStores       = 0;
+    m_bHasEntryRegs = pEntryRegs != nullptr;
+    m_entryRegs     = pEntryRegs != nullptr ? *pEntryRegs : DwarfRegs_t();
+    m_plan          = StackPlan_t();
+    m_nSteps        = 0;
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+DEADSTOP_CRASH_PATH
+DeadStop::StackEffectStep_t DeadStop::StackEffect_t::Step(uintptr_t iAdrs, const uint8_t* pBytes, const InstForm_t& form)
+{
+    m_nSteps++;
+
+    size_t iLength = form.m_iLength;
+    uint8_t iOpCode = form.m_iOpCode;
+    bool    bRegDst = form.m_bHasModRM == true && form.Mod() == 3;
+
+
+    if(form.m_iEncoding == InstEncoding_Legacy && form.m_iMap == InstMap_OneByte)
+    {
+        int64_t iImm = 0;
+        switch(iOpCode)
+        {
+            // PUSH r / POP r
+            case 0x50: case 0x51: case 0x52: case 0x53: case 0x54: case 0x55: case 0x56: case 0x57:
+                return Push(GetReg(form.OpCodeReg()), form.m_bOpSize16 == true ? 2 : 8);
+            case 0x58: case 0x59: case 0x5A: case 0x5B: case 0x5C: case 0x5D: case 0x5E: case 0x5F:
+                return Pop(form.OpCodeReg(), form.m_bOpSize16 == true ? 2 : 8);
+
+            // PUSH imm, PUSHF, POPF
+            case 0x68: case 0x6A: case 0x9C:
+                return Push(StackValue_t(), form.m_bOpSize16 == true ? 2 : 8);
+            case 0x9D:
+                return Pop(-1, form.m_bOpSize16 == true ? 2 : 8);
+
+            // RETN, RETN imm16
+            case 0xC3:
+                return Return(0);
+            case 0xC2:
+                if(ReadImmediate(pBytes, iLength, form, 2, iImm) == false)
+                    return StackEffectStep_Lost;
+                return Return(static_cast<uint16_t>(iImm));
+
+            // LEAVE : mov rsp, rbp; pop rbp
+            case 0xC9:
+                SetReg(X86_RSP, GetReg(X86_RBP));
+                return Pop(X86_RBP, 8);
+
+            // ENTER imm16, imm8 : push rbp; mov rbp, rsp; sub rsp, imm16. Nesting levels aren't a thing in real code.
+            case 0xC8:
+            {
+                if(ReadImmediate(pBytes, iLength, form, 2, iImm) == false || iLength < 4 || pBytes[iLength - 1] != 0)
+                    return StackEffectStep_Lost;
+
+                StackEffectStep_t iStep = Push(GetReg(X86_RBP), 8);
+                if(iStep != StackEffectStep_Continue)
+                    return iStep;
+
+                SetReg(X86_RBP, GetReg(X86_RSP));
+                SetReg(X86_RSP, AddOffset(GetReg(X86_RSP), -static_cast<int64_t>(static_cast<uint16_t>(iImm))));
+                return CheckRSP();
+            }
+
+            case 0xE8:
+                return Call();
+
+            // POP r/m
+            case 0x8F:
+            {
+                if(form.RegField() != 0)
+                    break;
+
+                if(bRegDst == true)
+                    return Pop(form.RM(), 8);
+
+                StackValue_t value = Load(GetReg(X86_RSP));
+                SetReg(X86_RSP, AddOffset(GetReg(X86_RSP), 8));
+                Store(EffectiveAdrs(form, iAdrs, iLength), value); // rSP as base is the popped rSP.
+                return CheckRSP();
+            }
+
+            // Group 5 : CALL, far CALL / JMP, PUSH r/m
+            case 0xFF:
+            {
+                switch(form.RegField())
+                {
+                    case 2:  return Call();
+                    case 3:  return StackEffectStep_Lost;
+                    case 5:  return StackEffectStep_Lost;
+                    case 6:  return Push(bRegDst == true ? GetReg(form.RM()) : Load(EffectiveAdrs(form, iAdrs, iLength)), 8);
+                    default: break;
+                }
+                break;
+            }
+
+            // ADD / SUB / AND r/m64, imm
+            case 0x81: case 0x83:
+            {
+                if(bRegDst == false || form.m_bRexW == false)
+                    break;
+
+                if(ReadImmediate(pBytes, iLength, form, iOpCode == 0x83 ? 1 : 4, iImm) == false)
+                    return StackEffectStep_Lost;
+
+                int          iDst  = form.RM();
+                StackValue_t value = GetReg(iDst);
+                if(form.RegField() == 0)
+                {
+                    SetReg(iDst, AddOffset(value, iImm));
+                }
+                else if(form.RegField() == 5)
+                {
+                    SetReg(iDst, AddOffset(value, -iImm));
+                }
+                else if(form.RegField() == 4)
+                {
+                    // AND rsp, -32 & friends ( stack realignment ). Only an actual value can be masked.
+                    uintptr_t iValue = 0;
+                    bool bKnown = IsConstant(value) == true || (iDst == X86_RSP && Concretize(value, iValue) == true);
+                    if(IsConstant(value) == true)
+                        iValue = static_cast<uintptr_t>(value.m_iOffset);
+
+                    SetReg(iDst, bKnown == true ? MakeConstant(static_cast<int64_t>(iValue) & iImm) : StackValue_t());
+                }
+                else
+                {
+                    break;
+                }
+                return CheckRSP();
+            }
+
+            // ADD / SUB r64, r64
+            case 0x01: case 0x03: case 0x29: case 0x2B:
+            {
+                if(bRegDst == false || form.m_bRexW == false)
+                    break;
+
+                bool bToRM = iOpCode == 0x01 || iOpCode == 0x29;
+                bool bSub  = iOpCode == 0x29 || iOpCode == 0x2B;
+                int  iDst  = bToRM == true ? form.RM()  : form.Reg();
+                int  iSrc  = bToRM == true ? form.Reg() : form.RM();
+
+                StackValue_t src = GetReg(iSrc);
+                StackValue_t dst = GetReg(iDst);
+                uintptr_t    iSrcValue = 0, iDstValue = 0;
+                if(IsConstant(src) == true)
+                {
+                    SetReg(iDst, AddOffset(dst, bSub == true ? -src.m_iOffset : src.m_iOffset));
+                }
+                else if(iDst == X86_RSP && Concretize(src, iSrcValue) == true && Concretize(dst, iDstValue) == true)
+                {
+                    SetReg(iDst, MakeConstant(static_cast<int64_t>(bSub == true ? iDstValue - iSrcValue : iDstValue + iSrcValue)));
+                }
+                else
+                {
+                    SetReg(iDst, StackValue_t());
+                }
+                return CheckRSP();
+            }
+
+            // MOV r/m64, r64 & MOV r64, r/m64
+            case 0x89:
+            {
+                if(form.m_bRexW == false)
+                    break;
+
+                if(bRegDst == true)
+                    SetReg(form.RM(), GetReg(form.Reg()));
+                else
+                    Store(EffectiveAdrs(form, iAdrs, iLength), GetReg(form.Reg()));
+                return CheckRSP();
+            }
+            case 0x8B:
+            {
+                if(form.m_bRexW == false)
+                    break;
+
+                SetReg(form.Reg(), bRegDst == true ? GetReg(form.RM()) : Load(EffectiveAdrs(form, iAdrs, iLength)));
+                return CheckRSP();
+            }
+
+            // LEA r64, m
+            case 0x8D:
+            {
+                if(form.m_bRexW == false || form.IsMemory() == false)
+                    break;
+
+                SetReg(form.Reg(), EffectiveAdrs(form, iAdrs, iLength));
+                return CheckRSP();
+            }
+
+            // MOV r, imm. 32 bit forms zero extend.
+            case 0xB8: case 0xB9: case 0xBA: case 0xBB: case 0xBC: case 0xBD: case 0xBE: case 0xBF:
+            {
+                if(form.m_bOpSize16 == true)
+                    break;
+
+                if(ReadImmediate(pBytes, iLength, form, form.m_bRexW == true ? 8 : 4, iImm) == false)
+                    return StackEffectStep_Lost;
+
+                SetReg(form.OpCodeReg(), MakeConstant(form.m_bRexW == true ? iImm : static_cast<int64_t>(static_cast<uint32_t>(iImm))));
+                return CheckRSP();
+            }
+
+            // MOV r/m, imm32
+            case 0xC7:
+            {
+                if(form.RegField() != 0 || form.m_bOpSize16 == true)
+                    break;
+
+                if(ReadImmediate(pBytes, iLength, form, 4, iImm) == false)
+                    return StackEffectStep_Lost;
+
+                StackValue_t value = MakeConstant(form.m_bRexW == true ? iImm : static_cast<int64_t>(static_cast<uint32_t>(iImm)));
+                if(bRegDst == true)
+                    SetReg(form.RM(), value);
+                else
+                    Store(EffectiveAdrs(form, iAdrs, iLength), form.m_bRexW == true ? value : StackValue_t());
+                return CheckRSP();
+            }
+
+            // XOR r, r : zero, whatever size.
+            case 0x31: case 0x33:
+            {
+                if(bRegDst == false || form.Reg() != form.RM())
+                    break;
+
+                SetReg(form.RM(), MakeConstant(0));
+                return CheckRSP();
+            }
+
+            default: break;
+        }
+    }
+    else if(form.m_iEncoding == InstEncoding_Legacy && form.m_iMap == InstMap_0F)
+    {
+        // PUSH / POP fs & gs
+        if(iOpCode == 0xA0 || iOpCode == 0xA8)
+            return Push(StackValue_t(), 8);
+        if(iOpCode == 0xA1 || iOpCode == 0xA9)
+            return Pop(-1, 8);
+    }
+
+
+    return ClobberWrittenRegs(form, iAdrs, iLength);
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+DEADSTOP_CRASH_PATH
+DeadStop::StackEffectStep_t DeadStop::StackEffect_t::TailCall()
+{
+    return Return(0);
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+DEADSTOP_CRASH_PATH
+const DeadStop::StackPlan_t& DeadStop::StackEffect_t::GetPlan() const
+{
+    return m_plan;
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+DEADSTOP_CRASH_PATH
+size_t DeadStop::StackEffect_t::GetStepCount() const
+{
+    return m_nSteps;
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+DEADSTOP_CRASH_PATH
+DeadStop::StackValue_t DeadStop::StackEffect_t::GetReg(int iX86Reg) const
+{
+    return m_regs[s_x86ToDwarf[iX86Reg & 15]];
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+DEADSTOP_CRASH_PATH
+void DeadStop::StackEffect_t::SetReg(int iX86Reg, const StackValue_t& value)
+{
+    m_regs[s_x86ToDwarf[iX86Reg & 15]] = value;
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+DEADSTOP_CRASH_PATH
+DeadStop::StackValue_t DeadStop::StackEffect_t::AddOffset(const StackValue_t& value, int64_t iOffset)
+{
+    if(value.m_iKind == StackValue_RegOffset)
+    {
+        StackValue_t result = value;
+        result.m_iOffset += iOffset;
+        return result;
+    }
+
+    // [ x ] + N has no form of its own, only its actual value can be moved.
+    uintptr_t iValue = 0;
+    if(value.m_iKind == StackValue_Deref && Concretize(value, iValue) == true)
+        return MakeConstant(static_cast<int64_t>(iValue) + iOffset);
+
+    return StackValue_t();
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+DEADSTOP_CRASH_PATH
+bool DeadStop::StackEffect_t::Concretize(const StackValue_t& value, uintptr_t& iValueOut)
+{
+    if(value.m_iKind == StackValue_Unknown)
+        return false;
+
+    if(IsConstant(value) == true)
+    {
+        iValueOut = static_cast<uintptr_t>(value.m_iOffset);
+        return true;
+    }
+
+    if(m_bHasEntryRegs == false)
+        return false;
+
+    // Plan now only holds for these exact registers.
+    m_plan.m_bUsesState = true;
+    return EvaluateStackValue(value, m_entryRegs, iValueOut);
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+DEADSTOP_CRASH_PATH
+DeadStop::StackValue_t DeadStop::StackEffect_t::EffectiveAdrs(const InstForm_t& form, uintptr_t iAdrs, size_t iLength)
+{
+    if(form.IsMemory() == false || form.m_bAdrsSize32 == true)
+        return StackValue_t();
+
+    if(form.IsRIPRelative() == true)
+        return MakeConstant(static_cast<int64_t>(iAdrs + iLength) + form.m_iDisp);
+
+
+    int     iBase   = form.RM();
+    int64_t iOffset = form.m_iDisp;
+    if(form.m_bHasSIB == true)
+    {
+        int iIndex = ((form.m_iSIB >> 3) & 7) | (form.m_bRexX == true ? 8 : 0);
+        int iScale = 1 << (form.m_iSIB >> 6);
+        iBase      = (form.m_iSIB & 7)        | (form.m_bRexB == true ? 8 : 0);
+
+        // No base with mod 00 & base 101, only disp32.
+        if(form.Mod() == 0 && (form.m_iSIB & 7) == 5)
+            iBase = -1;
+
+        // Index 100 without REX.X means no index. Indexed slots only have a place once we know the index.
+        if(iIndex != X86_RSP)
+        {
+            uintptr_t iIndexValue = 0;
+            if(Concretize(GetReg(iIndex), iIndexValue) == false)
+                return StackValue_t();
+
+            iOffset += static_cast<int64_t>(iIndexValue) * iScale;
+        }
+    }
+
+    return AddOffset(iBase >= 0 ? GetReg(iBase) : MakeConstant(0), iOffset);
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+DEADSTOP_CRASH_PATH
+DeadStop::StackValue_t DeadStop::StackEffect_t::Load(const StackValue_t& adrs)
+{
+    if(adrs.m_iKind == StackValue_Unknown)
+        return StackValue_t();
+
+
+    for(size_t iStore = 0; iStore < m_nStores; iStore++)
+    {
+        if(IsSameValue(m_stores[iStore].m_adrs, adrs) == true)
+            return m_stores[iStore].m_value;
+    }
+
+
+    if(adrs.m_iKind == StackValue_RegOffset)
+    {
+        StackValue_t value = adrs;
+        value.m_iKind = StackValue_Deref;
+        return value;
+    }
+
+
+    // [ [ x ] ] needs the actual address.
+    uintptr_t iAdrs = 0;
+    if(Concretize(adrs, iAdrs) == false)
+        return StackValue_t();
+
+    StackValue_t value;
+    value.m_iKind   = StackValue_Deref;
+    value.m_iBase   = -1;
+    value.m_iOffset = static_cast<int64_t>(iAdrs);
+    return value;
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+DEADSTOP_CRASH_PATH
+void DeadStop::StackEffect_t::Store(const StackValue_t& adrs, const StackValue_t& value)
+{
+    // Can't tell where unknown addresses land. Could be a slot we know, but real code doesn't do that.
+    if(adrs.m_iKind != StackValue_RegOffset)
+        return;
+
+    for(size_t iStore = 0; iStore < m_nStores; iStore++)
+    {
+        if(IsSameValue(m_stores[iStore].m_adrs, adrs) == true)
+        {
+            m_stores[iStore].m_value = value;
+            return;
+        }
+    }
+
+    // Full, oldest one goes. By then its usually below rSP anyway.
+    if(m_nStores == MAX_STORES)
+    {
+        for(size_t iStore = 1; iStore < MAX_STORES; iStore++)
+            m_stores[iStore - 1] = m_stores[iStore];
+        m_nStores--;
+    }
+
+    m_stores[m_nStores].m_adrs  = adrs;
+    m_stores[m_nStores].m_value = value;
+    m_nStores++;
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+DEADSTOP_CRASH_PATH
+DeadStop::StackEffectStep_t DeadStop::StackEffect_t::Push(const StackValue_t& value, int iSize)
+{
+    SetReg(X86_RSP, AddOffset(GetReg(X86_RSP), -iSize));
+    if(iSize == 8)
+        Store(GetReg(X86_RSP), value);
+
+    return CheckRSP();
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+DEADSTOP_CRASH_PATH
+DeadStop::StackEffectStep_t DeadStop::StackEffect_t::Pop(int iX86DestReg, int iSize)
+{
+    StackValue_t value = iSize == 8 ? Load(GetReg(X86_RSP)) : StackValue_t();
+    SetReg(X86_RSP, AddOffset(GetReg(X86_RSP), iSize));
+
+    // POP rsp loads rSP, increment is lost.
+    if(iX86DestReg >= 0)
+        SetReg(iX86DestReg, value);
+
+    return CheckRSP();
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+DEADSTOP_CRASH_PATH
+DeadStop::StackEffectStep_t DeadStop::StackEffect_t::Call()
+{
+    // Callee keeps rSP & the callee saved registers, anything else is gone.
+    for(int iReg : s_scratchRegs)
+        m_regs[iReg] = StackValue_t();
+
+
+    // & it is free to use the stack below rSP.
+    const StackValue_t& rsp = m_regs[DwarfReg_RSP];
+    size_t nKept = 0;
+    for(size_t iStore = 0; iStore < m_nStores; iStore++)
+    {
+        const Store_t& store = m_stores[iStore];
+        if(store.m_adrs.m_iBase == rsp.m_iBase && rsp.m_iKind == StackValue_RegOffset && store.m_adrs.m_iOffset < rsp.m_iOffset)
+            continue;
+
+        m_stores[nKept++] = store;
+    }
+
+    m_nStores = nKept;
+    return CheckRSP();
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+DEADSTOP_CRASH_PATH
+DeadStop::StackEffectStep_t DeadStop::StackEffect_t::Return(uint16_t iPopBytes)
+{
+    StackValue_t rsp = GetReg(X86_RSP);
+    StackValue_t ra  = Load(rsp);
+    StackValue_t cfa = AddOffset(rsp, 8 + iPopBytes);
+    if(ra.m_iKind == StackValue_Unknown || cfa.m_iKind == StackValue_Unknown)
+        return StackEffectStep_Lost;
+
+
+    for(int iReg = 0; iReg < 16; iReg++)
+        m_plan.m_regs[iReg] = m_regs[iReg];
+
+    // Caller can't expect these to survive a call.
+    for(int iReg : s_scratchRegs)
+        m_plan.m_regs[iReg] = StackValue_t();
+
+    m_plan.m_regs[DwarfReg_RSP] = cfa;
+    m_plan.m_regs[DwarfReg_RA]  = ra;
+    return StackEffectStep_Return;
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+DEADSTOP_CRASH_PATH
+DeadStop::StackEffectStep_t DeadStop::StackEffect_t::ClobberWrittenRegs(const InstForm_t& form, uintptr_t iAdrs, size_t iLength)
+{
+    uint16_t iWrites = 0;
+    switch(form.m_iMap)
+    {
+        case InstMap_OneByte: iWrites = s_oneByteWrites.m_iWrites[form.m_iOpCode]; break;
+        case InstMap_0F:      iWrites = s_twoByteWrites.m_iWrites[form.m_iOpCode]; break;
+        case InstMap_0F38:    iWrites = s_0F38Writes.m_iWrites[form.m_iOpCode];    break;
+        case InstMap_0F3A:    iWrites = s_0F3AWrites.m_iWrites[form.m_iOpCode];    break;
+        default: break;
+    }
+
+    if((iWrites & GPRWrite_Trap) != 0)
+        return StackEffectStep_Lost;
+
+    if((iWrites & GPRWrite_IfScalar) != 0 && form.m_bRepF3 == false && form.m_bRepF2 == false)
+        iWrites = 0;
+
+    if((iWrites & GPRWrite_NotIfF3) != 0 && form.m_bRepF3 == true)
+        iWrites = 0;
+
+    // KMOV r32, k in VEX space sits where SETcc is.
+    if(form.m_iEncoding != InstEncoding_Legacy && form.m_iMap == InstMap_0F && form.m_iOpCode >= 0x90 && form.m_iOpCode <= 0x93)
+        iWrites |= GPRWrite_Reg;
+
+
+    if((iWrites & GPRWrite_Group) != 0)
+    {
+        uint8_t iExt = form.RegField();
+        iWrites = 0;
+        switch(form.m_iOpCode)
+        {
+            case 0x80: case 0x81: case 0x82: case 0x83: iWrites = iExt == 7 ? 0 : GPRWrite_RM; break; // CMP writes nothing.
+            case 0xF6: case 0xF7:
+                if(iExt == 2 || iExt == 3)      iWrites = GPRWrite_RM;                  // NOT, NEG
+                else if(iExt >= 4)              iWrites = GPRWrite_RAX | GPRWrite_RDX;  // MUL, IMUL, DIV, IDIV
+                break;
+            case 0xFE: case 0xFF:               iWrites = iExt <= 1 ? GPRWrite_RM : 0; break; // INC, DEC
+            default: break;
+        }
+    }
+
+
+    // Memory destination might be a slot we know the contents of.
+    if((iWrites & GPRWrite_RM) != 0 && form.IsMemory() == true)
+        Store(EffectiveAdrs(form, iAdrs, iLength), StackValue_t());
+
+    if((iWrites & GPRWrite_RM) != 0 && form.m_bHasModRM == true && form.Mod() == 3) SetReg(form.RM(),        StackValue_t());
+    if((iWrites & GPRWrite_Reg)       != 0 && form.m_bHasModRM == true)             SetReg(form.Reg(),       StackValue_t());
+    if((iWrites & GPRWrite_OpCodeReg) != 0)                                         SetReg(form.OpCodeReg(), StackValue_t());
+    if((iWrites & GPRWrite_VEXReg)    != 0)                                         SetReg(form.m_iVEXReg,   StackValue_t());
+    if((iWrites & GPRWrite_RAX)       != 0) m_regs[DwarfReg_RAX] = StackValue_t();
+    if((iWrites & GPRWrite_RCX)       != 0) m_regs[DwarfReg_RCX] = StackValue_t();
+    if((iWrites & GPRWrite_RDX)       != 0) m_regs[DwarfReg_RDX] = StackValue_t();
+    if((iWrites & GPRWrite_RBX)       != 0) m_regs[DwarfReg_RBX] = StackValue_t();
+    if((iWrites & GPRWrite_RSI)       != 0) m_regs[DwarfReg_RSI] = StackValue_t();
+    if((iWrites & GPRWrite_RDI)       != 0) m_regs[DwarfReg_RDI] = StackValue_t();
+    if((iWrites & GPRWrite_R11)       != 0) m_regs[DwarfReg_R11] = StackValue_t();
+
+    return CheckRSP();
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+DEADSTOP_CRASH_PATH
+DeadStop::StackEffectStep_t DeadStop::StackEffect_t::CheckRSP() const
+{
+    return m_regs[DwarfReg_RSP].m_iKind == StackValue_Unknown ? StackEffectStep_Lost : StackEffectStep_Continue;
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+DEADSTOP_CRASH_PATH
+bool DeadStop::ApplyStackPlan(const StackPlan_t& plan, const DwarfRegs_t& regsIn, DwarfRegs_t& regsOut,
+        uintptr_t iStackLow, uintptr_t iStackHigh)
+{
+    // Where each saved register is, & the span all of them cover.
+    uintptr_t iSavedAdrs[DwarfReg_Count];
+    uint32_t  iSavedMask = 0;
+    uintptr_t iSpanStart = UINTPTR_MAX;
+    uintptr_t iSpanEnd   = 0;
+    for(int iReg = 0; iReg < DwarfReg_Count; iReg++)
+    {
+        StackValue_t adrs = plan.m_regs[iReg];
+        if(adrs.m_iKind != StackValue_Deref)
+            continue;
+
+        adrs.m_iKind = StackValue_RegOffset;
+        if(EvaluateStackValue(adrs, regsIn, iSavedAdrs[iReg]) == false)
+            continue;
+
+        iSavedMask |= 1u << iReg;
+        if(iSavedAdrs[iReg] < iSpanStart)                   iSpanStart = iSavedAdrs[iReg];
+        if(iSavedAdrs[iReg] + sizeof(uintptr_t) > iSpanEnd) iSpanEnd   = iSavedAdrs[iReg] + sizeof(uintptr_t);
+    }
+
+    uint8_t iSpan[MAX_PLAN_READ_SPAN];
+    bool    bHasSpan = iSavedMask != 0 && iSpanEnd > iSpanStart && iSpanEnd - iSpanStart <= sizeof(iSpan);
+    if(bHasSpan == true)
+    {
+        // Live stack is mapped for sure, no need to go through SafeRead() for it.
+        if(iStackHigh != 0 && iSpanStart >= iStackLow && iSpanEnd <= iStackHigh)
+            memcpy(iSpan, reinterpret_cast<const void*>(iSpanStart), iSpanEnd - iSpanStart);
+        else
+            bHasSpan = SafeRead(iSpan, iSpanStart, iSpanEnd - iSpanStart) == iSpanEnd - iSpanStart;
+    }
+
+
+    DwarfRegs_t regs;
+    for(int iReg = 0; iReg < DwarfReg_Count; iReg++)
+    {
+        uintptr_t iValue = 0;
+        if(bHasSpan == true && (iSavedMask & (1u << iReg)) != 0)
+        {
+            memcpy(&iValue, iSpan + (iSavedAdrs[iReg] - iSpanStart), sizeof(iValue));
+            regs.Set(iReg, iValue);
+        }
+        else if(EvaluateStackValue(plan.m_regs[iReg], regsIn, iValue) == true)
+        {
+            regs.Set(iReg, iValue);
+        }
+    }
+
+    if(regs.IsValid(DwarfReg_RA) == false || regs.IsValid(DwarfReg_RSP) == false)
+        return false;
+
+    regsOut = regs;
+    return true;
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+DEADSTOP_CRASH_PATH
+bool DeadStop::StackPlanFromUnwindRow(const UnwindRow_t& row, StackPlan_t& planOut)
+{
+    if(row.m_bSignalFrame == true || row.m_iCFAType != CFARule_RegOffset || row.m_iCFAReg < 0 || row.m_iCFAReg >= DwarfReg_Count)
+        return false;
+
+    StackValue_t cfa;
+    cfa.m_iKind   = StackValue_RegOffset;
+    cfa.m_iBase   = static_cast<int8_t>(row.m_iCFAReg);
+    cfa.m_iOffset = row.m_iCFAOffset;
+
+
+    StackPlan_t plan;
+    for(int iReg = 0; iReg < DwarfReg_Count; iReg++)
+    {
+        const RegRule_t& rule  = row.m_rules[iReg];
+        StackValue_t&    value = plan.m_regs[iReg];
+        switch(rule.m_iType)
+        {
+            case RegRule_Undefined: break;
+
+            case RegRule_SameValue:
+                value.m_iKind = StackValue_RegOffset;
+                value.m_iBase = static_cast<int8_t>(iReg);
+                break;
+
+            case RegRule_Offset:
+            case RegRule_ValOffset:
+                value.m_iKind   = rule.m_iType == RegRule_Offset ? StackValue_Deref : StackValue_RegOffset;
+                value.m_iBase   = cfa.m_iBase;
+                value.m_iOffset = cfa.m_iOffset + rule.m_iValue;
+                break;
+
+            case RegRule_Register:
+                if(rule.m_iValue >= 0 && rule.m_iValue < DwarfReg_Count)
+                {
+                    value.m_iKind = StackValue_RegOffset;
+                    value.m_iBase = static_cast<int8_t>(rule.m_iValue);
+                }
+                break;
+
+            default: return false;
+        }
+    }
+
+
+    // Caller's rSP is the CFA, return address might live in some other column.
+    plan.m_regs[DwarfReg_RSP] = cfa;
+    if(row.m_iReturnReg != DwarfReg_RA)
+    {
+        if(row.m_iReturnReg < 0 || row.m_iReturnReg >= DwarfReg_Count)
+            return false;
+        plan.m_regs[DwarfReg_RA] = plan.m_regs[row.m_iReturnReg];
+    }
+
+    // Outermost frames leave rIP undefined. Their plan keeps it that way, & ApplyStackPlan() won't take it.
+    planOut = plan;
+    return true;
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+DEADSTOP_CRASH_PATH
+bool DeadStop::IsFramePointerPlan(const StackPlan_t& plan)
+{
+    const StackValue_t& rsp = plan.m_regs[DwarfReg_RSP];
+    const StackValue_t& rbp = plan.m_regs[DwarfReg_RBP];
+
+    return rsp.m_iKind == StackValue_RegOffset && rsp.m_iBase == DwarfReg_RBP && rsp.m_iOffset == 16 &&
+           rbp.m_iKind == StackValue_Deref     && rbp.m_iBase == DwarfReg_RBP && rbp.m_iOffset == 0;
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+DEADSTOP_CRASH_PATH
+static DeadStop::StackValue_t DeadStop::MakeConstant(int64_t iValue)
+{
+    StackValue_t value;
+    value.m_iKind   = StackValue_RegOffset;
+    value.m_iBase   = -1;
+    value.m_iOffset = iValue;
+    return value;
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+DEADSTOP_CRASH_PATH
+static bool DeadStop::IsConstant(const StackValue_t& value)
+{
+    return value.m_iKind == StackValue_RegOffset && value.m_iBase < 0;
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+DEADSTOP_CRASH_PATH
+static bool DeadStop::IsSameValue(const StackValue_t& a, const StackValue_t& b)
+{
+    return a.m_iKind == b.m_iKind && a.m_iBase == b.m_iBase && a.m_iOffset == b.m_iOffset;
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+DEADSTOP_CRASH_PATH
+static bool DeadStop::ReadImmediate(const uint8_t* pBytes, size_t iLength, const InstForm_t& form, size_t iSize, int64_t& iImmOut)
+{
+    if(form.m_iImmOffset + iSize > iLength)
+        return false;
+
+    // Little endian, sign extended.
+    uint64_t iImm = 0;
+    for(size_t iByte = 0; iByte < iSize; iByte++)
+        iImm |= static_cast<uint64_t>(pBytes[form.m_iImmOffset + iByte]) << (iByte * 8);
+
+    if(iSize < 8 && (iImm & (1ull << (iSize * 8 - 1))) != 0)
+        iImm |= ~0ull << (iSize * 8);
+
+    iImmOut = static_cast<int64_t>(iImm);
+    return true;
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+DEADSTOP_CRASH_PATH
+static bool DeadStop::EvaluateStackValue(const StackValue_t& value, const DwarfRegs_t& regs, uintptr_t& iValueOut)
+{
+    if(value.m_iKind == StackValue_Unknown)
+        return false;
+
+    uintptr_t iValue = static_cast<uintptr_t>(value.m_iOffset);
+    if(value.m_iBase >= 0)
+    {
+        if(regs.IsValid(value.m_iBase) == false)
+            return false;
+
+        iValue += regs.Get(value.m_iBase);
+    }
+
+    if(value.m_iKind == StackValue_Deref)
+        return SafeReadValue(iValue, iValueOut);
+
+    iValueOut = iValue;
+    return true;
+}
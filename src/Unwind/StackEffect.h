@@ -0,0 +1,127 @@
+//=========================================================================
+//                      Stack Effect
+//=========================================================================
+// by      : INSANE
+// created : 16/10/2026
+//
+// purpose : Follows what a run of instructions does to rSP & the callee saved
+//           registers, up to a return. For code without unwind info, the
+//           result tells where the return address & saved registers are.
+//-------------------------------------------------------------------------
+#pragma once
+#include "../../Include/Alias.h"
+#include "DwarfCFI.h"
+#include <cstddef>
+#include <cstdint>
+
+
+
+namespace DEADSTOP_NAMESPACE
+{
+    struct InstForm_t;
+
+
+    ///////////////////////////////////////////////////////////////////////////
+    ///////////////////////////////////////////////////////////////////////////
+    enum StackValueKind_t : uint8_t
+    {
+        StackValue_Unknown = 0,
+        StackValue_RegOffset, // Entry value of m_iBase + m_iOffset. Just m_iOffset when there is no base.
+        StackValue_Deref,     // 8 bytes at ( entry value of m_iBase + m_iOffset ).
+    };
+
+
+    // A register's value in terms of the registers the interpreted code started with.
+    struct StackValue_t
+    {
+        uint8_t m_iKind   = StackValue_Unknown;
+        int8_t  m_iBase   = -1; // DwarfReg_t, or -1 for none.
+        int64_t m_iOffset = 0;
+    };
+
+
+    ///////////////////////////////////////////////////////////////////////////
+    ///////////////////////////////////////////////////////////////////////////
+    // Caller's registers in terms of the callee's, i.e. how to step one frame up from the address the
+    // interpretation started at. Only depends on that address, unless m_bUsesState.
+    struct StackPlan_t
+    {
+        StackValue_t m_regs[DwarfReg_Count]; // Caller's rIP is in DwarfReg_RA.
+        bool         m_bUsesState = false; // Some value came from the actual registers / memory ( e.g. AND rsp, -32 ).
+    };
+
+
+    enum StackEffectStep_t : int
+    {
+        StackEffectStep_Continue = 0,
+        StackEffectStep_Return,      // Plan is ready.
+        StackEffectStep_Lost,        // rSP got a value we can't follow, or the code can't be where a function goes on.
+    };
+
+
+    ///////////////////////////////////////////////////////////////////////////
+    ///////////////////////////////////////////////////////////////////////////
+    class StackEffect_t
+    {
+        public:
+            // pEntryRegs, if not nullptr, are the actual registers at the first instruction. Without them
+            // anything that isn't a fixed offset from some entry register can't be followed.
+            void               Reset(const DwarfRegs_t* pEntryRegs);
+
+            // Instructions are fed in the order they would run, already parsed ( ParseInstForm() ) from pBytes.
+            StackEffectStep_t  Step(uintptr_t iAdrs, const uint8_t* pBytes, const InstForm_t& form);
+
+            // A jump into another function, which returns straight to our caller. Same as a RETN here.
+            StackEffectStep_t  TailCall();
+
+            const StackPlan_t& GetPlan()      const;
+            size_t             GetStepCount() const;
+
+        private:
+            StackValue_t       GetReg(int iX86Reg) const;
+            void               SetReg(int iX86Reg, const StackValue_t& value);
+            StackValue_t       AddOffset(const StackValue_t& value, int64_t iOffset);
+            bool               Concretize(const StackValue_t& value, uintptr_t& iValueOut);
+            StackValue_t       EffectiveAdrs(const InstForm_t& form, uintptr_t iAdrs, size_t iLength);
+            StackValue_t       Load(const StackValue_t& adrs);
+            void               Store(const StackValue_t& adrs, const StackValue_t& value);
+
+            StackEffectStep_t  Push(const StackValue_t& value, int iSize);
+            StackEffectStep_t  Pop(int iX86DestReg, int iSize);
+            StackEffectStep_t  Call();
+            StackEffectStep_t  Return(uint16_t iPopBytes);
+            StackEffectStep_t  ClobberWrittenRegs(const InstForm_t& form, uintptr_t iAdrs, size_t iLength);
+            StackEffectStep_t  CheckRSP() const;
+
+            // Stack writes seen so far, so a POP after a PUSH / MOV gets what was put there.
+            static constexpr size_t MAX_STORES = 16;
+            struct Store_t
+            {
+                StackValue_t m_adrs;
+                StackValue_t m_value;
+            };
+
+            StackValue_t       m_regs[16]; // General purpose registers, in DWARF numbering.
+            Store_t            m_stores[MAX_STORES];
+            size_t             m_nStores       = 0; // Oldest first.
+
+            DwarfRegs_t        m_entryRegs;
+            bool               m_bHasEntryRegs = false;
+
+            StackPlan_t        m_plan;
+            size_t             m_nSteps        = 0;
+    };
+
+
+    // Caller's registers from the callee's, using a plan. Fails if rIP or rSP can't be worked out. Saved registers
+    // inside [ iStackLow, iStackHigh ), when non zero, are read straight from memory. Only pass live stack.
+    bool ApplyStackPlan(const StackPlan_t& plan, const DwarfRegs_t& regsIn, DwarfRegs_t& regsOut,
+            uintptr_t iStackLow = 0, uintptr_t iStackHigh = 0);
+
+    // Same step as ApplyUnwindRow( row ) would take, as a plan. Rows using DWARF expressions or
+    // describing signal frames have no plan, those return false.
+    bool StackPlanFromUnwindRow(const UnwindRow_t& row, StackPlan_t& planOut);
+
+    // Plan restores rBP & rSP from a [ rBP, rIP ] record at rBP, i.e. a normal stack frame.
+    bool IsFramePointerPlan(const StackPlan_t& plan);
+}
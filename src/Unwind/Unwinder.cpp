@@ -0,0 +1,663 @@
+//=========================================================================
+//                      Unwinder
+//=========================================================================
+// by      : INSANE
+// created : 16/10/2026
+//
+// purpose : Steps a thread's registers up one frame at a time, using the
+//           unwind info of whichever module the code belongs to.
+//-------------------------------------------------------------------------
+#include "Unwinder.h"
+#include "PlanCache.h"
+#include "../Defs/MemRegion_t.h"
+#include "../Jit/JitRegistry.h"
+#include "../Util/SafeRead/SafeRead.h"
+#include "../Util/MemoryLock/MemoryLock.h"
+#include <atomic>
+#include <cstring>
+#include <elf.h>
+
+
+// Mind this...
+using namespace DeadStop;
+
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+namespace DEADSTOP_NAMESPACE
+{
+    // A loaded module ( every mapping of one file ) & where its unwind info is.
+    struct UnwindModule_t
+    {
+        uintptr_t    m_iStart    = 0; // [ Start, End ) of all of the module's mappings.
+        uintptr_t    m_iEnd      = 0;
+        bool         m_bHasHdr   = false;
+        EhFrameHdr_t m_hdr;
+    };
+
+
+    // Captures unwind side by side, so each slot is its own seqlock, same as the unwind plan cache's.
+    // Writers own a slot while m_iSequence is odd & only get it with a compare exchange. Readers copy
+    // m_module out & keep the copy if m_iSequence was even & unchanged around it.
+    struct UnwindModuleSlot_t
+    {
+        std::atomic<uint32_t> m_iSequence;
+        UnwindModule_t        m_module;
+
+        // Frames seen in this module with & without rBP as frame pointer, see NoteFramePointerUse().
+        std::atomic<uint32_t> m_nFramePointerFrames;
+        std::atomic<uint32_t> m_nOmittedFrames;
+
+        bool KeepsFramePointers() const
+        {
+            return m_nFramePointerFrames.load(std::memory_order_relaxed) > 0 && m_nOmittedFrames.load(std::memory_order_relaxed) == 0;
+        }
+    };
+
+
+    // Crash path only walks a handful of modules, a tiny round robin cache does.
+    static constexpr size_t    MAX_UNWIND_MODULES  = 16;
+    static constexpr size_t    MAX_PROGRAM_HEADERS = 128;
+    static UnwindModuleSlot_t  s_unwindModules[MAX_UNWIND_MODULES];
+    static std::atomic<size_t> s_iNextUnwindModule(0);
+
+    // Last return address IsAfterCall() said yes to, recursion repeats them. Its this thread's, & only
+    // good while s_iCallSiteGeneration hasn't moved ( code might have been rewritten since ).
+    static std::atomic<uint32_t>  s_iCallSiteGeneration(0);
+    static thread_local uint32_t  t_iLastCallGeneration = 0;
+    static thread_local uintptr_t t_iLastCallSite       = 0;
+    static thread_local uintptr_t t_iLastCallTarget     = 0;
+
+    // Stack scan gives up this far above rSP, big enough for frames with a few buffers on them.
+    static constexpr size_t MAX_STACK_SCAN_WORDS   = 1024;
+    static constexpr size_t STACK_SCAN_BATCH_WORDS = 64;
+
+
+    static UnwindModuleSlot_t*   FindUnwindModule(MemRegionHandler_t& memRegions, uintptr_t iPC, UnwindModule_t& moduleOut);
+    static bool                  LoadUnwindModule(MemRegionHandler_t& memRegions, uintptr_t iPC, UnwindModule_t& moduleOut);
+    static bool                  IsSameFile(const MemRegion_t& a, const MemRegion_t& b);
+    static bool                  ReadStackWords(MemRegionHandler_t& memRegions, uintptr_t iAdrs, uintptr_t* pWords, size_t nWords,
+            uintptr_t iStackLow, uintptr_t iStackHigh);
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+DEADSTOP_CRASH_PATH
+void DeadStop::DwarfRegsFromContext(const ucontext_t* pContext, DwarfRegs_t& regsOut)
+{
+    static const int s_dwarfToGreg[DwarfReg_Count] = {
+        REG_RAX, REG_RDX, REG_RCX, REG_RBX, REG_RSI, REG_RDI, REG_RBP, REG_RSP,
+        REG_R8,  REG_R9,  REG_R10, REG_R11, REG_R12, REG_R13, REG_R14, REG_R15,
+        REG_RIP };
+
+    regsOut = DwarfRegs_t();
+    for(int iReg = 0; iReg < DwarfReg_Count; iReg++)
+        regsOut.Set(iReg, static_cast<uintptr_t>(pContext->uc_mcontext.gregs[s_dwarfToGreg[iReg]]));
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+DEADSTOP_CRASH_PATH
+UnwindStepResult_t DeadStop::StepWithCFI(MemRegionHandler_t& memRegions, const DwarfRegs_t& regsIn, bool bExactPC,
+        DwarfRegs_t& regsOut, bool& bNextExactPCOut, uintptr_t iStackLow, uintptr_t iStackHigh)
+{
+    if(regsIn.IsValid(DwarfReg_RA) == false)
+        return UnwindStep_Failed;
+
+
+    // Return addresses point right after the call, which might already be the next function.
+    uintptr_t iPC = regsIn.Get(DwarfReg_RA);
+    if(bExactPC == false)
+        iPC--;
+
+
+    // Most rows are a plan, & those are cached. Row for a return address seen before is one lookup.
+    StackPlan_t plan;
+    UnwindRow_t row;
+    bool        bHasPlan = FindUnwindPlan(iPC, UnwindMethod_CFI, plan);
+    if(bHasPlan == false)
+    {
+        UnwindModule_t module;
+        if(FindUnwindModule(memRegions, iPC, module) == nullptr || module.m_bHasHdr == false)
+            return UnwindStep_NoInfo;
+
+        if(FindUnwindRow(module.m_hdr, iPC, row) == false)
+            return UnwindStep_NoInfo;
+
+
+        bHasPlan = StackPlanFromUnwindRow(row, plan);
+        if(bHasPlan == true)
+            InsertUnwindPlan(iPC, UnwindMethod_CFI, plan);
+
+        // Outermost frames mark their return address as undefined.
+        if(row.m_iReturnReg >= 0 && row.m_iReturnReg < DwarfReg_Count && row.m_rules[row.m_iReturnReg].m_iType == RegRule_Undefined)
+            return UnwindStep_EndOfStack;
+    }
+
+    // Plans of outermost frames are cached too, so every capture doesn't search for their row again.
+    if(bHasPlan == true && plan.m_regs[DwarfReg_RA].m_iKind == StackValue_Unknown)
+        return UnwindStep_EndOfStack;
+
+    DwarfRegs_t regs;
+    bool        bApplied = bHasPlan == true ? ApplyStackPlan(plan, regsIn, regs, iStackLow, iStackHigh) : ApplyUnwindRow(row, regsIn, regs);
+    if(bApplied == false)
+        return UnwindStep_Failed;
+
+
+    // Stack only ever grows down. Caller's frame being below ours means the info lied, or we misread it.
+    if(row.m_bSignalFrame == false && regsIn.IsValid(DwarfReg_RSP) == true && regs.Get(DwarfReg_RSP) <= regsIn.Get(DwarfReg_RSP))
+        return UnwindStep_Failed;
+
+
+    // Return addresses are always past the prologue, so this is how the whole function keeps its frame.
+    if(bExactPC == false && row.m_bSignalFrame == false)
+        NoteFramePointerUse(memRegions, iPC + 1, bHasPlan == true && IsFramePointerPlan(plan));
+
+
+    regsOut         = regs;
+    bNextExactPCOut = row.m_bSignalFrame;
+    return UnwindStep_Ok;
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+DEADSTOP_CRASH_PATH
+UnwindStepResult_t DeadStop::StepWithFramePointer(MemRegionHandler_t& memRegions, const DwarfRegs_t& regsIn, bool bExactPC,
+        uintptr_t iStackLow, uintptr_t iStackHigh, DwarfRegs_t& regsOut)
+{
+    // Crash location might be in a prologue / epilogue, where rBP is still the caller's.
+    if(bExactPC == true || regsIn.IsValid(DwarfReg_RA) == false)
+        return UnwindStep_NoInfo;
+
+    UnwindModule_t      module;
+    UnwindModuleSlot_t* pSlot = FindUnwindModule(memRegions, regsIn.Get(DwarfReg_RA) - 1, module);
+    if(pSlot == nullptr || pSlot->KeepsFramePointers() == false)
+        return UnwindStep_NoInfo;
+
+    if(regsIn.IsValid(DwarfReg_RBP) == false || regsIn.IsValid(DwarfReg_RSP) == false)
+        return UnwindStep_Failed;
+
+
+    // Frame record is [ saved rBP, return address ], it must be on this stack & above where we are.
+    uintptr_t iRBP = regsIn.Get(DwarfReg_RBP);
+    if((iRBP & 7) != 0 || iRBP < regsIn.Get(DwarfReg_RSP) || iRBP + 16 < iRBP)
+        return UnwindStep_Failed;
+
+    if(iStackHigh != 0 && (iRBP < iStackLow || iRBP + 16 > iStackHigh))
+        return UnwindStep_Failed;
+
+    uintptr_t iFrameRecord[2] = { 0, 0 };
+    if(ReadStackWords(memRegions, iRBP, iFrameRecord, 2, iStackLow, iStackHigh) == false)
+        return UnwindStep_Failed;
+
+
+    // Caller's rBP is either 0 ( chain ends ) or further up the stack. Anything else isn't a frame record.
+    uintptr_t iCallerRBP  = iFrameRecord[0];
+    uintptr_t iReturnAdrs = iFrameRecord[1];
+    if(iCallerRBP != 0 && iCallerRBP < iRBP + 16)
+        return UnwindStep_Failed;
+
+    if(memRegions.HasExecutableRegion(iReturnAdrs) == false || IsAfterCall(iReturnAdrs) == false)
+        return UnwindStep_Failed;
+
+
+    // Callee saved registers could be anywhere in the frame, only rSP & rBP are known.
+    regsOut = DwarfRegs_t();
+    regsOut.Set(DwarfReg_RA,  iReturnAdrs);
+    regsOut.Set(DwarfReg_RSP, iRBP + 16);
+    regsOut.Set(DwarfReg_RBP, iCallerRBP);
+    return UnwindStep_Ok;
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+DEADSTOP_CRASH_PATH
+UnwindStepResult_t DeadStop::StepWithStackScan(MemRegionHandler_t& memRegions, const DwarfRegs_t& regsIn,
+        uintptr_t iStackLow, uintptr_t iStackHigh, DwarfRegs_t& regsOut)
+{
+    if(regsIn.IsValid(DwarfReg_RSP) == false)
+        return UnwindStep_Failed;
+
+    // Return addresses are always pushed 8 byte aligned.
+    uintptr_t iRSP     = (regsIn.Get(DwarfReg_RSP) + 7) & ~static_cast<uintptr_t>(7);
+    uintptr_t iScanEnd = iRSP + MAX_STACK_SCAN_WORDS * sizeof(uintptr_t);
+    if(iScanEnd < iRSP)
+        return UnwindStep_Failed;
+
+    if(iStackHigh != 0)
+    {
+        if(iRSP < iStackLow || iRSP >= iStackHigh)
+            return UnwindStep_Failed;
+
+        if(iScanEnd > iStackHigh)
+            iScanEnd = iStackHigh;
+    }
+
+
+    uintptr_t iWords[STACK_SCAN_BATCH_WORDS];
+    for(uintptr_t iBatch = iRSP; iBatch < iScanEnd; iBatch += sizeof(iWords))
+    {
+        size_t nWords = (iScanEnd - iBatch) / sizeof(uintptr_t);
+        if(nWords > STACK_SCAN_BATCH_WORDS)
+            nWords = STACK_SCAN_BATCH_WORDS;
+
+        // Scan stops at the first words that can't be read.
+        if(ReadStackWords(memRegions, iBatch, iWords, nWords, iStackLow, iStackHigh) == false)
+            return UnwindStep_NoInfo;
+
+
+        for(size_t iWord = 0; iWord < nWords; iWord++)
+        {
+            // Almost nothing on a stack points into code, only those get their bytes read.
+            uintptr_t iReturnAdrs = iWords[iWord];
+            uintptr_t iCallTarget = 0;
+            if(memRegions.IsCodeAdrs(iReturnAdrs) == false || IsAfterCall(iReturnAdrs, &iCallTarget) == false)
+                continue;
+
+            // Bytes that only happen to look like a direct call mostly don't go anywhere sane.
+            if(iCallTarget != 0 && memRegions.IsCodeAdrs(iCallTarget) == false)
+                continue;
+
+
+            uintptr_t iCallerRSP = iBatch + (iWord + 1) * sizeof(uintptr_t);
+            regsOut = DwarfRegs_t();
+            regsOut.Set(DwarfReg_RA,  iReturnAdrs);
+            regsOut.Set(DwarfReg_RSP, iCallerRSP);
+
+            // rBP pointing further up the stack could still be some caller's frame pointer.
+            if(regsIn.IsValid(DwarfReg_RBP) == true && regsIn.Get(DwarfReg_RBP) >= iCallerRSP &&
+                    (iStackHigh == 0 || regsIn.Get(DwarfReg_RBP) < iStackHigh))
+                regsOut.Set(DwarfReg_RBP, regsIn.Get(DwarfReg_RBP));
+
+            return UnwindStep_Ok;
+        }
+    }
+
+    return UnwindStep_NoInfo;
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+DEADSTOP_CRASH_PATH
+UnwindStepResult_t DeadStop::StepWithJitFrame(MemRegionHandler_t& memRegions, const DwarfRegs_t& regsIn, bool bExactPC,
+        uintptr_t iStackLow, uintptr_t iStackHigh, DwarfRegs_t& regsOut)
+{
+    if(regsIn.IsValid(DwarfReg_RA) == false)
+        return UnwindStep_Failed;
+
+    // Return addresses point right after the call, which might be past the end of the range.
+    uintptr_t     iPC = regsIn.Get(DwarfReg_RA) - (bExactPC == true ? 0 : 1);
+    JitCodeInfo_t code;
+    if(FindJitCode(iPC, code) == false || code.m_frame.m_iKind == DeadStopJitFrame_None)
+        return UnwindStep_NoInfo;
+
+    // Frame isn't set up yet, reading the code does better in here.
+    if(iPC - code.m_iStart < code.m_frame.m_iPrologueSize)
+        return UnwindStep_NoInfo;
+
+
+    uintptr_t iReturnAdrs = 0;
+    uintptr_t iCallerRSP  = 0;
+    uintptr_t iCallerRBP  = 0;
+    bool      bKnownRBP   = true;
+    if(code.m_frame.m_iKind == DeadStopJitFrame_FramePointer)
+    {
+        if(regsIn.IsValid(DwarfReg_RBP) == false)
+            return UnwindStep_Failed;
+
+        // [ saved rBP, return address ], same as any frame pointer frame.
+        uintptr_t iRBP            = regsIn.Get(DwarfReg_RBP);
+        uintptr_t iFrameRecord[2] = { 0, 0 };
+        if((iRBP & 7) != 0 || ReadStackWords(memRegions, iRBP, iFrameRecord, 2, iStackLow, iStackHigh) == false)
+            return UnwindStep_Failed;
+
+        iCallerRBP  = iFrameRecord[0];
+        iReturnAdrs = iFrameRecord[1];
+        iCallerRSP  = iRBP + 16;
+    }
+    else
+    {
+        if(regsIn.IsValid(DwarfReg_RSP) == false)
+            return UnwindStep_Failed;
+
+        uintptr_t iRSP        = regsIn.Get(DwarfReg_RSP);
+        uintptr_t iReturnSlot = iRSP + code.m_frame.m_iFrameSize;
+        if(ReadStackWords(memRegions, iReturnSlot, &iReturnAdrs, 1, iStackLow, iStackHigh) == false)
+            return UnwindStep_Failed;
+
+        iCallerRSP = iReturnSlot + 8;
+        if(code.m_frame.m_iSavedRbpOffset >= 0)
+        {
+            if(ReadStackWords(memRegions, iRSP + static_cast<uintptr_t>(code.m_frame.m_iSavedRbpOffset), &iCallerRBP, 1, iStackLow, iStackHigh) == false)
+                return UnwindStep_Failed;
+        }
+        else
+        {
+            // Code leaves rBP alone, caller's is still in it.
+            bKnownRBP  = regsIn.IsValid(DwarfReg_RBP);
+            iCallerRBP = regsIn.Get(DwarfReg_RBP);
+        }
+    }
+
+    if(iCallerRSP <= regsIn.Get(DwarfReg_RSP) || memRegions.HasExecutableRegion(iReturnAdrs) == false || IsAfterCall(iReturnAdrs) == false)
+        return UnwindStep_Failed;
+
+
+    // Callee saved registers could be anywhere in the frame, only rSP & rBP are known.
+    regsOut = DwarfRegs_t();
+    regsOut.Set(DwarfReg_RA,  iReturnAdrs);
+    regsOut.Set(DwarfReg_RSP, iCallerRSP);
+    if(bKnownRBP == true)
+        regsOut.Set(DwarfReg_RBP, iCallerRBP);
+
+    return UnwindStep_Ok;
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+DEADSTOP_CRASH_PATH
+void DeadStop::NoteFramePointerUse(MemRegionHandler_t& memRegions, uintptr_t iReturnAdrs, bool bFramePointer)
+{
+    UnwindModule_t      module;
+    UnwindModuleSlot_t* pSlot = FindUnwindModule(memRegions, iReturnAdrs - 1, module);
+    if(pSlot == nullptr)
+        return;
+
+    // Slot might get another module meanwhile, its counts are reset then anyway.
+    if(bFramePointer == true)
+        pSlot->m_nFramePointerFrames.fetch_add(1, std::memory_order_relaxed);
+    else
+        pSlot->m_nOmittedFrames.fetch_add(1, std::memory_order_relaxed);
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+DEADSTOP_CRASH_PATH
+bool DeadStop::IsAfterCall(uintptr_t iReturnAdrs, uintptr_t* pCallTargetOut)
+{
+    uint32_t iGeneration = s_iCallSiteGeneration.load(std::memory_order_acquire);
+    if(iReturnAdrs == t_iLastCallSite && iReturnAdrs != 0 && t_iLastCallGeneration == iGeneration)
+    {
+        if(pCallTargetOut != nullptr)
+            *pCallTargetOut = t_iLastCallTarget;
+
+        return true;
+    }
+
+    if(iReturnAdrs < 8)
+        return false;
+
+    uint8_t iBytes[8];
+    if(SafeRead(iBytes, iReturnAdrs - sizeof(iBytes), sizeof(iBytes)) != sizeof(iBytes))
+        return false;
+
+
+    // call rel32 : E8 xx xx xx xx
+    if(iBytes[8 - 5] == 0xE8)
+    {
+        int32_t iRel = 0;
+        memcpy(&iRel, &iBytes[8 - 4], sizeof(iRel));
+
+        t_iLastCallGeneration = iGeneration;
+        t_iLastCallSite       = iReturnAdrs;
+        t_iLastCallTarget     = iReturnAdrs + static_cast<uintptr_t>(static_cast<intptr_t>(iRel));
+        if(pCallTargetOut != nullptr)
+            *pCallTargetOut = t_iLastCallTarget;
+
+        return true;
+    }
+
+
+    // call r/m64 : FF /2, 2 to 7 bytes long depending on ModRM & SIB. REX prefixes don't change the length after FF.
+    for(int iLength = 2; iLength <= 7; iLength++)
+    {
+        if(iBytes[8 - iLength] != 0xFF)
+            continue;
+
+        uint8_t iModRM = iBytes[8 - iLength + 1];
+        if(((iModRM >> 3) & 7) != 2)
+            continue;
+
+        int iMod = iModRM >> 6;
+        int iRM  = iModRM & 7;
+
+        int iExpectedLength = 2;
+        if(iMod == 1)      iExpectedLength += 1;
+        else if(iMod == 2) iExpectedLength += 4;
+        else if(iMod == 0 && iRM == 5) iExpectedLength += 4; // rIP relative.
+
+        if(iMod != 3 && iRM == 4)
+        {
+            iExpectedLength += 1; // SIB byte.
+
+            // SIB base of rBP without displacement means disp32 instead.
+            if(iLength >= 3 && iMod == 0 && (iBytes[8 - iLength + 2] & 7) == 5)
+                iExpectedLength += 4;
+        }
+
+        if(iExpectedLength == iLength)
+        {
+            t_iLastCallGeneration = iGeneration;
+            t_iLastCallSite       = iReturnAdrs;
+            t_iLastCallTarget     = 0;
+            if(pCallTargetOut != nullptr)
+                *pCallTargetOut = 0;
+
+            return true;
+        }
+    }
+
+    return false;
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+DEADSTOP_CRASH_PATH
+void DeadStop::ClearUnwindModuleCache()
+{
+    for(size_t iSlot = 0; iSlot < MAX_UNWIND_MODULES; iSlot++)
+    {
+        UnwindModuleSlot_t& slot = s_unwindModules[iSlot];
+
+        // Nobody unwinds while maps are reloaded. Slot still odd is a writer the crash took over from, its ours now.
+        uint32_t iSequence = slot.m_iSequence.load(std::memory_order_acquire);
+        slot.m_iSequence.store((iSequence | 1), std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        slot.m_module = UnwindModule_t();
+        slot.m_nFramePointerFrames.store(0, std::memory_order_relaxed);
+        slot.m_nOmittedFrames.store(0, std::memory_order_relaxed);
+        slot.m_iSequence.store((iSequence | 1) + 1, std::memory_order_release);
+    }
+
+    s_iNextUnwindModule.store(0, std::memory_order_relaxed);
+    s_iCallSiteGeneration.fetch_add(1, std::memory_order_release);
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+DEADSTOP_CRASH_PATH
+const char* DeadStop::GetUnwindMethodName(UnwindMethod_t iMethod)
+{
+    switch(iMethod)
+    {
+        case UnwindMethod_FramePointer: return "frame pointer";
+        case UnwindMethod_CFI:          return "cfi";
+        case UnwindMethod_Heuristic:    return "heuristic";
+        case UnwindMethod_StackScan:    return "stack scan";
+        case UnwindMethod_JitFrame:     return "jit frame";
+        default:                        return "";
+    }
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+DEADSTOP_CRASH_PATH
+static UnwindModuleSlot_t* DeadStop::FindUnwindModule(MemRegionHandler_t& memRegions, uintptr_t iPC, UnwindModule_t& moduleOut)
+{
+    for(size_t iSlot = 0; iSlot < MAX_UNWIND_MODULES; iSlot++)
+    {
+        UnwindModuleSlot_t& slot = s_unwindModules[iSlot];
+
+        uint32_t iSequence = slot.m_iSequence.load(std::memory_order_acquire);
+        if((iSequence & 1) != 0)
+            continue; // Being written, can't tell what it holds.
+
+        UnwindModule_t module = slot.m_module;
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if(slot.m_iSequence.load(std::memory_order_relaxed) != iSequence)
+            continue;
+
+        if(iPC >= module.m_iStart && iPC < module.m_iEnd)
+        {
+            moduleOut = module;
+            return &slot;
+        }
+    }
+
+
+    // Modules without unwind info are cached too, so we don't keep looking.
+    if(LoadUnwindModule(memRegions, iPC, moduleOut) == false)
+        return nullptr;
+
+    // Next slot in line, unless someone is writing it. Module is still good for this step uncached,
+    // only the frame pointer counts need a slot, the next step finds it then.
+    UnwindModuleSlot_t& slot      = s_unwindModules[s_iNextUnwindModule.fetch_add(1, std::memory_order_relaxed) % MAX_UNWIND_MODULES];
+    uint32_t            iSequence = slot.m_iSequence.load(std::memory_order_acquire);
+    if((iSequence & 1) != 0 || slot.m_iSequence.compare_exchange_strong(iSequence, iSequence + 1, std::memory_order_acquire) == false)
+        return nullptr;
+
+    std::atomic_thread_fence(std::memory_order_release);
+    slot.m_module = moduleOut;
+    slot.m_nFramePointerFrames.store(0, std::memory_order_relaxed);
+    slot.m_nOmittedFrames.store(0, std::memory_order_relaxed);
+    slot.m_iSequence.store(iSequence + 2, std::memory_order_release);
+
+    return &slot;
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+DEADSTOP_CRASH_PATH
+static bool DeadStop::LoadUnwindModule(MemRegionHandler_t& memRegions, uintptr_t iPC, UnwindModule_t& moduleOut)
+{
+    // Raw regions still know which file they map, merged index entries don't.
+    const MemRegion_t* pRegions = memRegions.GetAllRegions();
+    size_t             nRegions = memRegions.GetRegionCount();
+
+    const MemRegion_t* pCodeRegion = nullptr;
+    for(size_t iRegion = 0; iRegion < nRegions; iRegion++)
+    {
+        if(iPC >= pRegions[iRegion].m_iStart && iPC < pRegions[iRegion].m_iEnd)
+        {
+            pCodeRegion = &pRegions[iRegion];
+            break;
+        }
+    }
+
+    // Anonymous code ( JIT etc. ) has nothing to find unwind info with.
+    if(pCodeRegion == nullptr || pCodeRegion->m_iPathLength == 0 || (pCodeRegion->m_iFlags & MemRegionFlag_Exec) == 0)
+        return false;
+
+
+    // Module's bounds & its base, the mapping of file offset 0 where the ELF header is.
+    uintptr_t iBase = 0;
+    moduleOut.m_iStart = pCodeRegion->m_iStart;
+    moduleOut.m_iEnd   = pCodeRegion->m_iEnd;
+    for(size_t iRegion = 0; iRegion < nRegions; iRegion++)
+    {
+        const MemRegion_t& region = pRegions[iRegion];
+        if(IsSameFile(region, *pCodeRegion) == false)
+            continue;
+
+        if(region.m_iStart < moduleOut.m_iStart) moduleOut.m_iStart = region.m_iStart;
+        if(region.m_iEnd   > moduleOut.m_iEnd)   moduleOut.m_iEnd   = region.m_iEnd;
+
+        if(region.m_iOffset == 0 && (iBase == 0 || region.m_iStart < iBase))
+            iBase = region.m_iStart;
+    }
+
+    moduleOut.m_bHasHdr = false;
+    if(iBase == 0)
+        return true;
+
+
+    Elf64_Ehdr ehdr;
+    if(SafeReadValue(iBase, ehdr) == false || memcmp(ehdr.e_ident, ELFMAG, SELFMAG) != 0 || ehdr.e_ident[EI_CLASS] != ELFCLASS64)
+        return true;
+
+    if(ehdr.e_phentsize != sizeof(Elf64_Phdr) || ehdr.e_phnum == 0 || ehdr.e_phnum > MAX_PROGRAM_HEADERS)
+        return true;
+
+
+    // Load bias comes from the segment mapped at file offset 0, .eh_frame_hdr from PT_GNU_EH_FRAME.
+    bool      bHasBias   = false;
+    uintptr_t iLoadBias  = 0;
+    uintptr_t iHdrVAdrs  = 0;
+    for(size_t iPhdr = 0; iPhdr < ehdr.e_phnum; iPhdr++)
+    {
+        Elf64_Phdr phdr;
+        if(SafeReadValue(iBase + ehdr.e_phoff + iPhdr * sizeof(Elf64_Phdr), phdr) == false)
+            return true;
+
+        if(phdr.p_type == PT_LOAD && phdr.p_offset == 0 && bHasBias == false)
+        {
+            iLoadBias = iBase - static_cast<uintptr_t>(phdr.p_vaddr);
+            bHasBias  = true;
+        }
+        else if(phdr.p_type == PT_GNU_EH_FRAME)
+        {
+            iHdrVAdrs = static_cast<uintptr_t>(phdr.p_vaddr);
+        }
+    }
+
+    if(bHasBias == false || iHdrVAdrs == 0)
+        return true;
+
+
+    moduleOut.m_bHasHdr = ParseEhFrameHdr(iLoadBias + iHdrVAdrs, moduleOut.m_hdr);
+    return true;
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+DEADSTOP_CRASH_PATH
+static bool DeadStop::IsSameFile(const MemRegion_t& a, const MemRegion_t& b)
+{
+    if(a.m_iInode != b.m_iInode || a.m_iPathLength != b.m_iPathLength || a.m_iPathLength == 0)
+        return false;
+
+    return memcmp(a.m_szPath, b.m_szPath, a.m_iPathLength) == 0;
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+DEADSTOP_CRASH_PATH
+static bool DeadStop::ReadStackWords(MemRegionHandler_t& memRegions, uintptr_t iAdrs, uintptr_t* pWords, size_t nWords,
+        uintptr_t iStackLow, uintptr_t iStackHigh)
+{
+    size_t iSize = nWords * sizeof(uintptr_t);
+    if(iAdrs + iSize < iAdrs)
+        return false;
+
+    // Live stack doesn't need its region looked up. Still read safely, its bounds come from pthread & the
+    // fiber registry, & either can be wrong ( stale fiber, corrupt rSP ).
+    if(iStackHigh != 0 && iAdrs >= iStackLow && iAdrs + iSize <= iStackHigh)
+        return SafeRead(pWords, iAdrs, iSize) == iSize;
+
+    return memRegions.HasParentRegion(iAdrs, iAdrs + iSize - 1) == true && SafeRead(pWords, iAdrs, iSize) == iSize;
+}
@@ -0,0 +1,121 @@
+//=========================================================================
+//                      Unwinder
+//=========================================================================
+// by      : INSANE
+// created : 16/10/2026
+//
+// purpose : Steps a thread's registers up one frame at a time, using the
+//           unwind info of whichever module the code belongs to.
+//-------------------------------------------------------------------------
+#pragma once
+#include "../../Include/Alias.h"
+#include "DwarfCFI.h"
+#include <cstddef>
+#include <cstdint>
+#include <ucontext.h>
+
+
+
+namespace DEADSTOP_NAMESPACE
+{
+    class MemRegionHandler_t;
+
+
+    ///////////////////////////////////////////////////////////////////////////
+    ///////////////////////////////////////////////////////////////////////////
+    // How a frame's caller was found. Shown next to each frame in the report.
+    enum UnwindMethod_t : uint8_t
+    {
+        UnwindMethod_None = 0,     // Crash location itself.
+        UnwindMethod_FramePointer, // rBP chain, module is known to keep frame pointers.
+        UnwindMethod_CFI,          // .eh_frame unwind info.
+        UnwindMethod_Heuristic,    // No unwind info, found by reading the code.
+        UnwindMethod_StackScan,    // Nothing else worked, first thing up the stack that looks like a return address.
+        UnwindMethod_JitFrame,     // Frame layout registered with the JIT code, see JitRegistry.h.
+    };
+
+
+    enum UnwindStepResult_t : int
+    {
+        UnwindStep_Ok = 0,
+        UnwindStep_EndOfStack, // Unwind info says there is no caller ( e.g. _start ).
+        UnwindStep_NoInfo,     // Code has no unwind info we could find.
+        UnwindStep_Failed,     // Had unwind info, but couldn't apply it.
+    };
+
+
+    // Register state of a signal context, rIP goes in DwarfReg_RA.
+    void               DwarfRegsFromContext(const ucontext_t* pContext, DwarfRegs_t& regsOut);
+
+    // Register state right where this gets inlined, rIP in DwarfReg_RA. Only rSP, rBP & the callee saved
+    // ones, nothing else survives a call anyway. Caller's frame must stay as it is while it gets unwound,
+    // i.e. no tail calls out of it.
+    __attribute__((always_inline)) inline void DwarfRegsFromHere(DwarfRegs_t& regsOut)
+    {
+        uintptr_t iRegs[8];
+        __asm__ volatile(
+                "leaq 0(%%rip), %%rax\n\t"
+                "movq %%rax, 0(%0)\n\t"
+                "movq %%rsp, 8(%0)\n\t"
+                "movq %%rbp, 16(%0)\n\t"
+                "movq %%rbx, 24(%0)\n\t"
+                "movq %%r12, 32(%0)\n\t"
+                "movq %%r13, 40(%0)\n\t"
+                "movq %%r14, 48(%0)\n\t"
+                "movq %%r15, 56(%0)\n\t"
+                : : "D"(iRegs) : "rax", "memory");
+
+        regsOut = DwarfRegs_t();
+        regsOut.Set(DwarfReg_RA,  iRegs[0]);
+        regsOut.Set(DwarfReg_RSP, iRegs[1]);
+        regsOut.Set(DwarfReg_RBP, iRegs[2]);
+        regsOut.Set(DwarfReg_RBX, iRegs[3]);
+        regsOut.Set(DwarfReg_R12, iRegs[4]);
+        regsOut.Set(DwarfReg_R13, iRegs[5]);
+        regsOut.Set(DwarfReg_R14, iRegs[6]);
+        regsOut.Set(DwarfReg_R15, iRegs[7]);
+    }
+
+    // Caller's registers, using .eh_frame info of the module holding regsIn's rIP. bExactPC is true when
+    // rIP is where the thread actually was ( crash location, signal frames ), false when its a return address.
+    // bNextExactPCOut tells the same for the caller, so it can be passed straight into the next step.
+    // [ iStackLow, iStackHigh ) is the same as for StepWithFramePointer(), saved registers in it are read
+    // without SafeRead().
+    UnwindStepResult_t StepWithCFI(MemRegionHandler_t& memRegions, const DwarfRegs_t& regsIn, bool bExactPC,
+            DwarfRegs_t& regsOut, bool& bNextExactPCOut, uintptr_t iStackLow = 0, uintptr_t iStackHigh = 0);
+
+    // Caller's registers, straight from the saved rBP & return address at [ rBP ]. Only for return addresses
+    // ( never the crash location, it could be in a prologue ) in modules seen keeping frame pointers, anything
+    // else is UnwindStep_NoInfo. [ iStackLow, iStackHigh ), when non zero, must be live stack ( crash rSP to the
+    // top ), frames must sit inside it & skip the region lookup. Frame must also be above rSP, & the return
+    // address executable & right after a call, or its UnwindStep_Failed.
+    UnwindStepResult_t StepWithFramePointer(MemRegionHandler_t& memRegions, const DwarfRegs_t& regsIn, bool bExactPC,
+            uintptr_t iStackLow, uintptr_t iStackHigh, DwarfRegs_t& regsOut);
+
+    // Caller's registers, guessed by scanning stack words from rSP up for a value that points into code, right
+    // after a call. Last resort for frames nothing else could step, it can pick up a stale return address left
+    // in a local, so frames found this way are low confidence. Only rSP, rIP & ( if it still points up the
+    // stack ) rBP are known after. [ iStackLow, iStackHigh ) is the same as for StepWithFramePointer().
+    UnwindStepResult_t StepWithStackScan(MemRegionHandler_t& memRegions, const DwarfRegs_t& regsIn,
+            uintptr_t iStackLow, uintptr_t iStackHigh, DwarfRegs_t& regsOut);
+
+    // Caller's registers, from the frame layout rIP's JIT code was registered with. UnwindStep_NoInfo for
+    // code registered without one, & in its prologue. [ iStackLow, iStackHigh ) is the same as for
+    // StepWithFramePointer().
+    UnwindStepResult_t StepWithJitFrame(MemRegionHandler_t& memRegions, const DwarfRegs_t& regsIn, bool bExactPC,
+            uintptr_t iStackLow, uintptr_t iStackHigh, DwarfRegs_t& regsOut);
+
+    // Tells the module holding iReturnAdrs' caller whether that frame used rBP as a frame pointer. StepWithCFI()
+    // does this on its own, other steps that learn how a frame looked should too. Modules only get the frame
+    // pointer fast path once every frame seen in them had one.
+    void               NoteFramePointerUse(MemRegionHandler_t& memRegions, uintptr_t iReturnAdrs, bool bFramePointer);
+
+    // Is there a call instruction ending right at iReturnAdrs? pCallTargetOut gets where a direct call goes,
+    // 0 for indirect ones.
+    bool               IsAfterCall(uintptr_t iReturnAdrs, uintptr_t* pCallTargetOut = nullptr);
+
+    // Modules whose .eh_frame_hdr was already looked up. Lookups are safe from any number of threads, clear it only
+    // while nobody unwinds ( maps reload ).
+    void               ClearUnwindModuleCache();
+    const char*        GetUnwindMethodName(UnwindMethod_t iMethod);
+}
@@ -0,0 +1,177 @@
+//=========================================================================
+//                      Crash Arena
+//=========================================================================
+// by      : INSANE
+// created : 16/10/2026
+//
+// purpose : One mmap'd, prefaulted block of memory reserved at initialization.
+//           Everything the crash path needs is bump allocated from here, so
+//           we never call malloc while the process is going down.
+//-------------------------------------------------------------------------
+#include "CrashArena.h"
+#include "../Assertion/Assertion.h"
+#include "../MemoryLock/MemoryLock.h"
+#include <sys/mman.h>
+#include <unistd.h>
+
+
+// Mind this...
+using namespace DeadStop;
+
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+DeadStop::CrashArena_t::CrashArena_t()
+{
+    m_pBase = nullptr; m_iCapacity = 0; m_iUsed = 0; m_iHighWaterMark = 0; m_nFailedAllocs = 0;
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+DeadStop::CrashArena_t::~CrashArena_t()
+{
+    Release();
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+bool DeadStop::CrashArena_t::Reserve(size_t iSize)
+{
+    assertion(m_pBase == nullptr && "Crash arena is already reserved.");
+    assertion(iSize > 0 && "Invalid crash arena size");
+
+
+    // Round up to page size.
+    size_t iPageSize = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+    iSize = (iSize + iPageSize - 1) & ~(iPageSize - 1);
+
+    void* pMemory = mmap(nullptr, iSize, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_POPULATE, -1, 0);
+    if(pMemory == MAP_FAILED)
+        return false;
+
+
+    // MAP_POPULATE is only a hint, touch every page so none of them fault in at crash time.
+    volatile uint8_t* pPages = reinterpret_cast<volatile uint8_t*>(pMemory);
+    for(size_t iOffset = 0; iOffset < iSize; iOffset += iPageSize)
+        pPages[iOffset] = 0;
+
+
+    m_pBase          = reinterpret_cast<uint8_t*>(pMemory);
+    m_iCapacity      = iSize;
+    m_iUsed          = 0;
+    m_iHighWaterMark = 0;
+    m_nFailedAllocs  = 0;
+    return true;
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+void DeadStop::CrashArena_t::Release()
+{
+    if(m_pBase != nullptr)
+        munmap(m_pBase, m_iCapacity);
+
+    m_pBase = nullptr; m_iCapacity = 0; m_iUsed = 0;
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+DEADSTOP_CRASH_PATH
+void* DeadStop::CrashArena_t::Allocate(size_t iSize, size_t iAlignment)
+{
+    assertion(iAlignment != 0 && (iAlignment & (iAlignment - 1)) == 0 && "Alignment must be a power of 2");
+
+    size_t iStart = (m_iUsed + iAlignment - 1) & ~(iAlignment - 1);
+
+    // Out of budget? Don't grow, caller is expected to handle nullptr.
+    if(m_pBase == nullptr || iStart > m_iCapacity || iSize > m_iCapacity - iStart)
+    {
+        m_nFailedAllocs++;
+        return nullptr;
+    }
+
+
+    m_iUsed = iStart + iSize;
+    if(m_iUsed > m_iHighWaterMark)
+        m_iHighWaterMark = m_iUsed;
+
+    return m_pBase + iStart;
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+DEADSTOP_CRASH_PATH
+size_t DeadStop::CrashArena_t::GetMarker() const
+{
+    return m_iUsed;
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+DEADSTOP_CRASH_PATH
+void DeadStop::CrashArena_t::ResetToMarker(size_t iMarker)
+{
+    assertion(iMarker <= m_iUsed && "Can't reset crash arena forward.");
+    m_iUsed = iMarker;
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+DEADSTOP_CRASH_PATH
+bool DeadStop::CrashArena_t::IsReserved() const
+{
+    return m_pBase != nullptr;
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+DEADSTOP_CRASH_PATH
+size_t DeadStop::CrashArena_t::GetCapacity() const
+{
+    return m_iCapacity;
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+DEADSTOP_CRASH_PATH
+size_t DeadStop::CrashArena_t::GetUsed() const
+{
+    return m_iUsed;
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+DEADSTOP_CRASH_PATH
+size_t DeadStop::CrashArena_t::GetHighWaterMark() const
+{
+    return m_iHighWaterMark;
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+DEADSTOP_CRASH_PATH
+size_t DeadStop::CrashArena_t::GetFailedAllocations() const
+{
+    return m_nFailedAllocs;
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+DEADSTOP_CRASH_PATH
+void* DeadStop::CrashArena_t::GetBase() const
+{
+    return m_pBase;
+}
@@ -0,0 +1,55 @@
+//=========================================================================
+//                      Crash Arena
+//=========================================================================
+// by      : INSANE
+// created : 16/10/2026
+//
+// purpose : One mmap'd, prefaulted block of memory reserved at initialization.
+//           Everything the crash path needs is bump allocated from here, so
+//           we never call malloc while the process is going down.
+//-------------------------------------------------------------------------
+#pragma once
+#include "../../../Include/Alias.h"
+#include <cstddef>
+#include <cstdint>
+
+
+
+namespace DEADSTOP_NAMESPACE
+{
+    ///////////////////////////////////////////////////////////////////////////
+    ///////////////////////////////////////////////////////////////////////////
+    class CrashArena_t
+    {
+        public:
+            CrashArena_t();
+            ~CrashArena_t();
+
+            // mmap + prefault iSize bytes. Call once, before any crash can happen.
+            bool   Reserve(size_t iSize);
+            void   Release();
+
+            void*  Allocate(size_t iSize, size_t iAlignment = alignof(std::max_align_t));
+
+            template<typename T>
+            T*     AllocateArray(size_t nItems) { return reinterpret_cast<T*>(Allocate(sizeof(T) * nItems, alignof(T))); }
+
+            // Bump pointer resets. Take a marker before a phase, reset to it after.
+            size_t GetMarker() const;
+            void   ResetToMarker(size_t iMarker);
+
+            bool   IsReserved()            const;
+            size_t GetCapacity()           const;
+            size_t GetUsed()               const;
+            size_t GetHighWaterMark()      const;
+            size_t GetFailedAllocations()  const; // Allocations we had to refuse, non zero means budget is too small.
+            void*  GetBase()               const;
+
+        private:
+            uint8_t* m_pBase         = nullptr;
+            size_t   m_iCapacity     = 0;
+            size_t   m_iUsed         = 0;
+            size_t   m_iHighWaterMark = 0;
+            size_t   m_nFailedAllocs = 0;
+    };
+}
@@ -7,8 +7,9 @@
 // purpose : assertion.h rip-off so we have assertions in release mode.
 //-------------------------------------------------------------------------
 #pragma once
-#include <cstdio>
 #include <cstdlib>
+#include <cstring>
+#include <unistd.h>
 
 
 // Set to false to disable assetions.
@@ -26,9 +27,15 @@
 ///////////////////////////////////////////////////////////////////////////
 inline void  Assertion(const char* szExpression, const char* szFile, int iLine)
 {
-    printf("Assertion failed!\n");
-    printf("Expression : %s\n", szExpression);
-    printf("File       : %s\n", szFile);
-    printf("Line       : %d\n", iLine);
+    // NOTE : Assertions can fail inside the signal handler, so no printf here.
+    char szLine[16]; int iIndex = sizeof(szLine);
+    szLine[--iIndex] = '\n';
+    do { szLine[--iIndex] = static_cast<char>('0' + iLine % 10); iLine /= 10; } while(iLine > 0 && iIndex > 0);
+
+    auto Print = [](const char* sz, size_t iSize) { (void)!write(STDOUT_FILENO, sz, iSize); };
+    Print("Assertion failed!\n", 18);
+    Print("Expression : ", 13); Print(szExpression, strlen(szExpression)); Print("\n", 1);
+    Print("File       : ", 13); Print(szFile, strlen(szFile)); Print("\n", 1);
+    Print("Line       : ", 13); Print(&szLine[iIndex], sizeof(szLine) - iIndex);
     abort();
 }
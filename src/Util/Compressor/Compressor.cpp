@@ -0,0 +1,422 @@
+//=========================================================================
+//                      Compressor
+//=========================================================================
+// by      : INSANE
+// created : 16/10/2026
+//
+// purpose : LZ block compressor for dump output. Fixed working memory from
+//           the crash arena, nothing allocated while crashing. Decompression
+//           is for the offline tools.
+//-------------------------------------------------------------------------
+#include "Compressor.h"
+#include "../Arena/CrashArena.h"
+#include "../Writer/Writer.h"
+#include "../MemoryLock/MemoryLock.h"
+#include <cstring>
+
+
+// Mind this...
+using namespace DeadStop;
+
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+namespace DEADSTOP_NAMESPACE
+{
+    // Incompressible input grows by a byte per 255 literals, plus the token.
+    constexpr size_t LZ_MAX_PAYLOAD_SIZE = LZ_BLOCK_SIZE + LZ_BLOCK_SIZE / 255 + 16;
+
+    static uint32_t ReadU32    (const uint8_t* pSrc);
+    static uint64_t ReadU64    (const uint8_t* pSrc);
+    static uint32_t HashU32    (uint32_t iValue);
+    static uint8_t* WriteLength(uint8_t* pDest, size_t iLength);
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+DeadStop::Compressor_t::Compressor_t()
+{
+    Release();
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+size_t DeadStop::Compressor_t::GetMemorySize()
+{
+    return (sizeof(uint32_t) << LZ_HASH_BITS) + sizeof(CompressedBlock_t) + LZ_MAX_PAYLOAD_SIZE + 2 * alignof(std::max_align_t);
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+bool DeadStop::Compressor_t::Initialize(CrashArena_t& arena)
+{
+    m_pHashTable = arena.AllocateArray<uint32_t>(static_cast<size_t>(1) << LZ_HASH_BITS);
+    m_pBlock     = arena.AllocateArray<uint8_t>(sizeof(CompressedBlock_t) + LZ_MAX_PAYLOAD_SIZE);
+    if(m_pHashTable == nullptr || m_pBlock == nullptr)
+    {
+        Release();
+        return false;
+    }
+
+    m_iRawBytes    = 0;
+    m_iPackedBytes = 0;
+    return true;
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+void DeadStop::Compressor_t::Release()
+{
+    // Memory is the arena's.
+    m_pHashTable   = nullptr;
+    m_pBlock       = nullptr;
+    m_iRawBytes    = 0;
+    m_iPackedBytes = 0;
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+DEADSTOP_CRASH_PATH
+bool DeadStop::Compressor_t::IsInitialized() const
+{
+    return m_pBlock != nullptr;
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+DEADSTOP_CRASH_PATH
+bool DeadStop::Compressor_t::Write(int iFd, const char* pData, size_t iSize)
+{
+    if(m_pBlock == nullptr)
+        return WriteAll(iFd, pData, iSize);
+
+
+    bool bResult = true;
+    while(iSize > 0)
+    {
+        size_t         iChunk = iSize < LZ_BLOCK_SIZE ? iSize : LZ_BLOCK_SIZE;
+        const uint8_t* pSrc   = reinterpret_cast<const uint8_t*>(pData);
+        uint8_t*       pDest  = m_pBlock + sizeof(CompressedBlock_t);
+
+        CompressedBlock_t block = { COMPRESSED_BLOCK_MAGIC, CompressedBlockFlag_None, static_cast<uint32_t>(iChunk), 0 };
+        size_t iPacked = CompressBlock(pSrc, iChunk, pDest);
+        if(iPacked >= iChunk)
+        {
+            memcpy(pDest, pSrc, iChunk);
+            iPacked        = iChunk;
+            block.m_iFlags = CompressedBlockFlag_Stored;
+        }
+        block.m_iPackedSize = static_cast<uint32_t>(iPacked);
+        memcpy(m_pBlock, &block, sizeof(block));
+
+
+        // Header & payload in one write(), O_APPEND keeps the block in one piece.
+        if(WriteAll(iFd, reinterpret_cast<const char*>(m_pBlock), sizeof(block) + iPacked) == false)
+            bResult = false;
+
+        m_iRawBytes    += iChunk;
+        m_iPackedBytes += sizeof(block) + iPacked;
+        pData          += iChunk;
+        iSize          -= iChunk;
+    }
+
+    return bResult;
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+DEADSTOP_CRASH_PATH
+bool DeadStop::Compressor_t::FlushFn(void* pContext, int iFd, const char* pData, size_t iSize)
+{
+    return static_cast<Compressor_t*>(pContext)->Write(iFd, pData, iSize);
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+DEADSTOP_CRASH_PATH
+uint64_t DeadStop::Compressor_t::GetRawBytes() const
+{
+    return m_iRawBytes;
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+DEADSTOP_CRASH_PATH
+uint64_t DeadStop::Compressor_t::GetPackedBytes() const
+{
+    return m_iPackedBytes;
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+DEADSTOP_CRASH_PATH
+size_t DeadStop::Compressor_t::CompressBlock(const uint8_t* pSrc, size_t iSize, uint8_t* pDest)
+{
+    // Greedy, one candidate per hash slot. Table is only good for one block, offsets can't reach past it.
+    memset(m_pHashTable, 0, sizeof(uint32_t) << LZ_HASH_BITS);
+
+    uint8_t* pOut    = pDest;
+    size_t   iCursor = 0;
+    size_t   iAnchor = 0; // Literals not written yet start here.
+    while(iCursor + LZ_MIN_MATCH <= iSize)
+    {
+        uint32_t  iValue     = ReadU32(pSrc + iCursor);
+        uint32_t& iCandidate = m_pHashTable[HashU32(iValue)];
+        size_t    iMatch     = iCandidate;
+        iCandidate           = static_cast<uint32_t>(iCursor + 1);
+
+        if(iMatch == 0 || iCursor - (iMatch - 1) > LZ_MAX_OFFSET || ReadU32(pSrc + iMatch - 1) != iValue)
+        {
+            // Skip ahead faster the longer nothing matched, incompressible data costs less that way.
+            iCursor += 1 + ((iCursor - iAnchor) >> 6);
+            continue;
+        }
+        iMatch--;
+
+
+        // 8 bytes a step, first differing byte is found from the lowest set bit.
+        size_t iLength = LZ_MIN_MATCH;
+        while(iCursor + iLength + sizeof(uint64_t) <= iSize)
+        {
+            uint64_t iDiff = ReadU64(pSrc + iMatch + iLength) ^ ReadU64(pSrc + iCursor + iLength);
+            if(iDiff != 0)
+            {
+                iLength += static_cast<size_t>(__builtin_ctzll(iDiff)) / 8;
+                break;
+            }
+
+            iLength += sizeof(uint64_t);
+        }
+
+        if(iCursor + iLength + sizeof(uint64_t) > iSize)
+        {
+            while(iCursor + iLength < iSize && pSrc[iMatch + iLength] == pSrc[iCursor + iLength])
+                iLength++;
+        }
+
+        size_t   iLiterals = iCursor - iAnchor;
+        uint8_t* pToken    = pOut++;
+        *pToken = static_cast<uint8_t>((iLiterals < 15 ? iLiterals : 15) << 4);
+        if(iLiterals >= 15)
+            pOut = WriteLength(pOut, iLiterals - 15);
+
+        memcpy(pOut, pSrc + iAnchor, iLiterals);
+        pOut += iLiterals;
+
+        size_t iOffset = iCursor - iMatch;
+        *pOut++ = static_cast<uint8_t>(iOffset & 0xFF);
+        *pOut++ = static_cast<uint8_t>(iOffset >> 8);
+
+        size_t iMatchCode = iLength - LZ_MIN_MATCH;
+        *pToken |= static_cast<uint8_t>(iMatchCode < 15 ? iMatchCode : 15);
+        if(iMatchCode >= 15)
+            pOut = WriteLength(pOut, iMatchCode - 15);
+
+        iCursor += iLength;
+        iAnchor  = iCursor;
+
+        // Bail early if its not paying off, caller stores the block as is.
+        if(static_cast<size_t>(pOut - pDest) >= iSize)
+            return iSize;
+    }
+
+
+    // Last sequence, whatever is left as literals.
+    size_t iLiterals = iSize - iAnchor;
+    *pOut++ = static_cast<uint8_t>((iLiterals < 15 ? iLiterals : 15) << 4);
+    if(iLiterals >= 15)
+        pOut = WriteLength(pOut, iLiterals - 15);
+
+    memcpy(pOut, pSrc + iAnchor, iLiterals);
+    pOut += iLiterals;
+
+    return static_cast<size_t>(pOut - pDest);
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+bool DeadStop::DecompressBlock(const uint8_t* pSrc, size_t iSrcSize, uint8_t* pDest, size_t iRawSize)
+{
+    size_t iIn  = 0;
+    size_t iOut = 0;
+    while(true)
+    {
+        if(iIn >= iSrcSize)
+            return false;
+
+        uint8_t iToken = pSrc[iIn++];
+
+
+        // Literals.
+        size_t iLiterals = iToken >> 4;
+        if(iLiterals == 15)
+        {
+            uint8_t iByte = 255;
+            while(iByte == 255)
+            {
+                if(iIn >= iSrcSize)
+                    return false;
+
+                iByte      = pSrc[iIn++];
+                iLiterals += iByte;
+            }
+        }
+
+        if(iLiterals > iSrcSize - iIn || iLiterals > iRawSize - iOut)
+            return false;
+
+        memcpy(pDest + iOut, pSrc + iIn, iLiterals);
+        iIn  += iLiterals;
+        iOut += iLiterals;
+
+        // Last sequence has no match.
+        if(iIn == iSrcSize)
+            return iOut == iRawSize;
+
+
+        // Match.
+        if(iSrcSize - iIn < 2)
+            return false;
+
+        size_t iOffset = static_cast<size_t>(pSrc[iIn]) | (static_cast<size_t>(pSrc[iIn + 1]) << 8);
+        iIn += 2;
+
+        size_t iLength = (iToken & 0xF) + LZ_MIN_MATCH;
+        if((iToken & 0xF) == 15)
+        {
+            uint8_t iByte = 255;
+            while(iByte == 255)
+            {
+                if(iIn >= iSrcSize)
+                    return false;
+
+                iByte    = pSrc[iIn++];
+                iLength += iByte;
+            }
+        }
+
+        if(iOffset == 0 || iOffset > iOut || iLength > iRawSize - iOut)
+            return false;
+
+        // Byte at a time, matches can overlap what they produce.
+        for(size_t i = 0; i < iLength; i++, iOut++)
+            pDest[iOut] = pDest[iOut - iOffset];
+    }
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+size_t DeadStop::InflateDump(const uint8_t* pData, size_t iSize, std::vector<uint8_t>& vecOut)
+{
+    vecOut.clear();
+    vecOut.reserve(iSize);
+
+    size_t nInflated = 0;
+    size_t iCursor   = 0;
+    while(iCursor < iSize)
+    {
+        CompressedBlock_t block;
+        if(iSize - iCursor >= sizeof(block))
+            memcpy(&block, pData + iCursor, sizeof(block));
+
+        bool bIsBlock = iSize - iCursor >= sizeof(block) && block.m_iMagic == COMPRESSED_BLOCK_MAGIC &&
+            block.m_iRawSize <= LZ_BLOCK_SIZE && block.m_iPackedSize <= iSize - iCursor - sizeof(block);
+
+        if(bIsBlock == true)
+        {
+            const uint8_t* pPayload = pData + iCursor + sizeof(block);
+            size_t         iOldSize = vecOut.size();
+            vecOut.resize(iOldSize + block.m_iRawSize);
+
+            bool bInflated = false;
+            if((block.m_iFlags & CompressedBlockFlag_Stored) != 0)
+            {
+                bInflated = block.m_iPackedSize == block.m_iRawSize;
+                if(bInflated == true)
+                    memcpy(vecOut.data() + iOldSize, pPayload, block.m_iRawSize);
+            }
+            else
+            {
+                bInflated = DecompressBlock(pPayload, block.m_iPackedSize, vecOut.data() + iOldSize, block.m_iRawSize);
+            }
+
+            if(bInflated == true)
+            {
+                nInflated++;
+                iCursor += sizeof(block) + block.m_iPackedSize;
+                continue;
+            }
+
+            vecOut.resize(iOldSize);
+        }
+
+
+        // Not a block, e.g. an uncompressed dump in the same file.
+        vecOut.push_back(pData[iCursor++]);
+    }
+
+    return nInflated;
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+DEADSTOP_CRASH_PATH
+static uint32_t DeadStop::ReadU32(const uint8_t* pSrc)
+{
+    uint32_t iValue;
+    memcpy(&iValue, pSrc, sizeof(iValue));
+    return iValue;
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+DEADSTOP_CRASH_PATH
+static uint64_t DeadStop::ReadU64(const uint8_t* pSrc)
+{
+    uint64_t iValue;
+    memcpy(&iValue, pSrc, sizeof(iValue));
+    return iValue;
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+DEADSTOP_CRASH_PATH
+static uint32_t DeadStop::HashU32(uint32_t iValue)
+{
+    return (iValue * 2654435761u) >> (32 - LZ_HASH_BITS);
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+DEADSTOP_CRASH_PATH
+static uint8_t* DeadStop::WriteLength(uint8_t* pDest, size_t iLength)
+{
+    while(iLength >= 255)
+    {
+        *pDest++ = 255;
+        iLength -= 255;
+    }
+
+    *pDest++ = static_cast<uint8_t>(iLength);
+    return pDest;
+}
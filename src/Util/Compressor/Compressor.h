@@ -0,0 +1,94 @@
+//=========================================================================
+//                      Compressor
+//=========================================================================
+// by      : INSANE
+// created : 16/10/2026
+//
+// purpose : LZ block compressor for dump output. Fixed working memory from
+//           the crash arena, nothing allocated while crashing. Decompression
+//           is for the offline tools.
+//-------------------------------------------------------------------------
+#pragma once
+#include "../../../Include/Alias.h"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+
+
+namespace DEADSTOP_NAMESPACE
+{
+    class CrashArena_t;
+
+    // Output is a run of blocks, CompressedBlock_t + payload, each written with its own write() so they
+    // stay whole in files other processes append to. Payload is m_iRawSize bytes as is if stored, LZ
+    // sequences otherwise :
+    //   token      : high nibble literal count, low nibble match length - LZ_MIN_MATCH. 15 in either
+    //                means more follows, in bytes added up till one isn't 255.
+    //   literals
+    //   offset     : 2 bytes little endian, how far back the match starts. 1 .. 65535.
+    //   match length bytes, if the low nibble was 15.
+    // Last sequence is literals only, block ends right after them.
+    constexpr uint32_t COMPRESSED_BLOCK_MAGIC = 0x5A4C5344; // "DSLZ"
+    constexpr size_t   LZ_BLOCK_SIZE          = 64 * 1024;  // Input bytes per block, at most.
+    constexpr size_t   LZ_MIN_MATCH           = 4;
+    constexpr size_t   LZ_MAX_OFFSET          = 65535;
+    constexpr int      LZ_HASH_BITS           = 13;
+
+
+    enum CompressedBlockFlags_t : uint32_t
+    {
+        CompressedBlockFlag_None   = 0,
+        CompressedBlockFlag_Stored = (1 << 0), // Didn't get any smaller, payload is the raw bytes.
+    };
+
+
+    struct CompressedBlock_t
+    {
+        uint32_t m_iMagic;
+        uint32_t m_iFlags;     // CompressedBlockFlags_t
+        uint32_t m_iRawSize;
+        uint32_t m_iPackedSize; // Payload that follows.
+    };
+
+
+    ///////////////////////////////////////////////////////////////////////////
+    ///////////////////////////////////////////////////////////////////////////
+    class Compressor_t
+    {
+        public:
+            Compressor_t();
+
+            // Hash table & one block's worth of output, carved out of the arena.
+            static size_t GetMemorySize();
+            bool          Initialize(CrashArena_t& arena);
+            void          Release();
+            bool          IsInitialized() const;
+
+            // Crash path. Compresses iSize bytes into blocks of up to LZ_BLOCK_SIZE input bytes & writes
+            // them to iFd. Blocks are independent, any flush size works.
+            bool          Write(int iFd, const char* pData, size_t iSize);
+
+            // Writer_t::FlushFn_t, pContext is the Compressor_t.
+            static bool   FlushFn(void* pContext, int iFd, const char* pData, size_t iSize);
+
+            uint64_t      GetRawBytes()    const;
+            uint64_t      GetPackedBytes() const; // Block headers included.
+
+        private:
+            size_t        CompressBlock(const uint8_t* pSrc, size_t iSize, uint8_t* pDest);
+
+            uint32_t* m_pHashTable   = nullptr; // Position + 1 of the last 4 bytes that hashed here, 0 if none.
+            uint8_t*  m_pBlock       = nullptr; // CompressedBlock_t + worst case payload.
+            uint64_t  m_iRawBytes    = 0;
+            uint64_t  m_iPackedBytes = 0;
+    };
+
+
+    // Offline. Inflates one block's payload into exactly iRawSize bytes. False if its malformed.
+    bool DecompressBlock(const uint8_t* pSrc, size_t iSrcSize, uint8_t* pDest, size_t iRawSize);
+
+    // Offline. pData with every compressed block in it inflated, anything else copied as is. Returns the
+    // number of blocks inflated, blocks that don't decompress are left as they are.
+    size_t InflateDump(const uint8_t* pData, size_t iSize, std::vector<uint8_t>& vecOut);
+}
@@ -0,0 +1,219 @@
+//=========================================================================
+//                      Memory Lock
+//=========================================================================
+// by      : INSANE
+// created : 16/10/2026
+//
+// purpose : Prefault & mlock the memory crash path runs on, so a crash on a
+//           swapping host doesn't stall on major page faults.
+//-------------------------------------------------------------------------
+#include "MemoryLock.h"
+#include "../../Defs/MemRegion_t.h"
+#include <vector>
+#include <cstring>
+#include <sys/mman.h>
+#include <unistd.h>
+#include <errno.h>
+#include <dlfcn.h>
+
+
+// Mind this...
+using namespace DeadStop;
+
+
+// Bounds of DEADSTOP_CRASH_PATH section. Weak, in case nothing got put in there.
+extern "C" const uint8_t __start_deadstop_crash_text[] __attribute__((weak));
+extern "C" const uint8_t __stop_deadstop_crash_text[]  __attribute__((weak));
+
+// Disassembler's .text & .rodata, renamed by the build. Weak, linked some other way they're not there.
+extern "C" const uint8_t __start_deadstop_dasm_text[]   __attribute__((weak));
+extern "C" const uint8_t __stop_deadstop_dasm_text[]    __attribute__((weak));
+extern "C" const uint8_t __start_deadstop_dasm_rodata[] __attribute__((weak));
+extern "C" const uint8_t __stop_deadstop_dasm_rodata[]  __attribute__((weak));
+
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+DeadStop::MemoryLock_t::MemoryLock_t()
+{
+    m_nLockedRanges = 0;
+    m_stats         = MemoryLockStats_t();
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+DeadStop::MemoryLock_t::~MemoryLock_t()
+{
+    UnlockAll();
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+bool DeadStop::MemoryLock_t::LockRange(const void* pAdrs, size_t iSize)
+{
+    if(pAdrs == nullptr || iSize == 0)
+        return true;
+
+
+    size_t    iPageSize = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+    uintptr_t iStart    = reinterpret_cast<uintptr_t>(pAdrs) & ~(iPageSize - 1);
+    uintptr_t iEnd      = (reinterpret_cast<uintptr_t>(pAdrs) + iSize + iPageSize - 1) & ~(iPageSize - 1);
+    size_t    iLockSize = iEnd - iStart;
+
+
+    // Fault everything in first. If mlock() gets refused, pages are at least resident right now.
+    volatile const uint8_t* pPages = reinterpret_cast<volatile const uint8_t*>(iStart);
+    for(size_t iOffset = 0; iOffset < iLockSize; iOffset += iPageSize)
+        (void)pPages[iOffset];
+
+
+    if(m_nLockedRanges >= MAX_LOCKED_RANGES || mlock(reinterpret_cast<void*>(iStart), iLockSize) != 0)
+    {
+        m_stats.m_iFailedBytes += iLockSize;
+        m_stats.m_iLastError    = m_nLockedRanges >= MAX_LOCKED_RANGES ? ENOMEM : errno;
+        return false;
+    }
+
+
+    m_lockedRanges[m_nLockedRanges].m_iStart = iStart;
+    m_lockedRanges[m_nLockedRanges].m_iSize  = iLockSize;
+    m_nLockedRanges++;
+
+    m_stats.m_iLockedBytes += iLockSize;
+    return true;
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+bool DeadStop::MemoryLock_t::LockCrashPathText()
+{
+    if(__start_deadstop_crash_text == nullptr || __stop_deadstop_crash_text == nullptr)
+        return false;
+
+    return LockRange(__start_deadstop_crash_text, static_cast<size_t>(__stop_deadstop_crash_text - __start_deadstop_crash_text));
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+bool DeadStop::MemoryLock_t::LockDisassembler(const void* pDecoder, size_t iMaxModuleSize)
+{
+    if(__start_deadstop_dasm_text != nullptr && __stop_deadstop_dasm_text != nullptr)
+    {
+        bool bAllLocked = LockRange(__start_deadstop_dasm_text, static_cast<size_t>(__stop_deadstop_dasm_text - __start_deadstop_dasm_text));
+
+        if(__start_deadstop_dasm_rodata != nullptr && __stop_deadstop_dasm_rodata != nullptr)
+            bAllLocked &= LockRange(__start_deadstop_dasm_rodata, static_cast<size_t>(__stop_deadstop_dasm_rodata - __start_deadstop_dasm_rodata));
+
+        return bAllLocked;
+    }
+
+
+    // Sections weren't split out. Same module as us means its linked into the program ( or whatever
+    // library we're in ), locking that would lock all of it. Warm up decode has to do then.
+    static const uint8_t s_iOurModule = 0;
+    Dl_info decoderInfo, ourInfo;
+    if(dladdr(pDecoder, &decoderInfo) == 0 || dladdr(&s_iOurModule, &ourInfo) == 0 ||
+        ourInfo.dli_fbase == nullptr || decoderInfo.dli_fbase == ourInfo.dli_fbase)
+        return false;
+
+    return LockModuleOf(pDecoder, iMaxModuleSize);
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+bool DeadStop::MemoryLock_t::LockModuleOf(const void* pAdrs, size_t iMaxModuleSize)
+{
+    // NOTE : Not on the crash path, we can use the heap here. Maps keep growing, so grow the buffer
+    //        till the whole file fits.
+    std::vector<char>    vecText;
+    std::vector<uint8_t> vecStorage;
+    MemRegionHandler_t   regions;
+    for(size_t iTextSize = 256 * 1024; ; iTextSize *= 2)
+    {
+        vecText.resize(iTextSize);
+        vecStorage.resize((iTextSize / 32) * MemRegionHandler_t::STORAGE_PER_REGION);
+        regions.SetStorage(vecStorage.data(), vecStorage.size());
+
+        if(regions.InitializeFromFile("/proc/self/maps", vecText.data(), vecText.size()) == false)
+            return false;
+
+        if(regions.IsTextTruncated() == false && regions.HasOverflowed() == false)
+            break;
+    }
+
+
+    // Which file is pAdrs from?
+    const MemRegion_t* pAllRegions = regions.GetAllRegions();
+    const MemRegion_t* pOwner      = nullptr;
+    uintptr_t          iAdrs       = reinterpret_cast<uintptr_t>(pAdrs);
+    for(size_t iRegionIndex = 0; iRegionIndex < regions.GetRegionCount(); iRegionIndex++)
+    {
+        if(iAdrs >= pAllRegions[iRegionIndex].m_iStart && iAdrs < pAllRegions[iRegionIndex].m_iEnd)
+        {
+            pOwner = &pAllRegions[iRegionIndex];
+            break;
+        }
+    }
+
+    if(pOwner == nullptr || pOwner->m_iInode == 0)
+        return false;
+
+
+    // Every readable, non writable mapping of that file. Writable ones are data / bss, not ours to pin.
+    auto isModuleRegion = [&](const MemRegion_t& region) -> bool
+    {
+        return region.m_iInode == pOwner->m_iInode && region.m_iPathLength == pOwner->m_iPathLength &&
+            (region.m_iFlags & MemRegionFlag_Read) != 0 && (region.m_iFlags & MemRegionFlag_Write) == 0 &&
+            memcmp(region.m_szPath, pOwner->m_szPath, region.m_iPathLength) == 0;
+    };
+
+    size_t iModuleSize = 0;
+    for(size_t iRegionIndex = 0; iRegionIndex < regions.GetRegionCount(); iRegionIndex++)
+    {
+        if(isModuleRegion(pAllRegions[iRegionIndex]) == true)
+            iModuleSize += pAllRegions[iRegionIndex].m_iEnd - pAllRegions[iRegionIndex].m_iStart;
+    }
+
+    if(iModuleSize > iMaxModuleSize)
+    {
+        m_stats.m_iSkippedBytes += iModuleSize;
+        return false;
+    }
+
+
+    bool bAllLocked = true;
+    for(size_t iRegionIndex = 0; iRegionIndex < regions.GetRegionCount(); iRegionIndex++)
+    {
+        const MemRegion_t& region = pAllRegions[iRegionIndex];
+        if(isModuleRegion(region) == true)
+            bAllLocked &= LockRange(reinterpret_cast<const void*>(region.m_iStart), region.m_iEnd - region.m_iStart);
+    }
+
+    return bAllLocked;
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+void DeadStop::MemoryLock_t::UnlockAll()
+{
+    for(size_t iRangeIndex = 0; iRangeIndex < m_nLockedRanges; iRangeIndex++)
+        munlock(reinterpret_cast<void*>(m_lockedRanges[iRangeIndex].m_iStart), m_lockedRanges[iRangeIndex].m_iSize);
+
+    m_nLockedRanges = 0;
+    m_stats         = MemoryLockStats_t();
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+const MemoryLockStats_t& DeadStop::MemoryLock_t::GetStats() const
+{
+    return m_stats;
+}
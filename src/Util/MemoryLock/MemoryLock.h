@@ -0,0 +1,75 @@
+//=========================================================================
+//                      Memory Lock
+//=========================================================================
+// by      : INSANE
+// created : 16/10/2026
+//
+// purpose : Prefault & mlock the memory crash path runs on, so a crash on a
+//           swapping host doesn't stall on major page faults.
+//-------------------------------------------------------------------------
+#pragma once
+#include "../../../Include/Alias.h"
+#include <cstddef>
+#include <cstdint>
+
+
+// Functions the crash handler can reach are grouped in this section, so their code can be locked
+// without locking the rest of the program. Linker gives us __start_ / __stop_ symbols for it.
+#define DEADSTOP_CRASH_PATH __attribute__((section("deadstop_crash_text")))
+
+
+
+namespace DEADSTOP_NAMESPACE
+{
+    ///////////////////////////////////////////////////////////////////////////
+    ///////////////////////////////////////////////////////////////////////////
+    struct MemoryLockStats_t
+    {
+        size_t m_iLockedBytes  = 0;
+        size_t m_iFailedBytes  = 0; // Usually RLIMIT_MEMLOCK.
+        size_t m_iSkippedBytes = 0; // Too big to be worth locking.
+        int    m_iLastError    = 0; // errno of the last failed mlock().
+    };
+
+
+    ///////////////////////////////////////////////////////////////////////////
+    ///////////////////////////////////////////////////////////////////////////
+    class MemoryLock_t
+    {
+        public:
+            MemoryLock_t();
+            ~MemoryLock_t();
+
+            // Touch every page in range & mlock it. Range is widened to page boundaries.
+            bool LockRange(const void* pAdrs, size_t iSize);
+
+            // Code of every DEADSTOP_CRASH_PATH function.
+            bool LockCrashPathText();
+
+            // Disassembler's code & tables, pDecoder being any of its functions. Our build moves them into
+            // their own sections ( see CMakeLists.txt ), else only a disassembler living in its own shared
+            // library gets locked, by module. Never locks the program its linked into.
+            bool LockDisassembler(const void* pDecoder, size_t iMaxModuleSize);
+
+            // Read only mappings ( code, constants, tables ) of the module holding pAdrs. Modules bigger
+            // than iMaxModuleSize are skipped, statically linked programs would lock themselves whole.
+            bool LockModuleOf(const void* pAdrs, size_t iMaxModuleSize);
+
+            void UnlockAll();
+
+            const MemoryLockStats_t& GetStats() const;
+
+        private:
+            static constexpr size_t MAX_LOCKED_RANGES = 64;
+
+            struct LockedRange_t
+            {
+                uintptr_t m_iStart = 0;
+                size_t    m_iSize  = 0;
+            };
+
+            LockedRange_t     m_lockedRanges[MAX_LOCKED_RANGES];
+            size_t            m_nLockedRanges = 0;
+            MemoryLockStats_t m_stats;
+    };
+}
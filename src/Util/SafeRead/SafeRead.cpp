@@ -0,0 +1,244 @@
+//=========================================================================
+//                      Safe Read
+//=========================================================================
+// by      : INSANE
+// created : 16/10/2026
+//
+// purpose : Reading process memory from inside the crash handler without
+//           faulting. Memory maps can be stale or lie, this can't.
+//-------------------------------------------------------------------------
+#include "SafeRead.h"
+#include "../MemoryLock/MemoryLock.h"
+#include <atomic>
+#include <cstring>
+#include <csetjmp>
+#include <signal.h>
+#include <pthread.h>
+#include <sys/uio.h>
+#include <unistd.h>
+#include <errno.h>
+
+
+// Mind this...
+using namespace DeadStop;
+
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+namespace DEADSTOP_NAMESPACE
+{
+    static std::atomic<int>    s_iReadMode(SafeReadMode_None);
+    static std::atomic<size_t> s_nSyscalls(0);
+    static std::atomic<size_t> s_nFailedReads(0);
+    static size_t              s_iPageSize = 4096; // sysconf() isn't async-signal-safe, cached at init.
+
+
+    // Remote iovecs per process_vm_readv call, one per page. Anything under IOV_MAX works.
+    static constexpr size_t MAX_PAGES_PER_SYSCALL = 64;
+
+
+    // NOTE : Trivial type on purpose, signal handler touches this. ( see AltStack.cpp )
+    struct RecoveryPoint_t
+    {
+        sigjmp_buf            m_jmpBuf;
+        volatile sig_atomic_t m_bActive;
+    };
+    static thread_local RecoveryPoint_t t_recoveryPoint;
+
+
+    static size_t ReadWithProcessVMReadv(void* pDest, uintptr_t iSrcAdrs, size_t iSize);
+    static size_t ReadWithRecoveryPoint (void* pDest, uintptr_t iSrcAdrs, size_t iSize);
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+void DeadStop::InitializeSafeRead(SafeReadMode_t iForceMode)
+{
+    s_iPageSize = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+
+    if(iForceMode != SafeReadMode_None)
+    {
+        s_iReadMode.store(iForceMode, std::memory_order_release);
+        return;
+    }
+
+
+    // Read something we know is there. If that fails, process_vm_readv isn't usable here.
+    uint64_t iSource = 0xDEADC0DEDEADC0DEull;
+    uint64_t iDest   = 0;
+    iovec    local   = { &iDest, sizeof(iDest) };
+    iovec    remote  = { &iSource, sizeof(iSource) };
+
+    ssize_t nBytes = process_vm_readv(getpid(), &local, 1, &remote, 1, 0);
+    bool    bWorks = nBytes == static_cast<ssize_t>(sizeof(iDest)) && iDest == iSource;
+
+    s_iReadMode.store(bWorks == true ? SafeReadMode_ProcessVMReadv : SafeReadMode_RecoveryPoint, std::memory_order_release);
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+DEADSTOP_CRASH_PATH
+SafeReadMode_t DeadStop::GetSafeReadMode()
+{
+    return static_cast<SafeReadMode_t>(s_iReadMode.load(std::memory_order_acquire));
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+DEADSTOP_CRASH_PATH
+size_t DeadStop::SafeRead(void* pDest, uintptr_t iSrcAdrs, size_t iSize)
+{
+    if(iSize == 0)
+        return 0;
+
+    size_t nBytesRead = 0;
+    switch(GetSafeReadMode())
+    {
+        case SafeReadMode_ProcessVMReadv: nBytesRead = ReadWithProcessVMReadv(pDest, iSrcAdrs, iSize); break;
+        case SafeReadMode_RecoveryPoint:  nBytesRead = ReadWithRecoveryPoint (pDest, iSrcAdrs, iSize); break;
+
+        // Not initialized? Not reading anything blind.
+        default: break;
+    }
+
+    if(nBytesRead < iSize)
+        s_nFailedReads.fetch_add(1, std::memory_order_relaxed);
+
+    return nBytesRead;
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+DEADSTOP_CRASH_PATH
+static size_t DeadStop::ReadWithProcessVMReadv(void* pDest, uintptr_t iSrcAdrs, size_t iSize)
+{
+    // Kernel reports partial transfers per iovec, so we hand it one iovec per page. That way a bad
+    // page in the middle still gets us every byte before it, & a whole batch costs one syscall.
+    pid_t    iPID    = getpid();
+    uint8_t* pOut    = reinterpret_cast<uint8_t*>(pDest);
+    size_t   nCopied = 0;
+
+    while(nCopied < iSize)
+    {
+        iovec  remote[MAX_PAGES_PER_SYSCALL];
+        size_t nRemote     = 0;
+        size_t iBatchBytes = 0;
+
+        uintptr_t iCursor = iSrcAdrs + nCopied;
+        while(nRemote < MAX_PAGES_PER_SYSCALL && nCopied + iBatchBytes < iSize)
+        {
+            size_t iToPageEnd = s_iPageSize - (iCursor & (s_iPageSize - 1));
+            size_t iLeft      = iSize - nCopied - iBatchBytes;
+            size_t iChunk     = iLeft < iToPageEnd ? iLeft : iToPageEnd;
+
+            remote[nRemote].iov_base = reinterpret_cast<void*>(iCursor);
+            remote[nRemote].iov_len  = iChunk;
+            nRemote++;
+
+            iBatchBytes += iChunk;
+            iCursor     += iChunk;
+        }
+
+
+        iovec local = { pOut + nCopied, iBatchBytes };
+
+        s_nSyscalls.fetch_add(1, std::memory_order_relaxed);
+        ssize_t nBytes = process_vm_readv(iPID, &local, 1, remote, nRemote, 0);
+        if(nBytes < 0)
+        {
+            if(errno == EINTR)
+                continue;
+
+            break; // EFAULT, very first page is bad.
+        }
+
+        nCopied += static_cast<size_t>(nBytes);
+
+        // Stopped early, rest is unreadable.
+        if(static_cast<size_t>(nBytes) < iBatchBytes)
+            break;
+    }
+
+    return nCopied;
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+DEADSTOP_CRASH_PATH
+static size_t DeadStop::ReadWithRecoveryPoint(void* pDest, uintptr_t iSrcAdrs, size_t iSize)
+{
+    // We are most likely inside the SIGSEGV handler already, which has SIGSEGV blocked. A fault
+    // with it blocked just kills us, so let them through for the length of the copy.
+    sigset_t faultSignals, oldMask;
+    sigemptyset(&faultSignals);
+    sigaddset(&faultSignals, SIGSEGV);
+    sigaddset(&faultSignals, SIGBUS);
+    pthread_sigmask(SIG_UNBLOCK, &faultSignals, &oldMask);
+
+
+    // Copy a page at a time, so a fault costs us at most the page it hit.
+    volatile size_t nCopied = 0;
+    if(sigsetjmp(t_recoveryPoint.m_jmpBuf, 0) == 0)
+    {
+        t_recoveryPoint.m_bActive = 1;
+
+        while(nCopied < iSize)
+        {
+            uintptr_t iCursor    = iSrcAdrs + nCopied;
+            size_t    iToPageEnd = s_iPageSize - (iCursor & (s_iPageSize - 1));
+            size_t    iLeft      = iSize - nCopied;
+            size_t    iChunk     = iLeft < iToPageEnd ? iLeft : iToPageEnd;
+
+            memcpy(reinterpret_cast<uint8_t*>(pDest) + nCopied, reinterpret_cast<const void*>(iCursor), iChunk);
+            nCopied = nCopied + iChunk;
+        }
+    }
+    t_recoveryPoint.m_bActive = 0;
+
+
+    pthread_sigmask(SIG_SETMASK, &oldMask, nullptr);
+    return nCopied;
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+DEADSTOP_CRASH_PATH
+bool DeadStop::RecoverFromSafeReadFault(int iSignalID)
+{
+    if(iSignalID != SIGSEGV && iSignalID != SIGBUS)
+        return false;
+
+    if(t_recoveryPoint.m_bActive == 0)
+        return false;
+
+
+    // Mask is restored by ReadWithRecoveryPoint() itself.
+    t_recoveryPoint.m_bActive = 0;
+    siglongjmp(t_recoveryPoint.m_jmpBuf, 1);
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+DEADSTOP_CRASH_PATH
+size_t DeadStop::GetSafeReadSyscallCount()
+{
+    return s_nSyscalls.load(std::memory_order_relaxed);
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+DEADSTOP_CRASH_PATH
+size_t DeadStop::GetSafeReadFailCount()
+{
+    return s_nFailedReads.load(std::memory_order_relaxed);
+}
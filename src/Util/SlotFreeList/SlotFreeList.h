@@ -0,0 +1,84 @@
+//=========================================================================
+//                      Slot Free List
+//=========================================================================
+// by      : INSANE
+// created : 16/10/2026
+//
+// purpose : Lock free allocator of slot indices, for the fixed size
+//           registries user code fills from hot paths.
+//-------------------------------------------------------------------------
+#pragma once
+#include "../../../Include/Alias.h"
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+
+
+namespace DEADSTOP_NAMESPACE
+{
+    ///////////////////////////////////////////////////////////////////////////
+    ///////////////////////////////////////////////////////////////////////////
+    // Hands out indices in [ 0, CAPACITY ). Freed ones sit on a Treiber stack, ones never handed out
+    // come from a bump counter, so there is nothing to set up & a zero initialized static one is ready
+    // to use. Both ends are a compare exchange or two, O(1) & never blocks.
+    template<size_t CAPACITY>
+    class SlotFreeList_t
+    {
+        static_assert(CAPACITY < 0xFFFFFFFF, "Slot indices must fit in 32 bits");
+
+        public:
+            bool Pop(size_t& iSlotOut)
+            {
+                // Tag changes on every pop & push, so a head that was popped & pushed back in between
+                // ( with a different next ) fails the exchange.
+                uint64_t iHead = m_iFreeHead.load(std::memory_order_acquire);
+                while((iHead & 0xFFFFFFFF) != 0)
+                {
+                    size_t   iSlot    = static_cast<size_t>(iHead & 0xFFFFFFFF) - 1;
+                    uint64_t iNext    = m_iNextFree[iSlot].load(std::memory_order_relaxed);
+                    uint64_t iNewHead = (((iHead >> 32) + 1) << 32) | iNext;
+                    if(m_iFreeHead.compare_exchange_weak(iHead, iNewHead, std::memory_order_acquire, std::memory_order_acquire) == true)
+                    {
+                        iSlotOut = iSlot;
+                        return true;
+                    }
+                }
+
+
+                // Nothing freed yet, take a slot nobody had before.
+                uint32_t nUsed = m_nUsed.load(std::memory_order_relaxed);
+                while(nUsed < CAPACITY)
+                {
+                    if(m_nUsed.compare_exchange_weak(nUsed, nUsed + 1, std::memory_order_acq_rel) == true)
+                    {
+                        iSlotOut = nUsed;
+                        return true;
+                    }
+                }
+
+                return false;
+            }
+
+            // Whatever was written to the slot before this is visible to its next Pop().
+            void Push(size_t iSlot)
+            {
+                uint64_t iHead    = m_iFreeHead.load(std::memory_order_relaxed);
+                uint64_t iNewHead = 0;
+                do
+                {
+                    m_iNextFree[iSlot].store(static_cast<uint32_t>(iHead & 0xFFFFFFFF), std::memory_order_relaxed);
+                    iNewHead = (((iHead >> 32) + 1) << 32) | static_cast<uint64_t>(iSlot + 1);
+                }
+                while(m_iFreeHead.compare_exchange_weak(iHead, iNewHead, std::memory_order_release, std::memory_order_relaxed) == false);
+            }
+
+            // Slots ever handed out, every slot in use is below this.
+            size_t GetUsedCount() const { return m_nUsed.load(std::memory_order_acquire); }
+
+        private:
+            std::atomic<uint64_t> m_iFreeHead;            // ( tag << 32 ) | ( slot index + 1 ), 0 index is empty.
+            std::atomic<uint32_t> m_nUsed;
+            std::atomic<uint32_t> m_iNextFree[CAPACITY];  // Slot index + 1 of the next free slot, 0 ends the list.
+    };
+}
@@ -7,35 +7,64 @@
 // purpose : Printf wrapper for convinence.
 //-------------------------------------------------------------------------
 #include "ConsoleSystem.h"
-#include <cstdio>
-#include <mutex>
+#include "../Writer/Writer.h"
+#include "../MemoryLock/MemoryLock.h"
 #include <cstdarg>
+#include <unistd.h>
 
 
 ///////////////////////////////////////////////////////////////////////////
 ///////////////////////////////////////////////////////////////////////////
+namespace DEADSTOP_NAMESPACE::Console
+{
+    // Trivial type, signal handlers read it.
+    static thread_local bool t_bMuted = false;
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+DEADSTOP_CRASH_PATH
 void DEADSTOP_NAMESPACE::Console::PrintToConsole(const char* szCaller, const char* szFGColor, const char* szModifier, const char* szFormat, ...)
 {
-    static std::mutex s_mtx;
+    if(t_bMuted == true)
+        return;
+
+
+    // NOTE : This gets called from inside the signal handler too, so no printf & no mutex.
+    //        Whole message is formatted on stack and written with a single write(2), which
+    //        also keeps messages from different threads from interleaving.
+    char     szBuffer[1024];
+    Writer_t writer(szBuffer, sizeof(szBuffer), -1);
 
-    s_mtx.lock();
-    
     // 2 calls so that caller name is always in white.
     if(szCaller[0] != '\0')
     {
-        printf("%s%s[ %s ] %s", Console::FG_BRIGHT_WHITE, Console::BOLD, szCaller, Console::RESET);
+        writer.Write(Console::FG_BRIGHT_WHITE).Write(Console::BOLD).Write("[ ").Write(szCaller).Write(" ] ").Write(Console::RESET);
     }
 
     // Format text.
-    printf("%s%s", szFGColor, szModifier);
+    writer.Write(szFGColor).Write(szModifier);
 
     // Print using varadic args.
     va_list args; va_start(args, szFormat);
-    vprintf(szFormat, args);
+    writer.FormatV(szFormat, args);
     va_end(args);
 
     // Reset
-    printf("%s\n", Console::RESET);
+    writer.Write(Console::RESET).Write('\n');
+
+    WriteAll(STDOUT_FILENO, writer.Data(), writer.Size());
+}
+
 
-    s_mtx.unlock();
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+DEADSTOP_CRASH_PATH
+bool DEADSTOP_NAMESPACE::Console::SetThreadMuted(bool bMuted)
+{
+    bool bWasMuted = t_bMuted;
+    t_bMuted = bMuted;
+    return bWasMuted;
 }
@@ -39,4 +39,7 @@ namespace DEADSTOP_NAMESPACE::Console
 
 
     void PrintToConsole(const char* szCaller, const char* szFGColor, const char* szModifier, const char* szFormat, ...);
+
+    // Drops whatever the calling thread prints while set. Returns what it was before, so it can be put back.
+    bool SetThreadMuted(bool bMuted);
 }
@@ -0,0 +1,544 @@
+//=========================================================================
+//                      Writer
+//=========================================================================
+// by      : INSANE
+// created : 16/10/2026
+//
+// purpose : Fixed buffer text writer. No heap, no stdio, no locale. Safe to
+//           use from inside a signal handler. Flushes with raw write(2).
+//-------------------------------------------------------------------------
+#include "Writer.h"
+#include "../MemoryLock/MemoryLock.h"
+#include <cstring>
+#include <unistd.h>
+#include <errno.h>
+
+
+// Mind this...
+using namespace DeadStop;
+
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+namespace DEADSTOP_NAMESPACE
+{
+    // Two digits per lookup, numbers get converted a byte ( or two decimal digits ) at a time. Built at
+    // compile time, so its plain read only data.
+    struct DigitPairs_t
+    {
+        char m_szHexUpper[256 * 2];
+        char m_szHexLower[256 * 2];
+        char m_szDec     [100 * 2];
+    };
+
+    static constexpr DigitPairs_t MakeDigitPairs()
+    {
+        DigitPairs_t pairs = {};
+        for(int i = 0; i < 256; i++)
+        {
+            pairs.m_szHexUpper[i * 2]     = "0123456789ABCDEF"[i >> 4];
+            pairs.m_szHexUpper[i * 2 + 1] = "0123456789ABCDEF"[i & 0xF];
+            pairs.m_szHexLower[i * 2]     = "0123456789abcdef"[i >> 4];
+            pairs.m_szHexLower[i * 2 + 1] = "0123456789abcdef"[i & 0xF];
+        }
+
+        for(int i = 0; i < 100; i++)
+        {
+            pairs.m_szDec[i * 2]     = static_cast<char>('0' + i / 10);
+            pairs.m_szDec[i * 2 + 1] = static_cast<char>('0' + i % 10);
+        }
+
+        return pairs;
+    }
+
+    static constexpr DigitPairs_t s_digitPairs = MakeDigitPairs();
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+DEADSTOP_CRASH_PATH
+DeadStop::Writer_t::Writer_t()
+{
+    Reset(nullptr, 0, -1);
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+DEADSTOP_CRASH_PATH
+DeadStop::Writer_t::Writer_t(char* pBuffer, size_t iCapacity, int iFd)
+{
+    Reset(pBuffer, iCapacity, iFd);
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+DEADSTOP_CRASH_PATH
+void DeadStop::Writer_t::Reset(char* pBuffer, size_t iCapacity, int iFd)
+{
+    m_pBuffer   = pBuffer;
+    m_iCapacity = pBuffer == nullptr ? 0 : iCapacity;
+    m_iSize     = 0;
+    m_iFd       = iFd;
+    m_bOverflow = false;
+
+    m_pfnFlush      = nullptr;
+    m_pFlushContext = nullptr;
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+DEADSTOP_CRASH_PATH
+void DeadStop::Writer_t::SetFlushFn(FlushFn_t pfnFlush, void* pContext)
+{
+    m_pfnFlush      = pfnFlush;
+    m_pFlushContext = pContext;
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+DEADSTOP_CRASH_PATH
+Writer_t& DeadStop::Writer_t::Write(const char* pData, size_t iSize)
+{
+    while(iSize > 0)
+    {
+        size_t iSpace = m_iCapacity - m_iSize;
+
+        // Out of space? Flush if we can, drop bytes if we can't.
+        if(iSpace == 0)
+        {
+            if(m_iFd < 0 || Flush() == false || m_iCapacity == 0)
+            {
+                m_bOverflow = true;
+                return *this;
+            }
+
+            continue;
+        }
+
+        size_t iChunk = iSize < iSpace ? iSize : iSpace;
+        memcpy(m_pBuffer + m_iSize, pData, iChunk);
+
+        m_iSize += iChunk;
+        pData   += iChunk;
+        iSize   -= iChunk;
+    }
+
+    return *this;
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+DEADSTOP_CRASH_PATH
+Writer_t& DeadStop::Writer_t::Write(const char* szString)
+{
+    if(szString == nullptr)
+        return Write("(null)");
+
+    size_t iLength = 0;
+    while(szString[iLength] != '\0') iLength++;
+
+    return Write(szString, iLength);
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+DEADSTOP_CRASH_PATH
+Writer_t& DeadStop::Writer_t::Write(char c)
+{
+    // Most writes are single characters into a buffer that has room.
+    if(m_iSize < m_iCapacity)
+    {
+        m_pBuffer[m_iSize++] = c;
+        return *this;
+    }
+
+    return Write(&c, 1);
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+DEADSTOP_CRASH_PATH
+Writer_t& DeadStop::Writer_t::WriteDec(int64_t iValue)
+{
+    if(iValue < 0)
+    {
+        Write('-');
+
+        // NOTE : Doing it this way so INT64_MIN doesn't overflow.
+        return WriteUDec(static_cast<uint64_t>(-(iValue + 1)) + 1);
+    }
+
+    return WriteUDec(static_cast<uint64_t>(iValue));
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+DEADSTOP_CRASH_PATH
+Writer_t& DeadStop::Writer_t::WriteUDec(uint64_t iValue, int iMinDigits, char cFill)
+{
+    // Filled from the back, two digits at a time.
+    char szDigits[24];
+    int  iPos = sizeof(szDigits);
+
+    while(iValue >= 100)
+    {
+        iPos -= 2;
+        memcpy(&szDigits[iPos], &s_digitPairs.m_szDec[(iValue % 100) * 2], 2);
+        iValue /= 100;
+    }
+
+    if(iValue >= 10)
+    {
+        iPos -= 2;
+        memcpy(&szDigits[iPos], &s_digitPairs.m_szDec[iValue * 2], 2);
+    }
+    else
+    {
+        szDigits[--iPos] = static_cast<char>('0' + iValue);
+    }
+
+    int nDigits = static_cast<int>(sizeof(szDigits)) - iPos;
+    WriteFill(cFill, iMinDigits - nDigits);
+
+    return Write(&szDigits[iPos], static_cast<size_t>(nDigits));
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+DEADSTOP_CRASH_PATH
+Writer_t& DeadStop::Writer_t::WriteHex(uint64_t iValue, int iMinDigits, bool bUpperCase)
+{
+    const char* szPairs = bUpperCase == true ? s_digitPairs.m_szHexUpper : s_digitPairs.m_szHexLower;
+
+    // Digit count is known upfront, so they go straight to where they belong, a byte at a time.
+    int  nDigits = iValue == 0 ? 1 : (64 - __builtin_clzll(iValue) + 3) / 4;
+    char szDigits[16];
+    int  iPos    = nDigits;
+
+    while(iPos >= 2)
+    {
+        iPos -= 2;
+        memcpy(&szDigits[iPos], &szPairs[(iValue & 0xFF) * 2], 2);
+        iValue >>= 8;
+    }
+
+    if(iPos == 1)
+        szDigits[0] = szPairs[(iValue & 0xF) * 2 + 1];
+
+    WriteFill('0', iMinDigits - nDigits);
+
+    return Write(szDigits, static_cast<size_t>(nDigits));
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+DEADSTOP_CRASH_PATH
+Writer_t& DeadStop::Writer_t::WritePadded(const char* szString, int iWidth)
+{
+    if(szString == nullptr)
+        szString = "(null)";
+
+    size_t iLength = 0;
+    while(szString[iLength] != '\0') iLength++;
+
+    Write(szString, iLength);
+    return WriteFill(' ', iWidth - static_cast<int>(iLength));
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+DEADSTOP_CRASH_PATH
+Writer_t& DeadStop::Writer_t::WriteFill(char c, int iCount)
+{
+    if(iCount <= 0)
+        return *this;
+
+    // Columns are rarely wider than this, one or two copies do it.
+    char szFill[64];
+    memset(szFill, c, iCount < static_cast<int>(sizeof(szFill)) ? iCount : sizeof(szFill));
+
+    while(iCount > 0)
+    {
+        int iChunk = iCount < static_cast<int>(sizeof(szFill)) ? iCount : static_cast<int>(sizeof(szFill));
+        Write(szFill, static_cast<size_t>(iChunk));
+        iCount -= iChunk;
+    }
+
+    return *this;
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+DEADSTOP_CRASH_PATH
+Writer_t& DeadStop::Writer_t::Append(const Writer_t& other)
+{
+    return Write(other.Data(), other.Size());
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+DEADSTOP_CRASH_PATH
+Writer_t& DeadStop::Writer_t::WriteThrough(const char* pData, size_t iSize)
+{
+    if(m_iFd < 0)
+        return Write(pData, iSize);
+
+    Flush();
+    if(m_pfnFlush != nullptr)
+        m_pfnFlush(m_pFlushContext, m_iFd, pData, iSize);
+    else
+        WriteAll(m_iFd, pData, iSize);
+
+    return *this;
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+DEADSTOP_CRASH_PATH
+Writer_t& DeadStop::Writer_t::Format(const char* szFormat, ...)
+{
+    va_list args; va_start(args, szFormat);
+    FormatV(szFormat, args);
+    va_end(args);
+
+    return *this;
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+DEADSTOP_CRASH_PATH
+Writer_t& DeadStop::Writer_t::FormatV(const char* szFormat, va_list args)
+{
+    if(szFormat == nullptr)
+        return *this;
+
+
+    while(*szFormat != '\0')
+    {
+        // Text up to the next conversion goes out in one piece.
+        if(*szFormat != '%')
+        {
+            const char* szLiteral = szFormat;
+            while(*szFormat != '\0' && *szFormat != '%') szFormat++;
+
+            Write(szLiteral, static_cast<size_t>(szFormat - szLiteral));
+            continue;
+        }
+        szFormat++;
+
+
+        // Flags & width.
+        char cFill      = ' ';
+        int  iWidth     = 0;
+        bool bLeftAlign = false;
+        while(*szFormat == '0' || *szFormat == '-')
+        {
+            if(*szFormat == '0') cFill      = '0';
+            if(*szFormat == '-') bLeftAlign = true;
+            szFormat++;
+        }
+        while(*szFormat >= '0' && *szFormat <= '9')
+            iWidth = iWidth * 10 + (*szFormat++ - '0');
+
+
+        // Length modifiers. We only care if its 64 bit or not.
+        bool bLong = false;
+        while(*szFormat == 'l' || *szFormat == 'z' || *szFormat == 'h')
+        {
+            if(*szFormat != 'h')
+                bLong = true;
+
+            szFormat++;
+        }
+
+
+        switch(*szFormat)
+        {
+            case 'd':
+            case 'i':
+                {
+                    int64_t  iValue = bLong == true ? va_arg(args, int64_t) : va_arg(args, int);
+                    uint64_t iAbs   = iValue < 0 ? static_cast<uint64_t>(-(iValue + 1)) + 1 : static_cast<uint64_t>(iValue);
+                    if(iValue < 0)
+                    {
+                        // Zeros go between the sign & the digits, spaces before the sign.
+                        if(cFill != '0')
+                        {
+                            int nDigits = 1;
+                            for(uint64_t iTemp = iAbs / 10; iTemp != 0; iTemp /= 10) nDigits++;
+                            WriteFill(cFill, iWidth - nDigits - 1);
+                            iWidth = 0;
+                        }
+
+                        Write('-');
+                        iWidth--;
+                    }
+                    WriteUDec(iAbs, iWidth, cFill);
+                }
+                break;
+
+            case 'u':
+                WriteUDec(bLong == true ? va_arg(args, uint64_t) : va_arg(args, unsigned int), iWidth, cFill);
+                break;
+
+            case 'x':
+            case 'X':
+                {
+                    uint64_t iValue = bLong == true ? va_arg(args, uint64_t) : va_arg(args, unsigned int);
+                    if(cFill == ' ')
+                    {
+                        // Count digits, so we can pad with spaces.
+                        int nDigits = 1;
+                        for(uint64_t iTemp = iValue >> 4; iTemp != 0; iTemp >>= 4) nDigits++;
+                        WriteFill(' ', iWidth - nDigits);
+                        iWidth = 0;
+                    }
+                    WriteHex(iValue, iWidth, *szFormat == 'X');
+                }
+                break;
+
+            case 'p':
+                Write("0x").WriteHex(reinterpret_cast<uintptr_t>(va_arg(args, void*)), 0, false);
+                break;
+
+            case 's':
+                {
+                    const char* szArg = va_arg(args, const char*);
+                    if(bLeftAlign == true)
+                    {
+                        WritePadded(szArg, iWidth);
+                    }
+                    else
+                    {
+                        int iLength = 0;
+                        while(szArg != nullptr && szArg[iLength] != '\0') iLength++;
+                        WriteFill(' ', iWidth - iLength).Write(szArg);
+                    }
+                }
+                break;
+
+            case 'c': Write(static_cast<char>(va_arg(args, int))); break;
+            case '%': Write('%'); break;
+
+            // Unknown conversion or a dangling '%' at the end.
+            case '\0': return *this;
+            default:   Write('%').Write(*szFormat); break;
+        }
+
+        szFormat++;
+    }
+
+    return *this;
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+DEADSTOP_CRASH_PATH
+bool DeadStop::Writer_t::Flush()
+{
+    if(m_iFd < 0)
+        return false;
+
+    bool bResult = m_pfnFlush != nullptr ? m_pfnFlush(m_pFlushContext, m_iFd, m_pBuffer, m_iSize) : WriteAll(m_iFd, m_pBuffer, m_iSize);
+    m_iSize = 0;
+
+    return bResult;
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+DEADSTOP_CRASH_PATH
+void DeadStop::Writer_t::Clear()
+{
+    m_iSize     = 0;
+    m_bOverflow = false;
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+DEADSTOP_CRASH_PATH
+const char* DeadStop::Writer_t::Data() const
+{
+    return m_pBuffer;
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+DEADSTOP_CRASH_PATH
+size_t DeadStop::Writer_t::Size() const
+{
+    return m_iSize;
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+DEADSTOP_CRASH_PATH
+size_t DeadStop::Writer_t::Capacity() const
+{
+    return m_iCapacity;
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+DEADSTOP_CRASH_PATH
+int DeadStop::Writer_t::GetFd() const
+{
+    return m_iFd;
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+DEADSTOP_CRASH_PATH
+bool DeadStop::Writer_t::HasOverflowed() const
+{
+    return m_bOverflow;
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////
+DEADSTOP_CRASH_PATH
+bool DeadStop::WriteAll(int iFd, const char* pData, size_t iSize)
+{
+    while(iSize > 0)
+    {
+        ssize_t iWritten = write(iFd, pData, iSize);
+        if(iWritten < 0)
+        {
+            if(errno == EINTR)
+                continue;
+
+            return false;
+        }
+
+        pData += iWritten;
+        iSize -= static_cast<size_t>(iWritten);
+    }
+
+    return true;
+}
@@ -0,0 +1,78 @@
+//=========================================================================
+//                      Writer
+//=========================================================================
+// by      : INSANE
+// created : 16/10/2026
+//
+// purpose : Fixed buffer text writer. No heap, no stdio, no locale. Safe to
+//           use from inside a signal handler. Flushes with raw write(2).
+//-------------------------------------------------------------------------
+#pragma once
+#include "../../../Include/Alias.h"
+#include <cstddef>
+#include <cstdint>
+#include <cstdarg>
+
+
+
+namespace DEADSTOP_NAMESPACE
+{
+    ///////////////////////////////////////////////////////////////////////////
+    ///////////////////////////////////////////////////////////////////////////
+    class Writer_t
+    {
+        public:
+            // Flushes go through this instead of write(2) if set, e.g. to compress them. Same contract as WriteAll().
+            typedef bool (*FlushFn_t)(void* pContext, int iFd, const char* pData, size_t iSize);
+
+            Writer_t();
+            Writer_t(char* pBuffer, size_t iCapacity, int iFd = -1);
+
+            // Use this buffer from now on. iFd < 0 means "scratch buffer", nothing is
+            // ever flushed and overflowing bytes are dropped.
+            void      Reset(char* pBuffer, size_t iCapacity, int iFd = -1);
+            void      SetFlushFn(FlushFn_t pfnFlush, void* pContext);
+
+            Writer_t& Write(const char* szString);
+            Writer_t& Write(const char* pData, size_t iSize);
+            Writer_t& Write(char c);
+            Writer_t& WriteDec(int64_t iValue);
+            Writer_t& WriteUDec(uint64_t iValue, int iMinDigits = 0, char cFill = '0');
+            Writer_t& WriteHex(uint64_t iValue, int iMinDigits = 0, bool bUpperCase = true);
+            Writer_t& WritePadded(const char* szString, int iWidth); // Left aligned, space filled.
+            Writer_t& WriteFill(char c, int iCount);
+            Writer_t& Append(const Writer_t& other);
+
+            // Big blobs. Flushes, then sends pData out the way flushes go, without copying it into the
+            // buffer first. Scratch buffers just take a copy.
+            Writer_t& WriteThrough(const char* pData, size_t iSize);
+
+            // printf style formatting for %s %c %d %i %u %x %X %p %% with '0' / width / 'l' 'z' 'h' modifiers.
+            Writer_t& Format(const char* szFormat, ...);
+            Writer_t& FormatV(const char* szFormat, va_list args);
+
+            // Write everything in buffer to file descriptor. Does nothing for scratch buffers.
+            bool        Flush();
+            void        Clear();
+
+            const char* Data()          const;
+            size_t      Size()          const;
+            size_t      Capacity()      const;
+            int         GetFd()         const;
+            bool        HasOverflowed() const;
+
+        private:
+            char*  m_pBuffer    = nullptr;
+            size_t m_iCapacity  = 0;
+            size_t m_iSize      = 0;
+            int    m_iFd        = -1;
+            bool   m_bOverflow  = false;
+
+            FlushFn_t m_pfnFlush      = nullptr;
+            void*     m_pFlushContext = nullptr;
+    };
+
+
+    // write(2) till done or till it fails. Retries on EINTR.
+    bool WriteAll(int iFd, const char* pData, size_t iSize);
+}